@@ -3,6 +3,12 @@
 
 #include <ctime>
 #include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "iterator.h"
+#include "utility.h"
+#include "algobase.h"
 
 
 
@@ -39,7 +45,7 @@ bool none_of(InputIterator first, InputIterator last,
         if (unary_pred(*first))
             return false;
     }
-    return true
+    return true;
 }
 
 template <typename InputIterator,typename T>
@@ -65,12 +71,31 @@ size_t count_if(InputIterator first, InputIterator last,
 }
 template <typename InputIterator, typename T>
 InputIterator
-find(InputIterator first, InputIterator last, const T& value) {
+__find(InputIterator first, InputIterator last, const T& value) {
     while (first != last && *first != value)
         ++first;
     return first;
 }
 
+// one-byte elements: memchr
+template <typename T, typename U>
+typename std::enable_if<
+  std::is_integral<T>::value && sizeof(T) == 1 && !std::is_same<T, bool>::value &&
+  std::is_integral<U>::value && sizeof(U) == 1,
+  T*>::type
+__find(T* first, T* last, const U& value) {
+    if (first == last)
+        return last;
+    const void* p = std::memchr(first, static_cast<unsigned char>(value), static_cast<size_t>(last - first));
+    return p == nullptr ? last : first + (static_cast<const T*>(p) - first);
+}
+
+template <typename InputIterator, typename T>
+InputIterator
+find(InputIterator first, InputIterator last, const T& value) {
+    return __find(first, last, value);
+}
+
 
 template <typename InputIterator, typename UnaryPredicate>
 InputIterator
@@ -91,8 +116,8 @@ find_if_not(InputIterator first, InputIterator last, UnaryPredicate unary_pred)
 //search
 template <typename ForwardIterator1, typename ForwardIterator2>
 ForwardIterator1
-search(ForwardIterator1 first1, ForwardIterator1 last1,
-       ForwardIterator2 first2, ForwardIterator2 last2)
+__search(ForwardIterator1 first1, ForwardIterator1 last1,
+         ForwardIterator2 first2, ForwardIterator2 last2)
 {
     auto dis1 = MYSTL::distance(first1, last1);
     auto dis2 = MYSTL::distance(first2, last2);
@@ -119,6 +144,39 @@ search(ForwardIterator1 first1, ForwardIterator1 last1,
 }
 
 
+// one-byte elements: memchr jumps to each occurrence of the first pattern byte and
+// memcmp checks the rest, both run many bytes per cycle
+template <typename T1, typename T2>
+typename std::enable_if<
+  std::is_same<typename std::remove_const<T1>::type, typename std::remove_const<T2>::type>::value &&
+  std::is_integral<T2>::value && sizeof(T2) == 1 && !std::is_same<T2, bool>::value,
+  T1*>::type
+__search(T1* first1, T1* last1, T2* first2, T2* last2) {
+    const auto n = static_cast<size_t>(last2 - first2);
+    if (n == 0)
+        return first1;
+    if (static_cast<size_t>(last1 - first1) < n)
+        return last1;
+    T1* const stop = last1 - (n - 1);  // last possible start + 1
+    while (first1 != stop) {
+        const void* p = std::memchr(first1, static_cast<unsigned char>(*first2), static_cast<size_t>(stop - first1));
+        if (p == nullptr)
+            return last1;
+        first1 += static_cast<const T1*>(p) - first1;
+        if (n == 1 || std::memcmp(first1 + 1, first2 + 1, n - 1) == 0)
+            return first1;
+        ++first1;
+    }
+    return last1;
+}
+
+template <typename ForwardIterator1, typename ForwardIterator2>
+ForwardIterator1
+search(ForwardIterator1 first1, ForwardIterator1 last1,
+       ForwardIterator2 first2, ForwardIterator2 last2) {
+    return __search(first1, last1, first2, last2);
+}
+
 template <typename ForwardIterator1, typename ForwardIterator2, 
                                      typename Compared>
 ForwardIterator1
@@ -149,6 +207,336 @@ search(ForwardIterator1 first1, ForwardIterator1 last1,
     return first1;
 }
 
+//find_end
+// last occurrence of [first2, last2) in [first1, last1), last1 when there is none or the
+// pattern is empty. each step is one search() past the previous match
+template <typename ForwardIterator1, typename ForwardIterator2>
+ForwardIterator1
+find_end(ForwardIterator1 first1, ForwardIterator1 last1,
+         ForwardIterator2 first2, ForwardIterator2 last2) {
+    if (first2 == last2)
+        return last1;
+    ForwardIterator1 result = last1;
+    while (true) {
+        ForwardIterator1 next = MYSTL::search(first1, last1, first2, last2);
+        if (next == last1)
+            return result;
+        result = first1 = next;
+        ++first1;
+    }
+}
+
+// default comparisons for the overloads without a Compare argument
+struct __less_op {
+    template <typename T1, typename T2>
+    bool operator()(const T1& a, const T2& b) const { return a < b; }
+};
+
+struct __equal_op {
+    template <typename T1, typename T2>
+    bool operator()(const T1& a, const T2& b) const { return a == b; }
+};
+
+// !comp(b, a), turns a lower_bound into an upper_bound
+template <typename Compare>
+struct __not_greater_op {
+    Compare comp;
+    template <typename T1, typename T2>
+    bool operator()(const T1& a, const T2& b) const { return !comp(b, a); }
+};
+
+/*****************************************************************************************/
+// lower_bound / upper_bound / binary_search
+// on random access ranges the halving loop has no data-dependent branch: the compiler turns
+// the step into a conditional move, so a search over a large sorted array costs one cache
+// miss per level and no mispredictions.
+/*****************************************************************************************/
+
+template <typename ForwardIterator, typename T, typename Compare>
+ForwardIterator
+__lower_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp,
+              MYSTL::forward_iterator_tag) {
+    auto len = MYSTL::distance(first, last);
+    while (len > 0) {
+        auto half = len / 2;
+        auto mid = first;
+        MYSTL::advance(mid, half);
+        if (comp(*mid, value)) {
+            first = ++mid;
+            len -= half + 1;
+        }
+        else {
+            len = half;
+        }
+    }
+    return first;
+}
+
+template <typename RandomAccessIterator, typename T, typename Compare>
+RandomAccessIterator
+__lower_bound(RandomAccessIterator first, RandomAccessIterator last, const T& value, Compare comp,
+              MYSTL::random_access_iterator_tag) {
+    auto len = last - first;
+    if (len == 0)
+        return first;
+    while (len > 1) {
+        const auto half = len / 2;
+        first = comp(first[half], value) ? first + half : first;
+        len -= half;
+    }
+    return first + (comp(*first, value) ? 1 : 0);
+}
+
+template <typename ForwardIterator, typename T, typename Compare>
+ForwardIterator
+lower_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp) {
+    return MYSTL::__lower_bound(first, last, value, comp, MYSTL::iterator_category(first));
+}
+
+template <typename ForwardIterator, typename T>
+ForwardIterator
+lower_bound(ForwardIterator first, ForwardIterator last, const T& value) {
+    return MYSTL::lower_bound(first, last, value,
+                              MYSTL::__less_op());
+}
+
+// first element with value < element
+template <typename ForwardIterator, typename T, typename Compare>
+ForwardIterator
+upper_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp) {
+    return MYSTL::lower_bound(first, last, value,
+                              MYSTL::__not_greater_op<Compare>{comp});
+}
+
+template <typename ForwardIterator, typename T>
+ForwardIterator
+upper_bound(ForwardIterator first, ForwardIterator last, const T& value) {
+    return MYSTL::lower_bound(first, last, value,
+                              MYSTL::__not_greater_op<MYSTL::__less_op>{MYSTL::__less_op()});
+}
+
+template <typename ForwardIterator, typename T, typename Compare>
+bool binary_search(ForwardIterator first, ForwardIterator last, const T& value, Compare comp) {
+    first = MYSTL::lower_bound(first, last, value, comp);
+    return first != last && !comp(value, *first);
+}
+
+template <typename ForwardIterator, typename T>
+bool binary_search(ForwardIterator first, ForwardIterator last, const T& value) {
+    first = MYSTL::lower_bound(first, last, value);
+    return first != last && !(value < *first);
+}
+
+/*****************************************************************************************/
+// sort
+// introsort: median-of-three quicksort down to runs of __sort_threshold elements, heapsort
+// when the recursion gets deeper than 2*log2(n), then one insertion sort pass over the
+// whole nearly sorted range.
+/*****************************************************************************************/
+
+constexpr ptrdiff_t __sort_threshold = 16;
+
+template <typename RandomAccessIterator, typename Compare>
+void __sift_down(RandomAccessIterator first, ptrdiff_t hole, ptrdiff_t len, Compare comp) {
+    auto value = MYSTL::move(first[hole]);
+    for (;;) {
+        ptrdiff_t child = 2 * hole + 1;
+        if (child >= len)
+            break;
+        if (child + 1 < len && comp(first[child], first[child + 1]))
+            ++child;
+        if (!comp(value, first[child]))
+            break;
+        first[hole] = MYSTL::move(first[child]);
+        hole = child;
+    }
+    first[hole] = MYSTL::move(value);
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void __heap_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+    const ptrdiff_t len = last - first;
+    for (ptrdiff_t i = len / 2; i-- > 0;)
+        MYSTL::__sift_down(first, i, len, comp);
+    for (ptrdiff_t end = len - 1; end > 0; --end) {
+        MYSTL::iter_swap(first, first + end);
+        MYSTL::__sift_down(first, 0, end, comp);
+    }
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void __move_median_to_first(RandomAccessIterator result, RandomAccessIterator a,
+                            RandomAccessIterator b, RandomAccessIterator c, Compare comp) {
+    if (comp(*a, *b)) {
+        if (comp(*b, *c))
+            MYSTL::iter_swap(result, b);
+        else if (comp(*a, *c))
+            MYSTL::iter_swap(result, c);
+        else
+            MYSTL::iter_swap(result, a);
+    }
+    else if (comp(*a, *c))
+        MYSTL::iter_swap(result, a);
+    else if (comp(*b, *c))
+        MYSTL::iter_swap(result, c);
+    else
+        MYSTL::iter_swap(result, b);
+}
+
+// the pivot is a median of three, so both scans stop before leaving the range
+template <typename RandomAccessIterator, typename Compare>
+RandomAccessIterator
+__unguarded_partition(RandomAccessIterator first, RandomAccessIterator last,
+                      RandomAccessIterator pivot, Compare comp) {
+    for (;;) {
+        while (comp(*first, *pivot))
+            ++first;
+        --last;
+        while (comp(*pivot, *last))
+            --last;
+        if (!(first < last))
+            return first;
+        MYSTL::iter_swap(first, last);
+        ++first;
+    }
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void __introsort_loop(RandomAccessIterator first, RandomAccessIterator last,
+                      size_t depth_limit, Compare comp) {
+    while (last - first > __sort_threshold) {
+        if (depth_limit == 0) {
+            MYSTL::__heap_sort(first, last, comp);
+            return;
+        }
+        --depth_limit;
+        auto mid = first + (last - first) / 2;
+        MYSTL::__move_median_to_first(first, first + 1, mid, last - 1, comp);
+        auto cut = MYSTL::__unguarded_partition(first + 1, last, first, comp);
+        MYSTL::__introsort_loop(cut, last, depth_limit, comp);
+        last = cut;
+    }
+}
+
+// the smallest element is already in front, so the inner loop needs no bound check
+template <typename RandomAccessIterator, typename Compare>
+void __unguarded_linear_insert(RandomAccessIterator last, Compare comp) {
+    auto value = MYSTL::move(*last);
+    auto next = last;
+    --next;
+    while (comp(value, *next)) {
+        *last = MYSTL::move(*next);
+        last = next;
+        --next;
+    }
+    *last = MYSTL::move(value);
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void __insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+    if (first == last)
+        return;
+    for (auto i = first + 1; i != last; ++i) {
+        if (comp(*i, *first)) {
+            auto value = MYSTL::move(*i);
+            MYSTL::move_backward(first, i, i + 1);
+            *first = MYSTL::move(value);
+        }
+        else {
+            MYSTL::__unguarded_linear_insert(i, comp);
+        }
+    }
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void __final_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+    if (last - first > __sort_threshold) {
+        MYSTL::__insertion_sort(first, first + __sort_threshold, comp);
+        for (auto i = first + __sort_threshold; i != last; ++i)
+            MYSTL::__unguarded_linear_insert(i, comp);
+    }
+    else {
+        MYSTL::__insertion_sort(first, last, comp);
+    }
+}
+
+template <typename RandomAccessIterator, typename Compare>
+void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+    if (last - first > 1) {
+        size_t depth = 0;
+        for (auto n = last - first; n > 1; n >>= 1)
+            ++depth;
+        MYSTL::__introsort_loop(first, last, 2 * depth, comp);
+        MYSTL::__final_insertion_sort(first, last, comp);
+    }
+}
+
+template <typename RandomAccessIterator>
+void sort(RandomAccessIterator first, RandomAccessIterator last) {
+    MYSTL::sort(first, last, MYSTL::__less_op());
+}
+
+template <typename ForwardIterator, typename Compare>
+bool is_sorted(ForwardIterator first, ForwardIterator last, Compare comp) {
+    if (first == last)
+        return true;
+    for (auto next = first; ++next != last; first = next)
+        if (comp(*next, *first))
+            return false;
+    return true;
+}
+
+template <typename ForwardIterator>
+bool is_sorted(ForwardIterator first, ForwardIterator last) {
+    return MYSTL::is_sorted(first, last,
+                            MYSTL::__less_op());
+}
+
+// removes consecutive duplicates, returns the new end
+template <typename ForwardIterator, typename BinaryPredicate>
+ForwardIterator unique(ForwardIterator first, ForwardIterator last, BinaryPredicate pred) {
+    if (first == last)
+        return last;
+    auto result = first;
+    while (++first != last) {
+        if (!pred(*result, *first) && ++result != first)
+            *result = MYSTL::move(*first);
+    }
+    return ++result;
+}
+
+template <typename ForwardIterator>
+ForwardIterator unique(ForwardIterator first, ForwardIterator last) {
+    return MYSTL::unique(first, last,
+                         MYSTL::__equal_op());
+}
+
+// merges two sorted ranges, on ties the element of the first range comes first
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator, typename Compare>
+OutputIterator merge(InputIterator1 first1, InputIterator1 last1,
+                     InputIterator2 first2, InputIterator2 last2,
+                     OutputIterator dest, Compare comp) {
+    while (first1 != last1 && first2 != last2) {
+        if (comp(*first2, *first1)) {
+            *dest = *first2;
+            ++first2;
+        }
+        else {
+            *dest = *first1;
+            ++first1;
+        }
+        ++dest;
+    }
+    return MYSTL::copy(first2, last2, MYSTL::copy(first1, last1, dest));
+}
+
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+OutputIterator merge(InputIterator1 first1, InputIterator1 last1,
+                     InputIterator2 first2, InputIterator2 last2, OutputIterator dest) {
+    return MYSTL::merge(first1, last1, first2, last2, dest,
+                        MYSTL::__less_op());
+}
+
 } // namespace MYSTL
 
 
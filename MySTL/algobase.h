@@ -403,7 +403,7 @@ bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
 }
 
 //  const unsigned char* 
-bool lexicographical_compare(const unsigned char* first1,
+inline bool lexicographical_compare(const unsigned char* first1,
                              const unsigned char* last1,
                              const unsigned char* first2,
                              const unsigned char* last2)
@@ -87,13 +87,38 @@ public:
 
 #include <new>
 #include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
 #include "construct.h"
 #include "utility.h"
+#ifdef MYSTL_USE_THREAD_CACHE
+#include "thread_cache.h"
+#endif
 
 namespace MYSTL
 {
 
 
+// the alignment ::operator new guarantees. a type aligned beyond it (alignas(32) SIMD
+// vectors, alignas(64) cache line padding) is allocated with posix_memalign instead
+#ifdef __STDCPP_DEFAULT_NEW_ALIGNMENT__
+constexpr size_t __default_new_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+#else
+constexpr size_t __default_new_alignment = alignof(std::max_align_t);
+#endif
+
+inline void* __aligned_allocate(size_t bytes, size_t align) {
+    void* p = nullptr;
+    if (::posix_memalign(&p, align < sizeof(void*) ? sizeof(void*) : align, bytes == 0 ? 1 : bytes) != 0)
+        throw std::bad_alloc();
+    return p;
+}
+
+inline void __aligned_deallocate(void* p) noexcept { std::free(p); }
+
+
 template <typename T>
 class allocator
 {
@@ -115,16 +140,35 @@ public:
 
 public:
 
+    allocator() = default;
+    template <typename U>
+    allocator(const allocator<U>&) noexcept {}
+
+
     //pointer address(reference x) { return &x; }
     //const_pointer address(const_reference x) { return &x; }
     
+    // MYSTL_USE_THREAD_CACHE: size classes with per-thread free lists (thread_cache.h)
     static pointer allocate(size_type n, const void* = static_cast<const void*>(0)) {
+        if (alignof(T) > __default_new_alignment)
+            return static_cast<T*>(__aligned_allocate(n * sizeof(T), alignof(T)));
+#ifdef MYSTL_USE_THREAD_CACHE
+        return static_cast<T*>(__thread_cache_allocate(n * sizeof(T)));
+#else
         return static_cast<T*>(::operator new(n * sizeof(T)));
+#endif
     }
 
-    static void deallocate(T* ptr, size_type /*size*/) {
+    static void deallocate(T* ptr, size_type size) {
         if (ptr == nullptr)  return;
+        if (alignof(T) > __default_new_alignment)
+            return __aligned_deallocate(ptr);
+#ifdef MYSTL_USE_THREAD_CACHE
+        __thread_cache_deallocate(ptr, size * sizeof(T));
+#else
+        (void)size;
         ::operator delete(ptr);
+#endif
     }
 
     // static size_type max_size() const {
@@ -149,6 +193,55 @@ public:
     //void destroy(pointer first, pointer last);
 };
 
+// stateless: memory from one allocator may be freed by any other
+template <typename T, typename U>
+bool operator==(const allocator<T>&, const allocator<U>&) noexcept { return true; }
+template <typename T, typename U>
+bool operator!=(const allocator<T>&, const allocator<U>&) noexcept { return false; }
+
+
+/*****************************************************************************************/
+// aligned_allocator
+// every block starts at a multiple of Align (a power of two, at least alignof(T)), e.g.
+// vector<float, aligned_allocator<float, 32>> for AVX aligned loads, or 64 to keep an
+// array from sharing its first cache line. rebinding keeps Align.
+/*****************************************************************************************/
+
+template <typename T, size_t Align = (alignof(T) > 64 ? alignof(T) : 64)>
+class aligned_allocator {
+    static_assert((Align & (Align - 1)) == 0, "aligned_allocator: Align must be a power of two");
+    static_assert(Align >= alignof(T), "aligned_allocator: Align below alignof(T)");
+
+public:
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+
+    static constexpr size_t alignment = Align;
+
+    template <typename U>
+    struct rebind { using other = aligned_allocator<U, (Align > alignof(U) ? Align : alignof(U))>; };
+
+    aligned_allocator() = default;
+    template <typename U, size_t A>
+    aligned_allocator(const aligned_allocator<U, A>&) noexcept {}
+
+    static T* allocate(size_type n) { return static_cast<T*>(__aligned_allocate(n * sizeof(T), Align)); }
+    static void deallocate(T* p, size_type) noexcept { __aligned_deallocate(p); }
+};
+
+template <typename T, size_t Align>
+constexpr size_t aligned_allocator<T, Align>::alignment;
+
+template <typename T, size_t A, typename U, size_t B>
+bool operator==(const aligned_allocator<T, A>&, const aligned_allocator<U, B>&) noexcept { return true; }
+template <typename T, size_t A, typename U, size_t B>
+bool operator!=(const aligned_allocator<T, A>&, const aligned_allocator<U, B>&) noexcept { return false; }
+
 /*
 template <typename T>
 void allocator<T>::construct(T* ptr) {
@@ -173,6 +266,141 @@ void allocator<T>::destroy(T* first, T* last) {
 */
 
 
+/*****************************************************************************************/
+// allocator support for containers
+// a container asks its allocator for raw memory only (allocate / deallocate) and builds
+// the elements itself. two optional members widen the concept:
+//   reallocate(p, old_n, new_n)             resizes a block keeping its bytes, e.g. by
+//                                           mremap; vector uses it for trivially copyable T
+//   select_on_container_copy_construction() the allocator a copy of the container gets
+/*****************************************************************************************/
+
+// the allocator for U of the same family, e.g. for the nodes of a list<T, Alloc>
+template <typename Alloc, typename U>
+using __rebind_alloc = typename Alloc::template rebind<U>::other;
+
+// the alignment of every block from Alloc: its static alignment member, alignof(T) by
+// default as for any allocator
+template <typename Alloc, typename = void>
+struct __allocator_alignment : std::integral_constant<size_t, alignof(typename Alloc::value_type)> {};
+template <typename Alloc>
+struct __allocator_alignment<Alloc, decltype(void(Alloc::alignment))>
+    : std::integral_constant<size_t, Alloc::alignment> {};
+
+template <typename Alloc, typename = void>
+struct __has_reallocate : std::false_type {};
+template <typename Alloc>
+struct __has_reallocate<Alloc, decltype(void(std::declval<Alloc&>().reallocate(
+    std::declval<typename Alloc::value_type*>(), size_t(), size_t())))> : std::true_type {};
+
+template <typename Alloc>
+auto __select_on_copy(const Alloc& a, int) -> decltype(a.select_on_container_copy_construction()) {
+    return a.select_on_container_copy_construction();
+}
+template <typename Alloc>
+Alloc __select_on_copy(const Alloc& a, long) { return a; }
+
+template <typename Alloc>
+Alloc __select_on_copy(const Alloc& a) { return __select_on_copy(a, 0); }
+
+// base of a container that holds its allocator: an empty allocator takes no space
+template <typename Alloc, bool = std::is_empty<Alloc>::value && !std::is_final<Alloc>::value>
+class __allocator_holder : private Alloc {
+protected:
+    __allocator_holder() = default;
+    explicit __allocator_holder(const Alloc& a) : Alloc(a) {}
+
+    Alloc&       alloc()       noexcept { return *this; }
+    const Alloc& alloc() const noexcept { return *this; }
+};
+
+template <typename Alloc>
+class __allocator_holder<Alloc, false> {
+    Alloc alloc_;
+
+protected:
+    __allocator_holder() = default;
+    explicit __allocator_holder(const Alloc& a) : alloc_(a) {}
+
+    Alloc&       alloc()       noexcept { return alloc_; }
+    const Alloc& alloc() const noexcept { return alloc_; }
+};
+
+
+/*****************************************************************************************/
+// node_cache
+// free list of raw nodes for node based containers. a released node is kept (up to
+// MaxCached of them) and handed out again by the next allocate, so erase / insert churn
+// does not go back to operator new. the nodes are linked through their own storage.
+/*****************************************************************************************/
+
+template <typename Node, size_t MaxCached = 64, typename Alloc = MYSTL::allocator<Node>>
+class node_cache : private __allocator_holder<Alloc> {
+    static_assert(sizeof(Node) >= sizeof(void*), "a cached node holds the free list link");
+    using alloc_base = __allocator_holder<Alloc>;
+
+    void*  free_;
+    size_t count_;
+
+public:
+    using allocator_type = Alloc;
+
+    static constexpr size_t max_cached = MaxCached;
+
+    node_cache() noexcept : free_(nullptr), count_(0) {}
+    explicit node_cache(const allocator_type& a) noexcept : alloc_base(a), free_(nullptr), count_(0) {}
+    node_cache(const node_cache&) = delete;
+    node_cache& operator=(const node_cache&) = delete;
+    node_cache(node_cache&& rhs) noexcept : alloc_base(rhs.alloc()), free_(rhs.free_), count_(rhs.count_) {
+        rhs.free_ = nullptr;
+        rhs.count_ = 0;
+    }
+    ~node_cache() { release(); }
+
+    allocator_type get_allocator() const noexcept { return this->alloc(); }
+
+    Node* allocate() {
+        if (free_ != nullptr) {
+            void* p = free_;
+            free_ = *static_cast<void**>(p);
+            --count_;
+            return static_cast<Node*>(p);
+        }
+        return this->alloc().allocate(1);
+    }
+
+    // p holds no object any more
+    void deallocate(Node* p) noexcept {
+        if (count_ < MaxCached) {
+            *reinterpret_cast<void**>(p) = free_;
+            free_ = p;
+            ++count_;
+        }
+        else {
+            this->alloc().deallocate(p, 1);
+        }
+    }
+
+    // gives every cached node back to the allocator
+    void release() noexcept {
+        while (free_ != nullptr) {
+            void* next = *static_cast<void**>(free_);
+            this->alloc().deallocate(static_cast<Node*>(free_), 1);
+            free_ = next;
+        }
+        count_ = 0;
+    }
+
+    size_t size() const noexcept { return count_; }
+
+    // the cached nodes go with the allocator that made them
+    void swap(node_cache& rhs) noexcept {
+        MYSTL::swap(free_, rhs.free_);
+        MYSTL::swap(count_, rhs.count_);
+        MYSTL::swap(this->alloc(), rhs.alloc());
+    }
+};
+
 } // namespace MYSTL
 
 
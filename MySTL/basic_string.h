@@ -0,0 +1,783 @@
+#ifndef BASIC_STRING_H_
+#define BASIC_STRING_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <iosfwd>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "allocator.h"
+#include "iterator.h"
+#include "algobase.h"
+#include "algo.h"
+#include "hash.h"
+#include "string_view.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// basic_string
+// the object is three words, plus the allocator if it has state. short strings (up to 23
+// chars on 64-bit, 11 char16_t, 5 char32_t) live inside it; the last byte then holds the
+// unused short capacity, so a full short string has a zero byte there, which doubles as
+// its terminator. long strings keep
+// pointer, size and capacity, and the capacity word carries a flag bit that lands in the
+// top bit of that same last byte (the low bit on big-endian targets).
+// the buffer always ends with CharT(), so c_str() is data(). find() / rfind() run on
+// MYSTL::find / search / find_end, which use memchr and memcmp for one-byte characters;
+// append / insert move characters with MYSTL::copy / copy_backward, i.e. memmove.
+// a basic_string converts implicitly to basic_string_view and explicitly from one.
+/*****************************************************************************************/
+
+template <typename CharT, typename Traits = std::char_traits<CharT>, typename Alloc = MYSTL::allocator<CharT>>
+class basic_string : private __allocator_holder<Alloc> {
+    static_assert(std::is_trivial<CharT>::value, "basic_string needs a trivial character type");
+    using alloc_base = __allocator_holder<Alloc>;
+
+public:
+    using allocator_type         = Alloc;
+    using traits_type            = Traits;
+    using value_type             = CharT;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using iterator               = value_type*;
+    using const_iterator         = const value_type*;
+    using reverse_iterator       = MYSTL::reverse_iterator<iterator>;
+    using const_reverse_iterator = MYSTL::reverse_iterator<const_iterator>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    struct long_rep {
+        CharT*    data;
+        size_type size;
+        size_type cap;  // encoded, see encode_cap
+    };
+
+    static constexpr size_type rep_bytes = sizeof(long_rep);
+    // characters that fit before the last byte, which holds the short size
+    static constexpr size_type short_cap = (rep_bytes - 1) / sizeof(CharT);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    static constexpr unsigned char long_bit    = 0x01;
+    static constexpr int           short_shift = 1;
+    static size_type encode_cap(size_type cap) { return (cap << 1) | 1; }
+    static size_type decode_cap(size_type cap) { return cap >> 1; }
+#else
+    static constexpr unsigned char long_bit    = 0x80;
+    static constexpr int           short_shift = 0;
+    static size_type encode_cap(size_type cap) { return cap | ~(npos >> 1); }
+    static size_type decode_cap(size_type cap) { return cap & (npos >> 1); }
+#endif
+
+    union rep {
+        long_rep      l;
+        CharT         s[rep_bytes / sizeof(CharT)];
+        unsigned char raw[rep_bytes];
+    } r_;
+
+    bool is_long() const { return (r_.raw[rep_bytes - 1] & long_bit) != 0; }
+
+    CharT*       ptr()       { return is_long() ? r_.l.data : r_.s; }
+    const CharT* ptr() const { return is_long() ? r_.l.data : r_.s; }
+
+    // writes the terminator first: for a full short string it lands on the size byte,
+    // which the size byte then sets to the same zero
+    void set_short_size(size_type n) {
+        r_.s[n] = CharT();
+        r_.raw[rep_bytes - 1] = static_cast<unsigned char>((short_cap - n) << short_shift);
+    }
+    void set_long_size(size_type n) {
+        r_.l.size = n;
+        r_.l.data[n] = CharT();
+    }
+    // for callers that do not know the mode. a size above short_cap only fits a long
+    // string; testing it first keeps the compiler from indexing r_.s with such a size
+    void set_size(size_type n) {
+        if (n > short_cap || is_long())
+            set_long_size(n);
+        else
+            set_short_size(n);
+    }
+    // where n characters go after the first pos ones, for a string with room for pos + n.
+    // by the same reasoning a total above short_cap means the long buffer; n is tested on
+    // its own too, as the compiler does not know that pos + n cannot wrap
+    CharT* ptr_for(size_type pos, size_type n) {
+        return n > short_cap || pos + n > short_cap ? r_.l.data + pos : ptr() + pos;
+    }
+
+    void init_short() {
+        r_.s[0] = CharT();
+        r_.raw[rep_bytes - 1] = static_cast<unsigned char>(short_cap << short_shift);
+    }
+
+    // owns a fresh buffer for cap characters plus the terminator, contents undefined
+    void init_long(CharT* data, size_type cap) {
+        r_.l.data = data;
+        r_.l.size = 0;
+        r_.l.cap = encode_cap(cap);
+    }
+
+    void free_long() {
+        if (is_long())
+            this->alloc().deallocate(r_.l.data, decode_cap(r_.l.cap) + 1);
+    }
+
+    size_type grow_capacity(size_type n) const {
+        if (n > max_size())
+            throw std::length_error("basic_string: length_error");
+        const size_type cap = capacity();
+        return cap * 2 > n ? MYSTL::min(cap * 2, max_size()) : n;
+    }
+
+    // reallocates for at least n characters keeping the first keep ones
+    void reallocate(size_type n, size_type keep) {
+        const size_type cap = grow_capacity(n);
+        CharT* buf = this->alloc().allocate(cap + 1);
+        MYSTL::copy(ptr(), ptr() + keep, buf);
+        free_long();
+        init_long(buf, cap);
+        set_long_size(keep);
+    }
+
+    void init(const CharT* s, size_type n) {
+        if (n <= short_cap) {
+            init_short();
+            MYSTL::copy(s, s + n, r_.s);
+            set_short_size(n);
+            return;
+        }
+        if (n > max_size())
+            throw std::length_error("basic_string: length_error");
+        init_long(this->alloc().allocate(n + 1), n);
+        MYSTL::copy(s, s + n, r_.l.data);
+        set_long_size(n);
+    }
+
+    void init(size_type n, CharT ch) {
+        init_short();
+        if (n <= short_cap) {
+            MYSTL::fill_n(r_.s, n, ch);
+            set_short_size(n);
+            return;
+        }
+        if (n > max_size())
+            throw std::length_error("basic_string: length_error");
+        init_long(this->alloc().allocate(n + 1), n);
+        MYSTL::fill_n(r_.l.data, n, ch);
+        set_long_size(n);
+    }
+
+    template <typename InputIterator>
+    void init_range(InputIterator first, InputIterator last, MYSTL::input_iterator_tag) {
+        init_short();
+        try {
+            for (; first != last; ++first)
+                push_back(*first);
+        }
+        catch(...) {
+            free_long();
+            throw;
+        }
+    }
+    template <typename ForwardIterator>
+    void init_range(ForwardIterator first, ForwardIterator last, MYSTL::forward_iterator_tag) {
+        const size_type n = static_cast<size_type>(MYSTL::distance(first, last));
+        init_short();
+        if (n > short_cap) {
+            if (n > max_size())
+                throw std::length_error("basic_string: length_error");
+            init_long(this->alloc().allocate(n + 1), n);
+        }
+        CharT* p = ptr();
+        for (; first != last; ++first, ++p)
+            *p = *first;
+        set_size(n);
+    }
+
+    void check_pos(size_type pos, const char* what) const {
+        if (pos > size())
+            throw std::out_of_range(what);
+    }
+
+    size_type clamp(size_type pos, size_type n) const { return MYSTL::min(n, size() - pos); }
+
+public:
+    //ctors:
+    basic_string() noexcept { init_short(); }
+    explicit basic_string(const allocator_type& a) noexcept : alloc_base(a) { init_short(); }
+    basic_string(const CharT* s, const allocator_type& a = allocator_type()) : alloc_base(a) {
+        init(s, Traits::length(s));
+    }
+    basic_string(const CharT* s, size_type n, const allocator_type& a = allocator_type()) : alloc_base(a) {
+        init(s, n);
+    }
+    basic_string(size_type n, CharT ch, const allocator_type& a = allocator_type()) : alloc_base(a) { init(n, ch); }
+    basic_string(const basic_string& rhs) : alloc_base(__select_on_copy(rhs.alloc())) {
+        init(rhs.data(), rhs.size());
+    }
+    basic_string(const basic_string& rhs, size_type pos, size_type n = npos,
+                 const allocator_type& a = allocator_type()) : alloc_base(a) {
+        rhs.check_pos(pos, "basic_string: out of range");
+        init(rhs.data() + pos, rhs.clamp(pos, n));
+    }
+    basic_string(basic_string&& rhs) noexcept : alloc_base(MYSTL::move(rhs.alloc())), r_(rhs.r_) {
+        rhs.init_short();
+    }
+    basic_string(std::initializer_list<CharT> ilist, const allocator_type& a = allocator_type()) : alloc_base(a) {
+        init(ilist.begin(), ilist.size());
+    }
+
+    template <typename InputIterator, typename = typename
+      std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    basic_string(InputIterator first, InputIterator last, const allocator_type& a = allocator_type())
+        : alloc_base(a) {
+        init_range(first, last, iterator_category(first));
+    }
+
+    // interoperation with code that still holds std::basic_string
+    explicit basic_string(const std::basic_string<CharT, Traits>& s) { init(s.data(), s.size()); }
+    std::basic_string<CharT, Traits> std_string() const {
+        return std::basic_string<CharT, Traits>(data(), size());
+    }
+
+    explicit basic_string(basic_string_view<CharT, Traits> v) { init(v.data(), v.size()); }
+    operator basic_string_view<CharT, Traits>() const noexcept {
+        return basic_string_view<CharT, Traits>(data(), size());
+    }
+
+    ~basic_string() { free_long(); }
+
+    allocator_type get_allocator() const { return this->alloc(); }
+
+    basic_string& operator=(const basic_string& rhs) {
+        if (this != &rhs)
+            assign(rhs.data(), rhs.size());
+        return *this;
+    }
+    basic_string& operator=(basic_string&& rhs) noexcept {
+        if (this != &rhs) {
+            free_long();
+            this->alloc() = MYSTL::move(rhs.alloc());
+            r_ = rhs.r_;
+            rhs.init_short();
+        }
+        return *this;
+    }
+    basic_string& operator=(const CharT* s) { return assign(s, Traits::length(s)); }
+    basic_string& operator=(CharT ch) { return assign(1, ch); }
+    basic_string& operator=(std::initializer_list<CharT> ilist) { return assign(ilist.begin(), ilist.size()); }
+
+    basic_string& assign(const CharT* s, size_type n) {
+        if (n > capacity()) {
+            // s may point into this string, build the copy before releasing anything
+            basic_string tmp(s, n, get_allocator());
+            swap(tmp);
+        }
+        else {
+            MYSTL::copy(s, s + n, ptr_for(0, n));
+            set_size(n);
+        }
+        return *this;
+    }
+    basic_string& assign(const CharT* s) { return assign(s, Traits::length(s)); }
+    basic_string& assign(const basic_string& str) { return *this = str; }
+    basic_string& assign(size_type n, CharT ch) {
+        if (n > capacity())
+            reallocate(n, 0);
+        MYSTL::fill_n(ptr_for(0, n), n, ch);
+        set_size(n);
+        return *this;
+    }
+    template <typename InputIterator, typename = typename
+      std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    basic_string& assign(InputIterator first, InputIterator last) {
+        basic_string tmp(first, last, get_allocator());
+        swap(tmp);
+        return *this;
+    }
+
+    //iterators
+    iterator        begin()       noexcept { return ptr(); }
+    const_iterator  begin() const noexcept { return ptr(); }
+    iterator        end()         noexcept { return ptr() + size(); }
+    const_iterator  end()   const noexcept { return ptr() + size(); }
+
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    //capacity
+    size_type size() const noexcept {
+        return is_long() ? r_.l.size : short_cap - (r_.raw[rep_bytes - 1] >> short_shift);
+    }
+    size_type length()   const noexcept { return size(); }
+    bool      empty()    const noexcept { return size() == 0; }
+    size_type capacity() const noexcept { return is_long() ? decode_cap(r_.l.cap) : short_cap; }
+    size_type max_size() const noexcept { return (npos >> 2) / sizeof(CharT) - 1; }
+
+    void reserve(size_type n) {
+        if (n > capacity())
+            reallocate(n, size());
+    }
+
+    // moves a long string that fits back inside the object, or trims the heap buffer
+    void shrink_to_fit() {
+        if (!is_long())
+            return;
+        const size_type n = size();
+        if (n == capacity())
+            return;
+        basic_string tmp(data(), n, get_allocator());
+        swap(tmp);
+    }
+
+    //element access
+    reference       operator[](size_type n)       { return ptr()[n]; }
+    const_reference operator[](size_type n) const { return ptr()[n]; }
+    reference at(size_type n) {
+        if (n >= size())
+            throw std::out_of_range("basic_string::at");
+        return ptr()[n];
+    }
+    const_reference at(size_type n) const {
+        if (n >= size())
+            throw std::out_of_range("basic_string::at");
+        return ptr()[n];
+    }
+    reference       front()       { return ptr()[0]; }
+    const_reference front() const { return ptr()[0]; }
+    reference       back()        { return ptr()[size() - 1]; }
+    const_reference back()  const { return ptr()[size() - 1]; }
+
+    CharT*       data()        noexcept { return ptr(); }
+    const CharT* data()  const noexcept { return ptr(); }
+    const CharT* c_str() const noexcept { return ptr(); }
+
+    //modifiers
+    void clear() noexcept { set_size(0); }
+
+    void push_back(CharT ch) {
+        const size_type n = size();
+        if (n == capacity())
+            reallocate(n + 1, n);
+        ptr()[n] = ch;
+        set_size(n + 1);
+    }
+    void pop_back() { set_size(size() - 1); }
+
+    basic_string& append(const CharT* s, size_type n) {
+        const size_type old = size();
+        if (n > capacity() - old) {
+            // s may point into this string: copy it into the new buffer before freeing
+            const size_type cap = grow_capacity(old + n);
+            CharT* buf = this->alloc().allocate(cap + 1);
+            MYSTL::copy(ptr(), ptr() + old, buf);
+            MYSTL::copy(s, s + n, buf + old);
+            free_long();
+            init_long(buf, cap);
+        }
+        else {
+            MYSTL::copy(s, s + n, ptr_for(old, n));
+        }
+        set_size(old + n);
+        return *this;
+    }
+    basic_string& append(const CharT* s) { return append(s, Traits::length(s)); }
+    basic_string& append(const basic_string& str) { return append(str.data(), str.size()); }
+    basic_string& append(const basic_string& str, size_type pos, size_type n = npos) {
+        str.check_pos(pos, "basic_string::append");
+        return append(str.data() + pos, str.clamp(pos, n));
+    }
+    basic_string& append(size_type n, CharT ch) {
+        const size_type old = size();
+        if (n > capacity() - old)
+            reallocate(old + n, old);
+        MYSTL::fill_n(ptr_for(old, n), n, ch);
+        set_size(old + n);
+        return *this;
+    }
+    template <typename InputIterator, typename = typename
+      std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    basic_string& append(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            push_back(*first);
+        return *this;
+    }
+    basic_string& append(std::initializer_list<CharT> ilist) { return append(ilist.begin(), ilist.size()); }
+
+    basic_string& operator+=(const basic_string& str) { return append(str.data(), str.size()); }
+    basic_string& operator+=(const CharT* s) { return append(s, Traits::length(s)); }
+    basic_string& operator+=(CharT ch) { push_back(ch); return *this; }
+    basic_string& append(basic_string_view<CharT, Traits> v) { return append(v.data(), v.size()); }
+    basic_string& operator+=(std::initializer_list<CharT> ilist) { return append(ilist.begin(), ilist.size()); }
+    basic_string& operator+=(basic_string_view<CharT, Traits> v) { return append(v.data(), v.size()); }
+
+    // replaces [pos, pos + n1) with n2 characters from s, s may point into this string
+    basic_string& replace(size_type pos, size_type n1, const CharT* s, size_type n2);
+    basic_string& replace(size_type pos, size_type n1, const basic_string& str) {
+        return replace(pos, n1, str.data(), str.size());
+    }
+    basic_string& replace(size_type pos, size_type n1, const CharT* s) {
+        return replace(pos, n1, s, Traits::length(s));
+    }
+    basic_string& replace(const_iterator first, const_iterator last, const basic_string& str) {
+        return replace(first - begin(), last - first, str.data(), str.size());
+    }
+
+    basic_string& insert(size_type pos, const CharT* s, size_type n) { return replace(pos, 0, s, n); }
+    basic_string& insert(size_type pos, const CharT* s) { return replace(pos, 0, s, Traits::length(s)); }
+    basic_string& insert(size_type pos, const basic_string& str) { return replace(pos, 0, str.data(), str.size()); }
+    basic_string& insert(size_type pos, size_type n, CharT ch) {
+        check_pos(pos, "basic_string::insert");
+        const size_type old = size();
+        if (n > capacity() - old)
+            reserve(old + n);
+        CharT* p = ptr();
+        MYSTL::copy_backward(p + pos, p + old, p + old + n);
+        MYSTL::fill_n(p + pos, n, ch);
+        set_size(old + n);
+        return *this;
+    }
+    iterator insert(const_iterator position, CharT ch) {
+        const size_type pos = static_cast<size_type>(position - begin());
+        insert(pos, 1, ch);
+        return begin() + pos;
+    }
+
+    basic_string& erase(size_type pos = 0, size_type n = npos) {
+        check_pos(pos, "basic_string::erase");
+        n = clamp(pos, n);
+        const size_type old = size();
+        CharT* p = ptr();
+        MYSTL::copy(p + pos + n, p + old, p + pos);
+        set_size(old - n);
+        return *this;
+    }
+    iterator erase(const_iterator position) {
+        const size_type pos = static_cast<size_type>(position - begin());
+        erase(pos, 1);
+        return begin() + pos;
+    }
+    iterator erase(const_iterator first, const_iterator last) {
+        const size_type pos = static_cast<size_type>(first - begin());
+        erase(pos, static_cast<size_type>(last - first));
+        return begin() + pos;
+    }
+
+    void resize(size_type n, CharT ch) {
+        const size_type old = size();
+        if (n > old)
+            append(n - old, ch);
+        else
+            set_size(n);
+    }
+    void resize(size_type n) { resize(n, CharT()); }
+
+    void swap(basic_string& rhs) noexcept {
+        if (this != &rhs) {
+            rep tmp = r_;
+            r_ = rhs.r_;
+            rhs.r_ = tmp;
+            MYSTL::swap(this->alloc(), rhs.alloc());
+        }
+    }
+
+    //operations
+    basic_string substr(size_type pos = 0, size_type n = npos) const {
+        check_pos(pos, "basic_string::substr");
+        return basic_string(data() + pos, clamp(pos, n), get_allocator());
+    }
+
+    size_type copy(CharT* dest, size_type n, size_type pos = 0) const {
+        check_pos(pos, "basic_string::copy");
+        n = clamp(pos, n);
+        MYSTL::copy(data() + pos, data() + pos + n, dest);
+        return n;
+    }
+
+    int compare(const CharT* s, size_type n) const {
+        const size_type len = size();
+        const int r = Traits::compare(data(), s, MYSTL::min(len, n));
+        return r != 0 ? r : len < n ? -1 : len > n ? 1 : 0;
+    }
+    int compare(const basic_string& str) const { return compare(str.data(), str.size()); }
+    int compare(const CharT* s) const { return compare(s, Traits::length(s)); }
+    int compare(size_type pos, size_type n, const basic_string& str) const {
+        return substr(pos, n).compare(str);
+    }
+
+    bool starts_with(const CharT* s, size_type n) const {
+        return size() >= n && Traits::compare(data(), s, n) == 0;
+    }
+    bool starts_with(const basic_string& str) const { return starts_with(str.data(), str.size()); }
+    bool starts_with(const CharT* s) const { return starts_with(s, Traits::length(s)); }
+    bool starts_with(CharT ch) const { return !empty() && Traits::eq(front(), ch); }
+    bool ends_with(const CharT* s, size_type n) const {
+        return size() >= n && Traits::compare(data() + size() - n, s, n) == 0;
+    }
+    bool ends_with(const basic_string& str) const { return ends_with(str.data(), str.size()); }
+    bool ends_with(const CharT* s) const { return ends_with(s, Traits::length(s)); }
+    bool ends_with(CharT ch) const { return !empty() && Traits::eq(back(), ch); }
+
+    //search
+    size_type find(const CharT* s, size_type pos, size_type n) const {
+        const size_type len = size();
+        if (pos > len || n > len - pos)
+            return npos;
+        const CharT* first = data();
+        const CharT* it = MYSTL::search(first + pos, first + len, s, s + n);
+        return it == first + len && n != 0 ? npos : static_cast<size_type>(it - first);
+    }
+    size_type find(const basic_string& str, size_type pos = 0) const { return find(str.data(), pos, str.size()); }
+    size_type find(const CharT* s, size_type pos = 0) const { return find(s, pos, Traits::length(s)); }
+    size_type find(CharT ch, size_type pos = 0) const {
+        const size_type len = size();
+        if (pos >= len)
+            return npos;
+        const CharT* first = data();
+        const CharT* it = MYSTL::find(first + pos, first + len, ch);
+        return it == first + len ? npos : static_cast<size_type>(it - first);
+    }
+
+    // last match starting at or before pos
+    size_type rfind(const CharT* s, size_type pos, size_type n) const {
+        const size_type len = size();
+        if (n > len)
+            return npos;
+        pos = MYSTL::min(pos, len - n);
+        if (n == 0)
+            return pos;
+        const CharT* first = data();
+        const CharT* last = first + pos + n;
+        const CharT* it = MYSTL::find_end(first, last, s, s + n);
+        return it == last ? npos : static_cast<size_type>(it - first);
+    }
+    size_type rfind(const basic_string& str, size_type pos = npos) const { return rfind(str.data(), pos, str.size()); }
+    size_type rfind(const CharT* s, size_type pos = npos) const { return rfind(s, pos, Traits::length(s)); }
+    size_type rfind(CharT ch, size_type pos = npos) const {
+        const size_type len = size();
+        if (len == 0)
+            return npos;
+        const CharT* p = data();
+        for (size_type i = MYSTL::min(pos, len - 1) + 1; i > 0; --i)
+            if (Traits::eq(p[i - 1], ch))
+                return i - 1;
+        return npos;
+    }
+
+    size_type find_first_of(const CharT* s, size_type pos, size_type n) const {
+        const CharT* p = data();
+        for (size_type i = pos; i < size(); ++i)
+            if (Traits::find(s, n, p[i]) != nullptr)
+                return i;
+        return npos;
+    }
+    size_type find_first_of(const basic_string& str, size_type pos = 0) const {
+        return find_first_of(str.data(), pos, str.size());
+    }
+    size_type find_first_of(const CharT* s, size_type pos = 0) const {
+        return find_first_of(s, pos, Traits::length(s));
+    }
+    size_type find_first_not_of(const CharT* s, size_type pos, size_type n) const {
+        const CharT* p = data();
+        for (size_type i = pos; i < size(); ++i)
+            if (Traits::find(s, n, p[i]) == nullptr)
+                return i;
+        return npos;
+    }
+    size_type find_first_not_of(const basic_string& str, size_type pos = 0) const {
+        return find_first_not_of(str.data(), pos, str.size());
+    }
+    size_type find_first_not_of(const CharT* s, size_type pos = 0) const {
+        return find_first_not_of(s, pos, Traits::length(s));
+    }
+    size_type find_last_of(const CharT* s, size_type pos, size_type n) const {
+        const CharT* p = data();
+        for (size_type i = MYSTL::min(pos, size() - 1) + 1; i > 0 && !empty(); --i)
+            if (Traits::find(s, n, p[i - 1]) != nullptr)
+                return i - 1;
+        return npos;
+    }
+    size_type find_last_of(const basic_string& str, size_type pos = npos) const {
+        return find_last_of(str.data(), pos, str.size());
+    }
+    size_type find_last_of(const CharT* s, size_type pos = npos) const {
+        return find_last_of(s, pos, Traits::length(s));
+    }
+};
+
+template <typename CharT, typename Traits, typename Alloc>
+constexpr typename basic_string<CharT, Traits, Alloc>::size_type basic_string<CharT, Traits, Alloc>::npos;
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc>&
+basic_string<CharT, Traits, Alloc>::replace(size_type pos, size_type n1, const CharT* s, size_type n2) {
+    check_pos(pos, "basic_string::replace");
+    n1 = clamp(pos, n1);
+    const size_type old = size();
+    if (n2 > n1 && n2 - n1 > capacity() - old) {
+        // new buffer: head, replacement, tail; s stays valid until the old one is freed
+        const size_type cap = grow_capacity(old - n1 + n2);
+        CharT* buf = this->alloc().allocate(cap + 1);
+        const CharT* p = ptr();
+        MYSTL::copy(p, p + pos, buf);
+        MYSTL::copy(s, s + n2, buf + pos);
+        MYSTL::copy(p + pos + n1, p + old, buf + pos + n2);
+        free_long();
+        init_long(buf, cap);
+        set_size(old - n1 + n2);
+        return *this;
+    }
+
+    CharT* p = ptr();
+    CharT* const tail = p + pos + n1;
+    if (s + n2 <= p || s >= p + old) {
+        // disjoint source: move the tail, then copy
+        MYSTL::copy(tail, p + old, p + pos + n2);  // memmove, the ranges may overlap
+        MYSTL::copy(s, s + n2, p + pos);
+    }
+    else {
+        // the source is inside this string, work from a copy
+        basic_string tmp(s, n2, get_allocator());
+        MYSTL::copy(tail, p + old, p + pos + n2);
+        MYSTL::copy(tmp.data(), tmp.data() + n2, p + pos);
+    }
+    set_size(old - n1 + n2);
+    return *this;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc>
+operator+(const basic_string<CharT, Traits, Alloc>& lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    basic_string<CharT, Traits, Alloc> result(lhs.get_allocator());
+    result.reserve(lhs.size() + rhs.size());
+    result.append(lhs).append(rhs);
+    return result;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc>
+operator+(basic_string<CharT, Traits, Alloc>&& lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return MYSTL::move(lhs.append(rhs));
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc>
+operator+(const basic_string<CharT, Traits, Alloc>& lhs, const CharT* rhs) {
+    basic_string<CharT, Traits, Alloc> result(lhs);
+    return MYSTL::move(result.append(rhs));
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc>
+operator+(basic_string<CharT, Traits, Alloc>&& lhs, const CharT* rhs) {
+    return MYSTL::move(lhs.append(rhs));
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc>
+operator+(const CharT* lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    basic_string<CharT, Traits, Alloc> result(lhs, rhs.get_allocator());
+    return MYSTL::move(result.append(rhs));
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+basic_string<CharT, Traits, Alloc>
+operator+(const basic_string<CharT, Traits, Alloc>& lhs, CharT rhs) {
+    basic_string<CharT, Traits, Alloc> result(lhs);
+    result.push_back(rhs);
+    return result;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+bool operator==(const basic_string<CharT, Traits, Alloc>& lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && Traits::compare(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+bool operator==(const basic_string<CharT, Traits, Alloc>& lhs, const CharT* rhs) {
+    return lhs.compare(rhs) == 0;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+bool operator==(const CharT* lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return rhs.compare(lhs) == 0;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+bool operator!=(const basic_string<CharT, Traits, Alloc>& lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+bool operator!=(const basic_string<CharT, Traits, Alloc>& lhs, const CharT* rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+bool operator!=(const CharT* lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+bool operator<(const basic_string<CharT, Traits, Alloc>& lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return lhs.compare(rhs) < 0;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+bool operator<=(const basic_string<CharT, Traits, Alloc>& lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return lhs.compare(rhs) <= 0;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+bool operator>(const basic_string<CharT, Traits, Alloc>& lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return lhs.compare(rhs) > 0;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+bool operator>=(const basic_string<CharT, Traits, Alloc>& lhs, const basic_string<CharT, Traits, Alloc>& rhs) {
+    return lhs.compare(rhs) >= 0;
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+void swap(basic_string<CharT, Traits, Alloc>& lhs, basic_string<CharT, Traits, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename CharT, typename Traits, typename Alloc>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os, const basic_string<CharT, Traits, Alloc>& str) {
+    return os.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+// same bytes, same hash as the std::basic_string specialization
+template <typename CharT, typename Traits, typename Alloc>
+struct hash<basic_string<CharT, Traits, Alloc>> {
+    using is_avalanching = void;
+    size_t operator()(const basic_string<CharT, Traits, Alloc>& s) const noexcept {
+        return static_cast<size_t>(hash_bytes(s.data(), s.size() * sizeof(CharT)));
+    }
+};
+
+using string    = basic_string<char>;
+using wstring   = basic_string<wchar_t>;
+using u16string = basic_string<char16_t>;
+using u32string = basic_string<char32_t>;
+
+} // end of namespace MYSTL
+
+#endif
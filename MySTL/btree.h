@@ -0,0 +1,1038 @@
+#ifndef BTREE_H_
+#define BTREE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include "iterator.h"
+#include "utility.h"
+#include "allocator.h"
+#include "construct.h"
+#include "algo.h"
+#include "vector.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// btree
+// B+-tree core of btree_map / btree_set. every element lives in a leaf, inner nodes only
+// hold separator keys (copies of leaf keys) and child pointers. a node is NodeSize bytes,
+// a few cache lines, and keeps its keys in one contiguous array, so a lookup reads one
+// short array per level instead of chasing a pointer per comparison. leaves are linked
+// both ways: iteration and range scans walk the leaf chain and never go back up.
+// assign_sorted() builds the tree bottom up from sorted unique input in O(n).
+// leaves and inner nodes come from Alloc rebound to each node type.
+// iterators are invalidated by any insert or erase.
+/*****************************************************************************************/
+
+// tag for the constructors that take sorted input without duplicates
+struct sorted_unique_t { explicit sorted_unique_t() = default; };
+constexpr sorted_unique_t sorted_unique{};
+
+/*****************************************************************************************/
+// in-node search: how many keys are < k (lower) or <= k (upper)
+/*****************************************************************************************/
+
+// 0: binary search, 1: compare and count, 2: compare and count with SSE2
+template <typename Key, typename Compare>
+struct __btree_search_kind
+    : std::integral_constant<int,
+        !(std::is_arithmetic<Key>::value && std::is_same<Compare, std::less<Key>>::value) ? 0 :
+#if defined(__SSE2__)
+        std::is_integral<Key>::value && sizeof(Key) == 4 ? 2 :
+#endif
+        1> {};
+
+template <typename Key, typename Compare, int Kind = __btree_search_kind<Key, Compare>::value>
+struct __btree_node_search {
+    static unsigned lower(const Key* keys, unsigned n, const Key& k, const Compare& comp) {
+        return static_cast<unsigned>(MYSTL::lower_bound(keys, keys + n, k, comp) - keys);
+    }
+    static unsigned upper(const Key* keys, unsigned n, const Key& k, const Compare& comp) {
+        return static_cast<unsigned>(MYSTL::upper_bound(keys, keys + n, k, comp) - keys);
+    }
+};
+
+// arithmetic keys: count the smaller keys over the whole node. no branch depends on the
+// data and the loop vectorizes, a node is a few cache lines so scanning all of it costs
+// about as much as the probes of a binary search
+template <typename Key, typename Compare>
+struct __btree_node_search<Key, Compare, 1> {
+    static unsigned lower(const Key* keys, unsigned n, const Key& k, const Compare&) {
+        unsigned c = 0;
+        for (unsigned i = 0; i < n; ++i)
+            c += keys[i] < k;
+        return c;
+    }
+    static unsigned upper(const Key* keys, unsigned n, const Key& k, const Compare&) {
+        unsigned c = 0;
+        for (unsigned i = 0; i < n; ++i)
+            c += !(k < keys[i]);
+        return c;
+    }
+};
+
+#if defined(__SSE2__)
+// 32-bit integers: four keys per compare. SSE2 only compares signed, unsigned keys are
+// shifted into signed order by flipping the top bit
+template <typename Key, typename Compare>
+struct __btree_node_search<Key, Compare, 2> {
+    static constexpr uint32_t bias = std::is_signed<Key>::value ? 0u : 0x80000000u;
+
+    // number of keys in [0, n) with key > k, or key < k when Greater is false
+    template <bool Greater>
+    static unsigned count(const Key* keys, unsigned n, const Key& k) {
+        const __m128i b = _mm_set1_epi32(static_cast<int>(bias));
+        const __m128i kv = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(k)), b);
+        unsigned c = 0, i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m128i v = _mm_xor_si128(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), b);
+            const __m128i m = Greater ? _mm_cmpgt_epi32(v, kv) : _mm_cmplt_epi32(v, kv);
+            c += static_cast<unsigned>(__builtin_popcount(_mm_movemask_epi8(m))) / 4;
+        }
+        for (; i < n; ++i)
+            c += Greater ? k < keys[i] : keys[i] < k;
+        return c;
+    }
+
+    static unsigned lower(const Key* keys, unsigned n, const Key& k, const Compare&) {
+        return count<false>(keys, n, k);
+    }
+    static unsigned upper(const Key* keys, unsigned n, const Key& k, const Compare&) {
+        return n - count<true>(keys, n, k);
+    }
+};
+#endif
+
+/*****************************************************************************************/
+// nodes
+/*****************************************************************************************/
+
+template <typename T>
+struct __btree_sizeof : std::integral_constant<size_t, sizeof(T)> {};
+template <>
+struct __btree_sizeof<void> : std::integral_constant<size_t, 0> {};
+
+template <typename T, size_t N>
+struct __btree_value_array {
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type data[N];
+    T* at(size_t i) { return reinterpret_cast<T*>(&data[i]); }
+};
+// sets store no mapped values
+template <size_t N>
+struct __btree_value_array<void, N> {
+    void* at(size_t) { return nullptr; }
+};
+
+struct __btree_node {
+    unsigned count;  // elements in a leaf, keys in an inner node
+};
+
+// reference / pointer of the iterators: a pair of references for maps, the key for sets
+template <typename Key, typename Mapped, bool Const>
+struct __btree_reference {
+    using type    = MYSTL::pair<const Key&, typename std::conditional<Const, const Mapped&, Mapped&>::type>;
+    using pointer = MYSTL::__arrow_proxy<type>;
+
+    template <typename Leaf>
+    static type make(Leaf* leaf, unsigned i) { return type(*leaf->key(i), *leaf->value(i)); }
+    static pointer arrow(type ref) { return pointer{ref}; }
+};
+
+template <typename Key, bool Const>
+struct __btree_reference<Key, void, Const> {
+    using type    = const Key&;
+    using pointer = const Key*;
+
+    template <typename Leaf>
+    static type make(Leaf* leaf, unsigned i) { return *leaf->key(i); }
+    static pointer arrow(type ref) { return &ref; }
+};
+
+
+template <typename Key, typename Mapped, typename Compare, size_t NodeSize = 256,
+          typename Alloc = MYSTL::allocator<Key>>
+class btree : private __allocator_holder<Alloc> {
+    using alloc_base = __allocator_holder<Alloc>;
+
+public:
+    using key_type        = Key;
+    using mapped_type     = Mapped;
+    using key_compare     = Compare;
+    using allocator_type  = Alloc;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+
+    static constexpr bool is_map = !std::is_void<Mapped>::value;
+
+private:
+    using key_storage = typename std::aligned_storage<sizeof(Key), alignof(Key)>::type;
+
+    static constexpr size_t leaf_header = sizeof(__btree_node) + 2 * sizeof(void*);
+    static constexpr size_t leaf_fit =
+        NodeSize > leaf_header ? (NodeSize - leaf_header) / (sizeof(Key) + __btree_sizeof<Mapped>::value) : 0;
+    static constexpr size_t inner_fit =
+        NodeSize > sizeof(__btree_node) + sizeof(void*)
+            ? (NodeSize - sizeof(__btree_node) - sizeof(void*)) / (sizeof(Key) + sizeof(void*)) : 0;
+
+public:
+    // slots per node, at least 4 so that splits and merges always have room
+    static constexpr unsigned leaf_slots  = leaf_fit < 4 ? 4 : static_cast<unsigned>(leaf_fit);
+    static constexpr unsigned inner_slots = inner_fit < 4 ? 4 : static_cast<unsigned>(inner_fit);
+
+private:
+    // below these a non-root node borrows from or merges with a sibling
+    static constexpr unsigned min_leaf  = leaf_slots / 2;
+    static constexpr unsigned min_inner = inner_slots / 2;
+    static constexpr int      max_height = 64;
+
+    struct leaf_node : __btree_node {
+        leaf_node* prev;
+        leaf_node* next;
+        key_storage keys[leaf_slots];
+        __btree_value_array<Mapped, leaf_slots> values;
+
+        Key*    key(unsigned i)   { return reinterpret_cast<Key*>(&keys[i]); }
+        Key*    key_data()        { return reinterpret_cast<Key*>(keys); }
+        Mapped* value(unsigned i) { return values.at(i); }
+    };
+
+    struct inner_node : __btree_node {
+        key_storage   keys[inner_slots];
+        __btree_node* children[inner_slots + 1];
+
+        Key* key(unsigned i) { return reinterpret_cast<Key*>(&keys[i]); }
+        Key* key_data()      { return reinterpret_cast<Key*>(keys); }
+    };
+
+    using leaf_allocator  = __rebind_alloc<Alloc, leaf_node>;
+    using inner_allocator = __rebind_alloc<Alloc, inner_node>;
+    using search          = __btree_node_search<Key, Compare>;
+
+    struct path_entry {
+        inner_node* node;
+        unsigned    index;  // child taken
+    };
+
+public:
+    template <bool Const>
+    class iterator_impl {
+        friend class btree;
+        template <bool> friend class iterator_impl;
+        using ref_traits = __btree_reference<Key, Mapped, Const>;
+
+        leaf_node* leaf_;
+        unsigned   pos_;
+
+        iterator_impl(leaf_node* leaf, unsigned pos) : leaf_(leaf), pos_(pos) {}
+
+    public:
+        using iterator_category = MYSTL::bidirectional_iterator_tag;
+        using value_type        = typename std::conditional<is_map, MYSTL::pair<Key, Mapped>, Key>::type;
+        using difference_type   = ptrdiff_t;
+        using reference         = typename ref_traits::type;
+        using pointer           = typename ref_traits::pointer;
+
+        iterator_impl() : leaf_(nullptr), pos_(0) {}
+        template <bool C = Const, typename = typename std::enable_if<C>::type>
+        iterator_impl(const iterator_impl<false>& rhs) : leaf_(rhs.leaf_), pos_(rhs.pos_) {}
+
+        const Key& key()        const { return *leaf_->key(pos_); }
+        reference  operator*()  const { return ref_traits::make(leaf_, pos_); }
+        pointer    operator->() const { return ref_traits::arrow(**this); }
+
+        // the end iterator is (rightmost leaf, its count), any other position is < count
+        iterator_impl& operator++() {
+            if (++pos_ == leaf_->count && leaf_->next != nullptr) {
+                leaf_ = leaf_->next;
+                pos_ = 0;
+            }
+            return *this;
+        }
+        iterator_impl& operator--() {
+            if (pos_ == 0) {
+                leaf_ = leaf_->prev;
+                pos_ = leaf_->count;
+            }
+            --pos_;
+            return *this;
+        }
+        iterator_impl operator++(int) { auto tmp = *this; ++*this; return tmp; }
+        iterator_impl operator--(int) { auto tmp = *this; --*this; return tmp; }
+
+        bool operator==(const iterator_impl& rhs) const { return leaf_ == rhs.leaf_ && pos_ == rhs.pos_; }
+        bool operator!=(const iterator_impl& rhs) const { return !(*this == rhs); }
+    };
+
+    using iterator       = typename std::conditional<is_map, iterator_impl<false>, iterator_impl<true>>::type;
+    using const_iterator = iterator_impl<true>;
+
+private:
+    __btree_node* root_;
+    leaf_node*    leftmost_;
+    leaf_node*    rightmost_;
+    size_type     size_;
+    int           height_;  // number of inner levels, 0 when the root is a leaf
+    key_compare   comp_;
+
+public:
+    btree() : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), height_(0), comp_() {}
+    explicit btree(const allocator_type& a)
+        : alloc_base(a), root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), height_(0),
+          comp_() {}
+    explicit btree(const key_compare& comp, const allocator_type& a = allocator_type())
+        : alloc_base(a), root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), height_(0),
+          comp_(comp) {}
+
+    // the elements of rhs are sorted and unique, so a copy is a bulk load
+    btree(const btree& rhs) : btree(rhs.comp_, __select_on_copy(rhs.alloc())) {
+        assign_sorted(rhs.begin(), rhs.end());
+    }
+    btree(btree&& rhs) noexcept : btree(rhs.comp_, rhs.alloc()) { steal(rhs); }
+
+    btree& operator=(const btree& rhs) {
+        if (this != &rhs) {
+            comp_ = rhs.comp_;
+            assign_sorted(rhs.begin(), rhs.end());
+        }
+        return *this;
+    }
+    btree& operator=(btree&& rhs) noexcept {
+        if (this != &rhs) {
+            clear();
+            comp_ = rhs.comp_;
+            // rhs's nodes are freed with rhs's allocator from now on
+            MYSTL::swap(this->alloc(), rhs.alloc());
+            steal(rhs);
+        }
+        return *this;
+    }
+
+    ~btree() { clear(); }
+
+    allocator_type get_allocator() const { return this->alloc(); }
+
+    //iterators
+    iterator       begin()       { return iterator(leftmost_, 0); }
+    const_iterator begin() const { return const_iterator(leftmost_, 0); }
+    iterator       end()         { return iterator(rightmost_, rightmost_ ? rightmost_->count : 0); }
+    const_iterator end()   const { return const_iterator(rightmost_, rightmost_ ? rightmost_->count : 0); }
+
+    //capacity
+    bool      empty()  const { return size_ == 0; }
+    size_type size()   const { return size_; }
+    int       height() const { return root_ == nullptr ? 0 : height_ + 1; }
+
+    key_compare key_comp() const { return comp_; }
+
+    //lookup
+    iterator lower_bound(const key_type& k) {
+        if (root_ == nullptr)
+            return end();
+        leaf_node* leaf = find_leaf(k, nullptr);
+        return normalize(leaf, search::lower(leaf->key_data(), leaf->count, k, comp_));
+    }
+    const_iterator lower_bound(const key_type& k) const {
+        return const_cast<btree*>(this)->lower_bound(k);
+    }
+    iterator upper_bound(const key_type& k) {
+        if (root_ == nullptr)
+            return end();
+        leaf_node* leaf = find_leaf(k, nullptr);
+        return normalize(leaf, search::upper(leaf->key_data(), leaf->count, k, comp_));
+    }
+    const_iterator upper_bound(const key_type& k) const {
+        return const_cast<btree*>(this)->upper_bound(k);
+    }
+
+    iterator find(const key_type& k) {
+        if (root_ == nullptr)
+            return end();
+        leaf_node* leaf = find_leaf(k, nullptr);
+        const unsigned pos = search::lower(leaf->key_data(), leaf->count, k, comp_);
+        if (pos < leaf->count && !comp_(k, *leaf->key(pos)))
+            return iterator(leaf, pos);
+        return end();
+    }
+    const_iterator find(const key_type& k) const { return const_cast<btree*>(this)->find(k); }
+
+    //insert
+    // builds the element from the key and the mapped arguments only when the key is new
+    template <typename K, typename... Args>
+    MYSTL::pair<iterator, bool> emplace_unique(K&& k, Args&&... args);
+
+    //erase
+    size_type erase(const key_type& k);
+
+    iterator erase(const_iterator position) {
+        // rebalancing may move the following elements, find the next one again by key
+        const_iterator next = position;
+        ++next;
+        if (next == end()) {
+            erase(position.key());
+            return end();
+        }
+        key_type next_key = next.key();
+        erase(position.key());
+        return lower_bound(next_key);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        if (first == begin() && last == end()) {
+            clear();
+            return end();
+        }
+        size_type n = 0;
+        for (auto it = first; it != last; ++it)
+            ++n;
+        iterator it = iterator(first.leaf_, first.pos_);
+        for (; n > 0; --n)
+            it = erase(const_iterator(it));
+        return it;
+    }
+
+    void clear() {
+        if (root_ != nullptr)
+            free_subtree(root_, height_);
+        root_ = nullptr;
+        leftmost_ = rightmost_ = nullptr;
+        size_ = 0;
+        height_ = 0;
+    }
+
+    // replaces the contents with [first, last), which must be sorted and free of
+    // duplicates. leaves are filled completely and the inner levels built on top, O(n)
+    template <typename InputIterator>
+    void assign_sorted(InputIterator first, InputIterator last);
+
+    void swap(btree& rhs) noexcept {
+        MYSTL::swap(root_, rhs.root_);
+        MYSTL::swap(leftmost_, rhs.leftmost_);
+        MYSTL::swap(rightmost_, rhs.rightmost_);
+        MYSTL::swap(size_, rhs.size_);
+        MYSTL::swap(height_, rhs.height_);
+        MYSTL::swap(comp_, rhs.comp_);
+        MYSTL::swap(this->alloc(), rhs.alloc());
+    }
+
+    // checks ordering, fill levels, separators and the leaf chain, for tests
+    bool __verify() const;
+
+private:
+    void steal(btree& rhs) noexcept {
+        root_ = rhs.root_;
+        leftmost_ = rhs.leftmost_;
+        rightmost_ = rhs.rightmost_;
+        size_ = rhs.size_;
+        height_ = rhs.height_;
+        rhs.root_ = nullptr;
+        rhs.leftmost_ = rhs.rightmost_ = nullptr;
+        rhs.size_ = 0;
+        rhs.height_ = 0;
+    }
+
+    static inner_node* as_inner(__btree_node* p) { return static_cast<inner_node*>(p); }
+    static leaf_node*  as_leaf(__btree_node* p)  { return static_cast<leaf_node*>(p); }
+
+    iterator normalize(leaf_node* leaf, unsigned pos) {
+        if (pos == leaf->count && leaf->next != nullptr)
+            return iterator(leaf->next, 0);
+        return iterator(leaf, pos);
+    }
+
+    // child i of an inner node holds the keys in [key(i - 1), key(i))
+    leaf_node* find_leaf(const key_type& k, path_entry* path) const {
+        __btree_node* node = root_;
+        for (int level = height_; level > 0; --level) {
+            inner_node* inner = as_inner(node);
+            const unsigned i = search::upper(inner->key_data(), inner->count, k, comp_);
+            if (path != nullptr)
+                path[level] = path_entry{inner, i};
+            node = inner->children[i];
+        }
+        return as_leaf(node);
+    }
+
+    leaf_node* new_leaf() {
+        leaf_node* leaf = leaf_allocator(this->alloc()).allocate(1);
+        leaf->count = 0;
+        leaf->prev = leaf->next = nullptr;
+        return leaf;
+    }
+    inner_node* new_inner() {
+        inner_node* inner = inner_allocator(this->alloc()).allocate(1);
+        inner->count = 0;
+        return inner;
+    }
+    void free_leaf(leaf_node* leaf) noexcept { leaf_allocator(this->alloc()).deallocate(leaf, 1); }
+    void free_inner(inner_node* inner) noexcept { inner_allocator(this->alloc()).deallocate(inner, 1); }
+
+    //element slots: a transfer move-constructs into dst and destroys src
+    static void destroy_slot(leaf_node* leaf, unsigned i) {
+        MYSTL::destroy(leaf->key(i));
+        destroy_value(leaf, i, std::integral_constant<bool, is_map>());
+    }
+    static void destroy_value(leaf_node* leaf, unsigned i, std::true_type) { MYSTL::destroy(leaf->value(i)); }
+    static void destroy_value(leaf_node*, unsigned, std::false_type) {}
+
+    static void transfer(leaf_node* dst, unsigned di, leaf_node* src, unsigned si) {
+        MYSTL::construct(dst->key(di), MYSTL::move(*src->key(si)));
+        MYSTL::destroy(src->key(si));
+        transfer_value(dst, di, src, si, std::integral_constant<bool, is_map>());
+    }
+    static void transfer_value(leaf_node* dst, unsigned di, leaf_node* src, unsigned si, std::true_type) {
+        MYSTL::construct(dst->value(di), MYSTL::move(*src->value(si)));
+        MYSTL::destroy(src->value(si));
+    }
+    static void transfer_value(leaf_node*, unsigned, leaf_node*, unsigned, std::false_type) {}
+
+    static void transfer_key(inner_node* dst, unsigned di, inner_node* src, unsigned si) {
+        MYSTL::construct(dst->key(di), MYSTL::move(*src->key(si)));
+        MYSTL::destroy(src->key(si));
+    }
+
+    template <typename K, typename... Args>
+    static void construct_slot(leaf_node* leaf, unsigned i, K&& k, Args&&... args) {
+        MYSTL::construct(leaf->key(i), MYSTL::forward<K>(k));
+        try {
+            construct_value(leaf, i, std::integral_constant<bool, is_map>(), MYSTL::forward<Args>(args)...);
+        }
+        catch(...) {
+            MYSTL::destroy(leaf->key(i));
+            throw;
+        }
+    }
+    template <typename... Args>
+    static void construct_value(leaf_node* leaf, unsigned i, std::true_type, Args&&... args) {
+        MYSTL::construct(leaf->value(i), MYSTL::forward<Args>(args)...);
+    }
+    static void construct_value(leaf_node*, unsigned, std::false_type) {}
+
+    // bulk load input: a pair for maps, the key for sets
+    template <typename V>
+    static void construct_from(leaf_node* leaf, unsigned i, const V& v, std::true_type) {
+        construct_slot(leaf, i, v.first, v.second);
+    }
+    template <typename V>
+    static void construct_from(leaf_node* leaf, unsigned i, const V& v, std::false_type) {
+        construct_slot(leaf, i, v);
+    }
+
+    // opens a hole at pos in a leaf holding count elements
+    static void shift_right(leaf_node* leaf, unsigned pos) {
+        for (unsigned i = leaf->count; i > pos; --i)
+            transfer(leaf, i, leaf, i - 1);
+    }
+    // closes the hole at pos, the leaf still counts it
+    static void shift_left(leaf_node* leaf, unsigned pos) {
+        for (unsigned i = pos; i + 1 < leaf->count; ++i)
+            transfer(leaf, i, leaf, i + 1);
+    }
+
+    // moves the key at ki and the child at ci of an inner node up / down by one
+    static void inner_insert(inner_node* node, unsigned i, key_type&& sep, __btree_node* right) {
+        for (unsigned j = node->count; j > i; --j) {
+            transfer_key(node, j, node, j - 1);
+            node->children[j + 1] = node->children[j];
+        }
+        MYSTL::construct(node->key(i), MYSTL::move(sep));
+        node->children[i + 1] = right;
+        ++node->count;
+    }
+    // removes key i and child i + 1
+    static void inner_remove(inner_node* node, unsigned i) {
+        MYSTL::destroy(node->key(i));
+        for (unsigned j = i; j + 1 < node->count; ++j) {
+            transfer_key(node, j, node, j + 1);
+            node->children[j + 1] = node->children[j + 2];
+        }
+        --node->count;
+    }
+
+    void link_after(leaf_node* leaf, leaf_node* right) {
+        right->prev = leaf;
+        right->next = leaf->next;
+        if (leaf->next != nullptr)
+            leaf->next->prev = right;
+        else
+            rightmost_ = right;
+        leaf->next = right;
+    }
+    void unlink(leaf_node* leaf) {
+        if (leaf->prev != nullptr)
+            leaf->prev->next = leaf->next;
+        else
+            leftmost_ = leaf->next;
+        if (leaf->next != nullptr)
+            leaf->next->prev = leaf->prev;
+        else
+            rightmost_ = leaf->prev;
+    }
+
+    void insert_into_parent(path_entry* path, int level, key_type&& sep, __btree_node* right);
+    void rebalance_leaf(path_entry* path, leaf_node* leaf);
+    void rebalance_inner(path_entry* path, int level);
+
+    void free_subtree(__btree_node* node, int level) {
+        if (level == 0) {
+            leaf_node* leaf = as_leaf(node);
+            for (unsigned i = 0; i < leaf->count; ++i)
+                destroy_slot(leaf, i);
+            free_leaf(leaf);
+            return;
+        }
+        inner_node* inner = as_inner(node);
+        for (unsigned i = 0; i <= inner->count; ++i)
+            free_subtree(inner->children[i], level - 1);
+        for (unsigned i = 0; i < inner->count; ++i)
+            MYSTL::destroy(inner->key(i));
+        free_inner(inner);
+    }
+
+    // frees the leaves from leftmost_ on, for a bulk load that failed before root_ was set
+    void free_leaf_chain() {
+        for (leaf_node* p = leftmost_; p != nullptr;) {
+            leaf_node* next = p->next;
+            free_subtree(p, 0);
+            p = next;
+        }
+        leftmost_ = rightmost_ = nullptr;
+        size_ = 0;
+    }
+
+    bool verify_node(__btree_node* node, int level, const key_type* lo, const key_type* hi,
+                     leaf_node*& expected_leaf, size_type& n) const;
+};
+
+template <typename Key, typename Mapped, typename Compare, size_t NodeSize, typename Alloc>
+template <typename K, typename... Args>
+MYSTL::pair<typename btree<Key, Mapped, Compare, NodeSize, Alloc>::iterator, bool>
+btree<Key, Mapped, Compare, NodeSize, Alloc>::emplace_unique(K&& k, Args&&... args) {
+    if (root_ == nullptr) {
+        leaf_node* leaf = new_leaf();
+        try {
+            construct_slot(leaf, 0, MYSTL::forward<K>(k), MYSTL::forward<Args>(args)...);
+        }
+        catch(...) {
+            free_leaf(leaf);
+            throw;
+        }
+        leaf->count = 1;
+        root_ = leftmost_ = rightmost_ = leaf;
+        height_ = 0;
+        size_ = 1;
+        return MYSTL::pair<iterator, bool>(begin(), true);
+    }
+
+    path_entry path[max_height + 1];
+    leaf_node* leaf = find_leaf(k, path);
+    unsigned pos = search::lower(leaf->key_data(), leaf->count, k, comp_);
+    if (pos < leaf->count && !comp_(k, *leaf->key(pos)))
+        return MYSTL::pair<iterator, bool>(iterator(leaf, pos), false);
+
+    if (leaf->count < leaf_slots) {
+        shift_right(leaf, pos);
+        try {
+            construct_slot(leaf, pos, MYSTL::forward<K>(k), MYSTL::forward<Args>(args)...);
+        }
+        catch(...) {
+            ++leaf->count;
+            shift_left(leaf, pos);
+            --leaf->count;
+            throw;
+        }
+        ++leaf->count;
+        ++size_;
+        return MYSTL::pair<iterator, bool>(iterator(leaf, pos), true);
+    }
+
+    // full leaf: split it. appending past the last key of the tree leaves the left leaf
+    // full, so ascending inserts produce packed leaves instead of half empty ones
+    leaf_node* right = new_leaf();
+    const unsigned split = (pos == leaf_slots && leaf->next == nullptr) ? leaf_slots : (leaf_slots + 1) / 2;
+    for (unsigned i = split; i < leaf_slots; ++i)
+        transfer(right, i - split, leaf, i);
+    right->count = leaf_slots - split;
+    leaf->count = split;
+    link_after(leaf, right);
+
+    leaf_node* target = leaf;
+    if (pos > split || (pos == split && split == leaf_slots)) {
+        target = right;
+        pos -= split;
+    }
+    // the element goes in before the separator is taken, it may be the first of right
+    shift_right(target, pos);
+    try {
+        construct_slot(target, pos, MYSTL::forward<K>(k), MYSTL::forward<Args>(args)...);
+    }
+    catch(...) {
+        ++target->count;
+        shift_left(target, pos);
+        --target->count;
+        // put the split back, the tree above has not changed yet
+        for (unsigned i = 0; i < right->count; ++i)
+            transfer(leaf, leaf->count + i, right, i);
+        leaf->count += right->count;
+        unlink(right);
+        free_leaf(right);
+        throw;
+    }
+    ++target->count;
+    ++size_;
+
+    insert_into_parent(path, 1, key_type(*right->key(0)), right);
+    return MYSTL::pair<iterator, bool>(iterator(target, pos), true);
+}
+
+// links right (a new sibling of path[level]'s child) with separator sep, splitting inner
+// nodes upwards as needed
+template <typename Key, typename Mapped, typename Compare, size_t NodeSize, typename Alloc>
+void btree<Key, Mapped, Compare, NodeSize, Alloc>::
+insert_into_parent(path_entry* path, int level, key_type&& sep, __btree_node* right) {
+    while (level <= height_) {
+        inner_node* node = path[level].node;
+        const unsigned i = path[level].index;
+        if (node->count < inner_slots) {
+            inner_insert(node, i, MYSTL::move(sep), right);
+            return;
+        }
+        // split the inner_slots + 1 keys so that half stay, one moves up and the rest go
+        // to the sibling. the moving key is node's key(mid), or sep itself when i == half
+        inner_node* sibling = new_inner();
+        const unsigned half = inner_slots / 2;
+        const unsigned mid = i < half ? half - 1 : half;
+        const unsigned first = i == half ? half : mid + 1;
+        for (unsigned j = first; j < inner_slots; ++j) {
+            transfer_key(sibling, j - first, node, j);
+            sibling->children[j - first + 1] = node->children[j + 1];
+        }
+        sibling->count = inner_slots - first;
+
+        if (i == half) {
+            sibling->children[0] = right;
+            node->count = half;
+        }
+        else {
+            sibling->children[0] = node->children[mid + 1];
+            key_type up(MYSTL::move(*node->key(mid)));
+            MYSTL::destroy(node->key(mid));
+            node->count = mid;
+            if (i < half)
+                inner_insert(node, i, MYSTL::move(sep), right);
+            else
+                inner_insert(sibling, i - mid - 1, MYSTL::move(sep), right);
+            sep = MYSTL::move(up);
+        }
+        right = sibling;
+        ++level;
+    }
+    // the root was split
+    inner_node* root = new_inner();
+    MYSTL::construct(root->key(0), MYSTL::move(sep));
+    root->children[0] = root_;
+    root->children[1] = right;
+    root->count = 1;
+    root_ = root;
+    ++height_;
+}
+
+template <typename Key, typename Mapped, typename Compare, size_t NodeSize, typename Alloc>
+typename btree<Key, Mapped, Compare, NodeSize, Alloc>::size_type
+btree<Key, Mapped, Compare, NodeSize, Alloc>::erase(const key_type& k) {
+    if (root_ == nullptr)
+        return 0;
+    path_entry path[max_height + 1];
+    leaf_node* leaf = find_leaf(k, path);
+    const unsigned pos = search::lower(leaf->key_data(), leaf->count, k, comp_);
+    if (pos == leaf->count || comp_(k, *leaf->key(pos)))
+        return 0;
+
+    destroy_slot(leaf, pos);
+    shift_left(leaf, pos);
+    --leaf->count;
+    --size_;
+
+    if (height_ == 0) {
+        if (leaf->count == 0) {
+            free_leaf(leaf);
+            root_ = nullptr;
+            leftmost_ = rightmost_ = nullptr;
+        }
+    }
+    else if (leaf->count < min_leaf) {
+        rebalance_leaf(path, leaf);
+    }
+    return 1;
+}
+
+// leaf has one element too few: take one from a sibling that can spare it, otherwise merge
+template <typename Key, typename Mapped, typename Compare, size_t NodeSize, typename Alloc>
+void btree<Key, Mapped, Compare, NodeSize, Alloc>::rebalance_leaf(path_entry* path, leaf_node* leaf) {
+    inner_node* parent = path[1].node;
+    const unsigned i = path[1].index;
+    leaf_node* left = i > 0 ? as_leaf(parent->children[i - 1]) : nullptr;
+    leaf_node* right = i < parent->count ? as_leaf(parent->children[i + 1]) : nullptr;
+
+    if (left != nullptr && left->count > min_leaf) {
+        shift_right(leaf, 0);
+        transfer(leaf, 0, left, left->count - 1);
+        --left->count;
+        ++leaf->count;
+        *parent->key(i - 1) = *leaf->key(0);
+        return;
+    }
+    if (right != nullptr && right->count > min_leaf) {
+        transfer(leaf, leaf->count, right, 0);
+        ++leaf->count;
+        shift_left(right, 0);
+        --right->count;
+        *parent->key(i) = *right->key(0);
+        return;
+    }
+
+    // merge into the left one of the pair, drop the right one and its separator
+    unsigned sep = i;
+    if (left != nullptr) {
+        right = leaf;
+        leaf = left;
+        sep = i - 1;
+    }
+    for (unsigned j = 0; j < right->count; ++j)
+        transfer(leaf, leaf->count + j, right, j);
+    leaf->count += right->count;
+    unlink(right);
+    free_leaf(right);
+    inner_remove(parent, sep);
+
+    rebalance_inner(path, 1);
+}
+
+// path[level].node may have lost a key: fix it the same way, or shrink the root
+template <typename Key, typename Mapped, typename Compare, size_t NodeSize, typename Alloc>
+void btree<Key, Mapped, Compare, NodeSize, Alloc>::rebalance_inner(path_entry* path, int level) {
+    for (; level <= height_; ++level) {
+        inner_node* node = path[level].node;
+        if (level == height_) {
+            if (node->count == 0) {
+                root_ = node->children[0];
+                free_inner(node);
+                --height_;
+            }
+            return;
+        }
+        if (node->count >= min_inner)
+            return;
+
+        inner_node* parent = path[level + 1].node;
+        const unsigned i = path[level + 1].index;
+        inner_node* left = i > 0 ? as_inner(parent->children[i - 1]) : nullptr;
+        inner_node* right = i < parent->count ? as_inner(parent->children[i + 1]) : nullptr;
+
+        if (left != nullptr && left->count > min_inner) {
+            // rotate right through the parent separator
+            for (unsigned j = node->count; j > 0; --j) {
+                transfer_key(node, j, node, j - 1);
+                node->children[j + 1] = node->children[j];
+            }
+            node->children[1] = node->children[0];
+            transfer_key(node, 0, parent, i - 1);
+            node->children[0] = left->children[left->count];
+            transfer_key(parent, i - 1, left, left->count - 1);
+            --left->count;
+            ++node->count;
+            return;
+        }
+        if (right != nullptr && right->count > min_inner) {
+            // rotate left through the parent separator
+            transfer_key(node, node->count, parent, i);
+            node->children[node->count + 1] = right->children[0];
+            ++node->count;
+            transfer_key(parent, i, right, 0);
+            right->children[0] = right->children[1];
+            for (unsigned j = 0; j + 1 < right->count; ++j) {
+                transfer_key(right, j, right, j + 1);
+                right->children[j + 1] = right->children[j + 2];
+            }
+            --right->count;
+            return;
+        }
+
+        // merge: left keys, the separator, right keys
+        unsigned sep = i;
+        if (left != nullptr) {
+            right = node;
+            node = left;
+            sep = i - 1;
+        }
+        MYSTL::construct(node->key(node->count), *parent->key(sep));
+        node->children[node->count + 1] = right->children[0];
+        ++node->count;
+        for (unsigned j = 0; j < right->count; ++j) {
+            transfer_key(node, node->count + j, right, j);
+            node->children[node->count + j + 1] = right->children[j + 1];
+        }
+        node->count += right->count;
+        free_inner(right);
+        inner_remove(parent, sep);
+    }
+}
+
+template <typename Key, typename Mapped, typename Compare, size_t NodeSize, typename Alloc>
+template <typename InputIterator>
+void btree<Key, Mapped, Compare, NodeSize, Alloc>::assign_sorted(InputIterator first, InputIterator last) {
+    clear();
+    if (first == last)
+        return;
+
+    // leaves, filled completely
+    MYSTL::vector<__btree_node*> level_nodes;
+    leaf_node* leaf = nullptr;
+    try {
+        for (; first != last; ++first) {
+            if (leaf == nullptr || leaf->count == leaf_slots) {
+                leaf_node* next = new_leaf();
+                if (leaf == nullptr)
+                    leftmost_ = next;
+                else
+                    link_after(leaf, next);
+                rightmost_ = leaf = next;
+                level_nodes.push_back(leaf);
+            }
+            construct_from(leaf, leaf->count, *first, std::integral_constant<bool, is_map>());
+            ++leaf->count;
+            ++size_;
+        }
+    }
+    catch(...) {
+        free_leaf_chain();
+        throw;
+    }
+
+    // the last leaf takes elements from its neighbour until both are at least half full
+    if (level_nodes.size() > 1 && leaf->count < min_leaf) {
+        leaf_node* prev = leaf->prev;
+        const unsigned move = (prev->count + leaf->count) / 2 - leaf->count;
+        for (unsigned j = leaf->count; j > 0; --j)
+            transfer(leaf, j - 1 + move, leaf, j - 1);
+        for (unsigned j = 0; j < move; ++j)
+            transfer(leaf, j, prev, prev->count - move + j);
+        prev->count -= move;
+        leaf->count += move;
+    }
+
+    // inner levels: group inner_slots + 1 children per node, the separator before child j
+    // is the smallest key under it. the last two groups are evened out the same way.
+    // every inner node goes into built before it is filled and counts only the separators
+    // already copied, so a throw frees the partial levels and then the leaves
+    MYSTL::vector<inner_node*> built;
+    try {
+        MYSTL::vector<const key_type*> level_min;
+        for (auto p : level_nodes)
+            level_min.push_back(as_leaf(p)->key(0));
+        height_ = 0;
+        const size_type per = inner_slots + 1;
+        while (level_nodes.size() > 1) {
+            const size_type m = level_nodes.size();
+            const size_type groups = (m + per - 1) / per;
+            size_type last_size = m - per * (groups - 1);
+            size_type before_last = per;
+            if (groups > 1 && last_size < min_inner + 1) {
+                const size_type s = per + last_size;
+                before_last = s - s / 2;
+                last_size = s / 2;
+            }
+
+            MYSTL::vector<__btree_node*> upper_nodes;
+            MYSTL::vector<const key_type*> upper_min;
+            size_type next = 0;
+            for (size_type g = 0; g < groups; ++g) {
+                const size_type n = g + 1 == groups ? last_size : g + 2 == groups ? before_last : per;
+                built.push_back(nullptr);
+                inner_node* inner = new_inner();
+                built.back() = inner;
+                inner->children[0] = level_nodes[next];
+                for (size_type j = 1; j < n; ++j) {
+                    MYSTL::construct(inner->key(inner->count), *level_min[next + j]);
+                    inner->children[j] = level_nodes[next + j];
+                    ++inner->count;
+                }
+                upper_nodes.push_back(inner);
+                upper_min.push_back(level_min[next]);
+                next += n;
+            }
+            level_nodes.swap(upper_nodes);
+            level_min.swap(upper_min);
+            ++height_;
+        }
+    }
+    catch(...) {
+        for (inner_node* inner : built) {
+            if (inner == nullptr)
+                continue;
+            for (unsigned i = 0; i < inner->count; ++i)
+                MYSTL::destroy(inner->key(i));
+            free_inner(inner);
+        }
+        free_leaf_chain();
+        height_ = 0;
+        throw;
+    }
+    root_ = level_nodes[0];
+}
+
+template <typename Key, typename Mapped, typename Compare, size_t NodeSize, typename Alloc>
+bool btree<Key, Mapped, Compare, NodeSize, Alloc>::__verify() const {
+    if (root_ == nullptr)
+        return size_ == 0 && leftmost_ == nullptr && rightmost_ == nullptr;
+    leaf_node* expected_leaf = leftmost_;
+    size_type n = 0;
+    if (!verify_node(root_, height_, nullptr, nullptr, expected_leaf, n))
+        return false;
+    return n == size_ && expected_leaf == nullptr;
+}
+
+// every key of the subtree is in [lo, hi), leaves are met in chain order
+template <typename Key, typename Mapped, typename Compare, size_t NodeSize, typename Alloc>
+bool btree<Key, Mapped, Compare, NodeSize, Alloc>::
+verify_node(__btree_node* node, int level, const key_type* lo, const key_type* hi,
+            leaf_node*& expected_leaf, size_type& n) const {
+    const bool is_root = node == root_;
+    if (level == 0) {
+        leaf_node* leaf = as_leaf(node);
+        // the rightmost leaf may be short, appends past the end split off a single element
+        if (leaf != expected_leaf || leaf->count == 0 || (!is_root && leaf != rightmost_ && leaf->count < min_leaf))
+            return false;
+        for (unsigned i = 0; i < leaf->count; ++i) {
+            const key_type& k = *leaf->key(i);
+            if ((i > 0 && !comp_(*leaf->key(i - 1), k)) || (lo && comp_(k, *lo)) || (hi && !comp_(k, *hi)))
+                return false;
+        }
+        if ((leaf->next == nullptr) != (leaf == rightmost_) || (leaf->next && leaf->next->prev != leaf))
+            return false;
+        n += leaf->count;
+        expected_leaf = leaf->next;
+        return true;
+    }
+    inner_node* inner = as_inner(node);
+    if (inner->count == 0 || (!is_root && inner->count < min_inner))
+        return false;
+    for (unsigned i = 0; i <= inner->count; ++i) {
+        const key_type* child_lo = i == 0 ? lo : inner->key(i - 1);
+        const key_type* child_hi = i == inner->count ? hi : inner->key(i);
+        if (!verify_node(inner->children[i], level - 1, child_lo, child_hi, expected_leaf, n))
+            return false;
+    }
+    return true;
+}
+
+} // end of namespace MYSTL
+
+#endif
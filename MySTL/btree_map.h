@@ -0,0 +1,193 @@
+#ifndef BTREE_MAP_H_
+#define BTREE_MAP_H_
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include "btree.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// btree_map
+// ordered map on a B+-tree. keys and mapped values sit in separate arrays inside the leaf,
+// so like flat_map the iterators yield a pair of references rather than a stored pair.
+// range scans walk the leaf chain; a map built from sorted unique input
+// (btree_map(sorted_unique, first, last)) is bulk loaded in O(n).
+// any insert or erase invalidates all iterators.
+/*****************************************************************************************/
+
+template <typename Key, typename T, typename Compare = std::less<Key>, size_t NodeSize = 256,
+          typename Alloc = MYSTL::allocator<MYSTL::pair<Key, T>>>
+class btree_map {
+public:
+    using key_type       = Key;
+    using mapped_type    = T;
+    using value_type     = MYSTL::pair<Key, T>;
+    using key_compare    = Compare;
+    using allocator_type = Alloc;
+
+private:
+    using tree_type = btree<Key, T, Compare, NodeSize, Alloc>;
+    tree_type tree_;
+
+public:
+    using size_type       = typename tree_type::size_type;
+    using difference_type = typename tree_type::difference_type;
+    using iterator        = typename tree_type::iterator;
+    using const_iterator  = typename tree_type::const_iterator;
+    using reference       = typename iterator::reference;
+    using const_reference = typename const_iterator::reference;
+
+public:
+    btree_map() = default;
+    explicit btree_map(const allocator_type& a) : tree_(a) {}
+    explicit btree_map(const key_compare& comp, const allocator_type& a = allocator_type()) : tree_(comp, a) {}
+
+    template <typename InputIterator>
+    btree_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+              const allocator_type& a = allocator_type())
+        : tree_(comp, a) { insert(first, last); }
+
+    // [first, last) must be sorted by key without duplicates
+    template <typename InputIterator>
+    btree_map(sorted_unique_t, InputIterator first, InputIterator last,
+              const key_compare& comp = key_compare(), const allocator_type& a = allocator_type())
+        : tree_(comp, a) { tree_.assign_sorted(first, last); }
+
+    btree_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(),
+              const allocator_type& a = allocator_type())
+        : tree_(comp, a) { insert(ilist.begin(), ilist.end()); }
+
+    btree_map(const btree_map&) = default;
+    btree_map(btree_map&&) = default;
+    btree_map& operator=(const btree_map&) = default;
+    btree_map& operator=(btree_map&&) = default;
+
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+    //iterators
+    iterator       begin()        { return tree_.begin(); }
+    const_iterator begin()  const { return tree_.begin(); }
+    iterator       end()          { return tree_.end(); }
+    const_iterator end()    const { return tree_.end(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend()   const { return end(); }
+
+    //capacity
+    bool      empty()  const { return tree_.empty(); }
+    size_type size()   const { return tree_.size(); }
+    int       height() const { return tree_.height(); }
+
+    //element access
+    mapped_type& operator[](const key_type& key) { return try_emplace(key).first->second; }
+    mapped_type& operator[](key_type&& key) { return try_emplace(MYSTL::move(key)).first->second; }
+
+    mapped_type& at(const key_type& key) {
+        auto it = find(key);
+        if (it == end())
+            throw std::out_of_range("btree_map::at");
+        return it->second;
+    }
+    const mapped_type& at(const key_type& key) const {
+        auto it = find(key);
+        if (it == end())
+            throw std::out_of_range("btree_map::at");
+        return it->second;
+    }
+
+    //modifiers
+    MYSTL::pair<iterator, bool> insert(const value_type& value) {
+        return tree_.emplace_unique(value.first, value.second);
+    }
+    MYSTL::pair<iterator, bool> insert(value_type&& value) {
+        return tree_.emplace_unique(MYSTL::move(value.first), MYSTL::move(value.second));
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            tree_.emplace_unique((*first).first, (*first).second);
+    }
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+    template <typename... Args>
+    MYSTL::pair<iterator, bool> emplace(Args&&... args) {
+        return insert(value_type(MYSTL::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    MYSTL::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return tree_.emplace_unique(key, MYSTL::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    MYSTL::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return tree_.emplace_unique(MYSTL::move(key), MYSTL::forward<Args>(args)...);
+    }
+
+    template <typename M>
+    MYSTL::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+        auto res = tree_.emplace_unique(key, MYSTL::forward<M>(obj));
+        if (!res.second)
+            res.first->second = MYSTL::forward<M>(obj);
+        return res;
+    }
+
+    iterator  erase(const_iterator position) { return tree_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+    size_type erase(const key_type& key) { return tree_.erase(key); }
+
+    // replaces the contents with sorted unique input in O(n)
+    template <typename InputIterator>
+    void assign_sorted(InputIterator first, InputIterator last) { tree_.assign_sorted(first, last); }
+
+    void clear() { tree_.clear(); }
+    void swap(btree_map& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    //lookup
+    iterator       find(const key_type& key)       { return tree_.find(key); }
+    const_iterator find(const key_type& key) const { return tree_.find(key); }
+    size_type      count(const key_type& key) const { return find(key) == end() ? 0 : 1; }
+    bool           contains(const key_type& key) const { return find(key) != end(); }
+
+    iterator       lower_bound(const key_type& key)       { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+    iterator       upper_bound(const key_type& key)       { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+    MYSTL::pair<iterator, iterator> equal_range(const key_type& key) {
+        return MYSTL::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+    MYSTL::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return MYSTL::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    key_compare key_comp() const { return tree_.key_comp(); }
+
+    bool __verify() const { return tree_.__verify(); }
+
+    friend bool operator==(const btree_map& lhs, const btree_map& rhs) {
+        if (lhs.size() != rhs.size())
+            return false;
+        auto it = rhs.begin();
+        for (auto kv : lhs) {
+            if (!(kv.first == (*it).first && kv.second == (*it).second))
+                return false;
+            ++it;
+        }
+        return true;
+    }
+};
+
+template <typename Key, typename T, typename Compare, size_t NodeSize, typename Alloc>
+bool operator!=(const btree_map<Key, T, Compare, NodeSize, Alloc>& lhs, const btree_map<Key, T, Compare, NodeSize, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare, size_t NodeSize, typename Alloc>
+void swap(btree_map<Key, T, Compare, NodeSize, Alloc>& lhs, btree_map<Key, T, Compare, NodeSize, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef BTREE_SET_H_
+#define BTREE_SET_H_
+
+#include <functional>
+#include <initializer_list>
+#include "btree.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// btree_set
+// ordered set on a B+-tree, iterators are constant. btree_set(sorted_unique, first, last)
+// and assign_sorted() bulk load sorted unique input in O(n).
+// any insert or erase invalidates all iterators.
+/*****************************************************************************************/
+
+template <typename Key, typename Compare = std::less<Key>, size_t NodeSize = 256,
+          typename Alloc = MYSTL::allocator<Key>>
+class btree_set {
+public:
+    using key_type       = Key;
+    using value_type     = Key;
+    using key_compare    = Compare;
+    using allocator_type = Alloc;
+
+private:
+    using tree_type = btree<Key, void, Compare, NodeSize, Alloc>;
+    tree_type tree_;
+
+public:
+    using size_type       = typename tree_type::size_type;
+    using difference_type = typename tree_type::difference_type;
+    using reference       = const Key&;
+    using const_reference = const Key&;
+    using iterator        = typename tree_type::const_iterator;
+    using const_iterator  = typename tree_type::const_iterator;
+
+public:
+    btree_set() = default;
+    explicit btree_set(const allocator_type& a) : tree_(a) {}
+    explicit btree_set(const key_compare& comp, const allocator_type& a = allocator_type()) : tree_(comp, a) {}
+
+    template <typename InputIterator>
+    btree_set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+              const allocator_type& a = allocator_type())
+        : tree_(comp, a) { insert(first, last); }
+
+    // [first, last) must be sorted without duplicates
+    template <typename InputIterator>
+    btree_set(sorted_unique_t, InputIterator first, InputIterator last,
+              const key_compare& comp = key_compare(), const allocator_type& a = allocator_type())
+        : tree_(comp, a) { tree_.assign_sorted(first, last); }
+
+    btree_set(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(),
+              const allocator_type& a = allocator_type())
+        : tree_(comp, a) { insert(ilist.begin(), ilist.end()); }
+
+    btree_set(const btree_set&) = default;
+    btree_set(btree_set&&) = default;
+    btree_set& operator=(const btree_set&) = default;
+    btree_set& operator=(btree_set&&) = default;
+
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+
+    //iterators
+    iterator begin()  const { return tree_.begin(); }
+    iterator end()    const { return tree_.end(); }
+    iterator cbegin() const { return begin(); }
+    iterator cend()   const { return end(); }
+
+    //capacity
+    bool      empty()  const { return tree_.empty(); }
+    size_type size()   const { return tree_.size(); }
+    int       height() const { return tree_.height(); }
+
+    //modifiers
+    MYSTL::pair<iterator, bool> insert(const value_type& value) { return tree_.emplace_unique(value); }
+    MYSTL::pair<iterator, bool> insert(value_type&& value) { return tree_.emplace_unique(MYSTL::move(value)); }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            tree_.emplace_unique(*first);
+    }
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+    template <typename... Args>
+    MYSTL::pair<iterator, bool> emplace(Args&&... args) {
+        return tree_.emplace_unique(value_type(MYSTL::forward<Args>(args)...));
+    }
+
+    iterator  erase(const_iterator position) { return tree_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+    size_type erase(const key_type& key) { return tree_.erase(key); }
+
+    // replaces the contents with sorted unique input in O(n)
+    template <typename InputIterator>
+    void assign_sorted(InputIterator first, InputIterator last) { tree_.assign_sorted(first, last); }
+
+    void clear() { tree_.clear(); }
+    void swap(btree_set& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    //lookup
+    iterator  find(const key_type& key)     const { return tree_.find(key); }
+    size_type count(const key_type& key)    const { return find(key) == end() ? 0 : 1; }
+    bool      contains(const key_type& key) const { return find(key) != end(); }
+
+    iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+    iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+    MYSTL::pair<iterator, iterator> equal_range(const key_type& key) const {
+        return MYSTL::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    key_compare key_comp() const { return tree_.key_comp(); }
+
+    bool __verify() const { return tree_.__verify(); }
+
+    friend bool operator==(const btree_set& lhs, const btree_set& rhs) {
+        return lhs.size() == rhs.size() && MYSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+};
+
+template <typename Key, typename Compare, size_t NodeSize, typename Alloc>
+bool operator!=(const btree_set<Key, Compare, NodeSize, Alloc>& lhs, const btree_set<Key, Compare, NodeSize, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare, size_t NodeSize, typename Alloc>
+void swap(btree_set<Key, Compare, NodeSize, Alloc>& lhs, btree_set<Key, Compare, NodeSize, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
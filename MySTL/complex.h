@@ -1,25 +1,42 @@
 #ifndef COMPLEX_H
 #define COMPLEX_H
 
+#include <cmath>
+#include <cstddef>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "vector.h"
+
+namespace MYSTL
+{
+
 template <typename Tp>
 class complex
 {
 public:
     using value_type = Tp;
 
-    constexpr 
-    complex(const Tp& r = Tp(), const Tp& i = Tp()) 
-            :m_real(r), m_imag(i) {}
-    
     constexpr
-    complex(const complex& rhs) 
-            :m_real(rhs.m_real), m_imag(rhs.m_imag) {} 
+    complex(const Tp& r = Tp(), const Tp& i = Tp())
+            :m_real(r), m_imag(i) {}
+
+    // defaulted, so complex<T> stays trivially copyable for memmove copies, serialize and mmap
+    constexpr complex(const complex& rhs) = default;
 
     template <class U>
     constexpr complex(const complex<U>& rhs)
-        : m_real(static_cast<Tp>(rhs.real())), m_imag(static_cast<Tp>(rhs.imag())) {} 
-    
-        
+        : m_real(static_cast<Tp>(rhs.real())), m_imag(static_cast<Tp>(rhs.imag())) {}
+
+    constexpr complex& operator=(const complex& rhs) = default;
+
+    complex& operator=(const Tp& rhs) {
+        m_real = rhs;
+        m_imag = Tp();
+        return *this;
+    }
 
 
 public:
@@ -29,11 +46,337 @@ public:
     constexpr void real(const Tp &r) { m_real = r; }
     constexpr void imag(const Tp &i) { m_imag = i; }
 
+public:
+    //arithmetic
+    complex& operator+=(const Tp& rhs) { m_real += rhs; return *this; }
+    complex& operator-=(const Tp& rhs) { m_real -= rhs; return *this; }
+    complex& operator*=(const Tp& rhs) { m_real *= rhs; m_imag *= rhs; return *this; }
+    complex& operator/=(const Tp& rhs) { m_real /= rhs; m_imag /= rhs; return *this; }
+
+    template <typename U>
+    complex& operator+=(const complex<U>& rhs) {
+        m_real += rhs.real();
+        m_imag += rhs.imag();
+        return *this;
+    }
+
+    template <typename U>
+    complex& operator-=(const complex<U>& rhs) {
+        m_real -= rhs.real();
+        m_imag -= rhs.imag();
+        return *this;
+    }
+
+    // (a + bi)(c + di) = (ac - bd) + (ad + bc)i
+    template <typename U>
+    complex& operator*=(const complex<U>& rhs) {
+        const Tp r = m_real * rhs.real() - m_imag * rhs.imag();
+        m_imag = m_real * rhs.imag() + m_imag * rhs.real();
+        m_real = r;
+        return *this;
+    }
+
+    // (a + bi)/(c + di) = ((ac + bd) + (bc - ad)i) / (c^2 + d^2)
+    template <typename U>
+    complex& operator/=(const complex<U>& rhs) {
+        const Tp denom = rhs.real() * rhs.real() + rhs.imag() * rhs.imag();
+        const Tp r = (m_real * rhs.real() + m_imag * rhs.imag()) / denom;
+        m_imag = (m_imag * rhs.real() - m_real * rhs.imag()) / denom;
+        m_real = r;
+        return *this;
+    }
+
 private:
     Tp m_real;
     Tp m_imag;
 
 };
 
+// the batch kernels below reinterpret complex<T> arrays as interleaved T arrays
+static_assert(sizeof(complex<float>) == 2 * sizeof(float), "complex<float> must be two packed floats");
+static_assert(sizeof(complex<double>) == 2 * sizeof(double), "complex<double> must be two packed doubles");
+
+
+/*****************************************************************************************/
+// unary and binary operators
+
+template <typename T>
+inline complex<T> operator+(const complex<T>& x) { return x; }
+
+template <typename T>
+inline complex<T> operator-(const complex<T>& x) { return complex<T>(-x.real(), -x.imag()); }
+
+template <typename T>
+inline complex<T> operator+(const complex<T>& lhs, const complex<T>& rhs) {
+    complex<T> result = lhs;
+    return result += rhs;
+}
+template <typename T>
+inline complex<T> operator+(const complex<T>& lhs, const T& rhs) {
+    complex<T> result = lhs;
+    return result += rhs;
+}
+template <typename T>
+inline complex<T> operator+(const T& lhs, const complex<T>& rhs) {
+    complex<T> result = rhs;
+    return result += lhs;
+}
+
+template <typename T>
+inline complex<T> operator-(const complex<T>& lhs, const complex<T>& rhs) {
+    complex<T> result = lhs;
+    return result -= rhs;
+}
+template <typename T>
+inline complex<T> operator-(const complex<T>& lhs, const T& rhs) {
+    complex<T> result = lhs;
+    return result -= rhs;
+}
+template <typename T>
+inline complex<T> operator-(const T& lhs, const complex<T>& rhs) {
+    return complex<T>(lhs - rhs.real(), -rhs.imag());
+}
+
+template <typename T>
+inline complex<T> operator*(const complex<T>& lhs, const complex<T>& rhs) {
+    complex<T> result = lhs;
+    return result *= rhs;
+}
+template <typename T>
+inline complex<T> operator*(const complex<T>& lhs, const T& rhs) {
+    complex<T> result = lhs;
+    return result *= rhs;
+}
+template <typename T>
+inline complex<T> operator*(const T& lhs, const complex<T>& rhs) {
+    complex<T> result = rhs;
+    return result *= lhs;
+}
+
+template <typename T>
+inline complex<T> operator/(const complex<T>& lhs, const complex<T>& rhs) {
+    complex<T> result = lhs;
+    return result /= rhs;
+}
+template <typename T>
+inline complex<T> operator/(const complex<T>& lhs, const T& rhs) {
+    complex<T> result = lhs;
+    return result /= rhs;
+}
+template <typename T>
+inline complex<T> operator/(const T& lhs, const complex<T>& rhs) {
+    complex<T> result = lhs;
+    return result /= rhs;
+}
+
+template <typename T>
+inline bool operator==(const complex<T>& lhs, const complex<T>& rhs) {
+    return lhs.real() == rhs.real() && lhs.imag() == rhs.imag();
+}
+template <typename T>
+inline bool operator==(const complex<T>& lhs, const T& rhs) {
+    return lhs.real() == rhs && lhs.imag() == T();
+}
+template <typename T>
+inline bool operator==(const T& lhs, const complex<T>& rhs) {
+    return rhs == lhs;
+}
+
+template <typename T>
+inline bool operator!=(const complex<T>& lhs, const complex<T>& rhs) { return !(lhs == rhs); }
+template <typename T>
+inline bool operator!=(const complex<T>& lhs, const T& rhs) { return !(lhs == rhs); }
+template <typename T>
+inline bool operator!=(const T& lhs, const complex<T>& rhs) { return !(lhs == rhs); }
+
+
+/*****************************************************************************************/
+// values
+
+template <typename T>
+constexpr T real(const complex<T>& x) { return x.real(); }
+
+template <typename T>
+constexpr T imag(const complex<T>& x) { return x.imag(); }
+
+// |x|^2, no sqrt
+template <typename T>
+inline T norm(const complex<T>& x) { return x.real() * x.real() + x.imag() * x.imag(); }
+
+// hypot avoids overflow/underflow of the intermediate squares
+template <typename T>
+inline T abs(const complex<T>& x) { return std::hypot(x.real(), x.imag()); }
+
+template <typename T>
+inline T arg(const complex<T>& x) { return std::atan2(x.imag(), x.real()); }
+
+template <typename T>
+inline complex<T> conj(const complex<T>& x) { return complex<T>(x.real(), -x.imag()); }
+
+template <typename T>
+inline complex<T> polar(const T& rho, const T& theta = T()) {
+    return complex<T>(rho * std::cos(theta), rho * std::sin(theta));
+}
+
+
+/*****************************************************************************************/
+// batch kernels
+// complex<float> arrays are interleaved (re, im, re, im, ...). The SSE paths load four
+// values, shuffle them into a split layout (one register of reals, one of imags),
+// do the arithmetic lane-wise and interleave again on the way out.
+/*****************************************************************************************/
+
+// out[i] = a[i] * b[i]
+template <typename T>
+inline void complex_multiply(const complex<T>* a, const complex<T>* b,
+                             complex<T>* out, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        out[i] = a[i] * b[i];
+}
+
+// out[i] = |a[i]|^2
+template <typename T>
+inline void complex_norm(const complex<T>* a, T* out, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        out[i] = norm(a[i]);
+}
+
+// split an interleaved array into separate real/imag arrays
+template <typename T>
+inline void complex_deinterleave(const complex<T>* in, T* re, T* im, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        re[i] = in[i].real();
+        im[i] = in[i].imag();
+    }
+}
+
+template <typename T>
+inline void complex_interleave(const T* re, const T* im, complex<T>* out, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        out[i] = complex<T>(re[i], im[i]);
+}
+
+// split layout multiply: (out_re + out_im i)[i] = (a_re + a_im i)[i] * (b_re + b_im i)[i]
+// plain loops over separate arrays, which the compiler vectorizes on its own
+template <typename T>
+inline void complex_multiply_split(const T* a_re, const T* a_im,
+                                   const T* b_re, const T* b_im,
+                                   T* out_re, T* out_im, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        const T r = a_re[i] * b_re[i] - a_im[i] * b_im[i];
+        const T m = a_re[i] * b_im[i] + a_im[i] * b_re[i];
+        out_re[i] = r;
+        out_im[i] = m;
+    }
+}
+
+template <typename T>
+inline void complex_norm_split(const T* re, const T* im, T* out, size_t n) {
+    for (size_t i = 0; i < n; ++i)
+        out[i] = re[i] * re[i] + im[i] * im[i];
+}
+
+#ifdef __SSE2__
+
+// load 4 interleaved complex<float> into split registers
+inline void __complex_load4(const complex<float>* p, __m128& re, __m128& im) {
+    const float* f = reinterpret_cast<const float*>(p);
+    const __m128 lo = _mm_loadu_ps(f);      // r0 i0 r1 i1
+    const __m128 hi = _mm_loadu_ps(f + 4);  // r2 i2 r3 i3
+    re = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+    im = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+inline void __complex_store4(complex<float>* p, __m128 re, __m128 im) {
+    float* f = reinterpret_cast<float*>(p);
+    _mm_storeu_ps(f, _mm_unpacklo_ps(re, im));
+    _mm_storeu_ps(f + 4, _mm_unpackhi_ps(re, im));
+}
+
+inline void complex_multiply(const complex<float>* a, const complex<float>* b,
+                             complex<float>* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 ar, ai, br, bi;
+        __complex_load4(a + i, ar, ai);
+        __complex_load4(b + i, br, bi);
+        const __m128 r = _mm_sub_ps(_mm_mul_ps(ar, br), _mm_mul_ps(ai, bi));
+        const __m128 m = _mm_add_ps(_mm_mul_ps(ar, bi), _mm_mul_ps(ai, br));
+        __complex_store4(out + i, r, m);
+    }
+    for (; i < n; ++i)
+        out[i] = a[i] * b[i];
+}
+
+inline void complex_norm(const complex<float>* a, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 re, im;
+        __complex_load4(a + i, re, im);
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im)));
+    }
+    for (; i < n; ++i)
+        out[i] = norm(a[i]);
+}
+
+inline void complex_deinterleave(const complex<float>* in, float* re, float* im, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 r, m;
+        __complex_load4(in + i, r, m);
+        _mm_storeu_ps(re + i, r);
+        _mm_storeu_ps(im + i, m);
+    }
+    for (; i < n; ++i) {
+        re[i] = in[i].real();
+        im[i] = in[i].imag();
+    }
+}
+
+inline void complex_interleave(const float* re, const float* im, complex<float>* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        __complex_store4(out + i, _mm_loadu_ps(re + i), _mm_loadu_ps(im + i));
+    for (; i < n; ++i)
+        out[i] = complex<float>(re[i], im[i]);
+}
+
+#endif // __SSE2__
+
+
+// vector front ends, out is resized to match the inputs
+template <typename T, typename Alloc>
+void complex_multiply(const vector<complex<T>, Alloc>& a, const vector<complex<T>, Alloc>& b,
+                      vector<complex<T>, Alloc>& out) {
+    const size_t n = MYSTL::min(a.size(), b.size());
+    out.resize(n);
+    complex_multiply(a.data(), b.data(), out.data(), n);
+}
+
+template <typename T, typename Alloc1, typename Alloc2>
+void complex_norm(const vector<complex<T>, Alloc1>& a, vector<T, Alloc2>& out) {
+    out.resize(a.size());
+    complex_norm(a.data(), out.data(), a.size());
+}
+
+template <typename T, typename Alloc1, typename Alloc2>
+void complex_deinterleave(const vector<complex<T>, Alloc1>& in,
+                          vector<T, Alloc2>& re, vector<T, Alloc2>& im) {
+    re.resize(in.size());
+    im.resize(in.size());
+    complex_deinterleave(in.data(), re.data(), im.data(), in.size());
+}
+
+template <typename T, typename Alloc1, typename Alloc2>
+void complex_interleave(const vector<T, Alloc1>& re, const vector<T, Alloc1>& im,
+                        vector<complex<T>, Alloc2>& out) {
+    const size_t n = MYSTL::min(re.size(), im.size());
+    out.resize(n);
+    complex_interleave(re.data(), im.data(), out.data(), n);
+}
+
+
+} // namespace MYSTL
+
 
-#endif
\ No newline at end of file
+#endif
@@ -42,7 +42,7 @@ inline void __destroy_n_aux(ForwardIterator first, ForwardIterator last, std::tr
 template <typename ForwardIterator>
 inline void __destroy_n_aux(ForwardIterator first, ForwardIterator last, std::false_type) {
     for (; first != last; ++first)
-        destroy(&*first);
+        __destroy_aux(&*first, std::false_type{});
 }
 
 
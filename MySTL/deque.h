@@ -0,0 +1,761 @@
+#ifndef DEQUE_H_
+#define DEQUE_H_
+
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include "memory.h"
+#include "utility.h"
+#include "iterator.h"
+#include "allocator.h"
+#include "algobase.h"
+#include "uninitialized.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// deque
+// elements live in fixed-size blocks; a map (array of block pointers) keeps the blocks
+// in order and leaves free slots on both sides, so push/pop at either end is O(1).
+// blocks freed by pop_front/pop_back are kept on a small free list and handed out again,
+// so a steady-state FIFO (push_back + pop_front) stops allocating once it is warm.
+/*****************************************************************************************/
+
+// elements per block: about 4 KiB, at least 16 elements for large types
+template <typename T>
+struct deque_buf_size {
+    static constexpr size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+};
+
+
+template <typename T, typename Ref, typename Ptr>
+struct deque_iterator
+    :public MYSTL::iterator<MYSTL::random_access_iterator_tag, T>
+{
+    using iterator          = deque_iterator<T, T&, T*>;
+    using const_iterator    = deque_iterator<T, const T&, const T*>;
+    using self              = deque_iterator;
+
+    using iterator_category = MYSTL::random_access_iterator_tag;
+    using value_type        = T;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    using value_pointer     = T*;
+    using map_pointer       = T**;
+
+    static constexpr size_type buffer_size = deque_buf_size<T>::value;
+
+    value_pointer cur;    // current element
+    value_pointer first;  // begin of the current block
+    value_pointer last;   // end of the current block
+    map_pointer   node;   // slot of the current block in the map
+
+    deque_iterator() noexcept : cur(nullptr), first(nullptr), last(nullptr), node(nullptr) {}
+    deque_iterator(value_pointer v, map_pointer n)
+        : cur(v), first(*n), last(*n + buffer_size), node(n) {}
+    // iterator -> const_iterator; a template, so the implicit copy operations stay
+    template <typename R, typename P, typename = typename std::enable_if<
+              std::is_same<R, T&>::value && !std::is_same<R, Ref>::value>::type>
+    deque_iterator(const deque_iterator<T, R, P>& rhs)
+        : cur(rhs.cur), first(rhs.first), last(rhs.last), node(rhs.node) {}
+
+    void set_node(map_pointer new_node) {
+        node = new_node;
+        first = *new_node;
+        last = first + buffer_size;
+    }
+
+    reference operator*()  const { return *cur; }
+    pointer   operator->() const { return cur; }
+
+    difference_type operator-(const self& rhs) const {
+        return static_cast<difference_type>(buffer_size) * (node - rhs.node - 1)
+               + (cur - first) + (rhs.last - rhs.cur);
+    }
+
+    self& operator++() {
+        ++cur;
+        if (cur == last) {
+            set_node(node + 1);
+            cur = first;
+        }
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self& operator--() {
+        if (cur == first) {
+            set_node(node - 1);
+            cur = last;
+        }
+        --cur;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) {
+        const difference_type bs = static_cast<difference_type>(buffer_size);
+        const difference_type offset = n + (cur - first);
+        if (offset >= 0 && offset < bs) {
+            cur += n;
+        }
+        else {
+            const difference_type node_offset =
+                offset > 0 ? offset / bs : -((-offset - 1) / bs) - 1;
+            set_node(node + node_offset);
+            cur = first + (offset - node_offset * bs);
+        }
+        return *this;
+    }
+    self operator+(difference_type n) const {
+        self tmp = *this;
+        return tmp += n;
+    }
+    self& operator-=(difference_type n) { return *this += -n; }
+    self operator-(difference_type n) const {
+        self tmp = *this;
+        return tmp -= n;
+    }
+
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    bool operator==(const self& rhs) const { return cur == rhs.cur; }
+    bool operator!=(const self& rhs) const { return cur != rhs.cur; }
+    bool operator<(const self& rhs) const {
+        return node == rhs.node ? cur < rhs.cur : node < rhs.node;
+    }
+    bool operator>(const self& rhs)  const { return rhs < *this; }
+    bool operator<=(const self& rhs) const { return !(rhs < *this); }
+    bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+
+template <typename T, typename Alloc = MYSTL::allocator<T>>
+class deque : private __allocator_holder<Alloc> {
+    using alloc_base = __allocator_holder<Alloc>;
+    // the map is allocated with a copy of the block allocator rebound to T*
+    using map_allocator = __rebind_alloc<Alloc, T*>;
+
+public:
+    using allocator_type         = Alloc;
+
+    using value_type             = T;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+
+    using iterator               = deque_iterator<T, T&, T*>;
+    using const_iterator         = deque_iterator<T, const T&, const T*>;
+    using reverse_iterator       = MYSTL::reverse_iterator<iterator>;
+    using const_reverse_iterator = MYSTL::reverse_iterator<const_iterator>;
+
+    static constexpr size_type buffer_size = deque_buf_size<T>::value;
+
+protected:
+    using map_pointer            = T**;
+
+    static constexpr size_type initial_map_size = 8;
+    // blocks kept for reuse instead of being returned to the allocator
+    static constexpr size_type max_spare_blocks = 2;
+
+    iterator    start;
+    iterator    finish;
+    map_pointer map_;
+    size_type   map_size_;
+    pointer     spare_;        // free blocks, linked through their first bytes
+    size_type   spare_count_;
+
+public:
+    //ctors:
+    deque() { create_map_and_nodes(0); }
+    explicit deque(const allocator_type& a) : alloc_base(a) { create_map_and_nodes(0); }
+    explicit deque(size_type n) { fill_initialize(n, value_type()); }
+    deque(size_type n, const value_type& value) { fill_initialize(n, value); }
+
+    template <typename InputIterator, typename = typename
+      std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    deque(InputIterator first, InputIterator last) {
+        create_map_and_nodes(0);
+        try {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+        catch(...) {
+            release_all();
+            throw;
+        }
+    }
+
+    deque(std::initializer_list<value_type> ilist) : deque(ilist.begin(), ilist.end()) {}
+
+    deque(const deque& rhs) : alloc_base(__select_on_copy(rhs.alloc())) {
+        create_map_and_nodes(rhs.size());
+        try {
+            MYSTL::uninitialized_copy(rhs.begin(), rhs.end(), start);
+        }
+        catch(...) {
+            destroy_nodes(start.node, finish.node + 1);
+            release_spare();
+            deallocate_map(map_, map_size_);
+            throw;
+        }
+    }
+
+    // leaves rhs empty but usable
+    deque(deque&& rhs) : alloc_base(rhs.alloc()) {
+        create_map_and_nodes(0);
+        swap(rhs);
+    }
+
+    deque& operator=(const deque& rhs) {
+        if (this != &rhs)
+            assign(rhs.begin(), rhs.end());
+        return *this;
+    }
+
+    deque& operator=(deque&& rhs) {
+        if (this != &rhs) {
+            clear();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    deque& operator=(std::initializer_list<value_type> ilist) {
+        assign(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~deque() { release_all(); }
+
+    allocator_type get_allocator() const { return this->alloc(); }
+
+public:
+    //iterators
+    iterator        begin()       { return start; }
+    const_iterator  begin() const { return start; }
+    iterator        end()         { return finish; }
+    const_iterator  end()   const { return finish; }
+
+    reverse_iterator       rbegin()        { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const { return begin(); }
+    const_iterator         cend()    const { return end(); }
+    const_reverse_iterator crbegin() const { return rbegin(); }
+    const_reverse_iterator crend()   const { return rend(); }
+
+    //capacity
+    size_type size()     const { return static_cast<size_type>(finish - start); }
+    size_type max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
+    bool      empty()    const { return start == finish; }
+
+    // returns the cached spare blocks to the allocator; the map keeps its size
+    void shrink_to_fit() { release_spare(); }
+
+    //element access
+    reference       operator[](size_type n)       { return start[static_cast<difference_type>(n)]; }
+    const_reference operator[](size_type n) const { return start[static_cast<difference_type>(n)]; }
+    reference at(size_type n) {
+        if (n >= size())
+            throw std::out_of_range("deque::at");
+        return (*this)[n];
+    }
+    const_reference at(size_type n) const {
+        if (n >= size())
+            throw std::out_of_range("deque::at");
+        return (*this)[n];
+    }
+    reference       front()       { return *start; }
+    const_reference front() const { return *start; }
+    reference       back()        { return *(finish - 1); }
+    const_reference back()  const { return *(finish - 1); }
+
+    //modifiers
+    void assign(size_type n, const value_type& value) {
+        if (n > size()) {
+            MYSTL::fill(begin(), end(), value);
+            insert(end(), n - size(), value);
+        }
+        else {
+            erase(begin() + n, end());
+            MYSTL::fill(begin(), end(), value);
+        }
+    }
+
+    template <typename InputIterator, typename = typename
+      std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void assign(InputIterator first, InputIterator last) {
+        auto cur = begin();
+        for (; first != last && cur != end(); ++first, ++cur)
+            *cur = *first;
+        if (first == last)
+            erase(cur, end());
+        else
+            insert(end(), first, last);
+    }
+
+    void assign(std::initializer_list<value_type> ilist) { assign(ilist.begin(), ilist.end()); }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        if (finish.cur != finish.last - 1) {
+            MYSTL::construct(finish.cur, MYSTL::forward<Args>(args)...);
+            ++finish.cur;
+        }
+        else {
+            reserve_map_at_back();
+            *(finish.node + 1) = allocate_node();
+            try {
+                MYSTL::construct(finish.cur, MYSTL::forward<Args>(args)...);
+            }
+            catch(...) {
+                deallocate_node(*(finish.node + 1));
+                throw;
+            }
+            finish.set_node(finish.node + 1);
+            finish.cur = finish.first;
+        }
+    }
+
+    template <typename... Args>
+    void emplace_front(Args&&... args) {
+        if (start.cur != start.first) {
+            MYSTL::construct(start.cur - 1, MYSTL::forward<Args>(args)...);
+            --start.cur;
+        }
+        else {
+            reserve_map_at_front();
+            *(start.node - 1) = allocate_node();
+            try {
+                MYSTL::construct(*(start.node - 1) + (buffer_size - 1), MYSTL::forward<Args>(args)...);
+            }
+            catch(...) {
+                deallocate_node(*(start.node - 1));
+                throw;
+            }
+            start.set_node(start.node - 1);
+            start.cur = start.last - 1;
+        }
+    }
+
+    void push_back(const value_type& value)  { emplace_back(value); }
+    void push_back(value_type&& value)       { emplace_back(MYSTL::move(value)); }
+    void push_front(const value_type& value) { emplace_front(value); }
+    void push_front(value_type&& value)      { emplace_front(MYSTL::move(value)); }
+
+    void pop_back() {
+        if (finish.cur != finish.first) {
+            --finish.cur;
+            MYSTL::destroy(finish.cur);
+        }
+        else {
+            deallocate_node(finish.first);
+            finish.set_node(finish.node - 1);
+            finish.cur = finish.last - 1;
+            MYSTL::destroy(finish.cur);
+        }
+    }
+
+    void pop_front() {
+        MYSTL::destroy(start.cur);
+        if (start.cur != start.last - 1) {
+            ++start.cur;
+        }
+        else {
+            deallocate_node(start.first);
+            start.set_node(start.node + 1);
+            start.cur = start.first;
+        }
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator position, Args&&... args);
+
+    iterator insert(const_iterator position, const value_type& value) { return emplace(position, value); }
+    iterator insert(const_iterator position, value_type&& value) { return emplace(position, MYSTL::move(value)); }
+    iterator insert(const_iterator position, size_type n, const value_type& value);
+    iterator insert(const_iterator position, std::initializer_list<value_type> ilist) {
+        return insert(position, ilist.begin(), ilist.end());
+    }
+
+    template <typename InputIterator, typename = typename
+      std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    iterator insert(const_iterator position, InputIterator first, InputIterator last) {
+        return insert_range(position, first, last, MYSTL::iterator_category(first));
+    }
+
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator first, const_iterator last);
+    void     clear();
+
+    void resize(size_type new_size) { resize(new_size, value_type()); }
+    void resize(size_type new_size, const value_type& value) {
+        const size_type len = size();
+        if (new_size < len)
+            erase(begin() + new_size, end());
+        else
+            insert(end(), new_size - len, value);
+    }
+
+    void swap(deque& rhs) noexcept {
+        MYSTL::swap(start, rhs.start);
+        MYSTL::swap(finish, rhs.finish);
+        MYSTL::swap(map_, rhs.map_);
+        MYSTL::swap(map_size_, rhs.map_size_);
+        MYSTL::swap(spare_, rhs.spare_);
+        MYSTL::swap(spare_count_, rhs.spare_count_);
+        MYSTL::swap(this->alloc(), rhs.alloc());
+    }
+
+protected:
+    //helpers
+
+    map_pointer allocate_map(size_type n) { return map_allocator(this->alloc()).allocate(n); }
+    void deallocate_map(map_pointer p, size_type n) noexcept { map_allocator(this->alloc()).deallocate(p, n); }
+
+    pointer allocate_node() {
+        if (spare_ != nullptr) {
+            pointer p = spare_;
+            spare_ = *reinterpret_cast<pointer*>(p);
+            --spare_count_;
+            return p;
+        }
+        return this->alloc().allocate(buffer_size);
+    }
+
+    void deallocate_node(pointer p) noexcept {
+        if (spare_count_ < max_spare_blocks) {
+            *reinterpret_cast<pointer*>(p) = spare_;
+            spare_ = p;
+            ++spare_count_;
+        }
+        else {
+            this->alloc().deallocate(p, buffer_size);
+        }
+    }
+
+    void release_spare() noexcept {
+        while (spare_ != nullptr) {
+            pointer next = *reinterpret_cast<pointer*>(spare_);
+            this->alloc().deallocate(spare_, buffer_size);
+            spare_ = next;
+        }
+        spare_count_ = 0;
+    }
+
+    void create_nodes(map_pointer nstart, map_pointer nfinish) {
+        map_pointer cur = nstart;
+        try {
+            for (; cur < nfinish; ++cur)
+                *cur = allocate_node();
+        }
+        catch(...) {
+            destroy_nodes(nstart, cur);
+            throw;
+        }
+    }
+
+    void destroy_nodes(map_pointer nstart, map_pointer nfinish) noexcept {
+        for (map_pointer n = nstart; n < nfinish; ++n)
+            deallocate_node(*n);
+    }
+
+    void create_map_and_nodes(size_type num_elements) {
+        spare_ = nullptr;
+        spare_count_ = 0;
+        const size_type num_nodes = num_elements / buffer_size + 1;
+        map_size_ = MYSTL::max(static_cast<size_type>(initial_map_size), num_nodes + 2);
+        map_ = allocate_map(map_size_);
+
+        map_pointer nstart = map_ + (map_size_ - num_nodes) / 2;
+        map_pointer nfinish = nstart + num_nodes - 1;
+        try {
+            create_nodes(nstart, nfinish + 1);
+        }
+        catch(...) {
+            deallocate_map(map_, map_size_);
+            map_ = nullptr;
+            map_size_ = 0;
+            throw;
+        }
+        start.set_node(nstart);
+        finish.set_node(nfinish);
+        start.cur = start.first;
+        finish.cur = finish.first + num_elements % buffer_size;
+    }
+
+    void fill_initialize(size_type n, const value_type& value) {
+        create_map_and_nodes(n);
+        try {
+            MYSTL::uninitialized_fill(start, finish, value);
+        }
+        catch(...) {
+            destroy_nodes(start.node, finish.node + 1);
+            release_spare();
+            deallocate_map(map_, map_size_);
+            throw;
+        }
+    }
+
+    void release_all() noexcept {
+        if (map_ == nullptr)  return;
+        MYSTL::destroy(start, finish);
+        destroy_nodes(start.node, finish.node + 1);
+        release_spare();
+        deallocate_map(map_, map_size_);
+        map_ = nullptr;
+    }
+
+    void reserve_map_at_back(size_type nodes_to_add = 1) {
+        if (nodes_to_add + 1 > map_size_ - static_cast<size_type>(finish.node - map_))
+            reallocate_map(nodes_to_add, false);
+    }
+
+    void reserve_map_at_front(size_type nodes_to_add = 1) {
+        if (nodes_to_add > static_cast<size_type>(start.node - map_))
+            reallocate_map(nodes_to_add, true);
+    }
+
+    // recentre the used slots if the map is less than half full, otherwise grow it
+    void reallocate_map(size_type nodes_to_add, bool add_at_front) {
+        const size_type old_num_nodes = finish.node - start.node + 1;
+        const size_type new_num_nodes = old_num_nodes + nodes_to_add;
+
+        map_pointer new_nstart;
+        if (map_size_ > 2 * new_num_nodes) {
+            new_nstart = map_ + (map_size_ - new_num_nodes) / 2
+                       + (add_at_front ? nodes_to_add : 0);
+            if (new_nstart < start.node)
+                MYSTL::copy(start.node, finish.node + 1, new_nstart);
+            else
+                MYSTL::copy_backward(start.node, finish.node + 1, new_nstart + old_num_nodes);
+        }
+        else {
+            const size_type new_map_size = map_size_ + MYSTL::max(map_size_, nodes_to_add) + 2;
+            map_pointer new_map = allocate_map(new_map_size);
+            new_nstart = new_map + (new_map_size - new_num_nodes) / 2
+                       + (add_at_front ? nodes_to_add : 0);
+            MYSTL::copy(start.node, finish.node + 1, new_nstart);
+            deallocate_map(map_, map_size_);
+            map_ = new_map;
+            map_size_ = new_map_size;
+        }
+        start.set_node(new_nstart);
+        finish.set_node(new_nstart + old_num_nodes - 1);
+    }
+
+    // opens n slots at position, filled with *src (single) or src[0, n); only the
+    // elements on the shorter side of position move
+    template <typename ForwardIterator>
+    iterator insert_n_aux(const_iterator position, size_type n, ForwardIterator src, bool single);
+
+    template <typename InputIterator>
+    iterator insert_range(const_iterator position, InputIterator first, InputIterator last,
+                          MYSTL::input_iterator_tag) {
+        const difference_type index = position - cbegin();
+        for (difference_type i = index; first != last; ++first, ++i)
+            emplace(cbegin() + i, *first);
+        return begin() + index;
+    }
+
+    template <typename ForwardIterator>
+    iterator insert_range(const_iterator position, ForwardIterator first, ForwardIterator last,
+                          MYSTL::forward_iterator_tag) {
+        const size_type n = MYSTL::distance(first, last);
+        return insert_n_aux(position, n, first, false);
+    }
+};
+
+/***********************************************************************/
+
+template <typename T, typename Alloc>
+template <typename... Args>
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::emplace(const_iterator position, Args&&... args) {
+    if (position.cur == start.cur) {
+        emplace_front(MYSTL::forward<Args>(args)...);
+        return start;
+    }
+    if (position.cur == finish.cur) {
+        emplace_back(MYSTL::forward<Args>(args)...);
+        return finish - 1;
+    }
+
+    value_type value_copy(MYSTL::forward<Args>(args)...);
+    const difference_type index = position - cbegin();
+    if (static_cast<size_type>(index) < size() / 2) {
+        emplace_front(MYSTL::move(front()));
+        iterator pos = start + index + 1;
+        MYSTL::move(start + 2, pos, start + 1);
+        *(pos - 1) = MYSTL::move(value_copy);
+        return pos - 1;
+    }
+    else {
+        emplace_back(MYSTL::move(back()));
+        iterator pos = start + index;
+        MYSTL::move_backward(pos, finish - 2, finish - 1);
+        *pos = MYSTL::move(value_copy);
+        return pos;
+    }
+}
+
+template <typename T, typename Alloc>
+template <typename ForwardIterator>
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::insert_n_aux(const_iterator position, size_type n, ForwardIterator src, bool single) {
+    const difference_type index = position - cbegin();
+    if (n == 0)
+        return begin() + index;
+
+    const difference_type count = static_cast<difference_type>(n);
+    if (static_cast<size_type>(index) < size() / 2) {
+        // grow by n at the front (the values are placeholders), shift the leading
+        // elements left and overwrite the gap
+        for (size_type i = 0; i < n; ++i)
+            emplace_front(*src);
+        MYSTL::move(start + count, start + count + index, start);
+        auto out = start + index;
+        if (single) {
+            MYSTL::fill(out, out + count, *src);
+        }
+        else {
+            for (auto it = src; out != start + index + count; ++it, ++out)
+                *out = *it;
+        }
+    }
+    else {
+        const difference_type after = static_cast<difference_type>(size()) - index;
+        for (size_type i = 0; i < n; ++i)
+            emplace_back(*src);
+        MYSTL::move_backward(start + index, start + index + after, finish);
+        auto out = start + index;
+        if (single) {
+            MYSTL::fill(out, out + count, *src);
+        }
+        else {
+            for (auto it = src; out != start + index + count; ++it, ++out)
+                *out = *it;
+        }
+    }
+    return begin() + index;
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::insert(const_iterator position, size_type n, const value_type& value) {
+    value_type value_copy(value);
+    return insert_n_aux(position, n, &value_copy, true);
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::erase(const_iterator position) {
+    iterator pos(start + (position - cbegin()));
+    const difference_type index = pos - start;
+    if (static_cast<size_type>(index) < size() / 2) {
+        MYSTL::move_backward(start, pos, pos + 1);
+        pop_front();
+    }
+    else {
+        MYSTL::move(pos + 1, finish, pos);
+        pop_back();
+    }
+    return start + index;
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator
+deque<T, Alloc>::erase(const_iterator first, const_iterator last) {
+    if (first == cbegin() && last == cend()) {
+        clear();
+        return finish;
+    }
+    const difference_type n = last - first;
+    const difference_type elems_before = first - cbegin();
+    iterator f(start + elems_before);
+    iterator l(f + n);
+    if (n == 0)
+        return f;
+
+    if (static_cast<size_type>(elems_before) < (size() - n) / 2) {
+        MYSTL::move_backward(start, f, l);
+        iterator new_start = start + n;
+        MYSTL::destroy(start, new_start);
+        destroy_nodes(start.node, new_start.node);
+        start = new_start;
+    }
+    else {
+        MYSTL::move(l, finish, f);
+        iterator new_finish = finish - n;
+        MYSTL::destroy(new_finish, finish);
+        destroy_nodes(new_finish.node + 1, finish.node + 1);
+        finish = new_finish;
+    }
+    return start + elems_before;
+}
+
+// keeps the first block, the others go to the spare list or the allocator
+template <typename T, typename Alloc>
+void deque<T, Alloc>::clear() {
+    MYSTL::destroy(start, finish);
+    destroy_nodes(start.node + 1, finish.node + 1);
+    finish = start;
+}
+
+/***********************************************************************/
+template <typename T, typename Alloc>
+void swap(deque<T, Alloc>& lhs, deque<T, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+template <typename T, typename Alloc>
+bool operator==(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && MYSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename Alloc>
+bool operator!=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc>
+bool operator<(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return MYSTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename Alloc>
+bool operator>(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, typename Alloc>
+bool operator<=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, typename Alloc>
+bool operator>=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+
+} //end of namespace MYSTL
+
+#endif
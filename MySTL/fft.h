@@ -0,0 +1,392 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+#include "complex.h"
+#include "vector.h"
+#include "memory.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// fft_plan
+// precomputes everything that depends only on the size and the direction, so one plan
+// can be executed on many buffers of that size.
+//   power of two : in-place iterative radix-2 (bit reversal + butterflies). Small stages
+//                  are run block by block so each block stays in L1 for all of them.
+//   otherwise    : Stockham autosort over the factors of n (radix 4, 2, 3, 5, then any
+//                  remaining prime), ping-ponging between the data and a scratch buffer.
+//   a prime factor of bluestein_min_prime or more: Bluestein's algorithm, the transform
+//                  as a convolution with a chirp done by a power of two plan of at least
+//                  2n - 1 points, so a large prime n costs O(n log n) instead of O(n^2).
+// the inverse transform is not normalized, divide by size() if needed.
+/*****************************************************************************************/
+
+template <typename T>
+class fft_plan
+{
+public:
+    using value_type   = T;
+    using complex_type = MYSTL::complex<T>;
+    using size_type    = size_t;
+
+    // bytes of data processed per block in the radix-2 path
+    static constexpr size_type cache_block_bytes = 32 * 1024;
+    // the generic radix butterfly costs O(r) per output, Bluestein takes over from here
+    static constexpr size_type bluestein_min_prime = 64;
+
+protected:
+    size_type n_;
+    bool inverse_;
+    bool pow2_;
+    vector<complex_type> twiddles_;   // pow2: per stage twiddles, otherwise W_n^k
+    vector<size_type> bitrev_;        // pow2 only
+    vector<size_type> factors_;       // mixed radix only
+    vector<complex_type> scratch_;    // mixed radix only
+    vector<complex_type> radix_buf_;  // generic radix butterfly inputs
+    vector<complex_type> chirp_;      // Bluestein only: W^(k^2 / 2)
+    vector<complex_type> chirp_fft_;  // Bluestein only: padded transform of conj(chirp_), over m
+    shared_ptr<const fft_plan> pow2_plan_;  // Bluestein only: forward plan of m points, stateless
+
+public:
+    explicit fft_plan(size_type n, bool inverse = false)
+        : n_(n), inverse_(inverse), pow2_(n != 0 && (n & (n - 1)) == 0) {
+        if (n_ < 2)  return;
+        if (pow2_)
+            init_radix2();
+        else
+            init_mixed_radix();
+    }
+
+    size_type size()       const { return n_; }
+    bool      is_inverse() const { return inverse_; }
+
+    // in-place transform of n = size() values
+    void execute(complex_type* data) {
+        if (n_ < 2)  return;
+        if (pow2_)
+            execute_radix2(data);
+        else if (pow2_plan_)
+            execute_bluestein(data);
+        else
+            execute_mixed_radix(data);
+    }
+
+    template <typename Alloc>
+    void execute(vector<complex_type, Alloc>& data) {
+        if (data.size() != n_)
+            throw std::invalid_argument("fft_plan::execute: data size differs from the plan size");
+        execute(data.data());
+    }
+
+protected:
+    // W^k for the plan direction, computed in double for accuracy
+    complex_type root(size_type k, size_type n) const {
+        const double pi = 3.14159265358979323846;
+        const double theta = (inverse_ ? 2.0 : -2.0) * pi * static_cast<double>(k) / static_cast<double>(n);
+        return complex_type(static_cast<T>(std::cos(theta)), static_cast<T>(std::sin(theta)));
+    }
+
+    /*************************************************************************************/
+    // radix-2
+
+    // stage with half-length h uses twiddles_[h - 1 + k], k in [0, h)
+    void init_radix2() {
+        twiddles_.resize(n_ - 1);
+        for (size_type h = 1; h < n_; h <<= 1) {
+            for (size_type k = 0; k < h; ++k)
+                twiddles_[h - 1 + k] = root(k, 2 * h);
+        }
+
+        size_type log_n = 0;
+        while ((size_type(1) << log_n) < n_)  ++log_n;
+        bitrev_.resize(n_);
+        for (size_type i = 0; i < n_; ++i) {
+            size_type r = 0;
+            for (size_type b = 0; b < log_n; ++b)
+                r |= ((i >> b) & 1) << (log_n - 1 - b);
+            bitrev_[i] = r;
+        }
+    }
+
+    // butterflies for half-lengths in [first_half, last_half] over data[0, len)
+    void radix2_stages(complex_type* data, size_type len,
+                       size_type first_half, size_type last_half) const {
+        const complex_type* tw = twiddles_.data();
+        for (size_type h = first_half; h <= last_half; h <<= 1) {
+            const complex_type* w = tw + h - 1;
+            for (size_type i = 0; i < len; i += 2 * h) {
+                complex_type* lo = data + i;
+                complex_type* hi = lo + h;
+                for (size_type k = 0; k < h; ++k) {
+                    const complex_type t = hi[k] * w[k];
+                    hi[k] = lo[k] - t;
+                    lo[k] += t;
+                }
+            }
+        }
+    }
+
+    void execute_radix2(complex_type* data) const {
+        for (size_type i = 0; i < n_; ++i) {
+            const size_type j = bitrev_[i];
+            if (i < j)
+                MYSTL::swap(data[i], data[j]);
+        }
+
+        size_type block = 2;
+        while (block * 2 * sizeof(complex_type) <= cache_block_bytes)  block <<= 1;
+
+        if (n_ <= block) {
+            radix2_stages(data, n_, 1, n_ / 2);
+            return;
+        }
+        // every stage with 2h <= block only touches one block at a time
+        for (size_type b = 0; b < n_; b += block)
+            radix2_stages(data + b, block, 1, block / 2);
+        radix2_stages(data, n_, block, n_ / 2);
+    }
+
+    /*************************************************************************************/
+    // mixed radix
+
+    void init_mixed_radix() {
+        size_type m = n_;
+        while (m % 4 == 0) { factors_.push_back(4); m /= 4; }
+        while (m % 2 == 0) { factors_.push_back(2); m /= 2; }
+        for (size_type p = 3; p * p <= m; p += 2) {
+            while (m % p == 0) { factors_.push_back(p); m /= p; }
+        }
+        if (m > 1)
+            factors_.push_back(m);
+
+        size_type max_radix = 0;
+        for (size_type i = 0; i < factors_.size(); ++i)
+            max_radix = MYSTL::max(max_radix, factors_[i]);
+        if (max_radix >= bluestein_min_prime) {
+            factors_.clear();
+            init_bluestein();
+            return;
+        }
+
+        twiddles_.resize(n_);
+        for (size_type k = 0; k < n_; ++k)
+            twiddles_[k] = root(k, n_);
+        scratch_.resize(n_);
+        radix_buf_.resize(max_radix);
+    }
+
+    // one Stockham stage: sub-transforms of length len = r * m at stride s
+    void stockham_stage(const complex_type* x, complex_type* y,
+                        size_type r, size_type m, size_type s) {
+        const complex_type* w = twiddles_.data();
+        const size_type wr = n_ / r;  // W_r^j = W_n^(j * n / r)
+
+        for (size_type p = 0; p < m; ++p) {
+            for (size_type q = 0; q < s; ++q) {
+                const complex_type* in = x + q + s * p;
+                complex_type* out = y + q + s * r * p;
+                const size_type sm = s * m;
+
+                if (r == 2) {
+                    const complex_type a = in[0], b = in[sm];
+                    out[0] = a + b;
+                    out[s] = (a - b) * w[s * p];
+                }
+                else if (r == 4) {
+                    const complex_type a0 = in[0], a1 = in[sm], a2 = in[2 * sm], a3 = in[3 * sm];
+                    const complex_type t0 = a0 + a2, t1 = a0 - a2;
+                    const complex_type t2 = a1 + a3;
+                    // (a1 - a3) * W_4, W_4 = -i forward, +i inverse
+                    const complex_type d = a1 - a3;
+                    const complex_type t3 = inverse_ ? complex_type(-d.imag(), d.real())
+                                                     : complex_type(d.imag(), -d.real());
+                    out[0]     = t0 + t2;
+                    out[s]     = (t1 + t3) * w[s * p];
+                    out[2 * s] = (t0 - t2) * w[2 * s * p];
+                    out[3 * s] = (t1 - t3) * w[3 * s * p];
+                }
+                else {
+                    complex_type* a = radix_buf_.data();
+                    for (size_type j = 0; j < r; ++j)
+                        a[j] = in[j * sm];
+                    for (size_type k = 0; k < r; ++k) {
+                        complex_type sum = a[0];
+                        for (size_type j = 1; j < r; ++j)
+                            sum += a[j] * w[((j * k) % r) * wr];
+                        out[k * s] = sum * w[s * p * k];
+                    }
+                }
+            }
+        }
+    }
+
+    void execute_mixed_radix(complex_type* data) {
+        complex_type* x = data;
+        complex_type* y = scratch_.data();
+        size_type s = 1;
+        size_type len = n_;
+        for (size_type i = 0; i < factors_.size(); ++i) {
+            const size_type r = factors_[i];
+            len /= r;
+            stockham_stage(x, y, r, len, s);
+            s *= r;
+            MYSTL::swap(x, y);
+        }
+        if (x != data)
+            MYSTL::copy(x, x + n_, data);
+    }
+
+    /*************************************************************************************/
+    // Bluestein
+    // jk = (j^2 + k^2 - (k - j)^2) / 2 turns X[k] = sum x[j] W^(jk) into
+    // X[k] = c[k] * sum (x[j] c[j]) conj(c[k - j]) with c[k] = W^(k^2 / 2): a product with
+    // the chirp, a convolution, and another product. the convolution is cyclic over m
+    // points, with conj(c) wrapped around so negative k - j land at the end
+
+    void init_bluestein() {
+        size_type m = 1;
+        while (m < 2 * n_ - 1)  m <<= 1;
+        pow2_plan_ = make_shared<fft_plan>(m);
+
+        // k^2 modulo 2n keeps the angle small, W^(k^2 / 2) has period 2n in k^2
+        const double pi = 3.14159265358979323846;
+        chirp_.resize(n_);
+        for (size_type k = 0; k < n_; ++k) {
+            const size_type k2 = (k * k) % (2 * n_);
+            const double theta = (inverse_ ? 1.0 : -1.0) * pi * static_cast<double>(k2) / static_cast<double>(n_);
+            chirp_[k] = complex_type(static_cast<T>(std::cos(theta)), static_cast<T>(std::sin(theta)));
+        }
+
+        chirp_fft_.resize(m);
+        chirp_fft_[0] = MYSTL::conj(chirp_[0]);
+        for (size_type k = 1; k < n_; ++k)
+            chirp_fft_[k] = chirp_fft_[m - k] = MYSTL::conj(chirp_[k]);
+        pow2_plan_->execute_radix2(chirp_fft_.data());
+        // the 1 / m of the inverse transform, applied once here
+        for (size_type i = 0; i < m; ++i)
+            chirp_fft_[i] /= static_cast<T>(m);
+        scratch_.resize(m);
+    }
+
+    void execute_bluestein(complex_type* data) {
+        const size_type m = scratch_.size();
+        complex_type* a = scratch_.data();
+        for (size_type k = 0; k < n_; ++k)
+            a[k] = data[k] * chirp_[k];
+        MYSTL::fill(a + n_, a + m, complex_type());
+        pow2_plan_->execute_radix2(a);
+        // the inverse transform through the forward plan: conj(fft(conj(z)))
+        for (size_type i = 0; i < m; ++i)
+            a[i] = MYSTL::conj(a[i] * chirp_fft_[i]);
+        pow2_plan_->execute_radix2(a);
+        for (size_type k = 0; k < n_; ++k)
+            data[k] = MYSTL::conj(a[k]) * chirp_[k];
+    }
+};
+
+template <typename T>
+constexpr typename fft_plan<T>::size_type fft_plan<T>::cache_block_bytes;
+template <typename T>
+constexpr typename fft_plan<T>::size_type fft_plan<T>::bluestein_min_prime;
+
+
+/*****************************************************************************************/
+// rfft_plan
+// forward transform of n real values, producing the n / 2 + 1 non-redundant bins.
+// for even n the input is packed as n / 2 complex values (even samples real, odd
+// samples imag), transformed with a half-size plan and split afterwards.
+/*****************************************************************************************/
+
+template <typename T>
+class rfft_plan
+{
+public:
+    using value_type   = T;
+    using complex_type = MYSTL::complex<T>;
+    using size_type    = size_t;
+
+protected:
+    size_type n_;
+    fft_plan<T> plan_;                // n / 2 for even n, n otherwise
+    vector<complex_type> buf_;
+    vector<complex_type> twiddles_;   // W_n^k, k in [0, n / 2)
+
+public:
+    explicit rfft_plan(size_type n)
+        : n_(n), plan_(n % 2 == 0 ? n / 2 : n), buf_(plan_.size()) {
+        if (n_ % 2 == 0) {
+            const double pi = 3.14159265358979323846;
+            twiddles_.resize(n_ / 2);
+            for (size_type k = 0; k < n_ / 2; ++k) {
+                const double theta = -2.0 * pi * static_cast<double>(k) / static_cast<double>(n_);
+                twiddles_[k] = complex_type(static_cast<T>(std::cos(theta)), static_cast<T>(std::sin(theta)));
+            }
+        }
+    }
+
+    size_type size()        const { return n_; }
+    size_type output_size() const { return n_ / 2 + 1; }
+
+    // in[0, n) -> out[0, n / 2 + 1)
+    void execute(const T* in, complex_type* out) {
+        if (n_ == 0)  return;
+        if (n_ % 2 != 0) {
+            for (size_type i = 0; i < n_; ++i)
+                buf_[i] = complex_type(in[i]);
+            plan_.execute(buf_.data());
+            MYSTL::copy(buf_.data(), buf_.data() + output_size(), out);
+            return;
+        }
+
+        const size_type h = n_ / 2;
+        for (size_type i = 0; i < h; ++i)
+            buf_[i] = complex_type(in[2 * i], in[2 * i + 1]);
+        plan_.execute(buf_.data());
+
+        // X[k] = E[k] + W_n^k O[k], with E = (Z[k] + conj(Z[h-k])) / 2, O = (Z[k] - conj(Z[h-k])) / 2i
+        const complex_type* z = buf_.data();
+        out[0] = complex_type(z[0].real() + z[0].imag());
+        out[h] = complex_type(z[0].real() - z[0].imag());
+        for (size_type k = 1; k < h; ++k) {
+            const complex_type a = z[k];
+            const complex_type b = MYSTL::conj(z[h - k]);
+            const complex_type e = (a + b) * T(0.5);
+            const complex_type d = (a - b) * T(0.5);
+            const complex_type o(d.imag(), -d.real());  // d / i
+            out[k] = e + twiddles_[k] * o;
+        }
+    }
+
+    template <typename Alloc1, typename Alloc2>
+    void execute(const vector<T, Alloc1>& in, vector<complex_type, Alloc2>& out) {
+        if (in.size() != n_)
+            throw std::invalid_argument("rfft_plan::execute: input size differs from the plan size");
+        out.resize(output_size());
+        execute(in.data(), out.data());
+    }
+};
+
+
+// one-shot helpers, build a plan per call
+template <typename T, typename Alloc>
+void fft(vector<MYSTL::complex<T>, Alloc>& data) {
+    fft_plan<T> plan(data.size());
+    plan.execute(data.data());
+}
+
+template <typename T, typename Alloc>
+void ifft(vector<MYSTL::complex<T>, Alloc>& data) {
+    fft_plan<T> plan(data.size(), true);
+    plan.execute(data.data());
+}
+
+
+} // namespace MYSTL
+
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef FILE_ALLOCATOR_H_
+#define FILE_ALLOCATOR_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "memory.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// file_allocator
+// an allocator whose blocks are mmap'ed memory.
+//   file_allocator<T>()                  anonymous private mappings
+//   file_allocator<T>(path, header)      the block is the file itself, MAP_SHARED: the
+//                                        first header bytes are left to the owner, the
+//                                        elements follow. a file backs one block at a time
+// reallocate grows or shrinks a block with ftruncate + mremap, so the pages are never
+// copied; without mremap the file is mapped again (anonymous blocks are copied).
+// vector<T, file_allocator<T>> picks reallocate up for trivially copyable T.
+// copies of an allocator share the file; a copied container gets an anonymous one.
+/*****************************************************************************************/
+
+// the open file behind a file_allocator and its single mapping
+struct __mapped_file {
+    int    fd;
+    size_t header_bytes;
+    char*  base;          // mapping of [0, mapped_bytes) of the file, or nullptr
+    size_t mapped_bytes;
+
+    __mapped_file(int f, size_t header) noexcept : fd(f), header_bytes(header), base(nullptr), mapped_bytes(0) {}
+    __mapped_file(const __mapped_file&) = delete;
+    __mapped_file& operator=(const __mapped_file&) = delete;
+    ~__mapped_file() {
+        if (base != nullptr)
+            ::munmap(base, mapped_bytes);
+        ::close(fd);
+    }
+};
+
+template <typename T>
+class file_allocator {
+    static_assert(std::is_trivially_copyable<T>::value, "file_allocator needs trivially copyable elements");
+
+    template <typename U> friend class file_allocator;
+
+public:
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+
+    template <typename U>
+    struct rebind { using other = file_allocator<U>; };
+
+private:
+    shared_ptr<__mapped_file> file_;  // empty for anonymous mappings
+
+    static void fail(const char* what) { throw std::system_error(errno, std::generic_category(), what); }
+
+    static size_t page_size() { return static_cast<size_t>(::sysconf(_SC_PAGESIZE)); }
+
+    void resize_file(size_t bytes) const {
+        if (::ftruncate(file_->fd, static_cast<off_t>(bytes)) != 0)
+            fail("file_allocator: ftruncate");
+    }
+
+    // anonymous blocks: n elements of fresh zero pages
+    static T* map_anonymous(size_type n) {
+        void* p = ::mmap(nullptr, n * sizeof(T), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+
+    T* map_file(size_t bytes) const {
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file_->fd, 0);
+        if (p == MAP_FAILED)
+            fail("file_allocator: mmap");
+        file_->base = static_cast<char*>(p);
+        file_->mapped_bytes = bytes;
+        return reinterpret_cast<T*>(file_->base + file_->header_bytes);
+    }
+
+public:
+    file_allocator() noexcept = default;
+
+    // opens (or creates) path. header_bytes is rounded up to the alignment of T
+    explicit file_allocator(const char* path, size_t header_bytes = 0) {
+        const int fd = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0)
+            fail("file_allocator: open");
+        header_bytes = (header_bytes + alignof(T) - 1) / alignof(T) * alignof(T);
+        try {
+            file_ = MYSTL::make_shared<__mapped_file>(fd, header_bytes);
+        }
+        catch (...) {
+            ::close(fd);
+            throw;
+        }
+    }
+
+    template <typename U>
+    file_allocator(const file_allocator<U>& rhs) noexcept : file_(rhs.file_) {}
+
+    file_allocator select_on_container_copy_construction() const { return file_allocator(); }
+
+    bool is_file() const noexcept { return static_cast<bool>(file_); }
+
+    // the header bytes of the mapped file, nullptr while no block is allocated. the
+    // address changes when reallocate moves the mapping
+    void* header() const noexcept { return file_ && file_->base != nullptr ? file_->base : nullptr; }
+
+    // size of the file on disk and the elements that fit behind its header
+    size_t file_size() const {
+        if (!file_)
+            return 0;
+        struct stat st;
+        if (::fstat(file_->fd, &st) != 0)
+            fail("file_allocator: fstat");
+        return static_cast<size_t>(st.st_size);
+    }
+    size_type stored_capacity() const {
+        const size_t bytes = file_size();
+        return bytes <= header_bytes() ? 0 : (bytes - header_bytes()) / sizeof(T);
+    }
+    size_t header_bytes() const noexcept { return file_ ? file_->header_bytes : 0; }
+
+    // the file keeps its size and contents: allocating n over an existing file maps what
+    // it already holds, growing it if needed
+    T* allocate(size_type n) {
+        if (!file_)
+            return n == 0 ? nullptr : map_anonymous(n);
+        if (file_->base != nullptr)
+            throw std::logic_error("file_allocator: the file already backs a block");
+        const size_t bytes = file_->header_bytes + n * sizeof(T);
+        if (bytes == 0)
+            return nullptr;
+        if (file_size() < bytes)
+            resize_file(bytes);
+        return map_file(bytes);
+    }
+
+    void deallocate(T* p, size_type n) noexcept {
+        if (!file_) {
+            if (p != nullptr)
+                ::munmap(p, n * sizeof(T));
+            return;
+        }
+        if (file_->base != nullptr)
+            ::munmap(file_->base, file_->mapped_bytes);
+        file_->base = nullptr;
+        file_->mapped_bytes = 0;
+    }
+
+    // resizes the block to new_n elements keeping the first min(old_n, new_n). the file
+    // is cut to the new size when it shrinks
+    T* reallocate(T* p, size_type old_n, size_type new_n) {
+        if (p == nullptr || (file_ && file_->base == nullptr))
+            return allocate(new_n);
+        if (new_n == 0 && header_bytes() == 0) {
+            deallocate(p, old_n);
+            return nullptr;
+        }
+        if (!file_) {
+#ifdef MREMAP_MAYMOVE
+            void* q = ::mremap(p, old_n * sizeof(T), new_n * sizeof(T), MREMAP_MAYMOVE);
+            if (q == MAP_FAILED)
+                throw std::bad_alloc();
+            return static_cast<T*>(q);
+#else
+            T* q = map_anonymous(new_n);
+            std::memcpy(q, p, (old_n < new_n ? old_n : new_n) * sizeof(T));
+            deallocate(p, old_n);
+            return q;
+#endif
+        }
+        const size_t bytes = file_->header_bytes + new_n * sizeof(T);
+        if (bytes > file_->mapped_bytes)
+            resize_file(bytes);
+#ifdef MREMAP_MAYMOVE
+        void* q = ::mremap(file_->base, file_->mapped_bytes, bytes, MREMAP_MAYMOVE);
+        if (q == MAP_FAILED)
+            fail("file_allocator: mremap");
+        file_->base = static_cast<char*>(q);
+        file_->mapped_bytes = bytes;
+#else
+        // the pages belong to the file, mapping it again loses nothing
+        ::munmap(file_->base, file_->mapped_bytes);
+        file_->base = nullptr;
+        map_file(bytes);
+#endif
+        if (bytes < file_size())
+            resize_file(bytes);
+        return reinterpret_cast<T*>(file_->base + file_->header_bytes);
+    }
+
+    // writes the pages holding [addr, addr + bytes) of a file block back to disk; wait
+    // blocks until they are written (MS_SYNC), otherwise writeback is only scheduled
+    static void sync(const void* addr, size_t bytes, bool wait = true) {
+        if (addr == nullptr || bytes == 0)
+            return;
+        const uintptr_t page = page_size();
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(addr) & ~(page - 1);
+        const uintptr_t end = reinterpret_cast<uintptr_t>(addr) + bytes;
+        if (::msync(reinterpret_cast<void*>(begin), end - begin, wait ? MS_SYNC : MS_ASYNC) != 0)
+            fail("file_allocator: msync");
+    }
+
+    template <typename U>
+    bool operator==(const file_allocator<U>& rhs) const noexcept { return file_ == rhs.file_; }
+    template <typename U>
+    bool operator!=(const file_allocator<U>& rhs) const noexcept { return !(*this == rhs); }
+};
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef FLAT_HASH_MAP_H_
+#define FLAT_HASH_MAP_H_
+
+#include <stdexcept>
+#include "flat_hash_table.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// flat_hash_map
+// unordered map on flat_hash_table: elements live directly in the slot array, so there is
+// no allocation per element and a lookup touches the control bytes and one slot.
+// references and iterators are invalidated by any insert that rehashes.
+/*****************************************************************************************/
+
+// a slot is either view of the same pair; the mutable one lets a rehash move the key
+// instead of copying it
+template <typename Key, typename T>
+union __flat_map_slot {
+    __flat_map_slot() {}
+    ~__flat_map_slot() {}
+
+    MYSTL::pair<const Key, T> value;
+    MYSTL::pair<Key, T>       mutable_value;
+};
+
+template <typename Key, typename T>
+struct __flat_map_policy {
+    using key_type   = Key;
+    using value_type = MYSTL::pair<const Key, T>;
+    using slot_type  = __flat_map_slot<Key, T>;
+
+    static constexpr bool constant_iterators = false;
+
+    static value_type&     element(slot_type* slot)          { return slot->value; }
+    static const Key&      key(const slot_type* slot)        { return slot->value.first; }
+    static const Key&      key_of(const value_type& value)   { return value.first; }
+
+    template <typename... Args>
+    static void construct(slot_type* slot, Args&&... args) {
+        MYSTL::construct(&slot->value, MYSTL::forward<Args>(args)...);
+    }
+    static void destroy(slot_type* slot) { MYSTL::destroy(&slot->value); }
+    static void transfer(slot_type* dst, slot_type* src) {
+        MYSTL::construct(&dst->mutable_value, MYSTL::move(src->mutable_value));
+        MYSTL::destroy(&src->mutable_value);
+    }
+};
+
+
+template <typename Key, typename T, typename Hash = MYSTL::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Alloc = MYSTL::allocator<MYSTL::pair<const Key, T>>>
+class flat_hash_map
+    : public flat_hash_table<__flat_map_policy<Key, T>, Hash, KeyEqual, Alloc>
+{
+    using base = flat_hash_table<__flat_map_policy<Key, T>, Hash, KeyEqual, Alloc>;
+
+public:
+    using mapped_type = T;
+    using typename base::key_type;
+    using typename base::value_type;
+    using typename base::allocator_type;
+    using typename base::size_type;
+    using typename base::iterator;
+    using typename base::const_iterator;
+    template <typename K>
+    using key_arg = typename base::template key_arg<K>;
+
+    using base::base;
+    flat_hash_map() = default;
+    flat_hash_map(std::initializer_list<value_type> ilist, const allocator_type& a = allocator_type())
+        : base(a) { this->insert(ilist); }
+
+    template <typename InputIterator>
+    flat_hash_map(InputIterator first, InputIterator last, const allocator_type& a = allocator_type())
+        : base(a) { this->insert(first, last); }
+
+    // inserts a default value when the key is missing
+    template <typename K = key_type>
+    mapped_type& operator[](const key_arg<K>& key) {
+        return try_emplace(key).first->second;
+    }
+    mapped_type& operator[](key_type&& key) {
+        return try_emplace(MYSTL::move(key)).first->second;
+    }
+
+    template <typename K = key_type>
+    mapped_type& at(const key_arg<K>& key) {
+        auto it = this->find(key);
+        if (it == this->end())
+            throw std::out_of_range("flat_hash_map::at");
+        return it->second;
+    }
+    template <typename K = key_type>
+    const mapped_type& at(const key_arg<K>& key) const {
+        auto it = this->find(key);
+        if (it == this->end())
+            throw std::out_of_range("flat_hash_map::at");
+        return it->second;
+    }
+
+    // constructs the mapped value only when the key is missing, args are left alone otherwise
+    template <typename K = key_type, typename... Args>
+    MYSTL::pair<iterator, bool> try_emplace(const key_arg<K>& key, Args&&... args) {
+        auto res = this->find_or_prepare_insert(key);
+        if (res.second)
+            this->emplace_at(res.first, key_type(key), mapped_type(MYSTL::forward<Args>(args)...));
+        return MYSTL::pair<iterator, bool>(this->iterator_at(res.first), res.second);
+    }
+    template <typename... Args>
+    MYSTL::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        auto res = this->find_or_prepare_insert(key);
+        if (res.second)
+            this->emplace_at(res.first, MYSTL::move(key), mapped_type(MYSTL::forward<Args>(args)...));
+        return MYSTL::pair<iterator, bool>(this->iterator_at(res.first), res.second);
+    }
+
+    template <typename M>
+    MYSTL::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value) {
+        auto res = try_emplace(key, MYSTL::forward<M>(value));
+        if (!res.second)
+            res.first->second = MYSTL::forward<M>(value);
+        return res;
+    }
+};
+
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+void swap(flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+          flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef FLAT_HASH_SET_H_
+#define FLAT_HASH_SET_H_
+
+#include "flat_hash_table.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// flat_hash_set
+// unordered set on flat_hash_table, the keys live directly in the slot array.
+// iterators are constant, references and iterators are invalidated by a rehash.
+/*****************************************************************************************/
+
+template <typename T>
+struct __flat_set_policy {
+    using key_type   = T;
+    using value_type = T;
+    using slot_type  = T;
+
+    static constexpr bool constant_iterators = true;
+
+    static T&       element(slot_type* slot)     { return *slot; }
+    static const T& key(const slot_type* slot)   { return *slot; }
+    static const T& key_of(const value_type& v)  { return v; }
+
+    template <typename... Args>
+    static void construct(slot_type* slot, Args&&... args) {
+        MYSTL::construct(slot, MYSTL::forward<Args>(args)...);
+    }
+    static void destroy(slot_type* slot) { MYSTL::destroy(slot); }
+    static void transfer(slot_type* dst, slot_type* src) {
+        MYSTL::construct(dst, MYSTL::move(*src));
+        MYSTL::destroy(src);
+    }
+};
+
+
+template <typename T, typename Hash = MYSTL::hash<T>, typename KeyEqual = std::equal_to<T>,
+          typename Alloc = MYSTL::allocator<T>>
+class flat_hash_set
+    : public flat_hash_table<__flat_set_policy<T>, Hash, KeyEqual, Alloc>
+{
+    using base = flat_hash_table<__flat_set_policy<T>, Hash, KeyEqual, Alloc>;
+
+public:
+    using typename base::value_type;
+    using typename base::allocator_type;
+    using typename base::iterator;
+    using typename base::const_iterator;
+
+    using base::base;
+    flat_hash_set() = default;
+    flat_hash_set(std::initializer_list<value_type> ilist, const allocator_type& a = allocator_type())
+        : base(a) { this->insert(ilist); }
+
+    template <typename InputIterator>
+    flat_hash_set(InputIterator first, InputIterator last, const allocator_type& a = allocator_type())
+        : base(a) { this->insert(first, last); }
+};
+
+template <typename T, typename Hash, typename KeyEqual, typename Alloc>
+void swap(flat_hash_set<T, Hash, KeyEqual, Alloc>& lhs,
+          flat_hash_set<T, Hash, KeyEqual, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,722 @@
+#ifndef FLAT_HASH_TABLE_H_
+#define FLAT_HASH_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include "utility.h"
+#include "iterator.h"
+#include "allocator.h"
+#include "construct.h"
+#include "algobase.h"
+#include "hash.h"
+
+#if defined(__SSE2__) && !defined(MYSTL_FLAT_HASH_NO_SSE2)
+#include <emmintrin.h>
+#define MYSTL_FLAT_HASH_SSE2 1
+#endif
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// flat_hash_table
+// open addressing table in the Swiss-table style, the engine behind flat_hash_map and
+// flat_hash_set.
+// next to the slots is one control byte per slot:
+//   ctrl_empty    never used              ctrl_deleted  tombstone
+//   ctrl_sentinel end marker for iteration
+//   0..127        full, holds the low 7 bits (H2) of the element's hash
+// a lookup starts at a position from the high bits (H1) and compares H2 against a whole
+// group of control bytes at once (16 with SSE2, 8 with plain 64-bit arithmetic), so only
+// slots whose H2 matches are ever compared with the key. a group containing an empty
+// byte ends the probe.
+// slots and control bytes share one allocation. the first width-1 control bytes are
+// mirrored after the sentinel so a group load never wraps.
+// erase writes ctrl_empty instead of a tombstone whenever no probe can have passed the
+// slot, i.e. when the run of full bytes around it is shorter than a group.
+/*****************************************************************************************/
+
+using __ctrl_t = signed char;
+
+constexpr __ctrl_t ctrl_empty    = -128;  // 0b10000000
+constexpr __ctrl_t ctrl_deleted  = -2;    // 0b11111110
+constexpr __ctrl_t ctrl_sentinel = -1;    // 0b11111111
+
+inline bool __ctrl_is_full(__ctrl_t c)  { return c >= 0; }
+
+// a control block for tables without storage: begin() sees the sentinel, find() the empties
+inline __ctrl_t* __empty_group() {
+    alignas(16) static __ctrl_t group[16] = {
+        ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+        ctrl_empty,    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+        ctrl_empty,    ctrl_empty, ctrl_empty, ctrl_empty};
+    return group;
+}
+
+// spreads the bits of a weak hash (std::hash of an integer is the identity), skipped for
+// hashers that declare is_avalanching
+inline size_t __flat_hash_mix(size_t h) {
+#ifdef __SIZEOF_INT128__
+    const unsigned __int128 m = static_cast<unsigned __int128>(h) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(m) ^ static_cast<size_t>(m >> 64);
+#else
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+#endif
+}
+
+inline size_t   __flat_hash_h1(size_t hash) { return hash >> 7; }
+inline __ctrl_t __flat_hash_h2(size_t hash) { return static_cast<__ctrl_t>(hash & 0x7F); }
+
+
+// the set bits of a group match. with SSE2 every slot has one bit (Shift = 0),
+// the portable group uses the top bit of each byte (Shift = 3)
+template <size_t Width, int Shift>
+class __hash_bitmask {
+public:
+    explicit __hash_bitmask(uint64_t mask) : mask_(mask) {}
+
+    explicit operator bool() const { return mask_ != 0; }
+
+    // index of the lowest match
+    size_t lowest() const { return static_cast<size_t>(__builtin_ctzll(mask_)) >> Shift; }
+    void   clear_lowest() { mask_ &= mask_ - 1; }
+
+    // empty slots before the first match / after the last match, the mask must be non-zero
+    size_t trailing_zeros() const { return lowest(); }
+    size_t leading_zeros() const {
+        constexpr int total_bits = static_cast<int>(Width << Shift);
+        return static_cast<size_t>(__builtin_clzll(mask_) - (64 - total_bits)) >> Shift;
+    }
+
+private:
+    uint64_t mask_;
+};
+
+#ifdef MYSTL_FLAT_HASH_SSE2
+
+struct __hash_group {
+    static constexpr size_t width = 16;
+    using bitmask = __hash_bitmask<16, 0>;
+
+    explicit __hash_group(const __ctrl_t* pos)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    bitmask match(__ctrl_t h2) const {
+        return bitmask(static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))));
+    }
+    bitmask match_empty() const { return match(ctrl_empty); }
+    bitmask match_empty_or_deleted() const {
+        return bitmask(static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl))));
+    }
+    // length of the run of empty/deleted bytes at the start of the group
+    size_t count_leading_empty_or_deleted() const {
+        const uint32_t mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ctrl_sentinel), ctrl)));
+        return static_cast<size_t>(__builtin_ctz(mask + 1));
+    }
+
+    __m128i ctrl;
+};
+
+#else
+
+struct __hash_group {
+    static constexpr size_t width = 8;
+    using bitmask = __hash_bitmask<8, 3>;
+
+    static constexpr uint64_t lsbs = 0x0101010101010101ull;
+    static constexpr uint64_t msbs = 0x8080808080808080ull;
+
+    // little endian: byte i of the word is ctrl[pos + i]
+    explicit __hash_group(const __ctrl_t* pos) { std::memcpy(&ctrl, pos, sizeof(ctrl)); }
+
+    // may report a false positive next to a real match, the key comparison filters it
+    bitmask match(__ctrl_t h2) const {
+        const uint64_t x = ctrl ^ (lsbs * static_cast<unsigned char>(h2));
+        return bitmask((x - lsbs) & ~x & msbs);
+    }
+    bitmask match_empty() const { return bitmask(ctrl & (~ctrl << 6) & msbs); }
+    bitmask match_empty_or_deleted() const { return bitmask(ctrl & (~ctrl << 7) & msbs); }
+    size_t count_leading_empty_or_deleted() const {
+        constexpr uint64_t gaps = 0x00FEFEFEFEFEFEFEull;
+        return static_cast<size_t>(
+            (__builtin_ctzll(((~ctrl & (ctrl >> 7)) | gaps) + 1) + 7) >> 3);
+    }
+
+    uint64_t ctrl;
+};
+
+#endif
+
+// triangular probing over groups, visits every group once when the capacity is 2^k - 1
+struct __probe_seq {
+    __probe_seq(size_t hash, size_t mask) : mask_(mask), offset_(hash & mask), index_(0) {}
+
+    size_t offset() const { return offset_; }
+    size_t offset(size_t i) const { return (offset_ + i) & mask_; }
+    void next() {
+        index_ += __hash_group::width;
+        offset_ = (offset_ + index_) & mask_;
+    }
+
+private:
+    size_t mask_;
+    size_t offset_;
+    size_t index_;
+};
+
+// capacities are 2^k - 1, at most 7/8 of the slots are filled
+inline size_t __normalize_capacity(size_t n) {
+    return n ? ~size_t{} >> __builtin_clzll(n) : 1;
+}
+
+inline size_t __capacity_to_growth(size_t capacity) {
+    if (__hash_group::width == 8 && capacity == 7)
+        return 6;
+    return capacity - capacity / 8;
+}
+
+inline size_t __growth_to_lower_bound_capacity(size_t growth) {
+    if (__hash_group::width == 8 && growth == 7)
+        return 8;
+    return growth + static_cast<size_t>((static_cast<ptrdiff_t>(growth) - 1) / 7);
+}
+
+
+// heterogeneous lookup is enabled when both the hasher and the key_equal are transparent
+template <typename T>
+struct __void_type { using type = void; };
+
+template <typename T, typename = void>
+struct __is_transparent : std::false_type {};
+template <typename T>
+struct __is_transparent<T, typename __void_type<typename T::is_transparent>::type>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct __is_avalanching : std::false_type {};
+template <typename T>
+struct __is_avalanching<T, typename __void_type<typename T::is_avalanching>::type>
+    : std::true_type {};
+
+// picks the lookup parameter type. spelled as a member alias (not std::conditional) so that
+// K stays deducible in find(const key_arg<K>&)
+template <bool Transparent>
+struct __flat_hash_key_arg {
+    template <typename K, typename Key>
+    using type = Key;
+};
+template <>
+struct __flat_hash_key_arg<true> {
+    template <typename K, typename Key>
+    using type = K;
+};
+
+
+template <typename Table, typename Value>
+class __flat_hash_iterator
+    :public MYSTL::iterator<MYSTL::forward_iterator_tag, Value>
+{
+    friend Table;
+    template <typename, typename> friend class __flat_hash_iterator;
+
+public:
+    using iterator_category = MYSTL::forward_iterator_tag;
+    using value_type        = typename std::remove_const<Value>::type;
+    using reference         = Value&;
+    using pointer           = Value*;
+    using difference_type   = ptrdiff_t;
+    using slot_type         = typename Table::slot_type;
+    using policy_type       = typename Table::policy_type;
+
+    __flat_hash_iterator() noexcept : ctrl_(nullptr), slot_(nullptr) {}
+    // iterator -> const_iterator
+    template <typename V, typename = typename std::enable_if<
+              std::is_same<const V, Value>::value && !std::is_same<V, Value>::value>::type>
+    __flat_hash_iterator(const __flat_hash_iterator<Table, V>& rhs) noexcept
+        : ctrl_(rhs.ctrl_), slot_(rhs.slot_) {}
+
+    reference operator*()  const { return policy_type::element(slot_); }
+    pointer   operator->() const { return &policy_type::element(slot_); }
+
+    __flat_hash_iterator& operator++() {
+        ++ctrl_;
+        ++slot_;
+        skip_empty_or_deleted();
+        return *this;
+    }
+    __flat_hash_iterator operator++(int) {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const __flat_hash_iterator& rhs) const { return ctrl_ == rhs.ctrl_; }
+    bool operator!=(const __flat_hash_iterator& rhs) const { return ctrl_ != rhs.ctrl_; }
+
+private:
+    __flat_hash_iterator(__ctrl_t* ctrl, slot_type* slot) noexcept : ctrl_(ctrl), slot_(slot) {}
+
+    void skip_empty_or_deleted() {
+        while (*ctrl_ < ctrl_sentinel) {
+            const size_t shift = __hash_group(ctrl_).count_leading_empty_or_deleted();
+            ctrl_ += shift;
+            slot_ += shift;
+        }
+    }
+
+    __ctrl_t*  ctrl_;
+    slot_type* slot_;
+};
+
+
+template <typename Policy, typename Hash, typename Eq, typename Alloc>
+class flat_hash_table : private __allocator_holder<__rebind_alloc<Alloc, unsigned char>> {
+    // slots and control bytes share one block of bytes
+    using alloc_base = __allocator_holder<__rebind_alloc<Alloc, unsigned char>>;
+
+public:
+    using policy_type     = Policy;
+    using slot_type       = typename Policy::slot_type;
+    using key_type        = typename Policy::key_type;
+    using value_type      = typename Policy::value_type;
+    using hasher          = Hash;
+    using key_equal       = Eq;
+    using allocator_type  = Alloc;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+    using iterator        = __flat_hash_iterator<flat_hash_table,
+                            typename std::conditional<Policy::constant_iterators,
+                                                      const value_type, value_type>::type>;
+    using const_iterator  = __flat_hash_iterator<flat_hash_table, const value_type>;
+
+    // K when heterogeneous lookup is enabled, key_type otherwise
+    template <typename K>
+    using key_arg = typename __flat_hash_key_arg<
+        __is_transparent<Hash>::value && __is_transparent<Eq>::value>::template type<K, key_type>;
+
+protected:
+    // byte blocks are taken to be aligned for max_align_t, as from operator new
+    static_assert(alignof(slot_type) <= alignof(std::max_align_t),
+                  "over-aligned slots are not supported");
+
+    static constexpr size_t cloned_bytes = __hash_group::width - 1;
+
+    __ctrl_t*  ctrl_;          // capacity_ + 1 + cloned_bytes bytes, after the slots
+    slot_type* slots_;         // start of the allocation
+    size_type  size_;
+    size_type  capacity_;
+    size_type  growth_left_;   // inserts into empty slots before the next rehash
+    __compressed_pair<hasher, key_equal> funcs_;
+
+public:
+    flat_hash_table() noexcept
+        : ctrl_(__empty_group()), slots_(nullptr), size_(0), capacity_(0), growth_left_(0) {}
+
+    explicit flat_hash_table(const allocator_type& a)
+        : alloc_base(a), ctrl_(__empty_group()), slots_(nullptr), size_(0), capacity_(0), growth_left_(0) {}
+
+    explicit flat_hash_table(size_type bucket_count, const hasher& hash = hasher(),
+                             const key_equal& eq = key_equal(), const allocator_type& a = allocator_type())
+        : alloc_base(a), ctrl_(__empty_group()), slots_(nullptr), size_(0), capacity_(0), growth_left_(0),
+          funcs_(hash, eq) {
+        if (bucket_count)
+            resize(__normalize_capacity(bucket_count));
+    }
+
+    flat_hash_table(const flat_hash_table& rhs)
+        : flat_hash_table(0, rhs.hash_function(), rhs.key_eq(), __select_on_copy(rhs.get_allocator())) {
+        reserve(rhs.size());
+        // no duplicates in rhs, so the elements can go straight to their first free slot.
+        // the slot is marked full only once its element exists, so a throwing copy leaves
+        // nothing half built for the destructor
+        for (auto it = rhs.begin(); it != rhs.end(); ++it) {
+            const size_t hash = hash_of(Policy::key(it.slot_));
+            const size_t target = find_first_non_full(hash);
+            Policy::construct(slots_ + target, *it);
+            set_ctrl(target, __flat_hash_h2(hash));
+            ++size_;
+            --growth_left_;
+        }
+    }
+
+    flat_hash_table(flat_hash_table&& rhs) noexcept
+        : alloc_base(MYSTL::move(rhs.alloc())), ctrl_(rhs.ctrl_), slots_(rhs.slots_), size_(rhs.size_),
+          capacity_(rhs.capacity_), growth_left_(rhs.growth_left_), funcs_(MYSTL::move(rhs.funcs_)) {
+        rhs.reset_storage();
+    }
+
+    flat_hash_table& operator=(const flat_hash_table& rhs) {
+        if (this != &rhs) {
+            flat_hash_table tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    flat_hash_table& operator=(flat_hash_table&& rhs) noexcept {
+        if (this != &rhs) {
+            destroy_slots();
+            this->alloc() = MYSTL::move(rhs.alloc());
+            ctrl_ = rhs.ctrl_;
+            slots_ = rhs.slots_;
+            size_ = rhs.size_;
+            capacity_ = rhs.capacity_;
+            growth_left_ = rhs.growth_left_;
+            funcs_ = MYSTL::move(rhs.funcs_);
+            rhs.reset_storage();
+        }
+        return *this;
+    }
+
+    ~flat_hash_table() { destroy_slots(); }
+
+public:
+    //iterators
+    iterator begin() {
+        iterator it(ctrl_, slots_);
+        it.skip_empty_or_deleted();
+        return it;
+    }
+    const_iterator begin() const { return const_cast<flat_hash_table*>(this)->begin(); }
+    iterator       end()         { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+    const_iterator end()   const { return const_cast<flat_hash_table*>(this)->end(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend()   const { return end(); }
+
+    //capacity
+    bool      empty()    const { return size_ == 0; }
+    size_type size()     const { return size_; }
+    size_type capacity() const { return capacity_; }
+    float     load_factor() const {
+        return capacity_ ? static_cast<float>(size_) / static_cast<float>(capacity_) : 0.0f;
+    }
+
+    // makes room for n elements without a rehash
+    void reserve(size_type n) {
+        if (n > size_ + growth_left_)
+            resize(__normalize_capacity(__growth_to_lower_bound_capacity(n)));
+    }
+
+    // rebuilds the table with at least n slots (or just enough for size()), drops tombstones
+    void rehash(size_type n) {
+        const size_type needed = MYSTL::max(n, __growth_to_lower_bound_capacity(size_));
+        if (needed == 0 && size_ == 0) {
+            destroy_slots();
+            reset_storage();
+            return;
+        }
+        resize(__normalize_capacity(needed));
+    }
+
+    hasher         hash_function() const { return funcs_.first(); }
+    key_equal      key_eq()        const { return funcs_.second(); }
+    allocator_type get_allocator() const { return allocator_type(this->alloc()); }
+
+    //lookup
+    template <typename K = key_type>
+    iterator find(const key_arg<K>& key) {
+        return find(key, hash_of(key));
+    }
+    template <typename K = key_type>
+    const_iterator find(const key_arg<K>& key) const {
+        return const_cast<flat_hash_table*>(this)->find(key);
+    }
+
+    template <typename K = key_type>
+    bool contains(const key_arg<K>& key) const { return find(key) != end(); }
+
+    template <typename K = key_type>
+    size_type count(const key_arg<K>& key) const { return contains(key) ? 1 : 0; }
+
+    //modifiers
+    // finds key or claims a slot for it; with .second == true the caller must construct the
+    // element through emplace_at before touching the table again
+    template <typename K>
+    MYSTL::pair<size_type, bool> find_or_prepare_insert(const K& key) {
+        const size_t hash = hash_of(key);
+        __probe_seq seq(__flat_hash_h1(hash), capacity_);
+        const __ctrl_t h2 = __flat_hash_h2(hash);
+        for (;;) {
+            const __hash_group g(ctrl_ + seq.offset());
+            for (auto m = g.match(h2); m; m.clear_lowest()) {
+                const size_t i = seq.offset(m.lowest());
+                if (funcs_.second()(Policy::key(slots_ + i), key))
+                    return MYSTL::pair<size_type, bool>(i, false);
+            }
+            if (g.match_empty())
+                break;
+            seq.next();
+        }
+        return MYSTL::pair<size_type, bool>(prepare_insert(hash), true);
+    }
+
+    // constructs the element in a slot claimed by find_or_prepare_insert
+    template <typename... Args>
+    void emplace_at(size_type i, Args&&... args) {
+        try {
+            Policy::construct(slots_ + i, MYSTL::forward<Args>(args)...);
+        }
+        catch(...) {
+            erase_meta_only(i);
+            throw;
+        }
+    }
+
+    iterator iterator_at(size_type i) { return iterator(ctrl_ + i, slots_ + i); }
+
+    MYSTL::pair<iterator, bool> insert(const value_type& value) {
+        auto res = find_or_prepare_insert(Policy::key_of(value));
+        if (res.second)
+            emplace_at(res.first, value);
+        return MYSTL::pair<iterator, bool>(iterator_at(res.first), res.second);
+    }
+
+    MYSTL::pair<iterator, bool> insert(value_type&& value) {
+        auto res = find_or_prepare_insert(Policy::key_of(value));
+        if (res.second)
+            emplace_at(res.first, MYSTL::move(value));
+        return MYSTL::pair<iterator, bool>(iterator_at(res.first), res.second);
+    }
+
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        reserve(size_ + ilist.size());
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // the element is built first to learn its key, and dropped if the key is already there
+    template <typename... Args>
+    MYSTL::pair<iterator, bool> emplace(Args&&... args) {
+        typename std::aligned_storage<sizeof(slot_type), alignof(slot_type)>::type raw;
+        slot_type* tmp = reinterpret_cast<slot_type*>(&raw);
+        Policy::construct(tmp, MYSTL::forward<Args>(args)...);
+        MYSTL::pair<size_type, bool> res;
+        try {
+            res = find_or_prepare_insert(Policy::key(tmp));
+        }
+        catch(...) {
+            Policy::destroy(tmp);
+            throw;
+        }
+        if (res.second)
+            Policy::transfer(slots_ + res.first, tmp);
+        else
+            Policy::destroy(tmp);
+        return MYSTL::pair<iterator, bool>(iterator_at(res.first), res.second);
+    }
+
+    void erase(const_iterator position) {
+        Policy::destroy(position.slot_);
+        erase_meta_only(static_cast<size_type>(position.ctrl_ - ctrl_));
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) {
+            auto next = first;
+            ++next;
+            erase(first);
+            first = next;
+        }
+        return iterator(last.ctrl_, last.slot_);
+    }
+
+    template <typename K = key_type, typename = typename std::enable_if<
+              !std::is_convertible<const K&, const_iterator>::value>::type>
+    size_type erase(const key_arg<K>& key) {
+        auto it = find(key);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    // keeps the storage
+    void clear() {
+        if (capacity_ == 0)
+            return;
+        for (size_type i = 0; i != capacity_; ++i)
+            if (__ctrl_is_full(ctrl_[i]))
+                Policy::destroy(slots_ + i);
+        size_ = 0;
+        reset_ctrl();
+    }
+
+    void swap(flat_hash_table& rhs) noexcept {
+        MYSTL::swap(ctrl_, rhs.ctrl_);
+        MYSTL::swap(slots_, rhs.slots_);
+        MYSTL::swap(size_, rhs.size_);
+        MYSTL::swap(capacity_, rhs.capacity_);
+        MYSTL::swap(growth_left_, rhs.growth_left_);
+        funcs_.swap(rhs.funcs_);
+        MYSTL::swap(this->alloc(), rhs.alloc());
+    }
+
+protected:
+    template <typename K>
+    size_t hash_of(const K& key) const {
+        return hash_of(key, __is_avalanching<Hash>{});
+    }
+    template <typename K>
+    size_t hash_of(const K& key, std::true_type) const { return funcs_.first()(key); }
+    template <typename K>
+    size_t hash_of(const K& key, std::false_type) const {
+        return __flat_hash_mix(funcs_.first()(key));
+    }
+
+    template <typename K>
+    iterator find(const K& key, size_t hash) {
+        __probe_seq seq(__flat_hash_h1(hash), capacity_);
+        const __ctrl_t h2 = __flat_hash_h2(hash);
+        for (;;) {
+            const __hash_group g(ctrl_ + seq.offset());
+            for (auto m = g.match(h2); m; m.clear_lowest()) {
+                const size_t i = seq.offset(m.lowest());
+                if (funcs_.second()(Policy::key(slots_ + i), key))
+                    return iterator_at(i);
+            }
+            if (g.match_empty())
+                return end();
+            seq.next();
+        }
+    }
+
+    // first empty or deleted slot on the probe sequence of hash
+    size_type find_first_non_full(size_t hash) const {
+        __probe_seq seq(__flat_hash_h1(hash), capacity_);
+        for (;;) {
+            const auto m = __hash_group(ctrl_ + seq.offset()).match_empty_or_deleted();
+            if (m)
+                return seq.offset(m.lowest());
+            seq.next();
+        }
+    }
+
+    size_type prepare_insert(size_t hash) {
+        size_type target = find_first_non_full(hash);
+        if (growth_left_ == 0 && ctrl_[target] != ctrl_deleted) {
+            rehash_and_grow();
+            target = find_first_non_full(hash);
+        }
+        ++size_;
+        growth_left_ -= (ctrl_[target] == ctrl_empty);
+        set_ctrl(target, __flat_hash_h2(hash));
+        return target;
+    }
+
+    void rehash_and_grow() {
+        if (capacity_ == 0)
+            resize(1);
+        else if (size_ * 32 <= capacity_ * 25)
+            resize(capacity_);  // mostly tombstones, rebuild at the same size
+        else
+            resize(capacity_ * 2 + 1);
+    }
+
+    void erase_meta_only(size_type i) {
+        --size_;
+        const size_type before = (i - __hash_group::width) & capacity_;
+        const auto empty_after = __hash_group(ctrl_ + i).match_empty();
+        const auto empty_before = __hash_group(ctrl_ + before).match_empty();
+        // if the full run through i is shorter than a group, every probe that reached i
+        // also saw an empty byte in the same group and stopped there
+        const bool was_never_full = empty_before && empty_after &&
+            empty_after.trailing_zeros() + empty_before.leading_zeros() < __hash_group::width;
+        set_ctrl(i, was_never_full ? ctrl_empty : ctrl_deleted);
+        growth_left_ += was_never_full;
+    }
+
+    // writes control byte i and its mirror past the sentinel
+    void set_ctrl(size_type i, __ctrl_t h) {
+        ctrl_[i] = h;
+        ctrl_[((i - cloned_bytes) & capacity_) + (cloned_bytes & capacity_)] = h;
+    }
+
+    static size_type alloc_size(size_type capacity) {
+        return capacity * sizeof(slot_type) + capacity + 1 + cloned_bytes;
+    }
+
+    void reset_ctrl() {
+        std::memset(ctrl_, ctrl_empty, capacity_ + 1 + cloned_bytes);
+        ctrl_[capacity_] = ctrl_sentinel;
+        growth_left_ = __capacity_to_growth(capacity_) - size_;
+    }
+
+    void reset_storage() {
+        ctrl_ = __empty_group();
+        slots_ = nullptr;
+        size_ = capacity_ = growth_left_ = 0;
+    }
+
+    void resize(size_type new_capacity) {
+        __ctrl_t* old_ctrl = ctrl_;
+        slot_type* old_slots = slots_;
+        const size_type old_capacity = capacity_;
+
+        unsigned char* mem = this->alloc().allocate(alloc_size(new_capacity));
+        slots_ = reinterpret_cast<slot_type*>(mem);
+        ctrl_ = reinterpret_cast<__ctrl_t*>(mem + new_capacity * sizeof(slot_type));
+        capacity_ = new_capacity;
+        reset_ctrl();
+
+        for (size_type i = 0; i != old_capacity; ++i) {
+            if (__ctrl_is_full(old_ctrl[i])) {
+                const size_t hash = hash_of(Policy::key(old_slots + i));
+                const size_type target = find_first_non_full(hash);
+                set_ctrl(target, __flat_hash_h2(hash));
+                Policy::transfer(slots_ + target, old_slots + i);
+            }
+        }
+        if (old_capacity)
+            this->alloc().deallocate(reinterpret_cast<unsigned char*>(old_slots), alloc_size(old_capacity));
+    }
+
+    void destroy_slots() {
+        if (capacity_ == 0)
+            return;
+        for (size_type i = 0; i != capacity_; ++i)
+            if (__ctrl_is_full(ctrl_[i]))
+                Policy::destroy(slots_ + i);
+        this->alloc().deallocate(reinterpret_cast<unsigned char*>(slots_), alloc_size(capacity_));
+    }
+};
+
+template <typename Policy, typename Hash, typename Eq, typename Alloc>
+bool operator==(const flat_hash_table<Policy, Hash, Eq, Alloc>& lhs,
+                const flat_hash_table<Policy, Hash, Eq, Alloc>& rhs) {
+    if (lhs.size() != rhs.size())
+        return false;
+    for (auto it = lhs.begin(); it != lhs.end(); ++it) {
+        auto found = rhs.find(Policy::key_of(*it));
+        if (found == rhs.end() || !(*found == *it))
+            return false;
+    }
+    return true;
+}
+
+template <typename Policy, typename Hash, typename Eq, typename Alloc>
+bool operator!=(const flat_hash_table<Policy, Hash, Eq, Alloc>& lhs,
+                const flat_hash_table<Policy, Hash, Eq, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,378 @@
+#ifndef FLAT_MAP_H_
+#define FLAT_MAP_H_
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include "utility.h"
+#include "iterator.h"
+#include "algo.h"
+#include "vector.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// flat_map
+// ordered map kept as two sorted vectors, keys in one and mapped values in the other
+// (struct of arrays). a lookup is a binary search over the dense key array only, so the
+// values never pollute the cache lines the search walks through.
+// a single insert or erase shifts the tail, O(n); insert(first, last) appends the whole
+// range, sorts the new part and merges it with the old keys in one pass.
+// iterators are index based and invalidated by any insert or erase.
+/*****************************************************************************************/
+
+template <typename Key, typename T, bool Const>
+class __flat_map_iterator {
+    using key_pointer    = const Key*;
+    using mapped_pointer = typename std::conditional<Const, const T*, T*>::type;
+
+    template <typename, typename, bool> friend class __flat_map_iterator;
+    template <typename, typename, typename> friend class flat_map;
+
+public:
+    using iterator_category = MYSTL::random_access_iterator_tag;
+    using value_type        = MYSTL::pair<Key, T>;
+    using difference_type   = ptrdiff_t;
+    using reference         = MYSTL::pair<const Key&, typename std::conditional<Const, const T&, T&>::type>;
+    using pointer           = MYSTL::__arrow_proxy<reference>;
+
+    __flat_map_iterator() : key_(nullptr), mapped_(nullptr) {}
+    __flat_map_iterator(key_pointer key, mapped_pointer mapped) : key_(key), mapped_(mapped) {}
+
+    // iterator -> const_iterator
+    template <bool C = Const, typename = typename std::enable_if<C>::type>
+    __flat_map_iterator(const __flat_map_iterator<Key, T, false>& rhs)
+        : key_(rhs.key_), mapped_(rhs.mapped_) {}
+
+    const Key& key()    const { return *key_; }
+    reference operator*()  const { return reference(*key_, *mapped_); }
+    pointer   operator->() const { return pointer{**this}; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    __flat_map_iterator& operator++() { ++key_; ++mapped_; return *this; }
+    __flat_map_iterator& operator--() { --key_; --mapped_; return *this; }
+    __flat_map_iterator  operator++(int) { auto tmp = *this; ++*this; return tmp; }
+    __flat_map_iterator  operator--(int) { auto tmp = *this; --*this; return tmp; }
+
+    __flat_map_iterator& operator+=(difference_type n) { key_ += n; mapped_ += n; return *this; }
+    __flat_map_iterator& operator-=(difference_type n) { key_ -= n; mapped_ -= n; return *this; }
+    __flat_map_iterator  operator+(difference_type n) const { auto tmp = *this; return tmp += n; }
+    __flat_map_iterator  operator-(difference_type n) const { auto tmp = *this; return tmp -= n; }
+    difference_type operator-(const __flat_map_iterator& rhs) const { return key_ - rhs.key_; }
+
+    bool operator==(const __flat_map_iterator& rhs) const { return key_ == rhs.key_; }
+    bool operator!=(const __flat_map_iterator& rhs) const { return key_ != rhs.key_; }
+    bool operator< (const __flat_map_iterator& rhs) const { return key_ <  rhs.key_; }
+    bool operator> (const __flat_map_iterator& rhs) const { return key_ >  rhs.key_; }
+    bool operator<=(const __flat_map_iterator& rhs) const { return key_ <= rhs.key_; }
+    bool operator>=(const __flat_map_iterator& rhs) const { return key_ >= rhs.key_; }
+
+private:
+    key_pointer    key_;
+    mapped_pointer mapped_;
+};
+
+
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class flat_map {
+public:
+    using key_type        = Key;
+    using mapped_type     = T;
+    using value_type      = MYSTL::pair<Key, T>;
+    using key_compare     = Compare;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using iterator        = __flat_map_iterator<Key, T, false>;
+    using const_iterator  = __flat_map_iterator<Key, T, true>;
+    using reference       = typename iterator::reference;
+    using const_reference = typename const_iterator::reference;
+    using key_container_type    = MYSTL::vector<Key>;
+    using mapped_container_type = MYSTL::vector<T>;
+
+private:
+    key_container_type    keys_;
+    mapped_container_type values_;
+    key_compare           comp_;
+
+public:
+    flat_map() : comp_() {}
+    explicit flat_map(const key_compare& comp) : comp_(comp) {}
+
+    template <typename InputIterator>
+    flat_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+        : comp_(comp) { insert(first, last); }
+
+    flat_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        : comp_(comp) { insert(ilist.begin(), ilist.end()); }
+
+    flat_map(const flat_map&) = default;
+    flat_map(flat_map&&) = default;
+    flat_map& operator=(const flat_map&) = default;
+    flat_map& operator=(flat_map&&) = default;
+
+    //iterators
+    iterator       begin()        { return iterator(keys_.data(), values_.data()); }
+    const_iterator begin()  const { return const_iterator(keys_.data(), values_.data()); }
+    iterator       end()          { return begin() + static_cast<difference_type>(size()); }
+    const_iterator end()    const { return begin() + static_cast<difference_type>(size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend()   const { return end(); }
+
+    //capacity
+    bool      empty()    const { return keys_.empty(); }
+    size_type size()     const { return keys_.size(); }
+    size_type capacity() const { return keys_.capacity(); }
+    void reserve(size_type n) {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+
+    // the underlying sorted arrays
+    const key_container_type&    keys()   const { return keys_; }
+    const mapped_container_type& values() const { return values_; }
+    key_compare key_comp() const { return comp_; }
+
+    //lookup
+    iterator lower_bound(const key_type& key) {
+        return begin() + index_lower_bound(key);
+    }
+    const_iterator lower_bound(const key_type& key) const {
+        return begin() + index_lower_bound(key);
+    }
+    iterator upper_bound(const key_type& key) {
+        return begin() + (MYSTL::upper_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+    }
+    const_iterator upper_bound(const key_type& key) const {
+        return begin() + (MYSTL::upper_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+    }
+    MYSTL::pair<iterator, iterator> equal_range(const key_type& key) {
+        return MYSTL::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+    MYSTL::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return MYSTL::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    iterator find(const key_type& key) {
+        const auto i = index_lower_bound(key);
+        return found_at(i, key) ? begin() + i : end();
+    }
+    const_iterator find(const key_type& key) const {
+        const auto i = index_lower_bound(key);
+        return found_at(i, key) ? begin() + i : end();
+    }
+    bool      contains(const key_type& key) const { return found_at(index_lower_bound(key), key); }
+    size_type count(const key_type& key)    const { return contains(key) ? 1 : 0; }
+
+    mapped_type& at(const key_type& key) {
+        const auto i = index_lower_bound(key);
+        if (!found_at(i, key))
+            throw std::out_of_range("flat_map::at");
+        return values_[i];
+    }
+    const mapped_type& at(const key_type& key) const {
+        const auto i = index_lower_bound(key);
+        if (!found_at(i, key))
+            throw std::out_of_range("flat_map::at");
+        return values_[i];
+    }
+
+    mapped_type& operator[](const key_type& key) { return try_emplace(key).first->second; }
+    mapped_type& operator[](key_type&& key) { return try_emplace(MYSTL::move(key)).first->second; }
+
+    //modifiers
+    // constructs the mapped value only when the key is missing
+    template <typename K, typename... Args>
+    MYSTL::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        const auto i = index_lower_bound(key);
+        if (found_at(i, key))
+            return MYSTL::pair<iterator, bool>(begin() + i, false);
+        return MYSTL::pair<iterator, bool>(
+            insert_at(i, MYSTL::forward<K>(key), MYSTL::forward<Args>(args)...), true);
+    }
+
+    MYSTL::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+    MYSTL::pair<iterator, bool> insert(value_type&& value) {
+        return try_emplace(MYSTL::move(value.first), MYSTL::move(value.second));
+    }
+    template <typename... Args>
+    MYSTL::pair<iterator, bool> emplace(Args&&... args) {
+        return insert(value_type(MYSTL::forward<Args>(args)...));
+    }
+
+    template <typename M>
+    MYSTL::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value) {
+        const auto i = index_lower_bound(key);
+        if (found_at(i, key)) {
+            values_[i] = MYSTL::forward<M>(value);
+            return MYSTL::pair<iterator, bool>(begin() + i, false);
+        }
+        return MYSTL::pair<iterator, bool>(insert_at(i, key, MYSTL::forward<M>(value)), true);
+    }
+
+    // bulk insert: one sort of the new elements and one merge, instead of a shift per element.
+    // like repeated insert, an existing key keeps its value and the first duplicate wins
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last);
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+    iterator erase(const_iterator position) {
+        const auto i = position - cbegin();
+        keys_.erase(keys_.begin() + i);
+        values_.erase(values_.begin() + i);
+        return begin() + i;
+    }
+    iterator erase(iterator position) { return erase(const_iterator(position)); }
+    iterator erase(const_iterator first, const_iterator last) {
+        const auto i = first - cbegin(), j = last - cbegin();
+        keys_.erase(keys_.begin() + i, keys_.begin() + j);
+        values_.erase(values_.begin() + i, values_.begin() + j);
+        return begin() + i;
+    }
+    size_type erase(const key_type& key) {
+        const auto it = find(key);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    void clear() {
+        keys_.clear();
+        values_.clear();
+    }
+
+    void swap(flat_map& rhs) noexcept {
+        keys_.swap(rhs.keys_);
+        values_.swap(rhs.values_);
+        MYSTL::swap(comp_, rhs.comp_);
+    }
+
+private:
+    difference_type index_lower_bound(const key_type& key) const {
+        return MYSTL::lower_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin();
+    }
+    bool found_at(difference_type i, const key_type& key) const {
+        return i != static_cast<difference_type>(size()) && !comp_(key, keys_[i]);
+    }
+
+    // keeps keys_ and values_ the same length if the second insert throws
+    template <typename K, typename... Args>
+    iterator insert_at(difference_type i, K&& key, Args&&... args) {
+        keys_.emplace(keys_.begin() + i, MYSTL::forward<K>(key));
+        try {
+            values_.emplace(values_.begin() + i, MYSTL::forward<Args>(args)...);
+        }
+        catch(...) {
+            keys_.erase(keys_.begin() + i);
+            throw;
+        }
+        return begin() + i;
+    }
+
+    void merge_tail(size_type old_size);
+};
+
+template <typename Key, typename T, typename Compare>
+template <typename InputIterator>
+void flat_map<Key, T, Compare>::insert(InputIterator first, InputIterator last) {
+    const size_type old_size = size();
+    try {
+        for (; first != last; ++first) {
+            const auto& value = *first;
+            keys_.push_back(value.first);
+            try {
+                values_.push_back(value.second);
+            }
+            catch(...) {
+                keys_.pop_back();
+                throw;
+            }
+        }
+    }
+    catch(...) {
+        keys_.erase(keys_.begin() + old_size, keys_.end());
+        values_.erase(values_.begin() + old_size, values_.end());
+        throw;
+    }
+    merge_tail(old_size);
+}
+
+// [0, old_size) is sorted and unique, [old_size, size()) is the freshly appended range
+template <typename Key, typename T, typename Compare>
+void flat_map<Key, T, Compare>::merge_tail(size_type old_size) {
+    const size_type n = size();
+    if (n == old_size)
+        return;
+
+    // common case: the new keys arrive sorted and all greater than the old ones
+    size_type i = old_size == 0 ? 1 : old_size;
+    while (i < n && comp_(keys_[i - 1], keys_[i]))
+        ++i;
+    if (i == n)
+        return;
+
+    // sort a permutation of the tail, so keys and values are each moved only once.
+    // equal keys are ordered by position, which lets the first one win
+    MYSTL::vector<size_type> order;
+    order.reserve(n - old_size);
+    for (size_type j = old_size; j < n; ++j)
+        order.push_back(j);
+    const key_type* keys = keys_.data();
+    const key_compare& comp = comp_;
+    MYSTL::sort(order.begin(), order.end(), [keys, &comp](size_type a, size_type b) {
+        return comp(keys[a], keys[b]) || (!comp(keys[b], keys[a]) && a < b);
+    });
+
+    key_container_type    new_keys;
+    mapped_container_type new_values;
+    new_keys.reserve(n);
+    new_values.reserve(n);
+    auto take = [&](size_type j) {
+        new_keys.push_back(MYSTL::move(keys_[j]));
+        new_values.push_back(MYSTL::move(values_[j]));
+    };
+
+    size_type old_i = 0;
+    auto next = order.begin();
+    while (old_i < old_size || next != order.end()) {
+        if (next == order.end() || (old_i < old_size && !comp_(keys_[*next], keys_[old_i]))) {
+            // an old key wins against an equal new one
+            if (next != order.end() && !comp_(keys_[old_i], keys_[*next]))
+                ++next;
+            else
+                take(old_i++);
+        }
+        else {
+            take(*next);
+            // skip the later duplicates of this key
+            while (++next != order.end() && !comp_(new_keys.back(), keys_[*next]))
+                ;
+        }
+    }
+    keys_.swap(new_keys);
+    values_.swap(new_values);
+}
+
+template <typename Key, typename T, typename Compare>
+bool operator==(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs) {
+    return lhs.keys() == rhs.keys() && lhs.values() == rhs.values();
+}
+
+template <typename Key, typename T, typename Compare>
+bool operator!=(const flat_map<Key, T, Compare>& lhs, const flat_map<Key, T, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare>
+void swap(flat_map<Key, T, Compare>& lhs, flat_map<Key, T, Compare>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef FLAT_SET_H_
+#define FLAT_SET_H_
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include "utility.h"
+#include "algo.h"
+#include "vector.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// flat_set
+// ordered set kept as one sorted vector: lookups are binary searches over contiguous keys.
+// a single insert or erase shifts the tail, O(n); insert(first, last) appends the range,
+// sorts it and merges it with the old keys once.
+// iterators are constant and invalidated by any insert or erase.
+/*****************************************************************************************/
+
+template <typename Key, typename Compare = std::less<Key>>
+class flat_set {
+public:
+    using key_type        = Key;
+    using value_type      = Key;
+    using key_compare     = Compare;
+    using value_compare   = Compare;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using container_type  = MYSTL::vector<Key>;
+    using iterator        = typename container_type::const_iterator;
+    using const_iterator  = typename container_type::const_iterator;
+    using reference       = const Key&;
+    using const_reference = const Key&;
+
+private:
+    container_type keys_;
+    key_compare    comp_;
+
+public:
+    flat_set() : comp_() {}
+    explicit flat_set(const key_compare& comp) : comp_(comp) {}
+
+    template <typename InputIterator>
+    flat_set(InputIterator first, InputIterator last, const key_compare& comp = key_compare())
+        : comp_(comp) { insert(first, last); }
+
+    flat_set(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        : comp_(comp) { insert(ilist.begin(), ilist.end()); }
+
+    //iterators
+    const_iterator begin()  const { return keys_.begin(); }
+    const_iterator end()    const { return keys_.end(); }
+    const_iterator cbegin() const { return keys_.begin(); }
+    const_iterator cend()   const { return keys_.end(); }
+
+    //capacity
+    bool      empty()    const { return keys_.empty(); }
+    size_type size()     const { return keys_.size(); }
+    size_type capacity() const { return keys_.capacity(); }
+    void      reserve(size_type n) { keys_.reserve(n); }
+
+    // the underlying sorted array
+    const container_type& keys() const { return keys_; }
+    key_compare key_comp() const { return comp_; }
+
+    //lookup
+    const_iterator lower_bound(const key_type& key) const {
+        return MYSTL::lower_bound(keys_.begin(), keys_.end(), key, comp_);
+    }
+    const_iterator upper_bound(const key_type& key) const {
+        return MYSTL::upper_bound(keys_.begin(), keys_.end(), key, comp_);
+    }
+    MYSTL::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return MYSTL::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+    const_iterator find(const key_type& key) const {
+        const auto it = lower_bound(key);
+        return it != end() && !comp_(key, *it) ? it : end();
+    }
+    bool      contains(const key_type& key) const { return find(key) != end(); }
+    size_type count(const key_type& key)    const { return contains(key) ? 1 : 0; }
+
+    //modifiers
+    template <typename... Args>
+    MYSTL::pair<iterator, bool> emplace(Args&&... args) {
+        return insert(value_type(MYSTL::forward<Args>(args)...));
+    }
+    MYSTL::pair<iterator, bool> insert(const value_type& value) { return insert_unique(value); }
+    MYSTL::pair<iterator, bool> insert(value_type&& value) { return insert_unique(MYSTL::move(value)); }
+
+    // bulk insert: one sort of the new keys and one merge, instead of a shift per key
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last);
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+    iterator erase(const_iterator position) { return keys_.erase(position); }
+    iterator erase(const_iterator first, const_iterator last) { return keys_.erase(first, last); }
+    size_type erase(const key_type& key) {
+        const auto it = find(key);
+        if (it == end())
+            return 0;
+        keys_.erase(it);
+        return 1;
+    }
+
+    void clear() { keys_.clear(); }
+
+    void swap(flat_set& rhs) noexcept {
+        keys_.swap(rhs.keys_);
+        MYSTL::swap(comp_, rhs.comp_);
+    }
+
+private:
+    template <typename V>
+    MYSTL::pair<iterator, bool> insert_unique(V&& value) {
+        const auto it = lower_bound(value);
+        if (it != end() && !comp_(value, *it))
+            return MYSTL::pair<iterator, bool>(it, false);
+        return MYSTL::pair<iterator, bool>(keys_.emplace(it, MYSTL::forward<V>(value)), true);
+    }
+};
+
+template <typename Key, typename Compare>
+template <typename InputIterator>
+void flat_set<Key, Compare>::insert(InputIterator first, InputIterator last) {
+    const size_type old_size = size();
+    try {
+        for (; first != last; ++first)
+            keys_.push_back(*first);
+    }
+    catch(...) {
+        keys_.erase(keys_.begin() + old_size, keys_.end());
+        throw;
+    }
+    const size_type n = size();
+
+    // common case: the new keys arrive sorted and all greater than the old ones
+    size_type i = old_size == 0 ? 1 : old_size;
+    while (i < n && comp_(keys_[i - 1], keys_[i]))
+        ++i;
+    if (i >= n)
+        return;
+
+    const key_compare& comp = comp_;
+    const auto tail = keys_.begin() + old_size;
+    MYSTL::sort(tail, keys_.end(), comp);
+    auto tail_end = MYSTL::unique(tail, keys_.end(), [&comp](const Key& a, const Key& b) {
+        return !comp(a, b) && !comp(b, a);
+    });
+
+    container_type merged;
+    merged.reserve(n);
+    auto a = keys_.begin(), b = tail;
+    while (a != tail && b != tail_end) {
+        if (comp_(*a, *b))
+            merged.push_back(MYSTL::move(*a++));
+        else if (comp_(*b, *a))
+            merged.push_back(MYSTL::move(*b++));
+        else {
+            // the old key wins against an equal new one
+            merged.push_back(MYSTL::move(*a++));
+            ++b;
+        }
+    }
+    for (; a != tail; ++a)
+        merged.push_back(MYSTL::move(*a));
+    for (; b != tail_end; ++b)
+        merged.push_back(MYSTL::move(*b));
+    keys_.swap(merged);
+}
+
+template <typename Key, typename Compare>
+bool operator==(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs) {
+    return lhs.keys() == rhs.keys();
+}
+
+template <typename Key, typename Compare>
+bool operator!=(const flat_set<Key, Compare>& lhs, const flat_set<Key, Compare>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare>
+void swap(flat_set<Key, Compare>& lhs, flat_set<Key, Compare>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
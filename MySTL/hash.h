@@ -0,0 +1,188 @@
+#ifndef HASH_H_
+#define HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include "utility.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// hash
+// MYSTL::hash<T> for integers, enums, floating point, pointers, pair and strings.
+// integers go through a 64-bit finalizer so that every input bit reaches every output bit,
+// byte ranges use a wyhash-style function: 64x64->128 multiplies over 16/48 byte chunks.
+// every specialization marks itself `is_avalanching`, which tells flat_hash_table that it
+// does not need to mix the result again. types without a specialization fall back to
+// std::hash.
+/*****************************************************************************************/
+
+// 64x64 -> 128 bit multiply, low half in a, high half in b
+inline void __hash_mum(uint64_t& a, uint64_t& b) {
+#ifdef __SIZEOF_INT128__
+    const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    a = static_cast<uint64_t>(r);
+    b = static_cast<uint64_t>(r >> 64);
+#else
+    const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    const uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+inline uint64_t __hash_mix(uint64_t a, uint64_t b) {
+    __hash_mum(a, b);
+    return a ^ b;
+}
+
+// murmur3 / splitmix64 finalizer, a bijection on 64-bit values
+inline uint64_t __hash_fmix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+inline uint64_t __hash_read8(const unsigned char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline uint64_t __hash_read4(const unsigned char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+// 1 to 3 bytes: first, middle and last byte
+inline uint64_t __hash_read3(const unsigned char* p, size_t k) {
+    return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+constexpr uint64_t __hash_secret0 = 0x2d358dccaa6c78a5ull;
+constexpr uint64_t __hash_secret1 = 0x8bb84b93962eacc9ull;
+constexpr uint64_t __hash_secret2 = 0x4b33a62ed433d4a3ull;
+constexpr uint64_t __hash_secret3 = 0x4d5a2da51de1aa47ull;
+
+// hashes len bytes at data. short keys (<= 16 bytes) take two overlapping loads and one
+// multiply, long keys run three independent lanes over 48-byte blocks
+inline uint64_t hash_bytes(const void* data, size_t len, uint64_t seed = 0) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    seed ^= __hash_mix(seed ^ __hash_secret0, __hash_secret1);
+    uint64_t a, b;
+    if (len <= 16) {
+        if (len >= 4) {
+            const size_t mid = (len >> 3) << 2;
+            a = (__hash_read4(p) << 32) | __hash_read4(p + mid);
+            b = (__hash_read4(p + len - 4) << 32) | __hash_read4(p + len - 4 - mid);
+        }
+        else if (len > 0) {
+            a = __hash_read3(p, len);
+            b = 0;
+        }
+        else {
+            a = b = 0;
+        }
+    }
+    else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = __hash_mix(__hash_read8(p) ^ __hash_secret1, __hash_read8(p + 8) ^ seed);
+                see1 = __hash_mix(__hash_read8(p + 16) ^ __hash_secret2, __hash_read8(p + 24) ^ see1);
+                see2 = __hash_mix(__hash_read8(p + 32) ^ __hash_secret3, __hash_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = __hash_mix(__hash_read8(p) ^ __hash_secret1, __hash_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = __hash_read8(p + i - 16);
+        b = __hash_read8(p + i - 8);
+    }
+    a ^= __hash_secret1;
+    b ^= seed;
+    __hash_mum(a, b);
+    return __hash_mix(a ^ __hash_secret0 ^ len, b ^ __hash_secret1);
+}
+
+
+template <typename T, typename = void>
+struct hash : std::hash<T> {};
+
+template <typename T>
+struct hash<T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type> {
+    using is_avalanching = void;
+    size_t operator()(T value) const noexcept {
+        return static_cast<size_t>(__hash_fmix64(static_cast<uint64_t>(value)));
+    }
+};
+
+template <typename T>
+struct hash<T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    using is_avalanching = void;
+    size_t operator()(T value) const noexcept {
+        if (value == T(0))
+            return 0;  // +0.0 and -0.0 compare equal
+        // long double carries padding bytes, equal values are still equal as double
+        using bits_type = typename std::conditional<(sizeof(T) > sizeof(double)), double, T>::type;
+        const bits_type bits = static_cast<bits_type>(value);
+        return static_cast<size_t>(hash_bytes(&bits, sizeof(bits)));
+    }
+};
+
+template <typename T>
+struct hash<T*> {
+    using is_avalanching = void;
+    size_t operator()(T* p) const noexcept {
+        return static_cast<size_t>(__hash_fmix64(reinterpret_cast<uintptr_t>(p)));
+    }
+};
+
+template <typename CharT, typename Traits, typename Alloc>
+struct hash<std::basic_string<CharT, Traits, Alloc>> {
+    using is_avalanching = void;
+    size_t operator()(const std::basic_string<CharT, Traits, Alloc>& s) const noexcept {
+        return static_cast<size_t>(hash_bytes(s.data(), s.size() * sizeof(CharT)));
+    }
+};
+
+// folds the hash of value into seed, the order of the calls matters
+template <typename T>
+void hash_combine(size_t& seed, const T& value) {
+    seed = static_cast<size_t>(
+        __hash_mix(seed ^ __hash_secret0, MYSTL::hash<T>()(value) ^ __hash_secret1));
+}
+
+template <typename T1, typename T2>
+struct hash<MYSTL::pair<T1, T2>> {
+    using is_avalanching = void;
+    size_t operator()(const MYSTL::pair<T1, T2>& p) const {
+        size_t seed = 0;
+        hash_combine(seed, p.first);
+        hash_combine(seed, p.second);
+        return seed;
+    }
+};
+
+} // end of namespace MYSTL
+
+#endif
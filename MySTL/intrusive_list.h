@@ -0,0 +1,263 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include "iterator.h"
+#include "utility.h"
+#include "list.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// intrusive_list
+// the links live inside the elements: T derives from list_hook<Tag> and the list only
+// relinks them, so insertion and removal never allocate. An object can sit in several
+// lists at once by deriving from hooks with different tags.
+// the list does not own its elements, destroying or clearing it only unlinks them.
+/*****************************************************************************************/
+
+template <typename Tag = void>
+struct list_hook : public list_node_base {
+    list_hook() noexcept { prev = next = nullptr; }
+    // copying an object does not copy its membership
+    list_hook(const list_hook&) noexcept { prev = next = nullptr; }
+    list_hook& operator=(const list_hook&) noexcept { return *this; }
+
+    bool is_linked() const noexcept { return next != nullptr; }
+};
+
+
+template <typename T, typename Hook>
+struct intrusive_list_iterator
+    :public MYSTL::iterator<MYSTL::bidirectional_iterator_tag, T>
+{
+    using iterator_category = MYSTL::bidirectional_iterator_tag;
+    using value_type        = typename std::remove_const<T>::type;
+    using difference_type   = ptrdiff_t;
+    using pointer           = T*;
+    using reference         = T&;
+    using self              = intrusive_list_iterator<T, Hook>;
+    using node_ptr          = list_node_base*;
+
+    node_ptr node_;
+
+    intrusive_list_iterator() = default;
+    explicit intrusive_list_iterator(node_ptr node) :node_(node) {}
+    // iterator -> const_iterator
+    template <typename U, typename = typename std::enable_if<
+              std::is_same<const U, T>::value && !std::is_same<U, T>::value>::type>
+    intrusive_list_iterator(const intrusive_list_iterator<U, Hook>& rhs) :node_(rhs.node_) {}
+
+    reference operator*() const {
+        return *static_cast<pointer>(static_cast<Hook*>(node_));
+    }
+    pointer operator->() const { return &(operator*()); }
+
+    self& operator++() {
+        node_ = node_->next;
+        return *this;
+    }
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--() {
+        node_ = node_->prev;
+        return *this;
+    }
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+
+template <typename T, typename Hook = list_hook<>>
+class intrusive_list {
+public:
+    using value_type             = T;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using pointer                = value_type*;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using hook_type              = Hook;
+
+    using iterator               = intrusive_list_iterator<T, Hook>;
+    using const_iterator         = intrusive_list_iterator<const T, Hook>;
+    using reverse_iterator       = MYSTL::reverse_iterator<iterator>;
+    using const_reverse_iterator = MYSTL::reverse_iterator<const_iterator>;
+
+    static_assert(std::is_base_of<Hook, T>::value, "T must derive from the hook type");
+
+protected:
+    using node_ptr               = list_node_base*;
+    list_node_base node_;  // sentinel, never a T
+    size_type size_;
+
+public:
+    intrusive_list() noexcept { empty_initialize(); }
+
+    template <typename Iterator>
+    intrusive_list(Iterator first, Iterator last) {
+        empty_initialize();
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    intrusive_list(const intrusive_list&) = delete;
+    intrusive_list& operator=(const intrusive_list&) = delete;
+
+    intrusive_list(intrusive_list&& rhs) noexcept {
+        empty_initialize();
+        splice(end(), rhs);
+    }
+
+    intrusive_list& operator=(intrusive_list&& rhs) noexcept {
+        if (this != &rhs) {
+            clear();
+            splice(end(), rhs);
+        }
+        return *this;
+    }
+
+    ~intrusive_list() { clear(); }
+
+public:
+    //iterators
+    iterator        begin()       { return iterator(node_.next); }
+    const_iterator  begin() const { return const_iterator(node_.next); }
+    iterator        end()         { return iterator(&node_); }
+    const_iterator  end()   const { return const_iterator(const_cast<node_ptr>(&node_)); }
+
+    reverse_iterator       rbegin()        { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const { return begin(); }
+    const_iterator         cend()    const { return end(); }
+
+    // O(1), the element must be linked into this list
+    iterator       iterator_to(reference value)       { return iterator(to_node(&value)); }
+    const_iterator iterator_to(const_reference value) const {
+        return const_iterator(to_node(const_cast<pointer>(&value)));
+    }
+
+    //capacity
+    size_type       size()  const { return size_; }
+    bool            empty() const { return node_.next == &node_; }
+
+    //element access
+    reference       front()       { return *begin(); }
+    const_reference front() const { return *begin(); }
+    reference       back()        { return *(--end()); }
+    const_reference back()  const { return *(--end()); }
+
+    //modifiers
+    void push_front(reference value) { insert(begin(), value); }
+    void push_back(reference value)  { insert(end(), value); }
+    void pop_front() { erase(begin()); }
+    void pop_back()  { erase(--end()); }
+
+    // links value before position, value must not be linked anywhere else
+    iterator insert(const_iterator position, reference value) noexcept {
+        node_ptr n = to_node(&value);
+        n->hook(position.node_);
+        ++size_;
+        return iterator(n);
+    }
+
+    iterator erase(const_iterator position) noexcept {
+        node_ptr n = position.node_;
+        node_ptr next = n->next;
+        n->unhook();
+        n->prev = n->next = nullptr;
+        --size_;
+        return iterator(next);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        while (first != last)
+            first = erase(first);
+        return iterator(last.node_);
+    }
+
+    // unlinks value from this list
+    void remove(reference value) noexcept { erase(iterator_to(value)); }
+
+    template <typename UnaryPredicate>
+    void remove_if(UnaryPredicate pred) {
+        auto first = begin();
+        auto last = end();
+        while (first != last) {
+            if (pred(*first))
+                first = erase(first);
+            else
+                ++first;
+        }
+    }
+
+    void clear() noexcept { erase(begin(), end()); }
+
+    void swap(intrusive_list& rhs) noexcept {
+        intrusive_list tmp(MYSTL::move(rhs));
+        rhs.splice(rhs.end(), *this);
+        splice(end(), tmp);
+    }
+
+public:
+    void splice(const_iterator position, intrusive_list& other) noexcept {
+        if (!other.empty()) {
+            position.node_->transfer(other.node_.next, &other.node_);
+            size_ += other.size_;
+            other.size_ = 0;
+        }
+    }
+
+    void splice(const_iterator position, intrusive_list& other, const_iterator i) noexcept {
+        node_ptr j = i.node_->next;
+        if (position.node_ == i.node_ || position.node_ == j)
+            return;
+        position.node_->transfer(i.node_, j);
+        ++size_;
+        --other.size_;
+    }
+
+    void splice(const_iterator position, intrusive_list& other,
+                const_iterator first, const_iterator last) noexcept {
+        if (first == last)
+            return;
+        // within one list the range only moves, the size stays
+        if (this != &other) {
+            const size_type n = MYSTL::distance(first, last);
+            size_ += n;
+            other.size_ -= n;
+        }
+        position.node_->transfer(first.node_, last.node_);
+    }
+
+protected:
+    void empty_initialize() noexcept {
+        node_.prev = node_.next = &node_;
+        size_ = 0;
+    }
+
+    static node_ptr to_node(pointer value) noexcept {
+        return static_cast<Hook*>(value);
+    }
+};
+
+template <typename T, typename Hook>
+void swap(intrusive_list<T, Hook>& lhs, intrusive_list<T, Hook>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
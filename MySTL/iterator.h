@@ -126,6 +126,15 @@ inline void advance(InputIterator& i, Distance n) {
 
 
 
+// operator-> for iterators whose reference is a prvalue (a pair of references, say):
+// the proxy keeps the value alive for the member access
+template <typename Reference>
+struct __arrow_proxy {
+    Reference ref;
+    Reference* operator->() { return &ref; }
+};
+
+
 //reverse_iterator
 template <typename Iterator>
 class reverse_iterator
@@ -8,18 +8,16 @@
 #include "allocator.h"
 #include "memory.h"
 
-namespace LIST_H
+namespace MYSTL
 {
 
 
-
-template <typename T>
-struct list_node {
-    using node_ptr = list_node<T>*;
+// the links only, shared by list_node and the intrusive list hooks
+struct list_node_base {
+    using node_ptr = list_node_base*;
 
     node_ptr prev;
     node_ptr next;
-    T data;
 
 public:
     void hook(node_ptr position) {
@@ -52,6 +50,11 @@ public:
 
 };
 
+template <typename T>
+struct list_node : public list_node_base {
+    T data;
+};
+
 template <typename T>
 struct list_iterator 
     :public MYSTL::iterator<MYSTL::bidirectional_iterator_tag, T>
@@ -61,7 +64,7 @@ struct list_iterator
     using pointer           = T*;
     using reference         = T&;
     using self              = list_iterator<T>;
-    using node_ptr          = list_node<T>*;
+    using node_ptr          = list_node_base*;
 
     node_ptr node_;
 
@@ -69,7 +72,7 @@ struct list_iterator
     list_iterator(const node_ptr& node) :node_(node) {}
     list_iterator(const list_iterator& rhs):node_(rhs.node_) {}
 
-    reference operator*() const { return node_->data; }
+    reference operator*() const { return static_cast<list_node<T>*>(node_)->data; }
     pointer operator->() const { return &(operator*()); }
 
     self& operator++() {
@@ -107,7 +110,7 @@ struct list_const_iterator
     using self              = list_const_iterator<T>;
     using iterator          = list_iterator<T>;
 
-    using node_ptr          = list_node<T>*;
+    using node_ptr          = list_node_base*;
     node_ptr node_;
 
     list_const_iterator() = default;
@@ -116,10 +119,10 @@ struct list_const_iterator
     list_const_iterator(const list_const_iterator& rhs)  : node_(rhs.node_) {}
 
     iterator __const_cast() const noexcept {
-        return iterator(const_cast<list_node<T>*>(node_));
+        return iterator(const_cast<list_node_base*>(node_));
     }
 
-    reference operator*() const { return node_->data; }
+    reference operator*() const { return static_cast<list_node<T>*>(node_)->data; }
     pointer operator->() const { return &(operator*()); }
 
     self& operator++() {
@@ -147,11 +150,11 @@ struct list_const_iterator
 
 
 template <typename T, typename Alloc = MYSTL::allocator<T>>
-class list {
+class list : private __allocator_holder<__rebind_alloc<Alloc, list_node<T>>> {
+    using alloc_base = __allocator_holder<__rebind_alloc<Alloc, list_node<T>>>;
+
 public:
-    using allocator_type         = MYSTL::allocator<T>;
-    using data_allocator         = MYSTL::allocator<T>;
-    using node_allocator         = MYSTL::allocator<list_node<T>>;
+    using allocator_type         = Alloc;
 
     using value_type             = T;
     using reference              = value_type&;
@@ -171,19 +174,20 @@ public:
     using const_reverse_iterator = MYSTL::reverse_iterator<const_iterator>;
 
 protected:
-    using node_ptr               = list_node<T>*;
+    using node_ptr               = list_node_base*;
     node_ptr node_;
     size_type size_;
 
 public:
     list() { empty_initialize(); }
+    explicit list(const allocator_type& a) : alloc_base(a) { empty_initialize(); }
     explicit list(size_type n) { fill_initialize(n, value_type{}); }
     list(size_type n, const T &value) { fill_initialize(n, value); }
 
     template <typename Iterator>
     list(Iterator first, Iterator last) { range_initialize(first, last); }
-    list(const list& rhs) { range_initialize(rhs.begin(), rhs.end()); }
-    list(list&& rhs) noexcept : node_(rhs.node), size_(rhs.size_) 
+    list(const list& rhs) : alloc_base(__select_on_copy(rhs.alloc())) { range_initialize(rhs.begin(), rhs.end()); }
+    list(list&& rhs) noexcept : alloc_base(rhs.alloc()), node_(rhs.node_), size_(rhs.size_) 
     { rhs.node_ = nullptr;   rhs.size_ = 0; }
     list(const std::initializer_list<T> &ilist) { range_initialize(ilist.begin(), ilist.end()); }
 
@@ -194,22 +198,25 @@ public:
         return *this;
     }
 
+    // the nodes move over with the allocator that made them, rhs is left empty
     list &operator=(list&& rhs) {
-        clear();
-        splice(end(), rhs);
+        if(this != &rhs) {
+            list tmp(MYSTL::move(rhs));
+            rhs.empty_initialize();
+            swap(tmp);
+        }
         return *this;
     }
     
     list &operator=(std::initializer_list<T> ilist) {
-        list tmp(ilist.begin(), ilist.end());
-        swap(tmp);
+        assign(ilist.begin(), ilist.end());
         return *this;
     }
 
     ~list() {
         if(node_ != nullptr) {
             clear();
-            node_allocator::deallocate(node_, 1);
+            this->alloc().deallocate(static_cast<list_node<T>*>(node_), 1);
             node_ = nullptr;
             size_ = 0;
         }
@@ -217,7 +224,7 @@ public:
 
 public:
     void empty_initialize() {
-        node_ = node_allocator::allocate(1);
+        node_ = this->alloc().allocate(1);
         node_->next = node_;
         node_->prev = node_;
         size_ = 0;
@@ -240,13 +247,15 @@ public:
         }
         catch(...) {
             clear();
-            node_allocator::deallocate(node_, 1);
+            this->alloc().deallocate(static_cast<list_node<T>*>(node_), 1);
             node_ = nullptr;
             throw;
         }
     }
 
 public:
+    allocator_type get_allocator() const { return allocator_type(this->alloc()); }
+
     //iterators
     iterator        begin()       { return node_->next; }
     const_iterator  begin() const { return node_->next; }
@@ -309,8 +318,7 @@ public:
 
     template <typename... Args>
     void emplace_front(Args&&... args) {
-        __insert(begin(), std::forward<Args>(args)...);
-        return front();
+        __insert(begin(), MYSTL::forward<Args>(args)...);
     }
 
     void  push_front(const value_type& value) {
@@ -359,7 +367,9 @@ public:
     }
     iterator insert(const_iterator position, size_type n, const value_type& value) {
         if(n) {
-            list tmp(n, value);
+            list tmp(get_allocator());
+            for (; n > 0; --n)
+                tmp.push_back(value);
             iterator it = tmp.begin();
             splice(position, tmp);
             return it;
@@ -371,7 +381,9 @@ public:
             //  ,typename = std::_RequireInputIter<InputIterator>
     iterator
     insert(const_iterator position, InputIterator first, InputIterator last) {
-        list tmp(first, last);
+        list tmp(get_allocator());
+        for (; first != last; ++first)
+            tmp.push_back(*first);
         if(!tmp.empty()) {
             iterator it = tmp.begin();
             splice(position, tmp);
@@ -394,6 +406,7 @@ public:
     void swap(list& rhs) {
         MYSTL::swap(node_, rhs.node_);
         MYSTL::swap(size_, rhs.size_);
+        MYSTL::swap(this->alloc(), rhs.alloc());
     }
 
     void resize(size_type new_size) {
@@ -440,18 +453,19 @@ public:
             return;
         transfer(position.__const_cast(), i.__const_cast(), j);
         ++size_;
-        ++other->size_;
+        --other.size_;
     }
 
     void splice(const_iterator position, list&& other, const_iterator first, const_iterator last) {
-        if(first != last && this != &other) {
+        if(first == last)
+            return;
+        // within one list the range only moves, the size stays
+        if(this != &other) {
             auto n = MYSTL::distance(first, last);
             size_ += n;
             other.size_ -= n;
-            transfer(position.__const_cast(), 
-                    first.__const_cast(), 
-                    last.__const_cast());
         }
+        transfer(position.__const_cast(), first.__const_cast(), last.__const_cast());
     }
     void splice(const_iterator position, list& other, const_iterator first, const_iterator last) {
         splice(position, MYSTL::move(other), first, last);
@@ -482,7 +496,7 @@ public:
             auto last = end();
             while(i.node_  != last.node_) {
                 MYSTL::swap(i.node_->prev, i.node_->next);
-                i.node_ = i.node->prev;
+                i.node_ = i.node_->prev;
             }
             MYSTL::swap(last.node_->prev, last.node_->next);
         } 
@@ -492,27 +506,27 @@ protected:
     //helper functions:
     
     template <typename... Args>
-    node_ptr create_node(Args&& ...args) {
-        auto p = node_allocator::allocate(1);
+    list_node<T>* create_node(Args&& ...args) {
+        auto p = this->alloc().allocate(1);
         try {
-            data_allocator::construct(MYSTL::addressof(p->data), MYSTL::forward<Args>(args)...);
+            MYSTL::construct(MYSTL::addressof(p->data), MYSTL::forward<Args>(args)...);
             p->prev = p->next = nullptr;
         }
         catch(...) {
-            node_allocator::deallocate(p, 1);
+            this->alloc().deallocate(p, 1);
             throw;
         }
         return p;
     }
-    void destroy_node(node_ptr p) {
-        data_allocator::destroy(MYSTL::addressof(p->data));
-        node_allocator::deallocate(p, 1);
+    void destroy_node(list_node<T>* p) {
+        MYSTL::destroy(MYSTL::addressof(p->data));
+        this->alloc().deallocate(p, 1);
     }
 
     //连接到position的前一个
     template <typename... Args>
     void __insert(iterator position, Args&&... args) {
-        node_ptr tmp = create_node(MYSTL::forward<Args>(args)...);
+        auto tmp = create_node(MYSTL::forward<Args>(args)...);
         tmp->hook(position.node_);
         ++size_;
     }
@@ -520,7 +534,7 @@ protected:
     void __erase(iterator position) noexcept {
         --size_;
         position.node_->unhook();
-        destroy_node(position.node_);
+        destroy_node(static_cast<list_node<T>*>(position.node_));
     }
 
     void transfer(iterator position, iterator first, iterator last) {
@@ -533,11 +547,11 @@ protected:
 
 // overload swap over MYSTL::swap
 // see <<effective c++>> Item...
-template <typename T>
-void swap(list<T>& lhs, list<T>& rhs) noexcept {
+template <typename T, typename Alloc>
+void swap(list<T, Alloc>& lhs, list<T, Alloc>& rhs) noexcept {
     lhs.swap(rhs);
 }
 
-} // end of namespace list
+} // end of namespace MYSTL
 
 #endif
\ No newline at end of file
@@ -0,0 +1,351 @@
+#ifndef MAP_H_
+#define MAP_H_
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include "rb_tree.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// map / multimap
+// ordered associative containers on rb_tree. insert with a hint just before the right spot
+// (end() for ascending input) is amortized O(1); extract() and insert(node_type&&) move
+// elements between maps without touching the allocator.
+/*****************************************************************************************/
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Alloc = MYSTL::allocator<MYSTL::pair<const Key, T>>>
+class map {
+public:
+    using key_type        = Key;
+    using mapped_type     = T;
+    using value_type      = MYSTL::pair<const Key, T>;
+    using key_compare     = Compare;
+    using allocator_type  = Alloc;
+
+private:
+    using tree_type = rb_tree<key_type, value_type, __select_first<value_type>, key_compare, Alloc>;
+    tree_type tree_;
+
+public:
+    using size_type              = typename tree_type::size_type;
+    using difference_type        = typename tree_type::difference_type;
+    using reference              = typename tree_type::reference;
+    using const_reference        = typename tree_type::const_reference;
+    using iterator               = typename tree_type::iterator;
+    using const_iterator         = typename tree_type::const_iterator;
+    using reverse_iterator       = typename tree_type::reverse_iterator;
+    using const_reverse_iterator = typename tree_type::const_reverse_iterator;
+    using node_type              = typename tree_type::node_type;
+    using insert_return_type     = typename tree_type::insert_return_type;
+
+    class value_compare {
+        friend class map;
+    protected:
+        Compare comp;
+        explicit value_compare(Compare c) : comp(c) {}
+    public:
+        bool operator()(const value_type& lhs, const value_type& rhs) const {
+            return comp(lhs.first, rhs.first);
+        }
+    };
+
+public:
+    map() = default;
+    explicit map(const allocator_type& a) : tree_(a) {}
+    explicit map(const key_compare& comp, const allocator_type& a = allocator_type()) : tree_(comp, a) {}
+
+    template <typename InputIterator>
+    map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+        const allocator_type& a = allocator_type())
+        : tree_(comp, a) { tree_.insert_range_unique(first, last); }
+
+    map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(),
+        const allocator_type& a = allocator_type())
+        : tree_(comp, a) { tree_.insert_range_unique(ilist.begin(), ilist.end()); }
+
+    map(const map&) = default;
+    map(map&&) = default;
+    map& operator=(const map&) = default;
+    map& operator=(map&&) = default;
+    map& operator=(std::initializer_list<value_type> ilist) {
+        tree_.clear();
+        tree_.insert_range_unique(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    //iterators
+    iterator               begin()         { return tree_.begin(); }
+    const_iterator         begin()   const { return tree_.begin(); }
+    iterator               end()           { return tree_.end(); }
+    const_iterator         end()     const { return tree_.end(); }
+    reverse_iterator       rbegin()        { return tree_.rbegin(); }
+    const_reverse_iterator rbegin()  const { return tree_.rbegin(); }
+    reverse_iterator       rend()          { return tree_.rend(); }
+    const_reverse_iterator rend()    const { return tree_.rend(); }
+    const_iterator         cbegin()  const { return begin(); }
+    const_iterator         cend()    const { return end(); }
+    const_reverse_iterator crbegin() const { return rbegin(); }
+    const_reverse_iterator crend()   const { return rend(); }
+
+    //capacity
+    bool      empty()    const { return tree_.empty(); }
+    size_type size()     const { return tree_.size(); }
+    size_type max_size() const { return tree_.max_size(); }
+
+    //element access
+    mapped_type& operator[](const key_type& key) { return try_emplace(key).first->second; }
+    mapped_type& operator[](key_type&& key) { return try_emplace(MYSTL::move(key)).first->second; }
+
+    mapped_type& at(const key_type& key) {
+        auto it = find(key);
+        if (it == end())
+            throw std::out_of_range("map::at");
+        return it->second;
+    }
+    const mapped_type& at(const key_type& key) const {
+        auto it = find(key);
+        if (it == end())
+            throw std::out_of_range("map::at");
+        return it->second;
+    }
+
+    //modifiers
+    MYSTL::pair<iterator, bool> insert(const value_type& value) { return tree_.insert_unique(value); }
+    MYSTL::pair<iterator, bool> insert(value_type&& value) { return tree_.insert_unique(MYSTL::move(value)); }
+    iterator insert(const_iterator hint, const value_type& value) {
+        return tree_.insert_hint_unique(hint, value);
+    }
+    iterator insert(const_iterator hint, value_type&& value) {
+        return tree_.insert_hint_unique(hint, MYSTL::move(value));
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) { tree_.insert_range_unique(first, last); }
+    void insert(std::initializer_list<value_type> ilist) {
+        tree_.insert_range_unique(ilist.begin(), ilist.end());
+    }
+
+    insert_return_type insert(node_type&& nh) { return tree_.insert_unique_node(MYSTL::move(nh)); }
+    iterator insert(const_iterator hint, node_type&& nh) {
+        return tree_.insert_hint_unique_node(hint, MYSTL::move(nh));
+    }
+
+    template <typename... Args>
+    MYSTL::pair<iterator, bool> emplace(Args&&... args) {
+        return tree_.emplace_unique(MYSTL::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return tree_.emplace_hint_unique(hint, MYSTL::forward<Args>(args)...);
+    }
+
+    // constructs the mapped value only when the key is missing
+    template <typename K, typename... Args>
+    MYSTL::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+        auto it = lower_bound(key);
+        if (it != end() && !key_comp()(key, it->first))
+            return MYSTL::pair<iterator, bool>(it, false);
+        return MYSTL::pair<iterator, bool>(
+            tree_.emplace_hint_unique(it, MYSTL::forward<K>(key), mapped_type(MYSTL::forward<Args>(args)...)),
+            true);
+    }
+
+    template <typename M>
+    MYSTL::pair<iterator, bool> insert_or_assign(const key_type& key, M&& value) {
+        auto it = lower_bound(key);
+        if (it != end() && !key_comp()(key, it->first)) {
+            it->second = MYSTL::forward<M>(value);
+            return MYSTL::pair<iterator, bool>(it, false);
+        }
+        return MYSTL::pair<iterator, bool>(tree_.emplace_hint_unique(it, key, MYSTL::forward<M>(value)), true);
+    }
+
+    iterator  erase(const_iterator position) { return tree_.erase(position); }
+    iterator  erase(iterator position) { return tree_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+    size_type erase(const key_type& key) { return tree_.erase(key); }
+
+    node_type extract(const_iterator position) { return tree_.extract(position); }
+    node_type extract(const key_type& key) { return tree_.extract(key); }
+
+    void clear() { tree_.clear(); }
+    void shrink_to_fit() { tree_.shrink_to_fit(); }
+    void swap(map& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    //lookup
+    iterator       find(const key_type& key)       { return tree_.find(key); }
+    const_iterator find(const key_type& key) const { return tree_.find(key); }
+    size_type      count(const key_type& key) const { return find(key) == end() ? 0 : 1; }
+    bool           contains(const key_type& key) const { return find(key) != end(); }
+
+    iterator       lower_bound(const key_type& key)       { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+    iterator       upper_bound(const key_type& key)       { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+    MYSTL::pair<iterator, iterator> equal_range(const key_type& key) { return tree_.equal_range(key); }
+    MYSTL::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return tree_.equal_range(key);
+    }
+
+    //observers
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+    key_compare   key_comp()   const { return tree_.key_comp(); }
+    value_compare value_comp() const { return value_compare(tree_.key_comp()); }
+
+    bool __verify() const { return tree_.__verify(); }
+
+    friend bool operator==(const map& lhs, const map& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator<(const map& lhs, const map& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator!=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void swap(map<Key, T, Compare, Alloc>& lhs, map<Key, T, Compare, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Alloc = MYSTL::allocator<MYSTL::pair<const Key, T>>>
+class multimap {
+public:
+    using key_type        = Key;
+    using mapped_type     = T;
+    using value_type      = MYSTL::pair<const Key, T>;
+    using key_compare     = Compare;
+    using allocator_type  = Alloc;
+
+private:
+    using tree_type = rb_tree<key_type, value_type, __select_first<value_type>, key_compare, Alloc>;
+    tree_type tree_;
+
+public:
+    using size_type              = typename tree_type::size_type;
+    using difference_type        = typename tree_type::difference_type;
+    using reference              = typename tree_type::reference;
+    using const_reference        = typename tree_type::const_reference;
+    using iterator               = typename tree_type::iterator;
+    using const_iterator         = typename tree_type::const_iterator;
+    using reverse_iterator       = typename tree_type::reverse_iterator;
+    using const_reverse_iterator = typename tree_type::const_reverse_iterator;
+    using node_type              = typename tree_type::node_type;
+
+public:
+    multimap() = default;
+    explicit multimap(const allocator_type& a) : tree_(a) {}
+    explicit multimap(const key_compare& comp, const allocator_type& a = allocator_type()) : tree_(comp, a) {}
+
+    template <typename InputIterator>
+    multimap(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+        const allocator_type& a = allocator_type())
+        : tree_(comp, a) { tree_.insert_range_equal(first, last); }
+
+    multimap(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(),
+        const allocator_type& a = allocator_type())
+        : tree_(comp, a) { tree_.insert_range_equal(ilist.begin(), ilist.end()); }
+
+    multimap(const multimap&) = default;
+    multimap(multimap&&) = default;
+    multimap& operator=(const multimap&) = default;
+    multimap& operator=(multimap&&) = default;
+
+    //iterators
+    iterator               begin()         { return tree_.begin(); }
+    const_iterator         begin()   const { return tree_.begin(); }
+    iterator               end()           { return tree_.end(); }
+    const_iterator         end()     const { return tree_.end(); }
+    reverse_iterator       rbegin()        { return tree_.rbegin(); }
+    const_reverse_iterator rbegin()  const { return tree_.rbegin(); }
+    reverse_iterator       rend()          { return tree_.rend(); }
+    const_reverse_iterator rend()    const { return tree_.rend(); }
+    const_iterator         cbegin()  const { return begin(); }
+    const_iterator         cend()    const { return end(); }
+
+    //capacity
+    bool      empty()    const { return tree_.empty(); }
+    size_type size()     const { return tree_.size(); }
+    size_type max_size() const { return tree_.max_size(); }
+
+    //modifiers
+    iterator insert(const value_type& value) { return tree_.insert_equal(value); }
+    iterator insert(value_type&& value) { return tree_.insert_equal(MYSTL::move(value)); }
+    iterator insert(const_iterator hint, const value_type& value) {
+        return tree_.insert_hint_equal(hint, value);
+    }
+    iterator insert(const_iterator hint, value_type&& value) {
+        return tree_.insert_hint_equal(hint, MYSTL::move(value));
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) { tree_.insert_range_equal(first, last); }
+    void insert(std::initializer_list<value_type> ilist) {
+        tree_.insert_range_equal(ilist.begin(), ilist.end());
+    }
+
+    iterator insert(node_type&& nh) { return tree_.insert_equal_node(MYSTL::move(nh)); }
+    iterator insert(const_iterator hint, node_type&& nh) {
+        return tree_.insert_hint_equal_node(hint, MYSTL::move(nh));
+    }
+
+    template <typename... Args>
+    iterator emplace(Args&&... args) { return tree_.emplace_equal(MYSTL::forward<Args>(args)...); }
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return tree_.emplace_hint_equal(hint, MYSTL::forward<Args>(args)...);
+    }
+
+    iterator  erase(const_iterator position) { return tree_.erase(position); }
+    iterator  erase(iterator position) { return tree_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+    size_type erase(const key_type& key) { return tree_.erase(key); }
+
+    node_type extract(const_iterator position) { return tree_.extract(position); }
+    node_type extract(const key_type& key) { return tree_.extract(key); }
+
+    void clear() { tree_.clear(); }
+    void shrink_to_fit() { tree_.shrink_to_fit(); }
+    void swap(multimap& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    //lookup
+    iterator       find(const key_type& key)       { return tree_.find(key); }
+    const_iterator find(const key_type& key) const { return tree_.find(key); }
+    size_type      count(const key_type& key) const { return tree_.count(key); }
+    bool           contains(const key_type& key) const { return find(key) != end(); }
+
+    iterator       lower_bound(const key_type& key)       { return tree_.lower_bound(key); }
+    const_iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+    iterator       upper_bound(const key_type& key)       { return tree_.upper_bound(key); }
+    const_iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+    MYSTL::pair<iterator, iterator> equal_range(const key_type& key) { return tree_.equal_range(key); }
+    MYSTL::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return tree_.equal_range(key);
+    }
+
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+    key_compare key_comp() const { return tree_.key_comp(); }
+
+    bool __verify() const { return tree_.__verify(); }
+
+    friend bool operator==(const multimap& lhs, const multimap& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator<(const multimap& lhs, const multimap& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool operator!=(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void swap(multimap<Key, T, Compare, Alloc>& lhs, multimap<Key, T, Compare, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -4,6 +4,8 @@
 #include <cstddef>
 #include <cstdlib>
 #include <climits>
+#include <atomic>
+#include <exception>
 
 #include "allocator.h"
 #include "construct.h"
@@ -21,64 +23,864 @@ constexpr T* addressof(T& value) noexcept {
 
 //my smart pointer
 
-// unique_ptr, without Deleter
+/*****************************************************************************************/
+// unique_ptr
+// the deleter is kept in a __compressed_pair with the pointer, so a stateless deleter
+// (default_delete, an empty functor) adds nothing and unique_ptr stays one pointer.
+// Deleter::pointer, when present, replaces T* as the stored handle type.
+/*****************************************************************************************/
+
+template <typename T>
+struct default_delete {
+    constexpr default_delete() noexcept = default;
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    default_delete(const default_delete<U>&) noexcept {}
+
+    void operator()(T* p) const noexcept {
+        static_assert(sizeof(T) > 0, "can't delete an incomplete type");
+        delete p;
+    }
+};
+
 template <typename T>
-class unique_ptr 
+struct default_delete<T[]> {
+    constexpr default_delete() noexcept = default;
+
+    void operator()(T* p) const noexcept {
+        static_assert(sizeof(T) > 0, "can't delete an incomplete type");
+        delete[] p;
+    }
+};
+
+// Deleter::pointer if it exists, otherwise T*
+template <typename T, typename Deleter, typename = void>
+struct __unique_ptr_pointer {
+    using type = T*;
+};
+
+template <typename T, typename Deleter>
+struct __unique_ptr_pointer<T, Deleter,
+    decltype(void(sizeof(typename std::remove_reference<Deleter>::type::pointer)))> {
+    using type = typename std::remove_reference<Deleter>::type::pointer;
+};
+
+template <typename T, typename Deleter = default_delete<T>>
+class unique_ptr
 {
-    
+public:
+    using pointer      = typename __unique_ptr_pointer<T, Deleter>::type;
+    using element_type = T;
+    using deleter_type = Deleter;
+
 private:
-    T* ptr;
+    __compressed_pair<pointer, Deleter> ptr_;
+
+    template <typename U, typename E> friend class unique_ptr;
 
 public:
-    explicit 
-    unique_ptr(T* ptr = nullptr) noexcept 
-        :ptr(ptr) {}
+    constexpr unique_ptr() noexcept : ptr_(pointer(), Deleter()) {}
+    constexpr unique_ptr(std::nullptr_t) noexcept : ptr_(pointer(), Deleter()) {}
+
+    explicit unique_ptr(pointer p) noexcept : ptr_(p, Deleter()) {}
+    unique_ptr(pointer p, const Deleter& d) noexcept : ptr_(p, d) {}
+    unique_ptr(pointer p, typename std::remove_reference<Deleter>::type&& d) noexcept
+        : ptr_(p, MYSTL::move(d)) {}
 
     unique_ptr(const unique_ptr&) = delete;
-    unique_ptr& opeartor=(const unique_ptr&) = delete;
+    unique_ptr& operator=(const unique_ptr&) = delete;
 
     unique_ptr(unique_ptr&& rhs) noexcept
-        : ptr(MYSTL::move(rhs))  { rhs.ptr = nullptr; }
+        : ptr_(rhs.release(), MYSTL::forward<Deleter>(rhs.get_deleter())) {}
+
+    template <typename U, typename E, typename = typename std::enable_if<
+              std::is_convertible<typename unique_ptr<U, E>::pointer, pointer>::value &&
+              !std::is_array<U>::value>::type>
+    unique_ptr(unique_ptr<U, E>&& rhs) noexcept
+        : ptr_(rhs.release(), MYSTL::forward<E>(rhs.get_deleter())) {}
+
     unique_ptr& operator=(unique_ptr&& rhs) noexcept {
         reset(rhs.release());
+        get_deleter() = MYSTL::forward<Deleter>(rhs.get_deleter());
+        return *this;
+    }
+
+    template <typename U, typename E>
+    unique_ptr& operator=(unique_ptr<U, E>&& rhs) noexcept {
+        reset(rhs.release());
+        get_deleter() = MYSTL::forward<E>(rhs.get_deleter());
         return *this;
     }
 
-    ~unique_ptr() { delete ptr; }
+    unique_ptr& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
 
+    ~unique_ptr() {
+        if (ptr_.first() != pointer())
+            get_deleter()(ptr_.first());
+    }
 
-    T *operator->() const noexcept { return ptr; }
-    T &operator*() const noexcept { return *ptr; }
-    T *get() const noexcept { return ptr; }
-    explicit operator bool() const { return ptr; }
+
+    typename std::add_lvalue_reference<T>::type operator*() const { return *ptr_.first(); }
+    pointer operator->() const noexcept { return ptr_.first(); }
+    pointer get() const noexcept { return ptr_.first(); }
+    Deleter&       get_deleter()       noexcept { return ptr_.second(); }
+    const Deleter& get_deleter() const noexcept { return ptr_.second(); }
+    explicit operator bool() const noexcept { return ptr_.first() != pointer(); }
 
     void swap(unique_ptr& rhs) noexcept {
-        using std::swap;
-        swap(ptr, rhs.ptr);
+        ptr_.swap(rhs.ptr_);
     }
 
-    void reset(T* p = nullptr) noexcept {
-        const T* old_ptr = ptr;
-        ptr = p;
-        if(old_ptr)
-            delete old_ptr;
+    void reset(pointer p = pointer()) noexcept {
+        pointer old_ptr = ptr_.first();
+        ptr_.first() = p;
+        if (old_ptr != pointer())
+            get_deleter()(old_ptr);
     }
 
-    T* release() {
-        T *result = nullptr;
-        std::swap(result, ptr);
+    pointer release() noexcept {
+        pointer result = ptr_.first();
+        ptr_.first() = pointer();
         return result;
     }
 };
 
+// arrays: operator[] instead of * and ->, no conversions between element types
+template <typename T, typename Deleter>
+class unique_ptr<T[], Deleter>
+{
+public:
+    using pointer      = typename __unique_ptr_pointer<T, Deleter>::type;
+    using element_type = T;
+    using deleter_type = Deleter;
+
+private:
+    __compressed_pair<pointer, Deleter> ptr_;
+
+public:
+    constexpr unique_ptr() noexcept : ptr_(pointer(), Deleter()) {}
+    constexpr unique_ptr(std::nullptr_t) noexcept : ptr_(pointer(), Deleter()) {}
+
+    explicit unique_ptr(pointer p) noexcept : ptr_(p, Deleter()) {}
+    unique_ptr(pointer p, const Deleter& d) noexcept : ptr_(p, d) {}
+    unique_ptr(pointer p, typename std::remove_reference<Deleter>::type&& d) noexcept
+        : ptr_(p, MYSTL::move(d)) {}
+
+    unique_ptr(const unique_ptr&) = delete;
+    unique_ptr& operator=(const unique_ptr&) = delete;
+
+    unique_ptr(unique_ptr&& rhs) noexcept
+        : ptr_(rhs.release(), MYSTL::forward<Deleter>(rhs.get_deleter())) {}
+
+    unique_ptr& operator=(unique_ptr&& rhs) noexcept {
+        reset(rhs.release());
+        get_deleter() = MYSTL::forward<Deleter>(rhs.get_deleter());
+        return *this;
+    }
+
+    unique_ptr& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    ~unique_ptr() {
+        if (ptr_.first() != pointer())
+            get_deleter()(ptr_.first());
+    }
+
+    T& operator[](size_t i) const { return ptr_.first()[i]; }
+    pointer get() const noexcept { return ptr_.first(); }
+    Deleter&       get_deleter()       noexcept { return ptr_.second(); }
+    const Deleter& get_deleter() const noexcept { return ptr_.second(); }
+    explicit operator bool() const noexcept { return ptr_.first() != pointer(); }
+
+    void swap(unique_ptr& rhs) noexcept {
+        ptr_.swap(rhs.ptr_);
+    }
+
+    void reset(pointer p = pointer()) noexcept {
+        pointer old_ptr = ptr_.first();
+        ptr_.first() = p;
+        if (old_ptr != pointer())
+            get_deleter()(old_ptr);
+    }
+
+    pointer release() noexcept {
+        pointer result = ptr_.first();
+        ptr_.first() = pointer();
+        return result;
+    }
+};
+
+template <typename T, typename D>
+void swap(unique_ptr<T, D>& lhs, unique_ptr<T, D>& rhs) noexcept { lhs.swap(rhs); }
+
+template <typename T1, typename D1, typename T2, typename D2>
+bool operator==(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    return lhs.get() == rhs.get();
+}
+
+template <typename T1, typename D1, typename T2, typename D2>
+bool operator!=(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    return lhs.get() != rhs.get();
+}
+
+template <typename T1, typename D1, typename T2, typename D2>
+bool operator<(const unique_ptr<T1, D1>& lhs, const unique_ptr<T2, D2>& rhs) {
+    return lhs.get() < rhs.get();
+}
+
+template <typename T, typename D>
+bool operator==(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept { return !lhs; }
+
+template <typename T, typename D>
+bool operator==(std::nullptr_t, const unique_ptr<T, D>& rhs) noexcept { return !rhs; }
+
+template <typename T, typename D>
+bool operator!=(const unique_ptr<T, D>& lhs, std::nullptr_t) noexcept { return static_cast<bool>(lhs); }
+
+template <typename T, typename D>
+bool operator!=(std::nullptr_t, const unique_ptr<T, D>& rhs) noexcept { return static_cast<bool>(rhs); }
+
+
+// make_unique value-initializes (zeroes arrays of trivial types),
+// make_unique_for_overwrite default-initializes, leaving trivial elements uninitialized.
+template <typename T>
+struct __unique_if {
+    using single_object = unique_ptr<T>;
+};
+
+template <typename T>
+struct __unique_if<T[]> {
+    using unknown_bound = unique_ptr<T[]>;
+};
+
+template <typename T, size_t N>
+struct __unique_if<T[N]> {
+    using known_bound = void;
+};
+
+template <typename T, typename... Args>
+typename __unique_if<T>::single_object make_unique(Args&&... args) {
+    return unique_ptr<T>(new T(MYSTL::forward<Args>(args)...));
+}
+
+template <typename T>
+typename __unique_if<T>::unknown_bound make_unique(size_t n) {
+    using U = typename std::remove_extent<T>::type;
+    return unique_ptr<T>(new U[n]());
+}
+
+template <typename T, typename... Args>
+typename __unique_if<T>::known_bound make_unique(Args&&...) = delete;
+
+template <typename T>
+typename __unique_if<T>::single_object make_unique_for_overwrite() {
+    return unique_ptr<T>(new T);
+}
+
+template <typename T>
+typename __unique_if<T>::unknown_bound make_unique_for_overwrite(size_t n) {
+    using U = typename std::remove_extent<T>::type;
+    return unique_ptr<T>(new U[n]);
+}
+
+template <typename T, typename... Args>
+typename __unique_if<T>::known_bound make_unique_for_overwrite(Args&&...) = delete;
+
+
+
+/*****************************************************************************************/
+// shared_ptr / weak_ptr, local_shared_ptr / local_weak_ptr
+// every owning group shares one control block holding two counters:
+//   use_count  : number of owners, the object dies when it drops to 0
+//   weak_count : number of weak refs, +1 while use_count > 0, the block dies at 0
+// the counting policy decides how the counters are updated: shared_ptr uses atomics,
+// local_shared_ptr plain integers for pointers that never leave one thread.
+/*****************************************************************************************/
+
+class bad_weak_ptr : public std::exception
+{
+public:
+    const char* what() const noexcept override { return "MYSTL::bad_weak_ptr"; }
+};
+
+struct __sp_atomic_policy
+{
+    using count_type = std::atomic<long>;
+
+    static void increment(count_type& c) noexcept {
+        c.fetch_add(1, std::memory_order_relaxed);
+    }
+    // true if c dropped to 0
+    static bool decrement(count_type& c) noexcept {
+        return c.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+    static bool increment_if_nonzero(count_type& c) noexcept {
+        long count = c.load(std::memory_order_relaxed);
+        while (count != 0) {
+            if (c.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel,
+                                        std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+    static long load(const count_type& c) noexcept {
+        return c.load(std::memory_order_relaxed);
+    }
+};
+
+struct __sp_local_policy
+{
+    using count_type = long;
+
+    static void increment(count_type& c) noexcept { ++c; }
+    static bool decrement(count_type& c) noexcept { return --c == 0; }
+    static bool increment_if_nonzero(count_type& c) noexcept {
+        if (c == 0)  return false;
+        ++c;
+        return true;
+    }
+    static long load(const count_type& c) noexcept { return c; }
+};
+
+template <typename Policy>
+class __sp_counted_base
+{
+private:
+    typename Policy::count_type use_count_;
+    typename Policy::count_type weak_count_;
+
+public:
+    __sp_counted_base() noexcept : use_count_(1), weak_count_(1) {}
+    __sp_counted_base(const __sp_counted_base&) = delete;
+    __sp_counted_base& operator=(const __sp_counted_base&) = delete;
+    virtual ~__sp_counted_base() = default;
+
+    // destroys the managed object
+    virtual void dispose() noexcept = 0;
+    // frees the control block itself
+    virtual void destroy() noexcept = 0;
+
+    void add_ref() noexcept { Policy::increment(use_count_); }
+
+    // for weak_ptr::lock, only succeeds while the object is alive
+    bool add_ref_lock() noexcept { return Policy::increment_if_nonzero(use_count_); }
+
+    void release() noexcept {
+        if (Policy::decrement(use_count_)) {
+            dispose();
+            weak_release();
+        }
+    }
+
+    void weak_add_ref() noexcept { Policy::increment(weak_count_); }
+
+    void weak_release() noexcept {
+        if (Policy::decrement(weak_count_))
+            destroy();
+    }
+
+    long use_count() const noexcept { return Policy::load(use_count_); }
+};
+
+// object allocated separately, freed with a deleter
+template <typename Ptr, typename Deleter, typename Policy>
+class __sp_counted_deleter : public __sp_counted_base<Policy>
+{
+private:
+    Ptr ptr_;
+    Deleter deleter_;
+
+public:
+    __sp_counted_deleter(Ptr p, Deleter d) noexcept
+        : ptr_(p), deleter_(MYSTL::move(d)) {}
+
+    void dispose() noexcept override { deleter_(ptr_); }
+    void destroy() noexcept override { delete this; }
+};
+
 template <typename T>
-void swap(unique_ptr<T>& lhs, unique_ptr<T>& rhs) noexcept { lhs.swap(rhs); }
+struct __sp_default_delete {
+    void operator()(T* p) const noexcept { delete p; }
+};
 
+// object and control block in one allocation, used by make_shared / allocate_shared
+template <typename T, typename Alloc, typename Policy>
+class __sp_counted_inplace : public __sp_counted_base<Policy>
+{
+public:
+    using block_allocator = typename Alloc::template rebind<__sp_counted_inplace>::other;
+
+private:
+    block_allocator alloc_;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage_;
+
+public:
+    template <typename... Args>
+    explicit __sp_counted_inplace(const Alloc& a, Args&&... args)
+        : alloc_(a) {
+        MYSTL::construct(get(), MYSTL::forward<Args>(args)...);
+    }
+
+    T* get() noexcept { return reinterpret_cast<T*>(&storage_); }
 
+    void dispose() noexcept override { MYSTL::destroy(get()); }
 
+    void destroy() noexcept override {
+        block_allocator a(alloc_);
+        this->~__sp_counted_inplace();
+        a.deallocate(this, 1);
+    }
+};
 
 
+template <typename T, typename Policy> class __weak_ptr;
+
+template <typename T, typename Policy>
+class __shared_ptr
+{
+public:
+    using element_type = T;
+    using weak_type    = __weak_ptr<T, Policy>;
+
+private:
+    T* ptr_;
+    __sp_counted_base<Policy>* cnt_;
+
+    template <typename U, typename P> friend class __shared_ptr;
+    template <typename U, typename P> friend class __weak_ptr;
+    template <typename U, typename P, typename Alloc, typename... Args>
+    friend __shared_ptr<U, P> __allocate_shared(const Alloc& a, Args&&... args);
+
+    // adopts an already counted block
+    __shared_ptr(T* p, __sp_counted_base<Policy>* c) noexcept : ptr_(p), cnt_(c) {}
+
+public:
+    constexpr __shared_ptr() noexcept : ptr_(nullptr), cnt_(nullptr) {}
+    constexpr __shared_ptr(std::nullptr_t) noexcept : ptr_(nullptr), cnt_(nullptr) {}
+
+    template <typename U>
+    explicit __shared_ptr(U* p) : __shared_ptr(p, __sp_default_delete<U>()) {}
+
+    template <typename U, typename Deleter>
+    __shared_ptr(U* p, Deleter d) : ptr_(p), cnt_(nullptr) {
+        try {
+            cnt_ = new __sp_counted_deleter<U*, Deleter, Policy>(p, d);
+        }
+        catch(...) {
+            d(p);
+            throw;
+        }
+    }
+
+    // aliasing: shares ownership with rhs but points at p
+    template <typename U>
+    __shared_ptr(const __shared_ptr<U, Policy>& rhs, T* p) noexcept : ptr_(p), cnt_(rhs.cnt_) {
+        if (cnt_)  cnt_->add_ref();
+    }
+
+    __shared_ptr(const __shared_ptr& rhs) noexcept : ptr_(rhs.ptr_), cnt_(rhs.cnt_) {
+        if (cnt_)  cnt_->add_ref();
+    }
+
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    __shared_ptr(const __shared_ptr<U, Policy>& rhs) noexcept : ptr_(rhs.ptr_), cnt_(rhs.cnt_) {
+        if (cnt_)  cnt_->add_ref();
+    }
+
+    __shared_ptr(__shared_ptr&& rhs) noexcept : ptr_(rhs.ptr_), cnt_(rhs.cnt_) {
+        rhs.ptr_ = nullptr;
+        rhs.cnt_ = nullptr;
+    }
 
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    __shared_ptr(__shared_ptr<U, Policy>&& rhs) noexcept : ptr_(rhs.ptr_), cnt_(rhs.cnt_) {
+        rhs.ptr_ = nullptr;
+        rhs.cnt_ = nullptr;
+    }
+
+    template <typename U>
+    explicit __shared_ptr(const __weak_ptr<U, Policy>& rhs) : ptr_(nullptr), cnt_(nullptr) {
+        if (rhs.cnt_ == nullptr || !rhs.cnt_->add_ref_lock())
+            throw bad_weak_ptr();
+        ptr_ = rhs.ptr_;
+        cnt_ = rhs.cnt_;
+    }
+
+    template <typename U, typename D>
+    __shared_ptr(unique_ptr<U, D>&& rhs) : __shared_ptr() {
+        if (rhs) {
+            __shared_ptr tmp(rhs.get(), MYSTL::move(rhs.get_deleter()));
+            rhs.release();
+            swap(tmp);
+        }
+    }
+
+    ~__shared_ptr() {
+        if (cnt_)  cnt_->release();
+    }
+
+    __shared_ptr& operator=(const __shared_ptr& rhs) noexcept {
+        __shared_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    template <typename U>
+    __shared_ptr& operator=(const __shared_ptr<U, Policy>& rhs) noexcept {
+        __shared_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    __shared_ptr& operator=(__shared_ptr&& rhs) noexcept {
+        __shared_ptr(MYSTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <typename U>
+    __shared_ptr& operator=(__shared_ptr<U, Policy>&& rhs) noexcept {
+        __shared_ptr(MYSTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    template <typename U, typename D>
+    __shared_ptr& operator=(unique_ptr<U, D>&& rhs) {
+        __shared_ptr(MYSTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    //modifiers
+    void reset() noexcept { __shared_ptr().swap(*this); }
+
+    template <typename U>
+    void reset(U* p) { __shared_ptr(p).swap(*this); }
+
+    template <typename U, typename Deleter>
+    void reset(U* p, Deleter d) { __shared_ptr(p, d).swap(*this); }
+
+    void swap(__shared_ptr& rhs) noexcept {
+        MYSTL::swap(ptr_, rhs.ptr_);
+        MYSTL::swap(cnt_, rhs.cnt_);
+    }
+
+    //observers
+    T* get() const noexcept { return ptr_; }
+    T& operator*() const noexcept { return *ptr_; }
+    T* operator->() const noexcept { return ptr_; }
+    long use_count() const noexcept { return cnt_ ? cnt_->use_count() : 0; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    template <typename U>
+    bool owner_before(const __shared_ptr<U, Policy>& rhs) const noexcept { return cnt_ < rhs.cnt_; }
+    template <typename U>
+    bool owner_before(const __weak_ptr<U, Policy>& rhs) const noexcept { return cnt_ < rhs.cnt_; }
+};
+
+
+template <typename T, typename Policy>
+class __weak_ptr
+{
+public:
+    using element_type = T;
+
+private:
+    T* ptr_;
+    __sp_counted_base<Policy>* cnt_;
+
+    template <typename U, typename P> friend class __shared_ptr;
+    template <typename U, typename P> friend class __weak_ptr;
+
+public:
+    constexpr __weak_ptr() noexcept : ptr_(nullptr), cnt_(nullptr) {}
+
+    __weak_ptr(const __weak_ptr& rhs) noexcept : ptr_(rhs.ptr_), cnt_(rhs.cnt_) {
+        if (cnt_)  cnt_->weak_add_ref();
+    }
+
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    __weak_ptr(const __weak_ptr<U, Policy>& rhs) noexcept : ptr_(rhs.ptr_), cnt_(rhs.cnt_) {
+        if (cnt_)  cnt_->weak_add_ref();
+    }
+
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    __weak_ptr(const __shared_ptr<U, Policy>& rhs) noexcept : ptr_(rhs.ptr_), cnt_(rhs.cnt_) {
+        if (cnt_)  cnt_->weak_add_ref();
+    }
+
+    __weak_ptr(__weak_ptr&& rhs) noexcept : ptr_(rhs.ptr_), cnt_(rhs.cnt_) {
+        rhs.ptr_ = nullptr;
+        rhs.cnt_ = nullptr;
+    }
+
+    ~__weak_ptr() {
+        if (cnt_)  cnt_->weak_release();
+    }
+
+    __weak_ptr& operator=(const __weak_ptr& rhs) noexcept {
+        __weak_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    template <typename U>
+    __weak_ptr& operator=(const __shared_ptr<U, Policy>& rhs) noexcept {
+        __weak_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    __weak_ptr& operator=(__weak_ptr&& rhs) noexcept {
+        __weak_ptr(MYSTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    void reset() noexcept { __weak_ptr().swap(*this); }
+
+    void swap(__weak_ptr& rhs) noexcept {
+        MYSTL::swap(ptr_, rhs.ptr_);
+        MYSTL::swap(cnt_, rhs.cnt_);
+    }
+
+    long use_count() const noexcept { return cnt_ ? cnt_->use_count() : 0; }
+    bool expired() const noexcept { return use_count() == 0; }
+
+    __shared_ptr<T, Policy> lock() const noexcept {
+        if (cnt_ && cnt_->add_ref_lock())
+            return __shared_ptr<T, Policy>(ptr_, cnt_);
+        return __shared_ptr<T, Policy>();
+    }
+
+    template <typename U>
+    bool owner_before(const __shared_ptr<U, Policy>& rhs) const noexcept { return cnt_ < rhs.cnt_; }
+    template <typename U>
+    bool owner_before(const __weak_ptr<U, Policy>& rhs) const noexcept { return cnt_ < rhs.cnt_; }
+};
+
+
+// one allocation holds both the control block and the object
+template <typename T, typename Policy, typename Alloc, typename... Args>
+__shared_ptr<T, Policy> __allocate_shared(const Alloc& a, Args&&... args) {
+    using block_type = __sp_counted_inplace<T, Alloc, Policy>;
+    typename block_type::block_allocator block_alloc(a);
+    block_type* block = block_alloc.allocate(1);
+    try {
+        ::new (static_cast<void*>(block)) block_type(a, MYSTL::forward<Args>(args)...);
+    }
+    catch(...) {
+        block_alloc.deallocate(block, 1);
+        throw;
+    }
+    return __shared_ptr<T, Policy>(block->get(), static_cast<__sp_counted_base<Policy>*>(block));
+}
+
+
+// thread-safe counting
+template <typename T>
+using shared_ptr = __shared_ptr<T, __sp_atomic_policy>;
+template <typename T>
+using weak_ptr = __weak_ptr<T, __sp_atomic_policy>;
+
+// non-atomic counting, copies of one group must stay on one thread
+template <typename T>
+using local_shared_ptr = __shared_ptr<T, __sp_local_policy>;
+template <typename T>
+using local_weak_ptr = __weak_ptr<T, __sp_local_policy>;
+
+
+template <typename T, typename Alloc, typename... Args>
+shared_ptr<T> allocate_shared(const Alloc& a, Args&&... args) {
+    return MYSTL::__allocate_shared<T, __sp_atomic_policy>(a, MYSTL::forward<Args>(args)...);
+}
+
+template <typename T, typename... Args>
+shared_ptr<T> make_shared(Args&&... args) {
+    return MYSTL::allocate_shared<T>(MYSTL::allocator<T>(), MYSTL::forward<Args>(args)...);
+}
+
+template <typename T, typename Alloc, typename... Args>
+local_shared_ptr<T> allocate_local_shared(const Alloc& a, Args&&... args) {
+    return MYSTL::__allocate_shared<T, __sp_local_policy>(a, MYSTL::forward<Args>(args)...);
+}
+
+template <typename T, typename... Args>
+local_shared_ptr<T> make_local_shared(Args&&... args) {
+    return MYSTL::allocate_local_shared<T>(MYSTL::allocator<T>(), MYSTL::forward<Args>(args)...);
+}
+
+template <typename T, typename U, typename Policy>
+__shared_ptr<T, Policy> static_pointer_cast(const __shared_ptr<U, Policy>& rhs) noexcept {
+    return __shared_ptr<T, Policy>(rhs, static_cast<T*>(rhs.get()));
+}
+
+template <typename T, typename U, typename Policy>
+__shared_ptr<T, Policy> const_pointer_cast(const __shared_ptr<U, Policy>& rhs) noexcept {
+    return __shared_ptr<T, Policy>(rhs, const_cast<T*>(rhs.get()));
+}
+
+template <typename T, typename U, typename Policy>
+__shared_ptr<T, Policy> dynamic_pointer_cast(const __shared_ptr<U, Policy>& rhs) noexcept {
+    T* p = dynamic_cast<T*>(rhs.get());
+    return p ? __shared_ptr<T, Policy>(rhs, p) : __shared_ptr<T, Policy>();
+}
+
+template <typename T, typename Policy>
+void swap(__shared_ptr<T, Policy>& lhs, __shared_ptr<T, Policy>& rhs) noexcept { lhs.swap(rhs); }
+
+template <typename T, typename Policy>
+void swap(__weak_ptr<T, Policy>& lhs, __weak_ptr<T, Policy>& rhs) noexcept { lhs.swap(rhs); }
+
+template <typename T, typename U, typename Policy>
+bool operator==(const __shared_ptr<T, Policy>& lhs, const __shared_ptr<U, Policy>& rhs) noexcept {
+    return lhs.get() == rhs.get();
+}
+
+template <typename T, typename U, typename Policy>
+bool operator!=(const __shared_ptr<T, Policy>& lhs, const __shared_ptr<U, Policy>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename U, typename Policy>
+bool operator<(const __shared_ptr<T, Policy>& lhs, const __shared_ptr<U, Policy>& rhs) noexcept {
+    return lhs.get() < rhs.get();
+}
+
+template <typename T, typename Policy>
+bool operator==(const __shared_ptr<T, Policy>& lhs, std::nullptr_t) noexcept { return !lhs; }
+
+template <typename T, typename Policy>
+bool operator==(std::nullptr_t, const __shared_ptr<T, Policy>& rhs) noexcept { return !rhs; }
+
+template <typename T, typename Policy>
+bool operator!=(const __shared_ptr<T, Policy>& lhs, std::nullptr_t) noexcept { return static_cast<bool>(lhs); }
+
+template <typename T, typename Policy>
+bool operator!=(std::nullptr_t, const __shared_ptr<T, Policy>& rhs) noexcept { return static_cast<bool>(rhs); }
+
+
+
+
+/*****************************************************************************************/
+// intrusive_ptr
+// the count lives in the object. intrusive_ptr_add_ref(T*) and intrusive_ptr_release(T*)
+// are found by ADL, release must free the object once the count reaches 0.
+/*****************************************************************************************/
+
+template <typename T>
+class intrusive_ptr
+{
+public:
+    using element_type = T;
+
+private:
+    T* ptr_;
+
+public:
+    constexpr intrusive_ptr() noexcept : ptr_(nullptr) {}
+
+    // add_ref = false adopts a reference the caller already holds
+    intrusive_ptr(T* p, bool add_ref = true) : ptr_(p) {
+        if (ptr_ && add_ref)  intrusive_ptr_add_ref(ptr_);
+    }
+
+    intrusive_ptr(const intrusive_ptr& rhs) : ptr_(rhs.ptr_) {
+        if (ptr_)  intrusive_ptr_add_ref(ptr_);
+    }
+
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    intrusive_ptr(const intrusive_ptr<U>& rhs) : ptr_(rhs.get()) {
+        if (ptr_)  intrusive_ptr_add_ref(ptr_);
+    }
+
+    intrusive_ptr(intrusive_ptr&& rhs) noexcept : ptr_(rhs.ptr_) { rhs.ptr_ = nullptr; }
+
+    ~intrusive_ptr() {
+        if (ptr_)  intrusive_ptr_release(ptr_);
+    }
+
+    intrusive_ptr& operator=(const intrusive_ptr& rhs) {
+        intrusive_ptr(rhs).swap(*this);
+        return *this;
+    }
+
+    intrusive_ptr& operator=(intrusive_ptr&& rhs) noexcept {
+        intrusive_ptr(MYSTL::move(rhs)).swap(*this);
+        return *this;
+    }
+
+    intrusive_ptr& operator=(T* p) {
+        intrusive_ptr(p).swap(*this);
+        return *this;
+    }
+
+    void reset() { intrusive_ptr().swap(*this); }
+    void reset(T* p, bool add_ref = true) { intrusive_ptr(p, add_ref).swap(*this); }
+
+    // gives up the reference without releasing it
+    T* detach() noexcept {
+        T* p = ptr_;
+        ptr_ = nullptr;
+        return p;
+    }
+
+    void swap(intrusive_ptr& rhs) noexcept { MYSTL::swap(ptr_, rhs.ptr_); }
+
+    T* get() const noexcept { return ptr_; }
+    T& operator*() const noexcept { return *ptr_; }
+    T* operator->() const noexcept { return ptr_; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+};
+
+template <typename T>
+void swap(intrusive_ptr<T>& lhs, intrusive_ptr<T>& rhs) noexcept { lhs.swap(rhs); }
+
+template <typename T, typename U>
+bool operator==(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) noexcept {
+    return lhs.get() == rhs.get();
+}
+
+template <typename T, typename U>
+bool operator!=(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) noexcept {
+    return lhs.get() != rhs.get();
+}
+
+template <typename T, typename U>
+bool operator<(const intrusive_ptr<T>& lhs, const intrusive_ptr<U>& rhs) noexcept {
+    return lhs.get() < rhs.get();
+}
+
+template <typename T>
+bool operator==(const intrusive_ptr<T>& lhs, std::nullptr_t) noexcept { return !lhs; }
+
+template <typename T>
+bool operator!=(const intrusive_ptr<T>& lhs, std::nullptr_t) noexcept { return static_cast<bool>(lhs); }
+
+// optional base providing the count and the two ADL hooks, using the same counting
+// policies as shared_ptr. Derived is deleted through its own type, no virtual dtor needed.
+template <typename Derived, typename Policy = __sp_atomic_policy>
+class intrusive_ref_counter
+{
+private:
+    mutable typename Policy::count_type ref_count_;
+
+public:
+    intrusive_ref_counter() noexcept : ref_count_(0) {}
+    intrusive_ref_counter(const intrusive_ref_counter&) noexcept : ref_count_(0) {}
+    intrusive_ref_counter& operator=(const intrusive_ref_counter&) noexcept { return *this; }
+
+    long use_count() const noexcept { return Policy::load(ref_count_); }
+
+    friend void intrusive_ptr_add_ref(const Derived* p) noexcept {
+        Policy::increment(static_cast<const intrusive_ref_counter*>(p)->ref_count_);
+    }
+
+    friend void intrusive_ptr_release(const Derived* p) noexcept {
+        if (Policy::decrement(static_cast<const intrusive_ref_counter*>(p)->ref_count_))
+            delete p;
+    }
+
+protected:
+    ~intrusive_ref_counter() = default;
+};
 
 
 
@@ -86,4 +888,4 @@ void swap(unique_ptr<T>& lhs, unique_ptr<T>& rhs) noexcept { lhs.swap(rhs); }
 } //namespace MYSTL
 
 
-#endif
\ No newline at end of file
+#endif
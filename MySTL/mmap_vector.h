@@ -0,0 +1,223 @@
+#ifndef MMAP_VECTOR_H_
+#define MMAP_VECTOR_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "iterator.h"
+#include "utility.h"
+#include "algobase.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// mmap_vector
+// a file of trivially copyable T mapped into memory (POSIX mmap), with the const
+// interface of MYSTL::vector: opening costs no reads and no copy, pages are faulted in
+// from the page cache on first touch and shared by every process mapping the same file.
+// the mode is a template parameter, so the element type of the accessors follows it:
+//   read_only      PROT_READ, MAP_SHARED. every accessor, const or not, yields const T
+//   copy_on_write  MAP_PRIVATE: writes go to private copies of the touched pages, the
+//                  file never changes
+// the madvise hint tells the kernel how to read ahead: sequential for scans, random for
+// lookups, willneed to start reading everything now. huge_pages asks for transparent
+// huge pages; the kernel honours it for copy-on-write pages and for file systems with
+// large folio support, elsewhere it is a no-op.
+// the file must hold a whole number of T. the mapping is fixed in size and move-only.
+/*****************************************************************************************/
+
+enum class map_mode { read_only, copy_on_write };
+enum class map_advice { normal, sequential, random, willneed };
+
+template <typename T, map_mode Mode = map_mode::read_only>
+class mmap_vector {
+    static_assert(std::is_trivially_copyable<T>::value, "mmap_vector needs trivially copyable elements");
+
+    // what the non-const accessors hand out: a write into a PROT_READ page would fault
+    using element_type = typename std::conditional<Mode == map_mode::read_only, const T, T>::type;
+
+public:
+    using value_type             = T;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using pointer                = element_type*;
+    using const_pointer          = const T*;
+    using reference              = element_type&;
+    using const_reference        = const T&;
+    using iterator               = element_type*;
+    using const_iterator         = const T*;
+    using reverse_iterator       = MYSTL::reverse_iterator<iterator>;
+    using const_reverse_iterator = MYSTL::reverse_iterator<const_iterator>;
+
+private:
+    T*        start_;
+    size_type size_;
+    size_type bytes_;  // mapped length
+
+    static void fail(const char* what) { throw std::system_error(errno, std::generic_category(), what); }
+
+    static int advice_flag(map_advice advice) {
+        switch (advice) {
+        case map_advice::sequential: return MADV_SEQUENTIAL;
+        case map_advice::random:     return MADV_RANDOM;
+        case map_advice::willneed:   return MADV_WILLNEED;
+        default:                     return MADV_NORMAL;
+        }
+    }
+
+public:
+    mmap_vector() noexcept : start_(nullptr), size_(0), bytes_(0) {}
+
+    explicit mmap_vector(const char* path, map_advice advice = map_advice::normal, bool huge_pages = false)
+        : mmap_vector() { open(path, advice, huge_pages); }
+
+    mmap_vector(const mmap_vector&) = delete;
+    mmap_vector& operator=(const mmap_vector&) = delete;
+
+    mmap_vector(mmap_vector&& rhs) noexcept
+        : start_(rhs.start_), size_(rhs.size_), bytes_(rhs.bytes_) {
+        rhs.start_ = nullptr;
+        rhs.size_ = rhs.bytes_ = 0;
+    }
+    mmap_vector& operator=(mmap_vector&& rhs) noexcept {
+        if (this != &rhs) {
+            close();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    ~mmap_vector() { close(); }
+
+    // maps path, replacing the current mapping. the descriptor is closed again right away,
+    // the mapping keeps the file alive
+    void open(const char* path, map_advice advice = map_advice::normal, bool huge_pages = false) {
+        close();
+        const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            fail("mmap_vector: open");
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            const int err = errno;
+            ::close(fd);
+            errno = err;
+            fail("mmap_vector: fstat");
+        }
+        const size_type bytes = static_cast<size_type>(st.st_size);
+        if (bytes % sizeof(T) != 0) {
+            ::close(fd);
+            throw std::runtime_error("mmap_vector: file size is not a multiple of sizeof(T)");
+        }
+        if (bytes == 0) {
+            // mmap rejects empty mappings
+            ::close(fd);
+            return;
+        }
+        const int prot = Mode == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        const int flags = Mode == map_mode::read_only ? MAP_SHARED : MAP_PRIVATE;
+        void* p = ::mmap(nullptr, bytes, prot, flags, fd, 0);
+        const int err = errno;
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            errno = err;
+            fail("mmap_vector: mmap");
+        }
+        start_ = static_cast<T*>(p);
+        size_ = bytes / sizeof(T);
+        bytes_ = bytes;
+        advise(advice);
+#ifdef MADV_HUGEPAGE
+        if (huge_pages)
+            ::madvise(p, bytes, MADV_HUGEPAGE);  // a hint, failure leaves normal pages
+#else
+        (void)huge_pages;
+#endif
+    }
+
+    void close() noexcept {
+        if (start_ != nullptr)
+            ::munmap(start_, bytes_);
+        start_ = nullptr;
+        size_ = bytes_ = 0;
+    }
+
+    // changes the read-ahead hint for the whole mapping, or for elements [first, first + n)
+    void advise(map_advice advice) { advise(advice, 0, size_); }
+    void advise(map_advice advice, size_type first, size_type n) {
+        if (n == 0 || first >= size_)
+            return;
+        n = MYSTL::min(n, size_ - first);
+        // madvise wants a page aligned start
+        const uintptr_t page = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(start_ + first) & ~(page - 1);
+        const uintptr_t end = reinterpret_cast<uintptr_t>(start_ + first + n);
+        if (::madvise(reinterpret_cast<void*>(begin), end - begin, advice_flag(advice)) != 0)
+            fail("mmap_vector: madvise");
+    }
+
+    bool     is_open() const noexcept { return start_ != nullptr; }
+    map_mode mode()    const noexcept { return Mode; }
+
+    //iterators
+    iterator        begin()        noexcept { return start_; }
+    const_iterator  begin()  const noexcept { return start_; }
+    iterator        end()          noexcept { return start_ + size_; }
+    const_iterator  end()    const noexcept { return start_ + size_; }
+    const_iterator  cbegin() const noexcept { return begin(); }
+    const_iterator  cend()   const noexcept { return end(); }
+
+    reverse_iterator       rbegin()        noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend()   const noexcept { return rend(); }
+
+    //capacity
+    size_type size()     const noexcept { return size_; }
+    size_type capacity() const noexcept { return size_; }
+    bool      empty()    const noexcept { return size_ == 0; }
+
+    //element access
+    reference       operator[](size_type n)       { return start_[n]; }
+    const_reference operator[](size_type n) const { return start_[n]; }
+    reference at(size_type n) {
+        if (n >= size_)
+            throw std::out_of_range("mmap_vector::at");
+        return start_[n];
+    }
+    const_reference at(size_type n) const {
+        if (n >= size_)
+            throw std::out_of_range("mmap_vector::at");
+        return start_[n];
+    }
+    reference       front()       { return start_[0]; }
+    const_reference front() const { return start_[0]; }
+    reference       back()        { return start_[size_ - 1]; }
+    const_reference back()  const { return start_[size_ - 1]; }
+    pointer         data()        noexcept { return start_; }
+    const_pointer   data()  const noexcept { return start_; }
+
+    void swap(mmap_vector& rhs) noexcept {
+        MYSTL::swap(start_, rhs.start_);
+        MYSTL::swap(size_, rhs.size_);
+        MYSTL::swap(bytes_, rhs.bytes_);
+    }
+};
+
+template <typename T, map_mode Mode>
+void swap(mmap_vector<T, Mode>& lhs, mmap_vector<T, Mode>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
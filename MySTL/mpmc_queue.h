@@ -0,0 +1,308 @@
+#ifndef MPMC_QUEUE_H_
+#define MPMC_QUEUE_H_
+
+#include <atomic>
+#include <stdexcept>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <type_traits>
+#include "utility.h"
+#include "allocator.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// mpmc_queue
+// bounded lock-free queue for any number of producers and consumers (D. Vyukov's design).
+// every slot carries a sequence number that says whose turn it is:
+//   sequence == pos          the slot is free for the producer that claims pos
+//   sequence == pos + 1      the slot holds the element for the consumer that claims pos
+// a thread claims a position with a CAS on enqueue_pos_ / dequeue_pos_ and then owns the
+// slot until it bumps the sequence, so there is no lock and no ABA problem.
+// a claimed slot is always handed on: a producer whose constructor throws publishes the
+// slot marked empty and consumers skip it; a consumer whose move assignment throws
+// destroys the element, frees the slot and rethrows, so that element is lost.
+/*****************************************************************************************/
+
+inline void __cpu_relax() {
+#ifdef __SSE2__
+    _mm_pause();
+#endif
+}
+
+template <typename T>
+struct __mpmc_cell {
+    std::atomic<size_t> sequence;
+    bool full;  // false when the producer of this lap threw, written by the slot owner
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    T* value() { return reinterpret_cast<T*>(&storage); }
+};
+
+template <typename T, typename Alloc = MYSTL::allocator<T>>
+class mpmc_queue : private __allocator_holder<__rebind_alloc<Alloc, __mpmc_cell<T>>> {
+    using alloc_base = __allocator_holder<__rebind_alloc<Alloc, __mpmc_cell<T>>>;
+
+public:
+    using value_type     = T;
+    using size_type      = size_t;
+    using allocator_type = Alloc;
+
+protected:
+    using cell = __mpmc_cell<T>;
+
+    alignas(cache_line_size) cell* buffer_;
+    size_type mask_;
+    alignas(cache_line_size) std::atomic<size_type> enqueue_pos_;
+    alignas(cache_line_size) std::atomic<size_type> dequeue_pos_;
+    char pad_[cache_line_size - sizeof(std::atomic<size_type>)];
+
+public:
+    // the capacity is rounded up to a power of two
+    explicit mpmc_queue(size_type capacity, const allocator_type& a = allocator_type())
+        : alloc_base(a), buffer_(nullptr), mask_(round_up(capacity) - 1), enqueue_pos_(0), dequeue_pos_(0) {
+        buffer_ = this->alloc().allocate(mask_ + 1);
+        for (size_type i = 0; i <= mask_; ++i)
+            ::new (static_cast<void*>(buffer_ + i)) cell;
+        for (size_type i = 0; i <= mask_; ++i) {
+            buffer_[i].sequence.store(i, std::memory_order_relaxed);
+            buffer_[i].full = false;
+        }
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue() {
+        const size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+        for (size_type pos = dequeue_pos_.load(std::memory_order_relaxed); pos != tail; ++pos)
+            if (buffer_[pos & mask_].full)
+                buffer_[pos & mask_].value()->~T();
+        this->alloc().deallocate(buffer_, mask_ + 1);
+    }
+
+public:
+    allocator_type get_allocator() const { return allocator_type(this->alloc()); }
+
+    size_type capacity() const { return mask_ + 1; }
+
+    // a snapshot, may be stale as soon as it returns
+    size_type size_approx() const {
+        const size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+        const size_type head = dequeue_pos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        cell* c;
+        size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            c = buffer_ + (pos & mask_);
+            const size_type seq = c->sequence.load(std::memory_order_acquire);
+            const ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false;  // the slot still holds an element from the previous lap
+            }
+            else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        try {
+            ::new (static_cast<void*>(c->value())) T(MYSTL::forward<Args>(args)...);
+        }
+        catch (...) {
+            c->full = false;
+            c->sequence.store(pos + 1, std::memory_order_release);
+            throw;
+        }
+        c->full = true;
+        c->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const value_type& value) { return try_emplace(value); }
+    bool try_push(value_type&& value)      { return try_emplace(MYSTL::move(value)); }
+
+    bool try_pop(value_type& out) {
+        for (;;) {
+            size_type pos;
+            cell* c = claim_front(pos);
+            if (c == nullptr)
+                return false;
+            if (!c->full) {  // its producer threw, nothing to hand out
+                c->sequence.store(pos + mask_ + 1, std::memory_order_release);
+                continue;
+            }
+            try {
+                out = MYSTL::move(*c->value());
+            }
+            catch (...) {
+                release_front(c, pos);
+                throw;
+            }
+            release_front(c, pos);
+            return true;
+        }
+    }
+
+protected:
+    // claims the oldest published slot, nullptr when there is none
+    cell* claim_front(size_type& pos) {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell* c = buffer_ + (pos & mask_);
+            const size_type seq = c->sequence.load(std::memory_order_acquire);
+            const ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    return c;
+            }
+            else if (diff < 0) {
+                return nullptr;  // nothing published at this position yet
+            }
+            else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void release_front(cell* c, size_type pos) {
+        c->value()->~T();
+        c->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    }
+
+    // past the largest power of two in size_type the doubling below would wrap to zero
+    static size_type round_up(size_type n) {
+        if (n > (static_cast<size_type>(-1) >> 1) + 1)
+            throw std::length_error("mpmc_queue: capacity too large");
+        size_type cap = 2;
+        while (cap < n)
+            cap <<= 1;
+        return cap;
+    }
+};
+
+
+/*****************************************************************************************/
+// blocking_mpmc_queue
+// push() / pop() that wait instead of failing. a waiting thread first retries for
+// spin_count rounds and only then parks on a condition variable, so short stalls never
+// reach the kernel. the fast path takes no lock: a thread that made progress only locks
+// the mutex to notify when the waiter count says someone is parked.
+/*****************************************************************************************/
+
+template <typename T, typename Alloc = MYSTL::allocator<T>>
+class blocking_mpmc_queue {
+public:
+    using value_type     = T;
+    using size_type      = size_t;
+    using allocator_type = Alloc;
+
+protected:
+    mpmc_queue<T, Alloc> queue_;
+    const unsigned spin_count_;
+
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::atomic<int> waiting_consumers_;
+    std::atomic<int> waiting_producers_;
+
+public:
+    explicit blocking_mpmc_queue(size_type capacity, unsigned spin_count = 1024,
+                                 const allocator_type& a = allocator_type())
+        : queue_(capacity, a), spin_count_(spin_count),
+          waiting_consumers_(0), waiting_producers_(0) {}
+
+    allocator_type get_allocator() const { return queue_.get_allocator(); }
+
+    size_type capacity()    const { return queue_.capacity(); }
+    size_type size_approx() const { return queue_.size_approx(); }
+
+    bool try_push(const value_type& value) {
+        if (!queue_.try_push(value))
+            return false;
+        wake(waiting_consumers_, not_empty_);
+        return true;
+    }
+
+    bool try_pop(value_type& out) {
+        if (!queue_.try_pop(out))
+            return false;
+        wake(waiting_producers_, not_full_);
+        return true;
+    }
+
+    void push(const value_type& value) {
+        wait_for([&] { return queue_.try_push(value); }, waiting_producers_, not_full_,
+                 waiting_consumers_, not_empty_);
+        wake(waiting_consumers_, not_empty_);
+    }
+
+    void push(value_type&& value) {
+        wait_for([&] { return queue_.try_push(MYSTL::move(value)); }, waiting_producers_, not_full_,
+                 waiting_consumers_, not_empty_);
+        wake(waiting_consumers_, not_empty_);
+    }
+
+    void pop(value_type& out) {
+        wait_for([&] { return queue_.try_pop(out); }, waiting_consumers_, not_empty_,
+                 waiting_producers_, not_full_);
+        wake(waiting_producers_, not_full_);
+    }
+
+protected:
+    // others / others_cv: the opposite side, woken before parking. a consumer that only
+    // skipped slots of throwing producers freed them without a successful pop to say so
+    template <typename Attempt>
+    void wait_for(Attempt attempt, std::atomic<int>& waiters, std::condition_variable& cv,
+                  std::atomic<int>& others, std::condition_variable& others_cv) {
+        for (unsigned i = 0; i < spin_count_; ++i) {
+            if (attempt())
+                return;
+            if (i < spin_count_ / 2)
+                __cpu_relax();
+            else
+                std::this_thread::yield();
+        }
+        wake(others, others_cv);
+        std::unique_lock<std::mutex> lock(mutex_);
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        // pairs with the fence in wake(): either the other side sees our count,
+        // or the attempt below sees its element
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        try {
+            while (!attempt())
+                cv.wait(lock);
+        }
+        catch (...) {
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void wake(std::atomic<int>& waiters, std::condition_variable& cv) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0) {
+            // taking the lock orders us after a waiter that is between its check and wait()
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv.notify_all();
+        }
+    }
+};
+
+} // end of namespace MYSTL
+
+#endif
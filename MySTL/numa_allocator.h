@@ -0,0 +1,250 @@
+#ifndef NUMA_ALLOCATOR_H_
+#define NUMA_ALLOCATOR_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "vector.h"
+#include "algobase.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// numa_allocator
+// an allocator for large arrays on multi-socket machines. blocks of at least
+// large_bytes (default 2 MiB) are mmap'ed directly and then
+//   pages:  transparent_huge  madvise(MADV_HUGEPAGE)
+//           hugetlb           MAP_HUGETLB from the reserved pool; the block is rounded
+//                             to 2 MiB and falls back to normal pages when the pool is
+//                             empty
+//   policy: local             default kernel policy, a page lands on the node of the
+//                             thread that touches it first
+//           bind              mbind(MPOL_BIND) to one node
+//           preferred         that node first, others when it is full
+//           interleave        pages spread round robin over a node mask
+// smaller blocks come from operator new like MYSTL::allocator. mbind is called with
+// syscall(), no libnuma needed; a kernel without NUMA support ignores the policy.
+// first_touch_vector builds vector(n, value) with every thread filling its own part,
+// so under the local policy each part lives on the node of the thread that uses it.
+/*****************************************************************************************/
+
+enum class page_policy { normal, transparent_huge, hugetlb };
+enum class numa_policy { local, bind, preferred, interleave };
+
+// bit i set: node i is online, read from sysfs ("0-1,4"); node 0 only when unknown
+inline unsigned long numa_online_nodes() {
+    unsigned long mask = 0;
+    if (std::FILE* f = std::fopen("/sys/devices/system/node/online", "r")) {
+        int lo, hi;
+        while (std::fscanf(f, "%d", &lo) == 1) {
+            hi = lo;
+            int c = std::fgetc(f);
+            if (c == '-') {
+                if (std::fscanf(f, "%d", &hi) != 1)
+                    break;
+                c = std::fgetc(f);
+            }
+            for (int node = lo; node <= hi && node < 64; ++node)
+                mask |= 1UL << node;
+            if (c != ',')
+                break;
+        }
+        std::fclose(f);
+    }
+    return mask != 0 ? mask : 1UL;
+}
+
+inline int numa_node_count() {
+    const unsigned long mask = numa_online_nodes();
+    int count = 0;
+    for (int node = 0; node < 64; ++node)
+        count += static_cast<int>((mask >> node) & 1);
+    return count;
+}
+
+// the node of the page at p (a page not touched yet has none), -1 when unknown
+inline int numa_node_of(const void* p) {
+#ifdef SYS_get_mempolicy
+    int node = -1;
+    const unsigned long mpol_f_node = 1, mpol_f_addr = 2;
+    if (::syscall(SYS_get_mempolicy, &node, nullptr, 0UL, p, mpol_f_node | mpol_f_addr) == 0)
+        return node;
+#else
+    (void)p;
+#endif
+    return -1;
+}
+
+template <typename T>
+class numa_allocator {
+    template <typename U> friend class numa_allocator;
+
+public:
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+
+    template <typename U>
+    struct rebind { using other = numa_allocator<U>; };
+
+    static constexpr size_t huge_page_bytes = size_t(2) << 20;
+
+private:
+    page_policy   pages_;
+    numa_policy   policy_;
+    unsigned long nodes_;        // node mask for bind / preferred / interleave
+    size_t        large_bytes_;  // blocks from this size on are mmap'ed
+
+    bool is_large(size_t bytes) const noexcept { return bytes >= large_bytes_; }
+
+    // hugetlb blocks are whole huge pages, whichever pages they end up on
+    size_t mapped_bytes(size_t bytes) const noexcept {
+        return pages_ == page_policy::hugetlb ? (bytes + huge_page_bytes - 1) / huge_page_bytes * huge_page_bytes
+                                              : bytes;
+    }
+
+    void* map(size_t bytes) const {
+        void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+        if (pages_ == page_policy::hugetlb)
+            p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+        if (p == MAP_FAILED)
+            p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+        if (pages_ != page_policy::normal)
+            ::madvise(p, bytes, MADV_HUGEPAGE);  // a hint, failure leaves normal pages
+#endif
+        return p;
+    }
+
+    // runs before the first touch, so every page is placed by the policy
+    void apply_policy(void* p, size_t bytes) const {
+        if (policy_ == numa_policy::local)
+            return;
+#ifdef SYS_mbind
+        const int mode = policy_ == numa_policy::bind ? 2 : policy_ == numa_policy::preferred ? 1 : 3;
+        const unsigned long mask = nodes_;
+        if (::syscall(SYS_mbind, p, bytes, mode, &mask, 64UL, 0U) != 0 && errno != ENOSYS) {
+            const int err = errno;
+            ::munmap(p, bytes);
+            throw std::system_error(err, std::generic_category(), "numa_allocator: mbind");
+        }
+#else
+        (void)p;
+        (void)bytes;
+#endif
+    }
+
+public:
+    // transparent huge pages, local placement
+    numa_allocator() noexcept
+        : pages_(page_policy::transparent_huge), policy_(numa_policy::local), nodes_(0), large_bytes_(huge_page_bytes) {}
+
+    numa_allocator(page_policy pages, numa_policy policy, unsigned long nodes = 0,
+                   size_t large_bytes = huge_page_bytes) noexcept
+        : pages_(pages), policy_(policy), nodes_(nodes), large_bytes_(large_bytes) {}
+
+    template <typename U>
+    numa_allocator(const numa_allocator<U>& rhs) noexcept
+        : pages_(rhs.pages_), policy_(rhs.policy_), nodes_(rhs.nodes_), large_bytes_(rhs.large_bytes_) {}
+
+    static numa_allocator on_node(int node, page_policy pages = page_policy::transparent_huge) {
+        return numa_allocator(pages, numa_policy::bind, 1UL << node);
+    }
+    static numa_allocator preferring(int node, page_policy pages = page_policy::transparent_huge) {
+        return numa_allocator(pages, numa_policy::preferred, 1UL << node);
+    }
+    // all online nodes unless a mask is given
+    static numa_allocator interleaved(unsigned long nodes = 0, page_policy pages = page_policy::transparent_huge) {
+        return numa_allocator(pages, numa_policy::interleave, nodes != 0 ? nodes : numa_online_nodes());
+    }
+
+    page_policy   pages()       const noexcept { return pages_; }
+    numa_policy   policy()      const noexcept { return policy_; }
+    unsigned long nodes()       const noexcept { return nodes_; }
+    size_t        large_bytes() const noexcept { return large_bytes_; }
+
+    T* allocate(size_type n) {
+        const size_t bytes = n * sizeof(T);
+        if (!is_large(bytes))
+            return alignof(T) > __default_new_alignment ? static_cast<T*>(__aligned_allocate(bytes, alignof(T)))
+                                                        : static_cast<T*>(::operator new(bytes));
+        const size_t len = mapped_bytes(bytes);
+        void* p = map(len);
+        apply_policy(p, len);
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_type n) noexcept {
+        if (p == nullptr)
+            return;
+        const size_t bytes = n * sizeof(T);
+        if (is_large(bytes))
+            ::munmap(p, mapped_bytes(bytes));
+        else if (alignof(T) > __default_new_alignment)
+            __aligned_deallocate(p);
+        else
+            ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const numa_allocator<U>& rhs) const noexcept {
+        return pages_ == rhs.pages_ && large_bytes_ == rhs.large_bytes_;
+    }
+    template <typename U>
+    bool operator!=(const numa_allocator<U>& rhs) const noexcept { return !(*this == rhs); }
+};
+
+template <typename T>
+constexpr size_t numa_allocator<T>::huge_page_bytes;
+
+// vector(n, value, a) whose elements are first written by `threads` threads, each filling
+// one contiguous part. the block is reserved untouched, so every page is placed when its
+// thread writes it
+template <typename T, typename Alloc = MYSTL::allocator<T>>
+vector<T, Alloc> first_touch_vector(size_t n, const T& value, const Alloc& a = Alloc(),
+                                    unsigned threads = std::thread::hardware_concurrency()) {
+    static_assert(std::is_trivial<T>::value, "first_touch_vector needs a trivial T");
+    vector<T, Alloc> v(a);
+    v.resize_uninitialized(n);
+    threads = static_cast<unsigned>(MYSTL::min<size_t>(threads == 0 ? 1 : threads, n == 0 ? 1 : n));
+    const size_t part = (n + threads - 1) / threads;
+    T* data = v.data();
+    vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    try {
+        for (unsigned t = 1; t < threads; ++t) {
+            const size_t first = MYSTL::min(n, t * part);
+            const size_t last = MYSTL::min(n, first + part);
+            workers.emplace_back([=] { MYSTL::fill(data + first, data + last, value); });
+        }
+    }
+    catch (...) {
+        for (auto& w : workers)
+            w.join();
+        throw;
+    }
+    MYSTL::fill(data, data + MYSTL::min(n, part), value);
+    for (auto& w : workers)
+        w.join();
+    return v;
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,245 @@
+#ifndef PERSISTENT_VECTOR_H_
+#define PERSISTENT_VECTOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "file_allocator.h"
+#include "iterator.h"
+#include "utility.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// persistent_vector
+// an append-only vector of trivially copyable T living in a file. elements are written
+// straight into a MAP_SHARED mapping from file_allocator, growth doubles the file with
+// ftruncate + mremap, so appending never copies and never calls write().
+// the file starts with a 64 byte header (magic, sizeof(T), element count). an append
+// writes the element first and publishes the new count after it; opening the file again
+// restores every published element.
+// sync() flushes the unsynced elements and the header with msync; set_sync_every(n)
+// schedules that writeback after every n appends. without sync the kernel writes the
+// dirty pages back on its own schedule, which survives a crash of the process but not
+// of the machine.
+/*****************************************************************************************/
+
+struct __pv_header {
+    char     magic[8];
+    uint64_t elem_size;
+    uint64_t count;
+    char     reserved[40];
+};
+static_assert(sizeof(__pv_header) == 64, "persistent_vector header layout");
+
+template <typename T>
+class persistent_vector {
+public:
+    using value_type             = T;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using const_pointer          = const T*;
+    using const_reference        = const T&;
+    using const_iterator         = const T*;
+    using const_reverse_iterator = MYSTL::reverse_iterator<const_iterator>;
+    using allocator_type         = file_allocator<T>;
+
+    static constexpr size_t header_bytes = sizeof(__pv_header);
+
+private:
+    static constexpr size_type initial_capacity = 16;
+
+    allocator_type alloc_;
+    T*             start_;
+    size_type      size_;
+    size_type      cap_;
+    size_type      synced_;      // elements already flushed by sync()
+    size_type      sync_every_;  // 0: only explicit sync()
+
+    static const char* magic() { return "MYSTLPV1"; }
+
+    __pv_header* header() const { return static_cast<__pv_header*>(alloc_.header()); }
+
+    void grow(size_type n) {
+        start_ = alloc_.reallocate(start_, cap_, n);
+        cap_ = n;
+    }
+
+    // the element bytes are in place before the count that makes them visible
+    void publish(size_type n) {
+        std::atomic_thread_fence(std::memory_order_release);
+        size_ = n;
+        header()->count = n;
+        if (sync_every_ != 0 && size_ - synced_ >= sync_every_)
+            sync(false);
+    }
+
+public:
+    persistent_vector() noexcept : start_(nullptr), size_(0), cap_(0), synced_(0), sync_every_(0) {}
+
+    explicit persistent_vector(const char* path) : persistent_vector() { open(path); }
+
+    persistent_vector(const persistent_vector&) = delete;
+    persistent_vector& operator=(const persistent_vector&) = delete;
+
+    persistent_vector(persistent_vector&& rhs) noexcept
+        : alloc_(MYSTL::move(rhs.alloc_)), start_(rhs.start_), size_(rhs.size_), cap_(rhs.cap_),
+          synced_(rhs.synced_), sync_every_(rhs.sync_every_) {
+        rhs.start_ = nullptr;
+        rhs.size_ = rhs.cap_ = rhs.synced_ = 0;
+    }
+    persistent_vector& operator=(persistent_vector&& rhs) noexcept {
+        if (this != &rhs) {
+            close();
+            swap(rhs);
+        }
+        return *this;
+    }
+
+    ~persistent_vector() { close(); }
+
+    // opens path, creating an empty vector if the file is new or empty. throws
+    // runtime_error when the file is not a persistent_vector of T
+    void open(const char* path) {
+        close();
+        allocator_type alloc(path, header_bytes);
+        const size_t bytes = alloc.file_size();
+        const bool fresh = bytes == 0;
+        if (!fresh && bytes < header_bytes)
+            throw std::runtime_error("persistent_vector: file too short for the header");
+        const size_type cap = fresh ? static_cast<size_type>(initial_capacity) : alloc.stored_capacity();
+        T* start = alloc.allocate(cap);
+        __pv_header* h = static_cast<__pv_header*>(alloc.header());
+        if (fresh) {
+            std::memcpy(h->magic, magic(), sizeof(h->magic));
+            h->elem_size = sizeof(T);
+            h->count = 0;
+        }
+        else if (std::memcmp(h->magic, magic(), sizeof(h->magic)) != 0 || h->elem_size != sizeof(T) ||
+                 h->count > cap) {
+            alloc.deallocate(start, cap);
+            throw std::runtime_error("persistent_vector: not a vector of this element type");
+        }
+        alloc_ = MYSTL::move(alloc);
+        start_ = start;
+        cap_ = cap;
+        size_ = synced_ = static_cast<size_type>(h->count);
+    }
+
+    // unmaps the file; what was appended stays in it
+    void close() noexcept {
+        if (start_ != nullptr || alloc_.header() != nullptr)
+            alloc_.deallocate(start_, cap_);
+        alloc_ = allocator_type();
+        start_ = nullptr;
+        size_ = cap_ = synced_ = 0;
+    }
+
+    bool is_open() const noexcept { return alloc_.header() != nullptr; }
+
+    //appending
+    void push_back(const T& value) {
+        if (size_ == cap_) {
+            const T copy = value;  // value may be an element, and grow() can move the mapping
+            grow(cap_ < initial_capacity ? static_cast<size_type>(initial_capacity) : 2 * cap_);
+            start_[size_] = copy;
+        }
+        else {
+            start_[size_] = value;
+        }
+        publish(size_ + 1);
+    }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) { push_back(T(MYSTL::forward<Args>(args)...)); }
+
+    void append(const T* first, size_type n) {
+        if (n == 0)
+            return;
+        if (cap_ - size_ < n) {
+            size_type len = cap_ < initial_capacity ? static_cast<size_type>(initial_capacity) : cap_;
+            while (len - size_ < n)
+                len *= 2;
+            // a source inside the vector moves along with the mapping
+            const bool inside = first >= start_ && first < start_ + size_;
+            const size_type offset = inside ? static_cast<size_type>(first - start_) : 0;
+            grow(len);
+            if (inside)
+                first = start_ + offset;
+        }
+        std::memcpy(start_ + size_, first, n * sizeof(T));
+        publish(size_ + n);
+    }
+    void append(const T* first, const T* last) { append(first, static_cast<size_type>(last - first)); }
+
+    void reserve(size_type n) {
+        if (n > cap_)
+            grow(n);
+    }
+
+    //durability
+    // msync of the elements appended since the last sync and of the header; wait = false
+    // only schedules the writeback
+    void sync(bool wait = true) {
+        if (!is_open())
+            return;
+        if (size_ > synced_)
+            allocator_type::sync(start_ + synced_, (size_ - synced_) * sizeof(T), wait);
+        allocator_type::sync(header(), header_bytes, wait);
+        synced_ = size_;
+    }
+
+    // n > 0: sync(false) after every n appended elements. 0 turns it off
+    void      set_sync_every(size_type n) noexcept { sync_every_ = n; }
+    size_type sync_every() const noexcept { return sync_every_; }
+
+    //iterators
+    const_iterator         begin()   const noexcept { return start_; }
+    const_iterator         end()     const noexcept { return start_ + size_; }
+    const_iterator         cbegin()  const noexcept { return begin(); }
+    const_iterator         cend()    const noexcept { return end(); }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+
+    //capacity
+    size_type size()     const noexcept { return size_; }
+    size_type capacity() const noexcept { return cap_; }
+    bool      empty()    const noexcept { return size_ == 0; }
+
+    //element access
+    const_reference operator[](size_type n) const { return start_[n]; }
+    const_reference at(size_type n) const {
+        if (n >= size_)
+            throw std::out_of_range("persistent_vector::at");
+        return start_[n];
+    }
+    const_reference front() const { return start_[0]; }
+    const_reference back()  const { return start_[size_ - 1]; }
+    const_pointer   data()  const noexcept { return start_; }
+
+    void swap(persistent_vector& rhs) noexcept {
+        MYSTL::swap(alloc_, rhs.alloc_);
+        MYSTL::swap(start_, rhs.start_);
+        MYSTL::swap(size_, rhs.size_);
+        MYSTL::swap(cap_, rhs.cap_);
+        MYSTL::swap(synced_, rhs.synced_);
+        MYSTL::swap(sync_every_, rhs.sync_every_);
+    }
+};
+
+template <typename T>
+constexpr size_t persistent_vector<T>::header_bytes;
+template <typename T>
+constexpr typename persistent_vector<T>::size_type persistent_vector<T>::initial_capacity;
+
+template <typename T>
+void swap(persistent_vector<T>& lhs, persistent_vector<T>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef QUEUE_H_
+#define QUEUE_H_
+
+#include <initializer_list>
+#include <utility>
+#include "utility.h"
+#include "deque.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// queue
+// FIFO adapter over any container with front/back/push_back/emplace_back/pop_front:
+// MYSTL::deque (default) or MYSTL::list. with the deque, a BFS frontier that pushes and
+// pops at a steady rate reuses the same blocks instead of allocating per element.
+// reserve() is only available when the container has one.
+/*****************************************************************************************/
+
+template <typename T, typename Container = MYSTL::deque<T>>
+class queue {
+public:
+    using container_type  = Container;
+    using value_type      = typename Container::value_type;
+    using size_type       = typename Container::size_type;
+    using reference       = typename Container::reference;
+    using const_reference = typename Container::const_reference;
+
+protected:
+    Container c;
+
+public:
+    queue() = default;
+    explicit queue(const Container& cont) :c(cont) {}
+    explicit queue(Container&& cont) :c(MYSTL::move(cont)) {}
+
+    //capacity
+    bool      empty() const { return c.empty(); }
+    size_type size()  const { return c.size(); }
+
+    template <typename C = Container>
+    auto reserve(size_type n) -> decltype(std::declval<C&>().reserve(n), void()) {
+        c.reserve(n);
+    }
+
+    //element access
+    reference       front()       { return c.front(); }
+    const_reference front() const { return c.front(); }
+    reference       back()        { return c.back(); }
+    const_reference back()  const { return c.back(); }
+
+    //modifiers
+    void push(const value_type& value) { c.push_back(value); }
+    void push(value_type&& value)      { c.push_back(MYSTL::move(value)); }
+
+    template <typename... Args>
+    void emplace(Args&&... args) { c.emplace_back(MYSTL::forward<Args>(args)...); }
+
+    // appends every element of the range in order
+    template <typename Range>
+    void push_range(Range&& range) {
+        __reserve_more(c, __range_size_hint(range, 0), 0);
+        for (auto&& value : range)
+            c.push_back(MYSTL::forward<decltype(value)>(value));
+    }
+    void push_range(std::initializer_list<value_type> ilist) {
+        __reserve_more(c, ilist.size(), 0);
+        for (auto& value : ilist)
+            c.push_back(value);
+    }
+
+    void pop() { c.pop_front(); }
+
+    void swap(queue& rhs) { MYSTL::swap(c, rhs.c); }
+
+    // access to the underlying container for comparisons
+    const Container& container() const { return c; }
+};
+
+template <typename T, typename Container>
+bool operator==(const queue<T, Container>& lhs, const queue<T, Container>& rhs) {
+    return lhs.container() == rhs.container();
+}
+
+template <typename T, typename Container>
+bool operator!=(const queue<T, Container>& lhs, const queue<T, Container>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Container>
+bool operator<(const queue<T, Container>& lhs, const queue<T, Container>& rhs) {
+    return lhs.container() < rhs.container();
+}
+
+template <typename T, typename Container>
+void swap(queue<T, Container>& lhs, queue<T, Container>& rhs) {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,1031 @@
+#ifndef RB_TREE_H_
+#define RB_TREE_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include "iterator.h"
+#include "utility.h"
+#include "allocator.h"
+#include "construct.h"
+#include "memory.h"
+#include "algobase.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// rb_tree
+// red-black tree core of map / set / multimap / multiset.
+// the header node sits inside the tree object: header.parent is the root, header.left the
+// leftmost and header.right the rightmost node, so begin(), rbegin() and an insert at
+// either end need no search. erased nodes go to a node_cache and are reused by later
+// inserts; extract() hands a node out in a node handle that another tree can link again
+// without copying or reallocating the element.
+/*****************************************************************************************/
+
+using __rb_tree_color_type = bool;
+constexpr __rb_tree_color_type __rb_tree_red   = false;
+constexpr __rb_tree_color_type __rb_tree_black = true;
+
+struct __rb_tree_node_base {
+    using base_ptr = __rb_tree_node_base*;
+
+    __rb_tree_color_type color;
+    base_ptr parent;
+    base_ptr left;
+    base_ptr right;
+
+    static base_ptr minimum(base_ptr x) {
+        while (x->left != nullptr)
+            x = x->left;
+        return x;
+    }
+    static base_ptr maximum(base_ptr x) {
+        while (x->right != nullptr)
+            x = x->right;
+        return x;
+    }
+};
+
+template <typename Value>
+struct __rb_tree_node : public __rb_tree_node_base {
+    Value value;
+};
+
+inline __rb_tree_node_base* __rb_tree_increment(__rb_tree_node_base* x) {
+    if (x->right != nullptr) {
+        x = x->right;
+        while (x->left != nullptr)
+            x = x->left;
+    }
+    else {
+        auto y = x->parent;
+        while (x == y->right) {
+            x = y;
+            y = y->parent;
+        }
+        // x was the rightmost node of a one node tree, y is the header
+        if (x->right != y)
+            x = y;
+    }
+    return x;
+}
+
+inline __rb_tree_node_base* __rb_tree_decrement(__rb_tree_node_base* x) {
+    if (x->color == __rb_tree_red && x->parent->parent == x) {
+        x = x->right;  // end() -> rightmost
+    }
+    else if (x->left != nullptr) {
+        x = x->left;
+        while (x->right != nullptr)
+            x = x->right;
+    }
+    else {
+        auto y = x->parent;
+        while (x == y->left) {
+            x = y;
+            y = y->parent;
+        }
+        x = y;
+    }
+    return x;
+}
+
+inline void __rb_tree_rotate_left(__rb_tree_node_base* x, __rb_tree_node_base*& root) {
+    auto y = x->right;
+    x->right = y->left;
+    if (y->left != nullptr)
+        y->left->parent = x;
+    y->parent = x->parent;
+    if (x == root)
+        root = y;
+    else if (x == x->parent->left)
+        x->parent->left = y;
+    else
+        x->parent->right = y;
+    y->left = x;
+    x->parent = y;
+}
+
+inline void __rb_tree_rotate_right(__rb_tree_node_base* x, __rb_tree_node_base*& root) {
+    auto y = x->left;
+    x->left = y->right;
+    if (y->right != nullptr)
+        y->right->parent = x;
+    y->parent = x->parent;
+    if (x == root)
+        root = y;
+    else if (x == x->parent->right)
+        x->parent->right = y;
+    else
+        x->parent->left = y;
+    y->right = x;
+    x->parent = y;
+}
+
+// links x as a child of p and restores the red-black invariants
+inline void __rb_tree_insert_and_rebalance(bool insert_left, __rb_tree_node_base* x,
+                                           __rb_tree_node_base* p, __rb_tree_node_base& header) {
+    auto& root = header.parent;
+    x->parent = p;
+    x->left = nullptr;
+    x->right = nullptr;
+    x->color = __rb_tree_red;
+
+    if (insert_left) {
+        p->left = x;  // also makes leftmost = x when p is the header
+        if (p == &header) {
+            header.parent = x;
+            header.right = x;
+        }
+        else if (p == header.left) {
+            header.left = x;
+        }
+    }
+    else {
+        p->right = x;
+        if (p == header.right)
+            header.right = x;
+    }
+
+    while (x != root && x->parent->color == __rb_tree_red) {
+        auto xpp = x->parent->parent;
+        if (x->parent == xpp->left) {
+            auto y = xpp->right;
+            if (y != nullptr && y->color == __rb_tree_red) {
+                x->parent->color = __rb_tree_black;
+                y->color = __rb_tree_black;
+                xpp->color = __rb_tree_red;
+                x = xpp;
+            }
+            else {
+                if (x == x->parent->right) {
+                    x = x->parent;
+                    __rb_tree_rotate_left(x, root);
+                }
+                x->parent->color = __rb_tree_black;
+                xpp->color = __rb_tree_red;
+                __rb_tree_rotate_right(xpp, root);
+            }
+        }
+        else {
+            auto y = xpp->left;
+            if (y != nullptr && y->color == __rb_tree_red) {
+                x->parent->color = __rb_tree_black;
+                y->color = __rb_tree_black;
+                xpp->color = __rb_tree_red;
+                x = xpp;
+            }
+            else {
+                if (x == x->parent->left) {
+                    x = x->parent;
+                    __rb_tree_rotate_right(x, root);
+                }
+                x->parent->color = __rb_tree_black;
+                xpp->color = __rb_tree_red;
+                __rb_tree_rotate_left(xpp, root);
+            }
+        }
+    }
+    root->color = __rb_tree_black;
+}
+
+// unlinks z from the tree and rebalances, returns z
+inline __rb_tree_node_base*
+__rb_tree_rebalance_for_erase(__rb_tree_node_base* z, __rb_tree_node_base& header) {
+    auto& root = header.parent;
+    auto& leftmost = header.left;
+    auto& rightmost = header.right;
+    __rb_tree_node_base* y = z;
+    __rb_tree_node_base* x = nullptr;
+    __rb_tree_node_base* x_parent = nullptr;
+
+    if (y->left == nullptr) {
+        x = y->right;
+    }
+    else if (y->right == nullptr) {
+        x = y->left;
+    }
+    else {
+        // two children: y is the successor of z and takes z's place
+        y = y->right;
+        while (y->left != nullptr)
+            y = y->left;
+        x = y->right;
+    }
+
+    if (y != z) {
+        z->left->parent = y;
+        y->left = z->left;
+        if (y != z->right) {
+            x_parent = y->parent;
+            if (x != nullptr)
+                x->parent = y->parent;
+            y->parent->left = x;
+            y->right = z->right;
+            z->right->parent = y;
+        }
+        else {
+            x_parent = y;
+        }
+        if (root == z)
+            root = y;
+        else if (z->parent->left == z)
+            z->parent->left = y;
+        else
+            z->parent->right = y;
+        y->parent = z->parent;
+        MYSTL::swap(y->color, z->color);
+        y = z;  // y is now the node that was actually removed
+    }
+    else {
+        x_parent = y->parent;
+        if (x != nullptr)
+            x->parent = y->parent;
+        if (root == z)
+            root = x;
+        else if (z->parent->left == z)
+            z->parent->left = x;
+        else
+            z->parent->right = x;
+        if (leftmost == z)
+            leftmost = z->right == nullptr ? z->parent : __rb_tree_node_base::minimum(x);
+        if (rightmost == z)
+            rightmost = z->left == nullptr ? z->parent : __rb_tree_node_base::maximum(x);
+    }
+
+    if (y->color != __rb_tree_red) {
+        while (x != root && (x == nullptr || x->color == __rb_tree_black)) {
+            if (x == x_parent->left) {
+                auto w = x_parent->right;
+                if (w->color == __rb_tree_red) {
+                    w->color = __rb_tree_black;
+                    x_parent->color = __rb_tree_red;
+                    __rb_tree_rotate_left(x_parent, root);
+                    w = x_parent->right;
+                }
+                if ((w->left == nullptr || w->left->color == __rb_tree_black) &&
+                    (w->right == nullptr || w->right->color == __rb_tree_black)) {
+                    w->color = __rb_tree_red;
+                    x = x_parent;
+                    x_parent = x_parent->parent;
+                }
+                else {
+                    if (w->right == nullptr || w->right->color == __rb_tree_black) {
+                        w->left->color = __rb_tree_black;
+                        w->color = __rb_tree_red;
+                        __rb_tree_rotate_right(w, root);
+                        w = x_parent->right;
+                    }
+                    w->color = x_parent->color;
+                    x_parent->color = __rb_tree_black;
+                    if (w->right != nullptr)
+                        w->right->color = __rb_tree_black;
+                    __rb_tree_rotate_left(x_parent, root);
+                    break;
+                }
+            }
+            else {
+                auto w = x_parent->left;
+                if (w->color == __rb_tree_red) {
+                    w->color = __rb_tree_black;
+                    x_parent->color = __rb_tree_red;
+                    __rb_tree_rotate_right(x_parent, root);
+                    w = x_parent->left;
+                }
+                if ((w->right == nullptr || w->right->color == __rb_tree_black) &&
+                    (w->left == nullptr || w->left->color == __rb_tree_black)) {
+                    w->color = __rb_tree_red;
+                    x = x_parent;
+                    x_parent = x_parent->parent;
+                }
+                else {
+                    if (w->left == nullptr || w->left->color == __rb_tree_black) {
+                        w->right->color = __rb_tree_black;
+                        w->color = __rb_tree_red;
+                        __rb_tree_rotate_left(w, root);
+                        w = x_parent->left;
+                    }
+                    w->color = x_parent->color;
+                    x_parent->color = __rb_tree_black;
+                    if (w->left != nullptr)
+                        w->left->color = __rb_tree_black;
+                    __rb_tree_rotate_right(x_parent, root);
+                    break;
+                }
+            }
+        }
+        if (x != nullptr)
+            x->color = __rb_tree_black;
+    }
+    return y;
+}
+
+
+template <typename T>
+struct __rb_tree_iterator {
+    using iterator_category = MYSTL::bidirectional_iterator_tag;
+    using value_type        = T;
+    using pointer           = T*;
+    using reference         = T&;
+    using difference_type   = ptrdiff_t;
+    using self              = __rb_tree_iterator<T>;
+    using base_ptr          = __rb_tree_node_base*;
+
+    base_ptr node_;
+
+    __rb_tree_iterator() : node_(nullptr) {}
+    explicit __rb_tree_iterator(base_ptr node) : node_(node) {}
+
+    reference operator*() const { return static_cast<__rb_tree_node<T>*>(node_)->value; }
+    pointer operator->() const { return MYSTL::addressof(operator*()); }
+
+    self& operator++() { node_ = __rb_tree_increment(node_); return *this; }
+    self& operator--() { node_ = __rb_tree_decrement(node_); return *this; }
+    self operator++(int) { self tmp = *this; ++*this; return tmp; }
+    self operator--(int) { self tmp = *this; --*this; return tmp; }
+
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+template <typename T>
+struct __rb_tree_const_iterator {
+    using iterator_category = MYSTL::bidirectional_iterator_tag;
+    using value_type        = T;
+    using pointer           = const T*;
+    using reference         = const T&;
+    using difference_type   = ptrdiff_t;
+    using self              = __rb_tree_const_iterator<T>;
+    using iterator          = __rb_tree_iterator<T>;
+    using base_ptr          = __rb_tree_node_base*;
+
+    base_ptr node_;
+
+    __rb_tree_const_iterator() : node_(nullptr) {}
+    explicit __rb_tree_const_iterator(base_ptr node) : node_(node) {}
+    __rb_tree_const_iterator(const iterator& rhs) : node_(rhs.node_) {}
+
+    iterator __const_cast() const { return iterator(node_); }
+
+    reference operator*() const { return static_cast<__rb_tree_node<T>*>(node_)->value; }
+    pointer operator->() const { return MYSTL::addressof(operator*()); }
+
+    self& operator++() { node_ = __rb_tree_increment(node_); return *this; }
+    self& operator--() { node_ = __rb_tree_decrement(node_); return *this; }
+    self operator++(int) { self tmp = *this; ++*this; return tmp; }
+    self operator--(int) { self tmp = *this; --*this; return tmp; }
+
+    bool operator==(const self& rhs) const { return node_ == rhs.node_; }
+    bool operator!=(const self& rhs) const { return node_ != rhs.node_; }
+};
+
+
+// owns one extracted node and a copy of the allocator that made it. key() / mapped() are
+// for map nodes, value() for set nodes
+template <typename Value, typename Alloc = MYSTL::allocator<Value>>
+class rb_node_handle : private __allocator_holder<__rebind_alloc<Alloc, __rb_tree_node<Value>>> {
+    using node_type      = __rb_tree_node<Value>;
+    using node_allocator = __rebind_alloc<Alloc, node_type>;
+    using alloc_base     = __allocator_holder<node_allocator>;
+
+    template <typename, typename, typename, typename, typename> friend class rb_tree;
+
+    node_type* node_;
+
+    rb_node_handle(node_type* node, const node_allocator& a) noexcept : alloc_base(a), node_(node) {}
+
+    node_type* release() noexcept {
+        auto p = node_;
+        node_ = nullptr;
+        return p;
+    }
+
+public:
+    using value_type     = Value;
+    using allocator_type = Alloc;
+
+    rb_node_handle() noexcept : node_(nullptr) {}
+    rb_node_handle(rb_node_handle&& rhs) noexcept : alloc_base(rhs.alloc()), node_(rhs.release()) {}
+    rb_node_handle& operator=(rb_node_handle&& rhs) noexcept {
+        if (this != &rhs) {
+            reset();
+            this->alloc() = rhs.alloc();
+            node_ = rhs.release();
+        }
+        return *this;
+    }
+    rb_node_handle(const rb_node_handle&) = delete;
+    rb_node_handle& operator=(const rb_node_handle&) = delete;
+    ~rb_node_handle() { reset(); }
+
+    bool empty() const noexcept { return node_ == nullptr; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+    value_type& value() const { return node_->value; }
+
+    // the key of an unlinked node may be changed before it is inserted again
+    template <typename V = Value>
+    typename std::remove_const<typename V::first_type>::type& key() const {
+        using key_type = typename std::remove_const<typename V::first_type>::type;
+        return const_cast<key_type&>(node_->value.first);
+    }
+    template <typename V = Value>
+    typename V::second_type& mapped() const { return node_->value.second; }
+
+    allocator_type get_allocator() const { return allocator_type(this->alloc()); }
+
+    void swap(rb_node_handle& rhs) noexcept {
+        MYSTL::swap(node_, rhs.node_);
+        MYSTL::swap(this->alloc(), rhs.alloc());
+    }
+
+private:
+    void reset() noexcept {
+        if (node_ != nullptr) {
+            MYSTL::destroy(MYSTL::addressof(node_->value));
+            this->alloc().deallocate(node_, 1);
+            node_ = nullptr;
+        }
+    }
+};
+
+template <typename Iterator, typename NodeHandle>
+struct rb_insert_return {
+    Iterator   position;
+    bool       inserted;
+    NodeHandle node;
+};
+
+// KeyOfValue for set and map
+template <typename T>
+struct __identity {
+    const T& operator()(const T& value) const { return value; }
+};
+
+template <typename Pair>
+struct __select_first {
+    const typename Pair::first_type& operator()(const Pair& p) const { return p.first; }
+};
+
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Alloc = MYSTL::allocator<Value>>
+class rb_tree {
+public:
+    using key_type               = Key;
+    using value_type             = Value;
+    using key_compare            = Compare;
+    using allocator_type         = Alloc;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using iterator               = __rb_tree_iterator<Value>;
+    using const_iterator         = __rb_tree_const_iterator<Value>;
+    using reverse_iterator       = MYSTL::reverse_iterator<iterator>;
+    using const_reverse_iterator = MYSTL::reverse_iterator<const_iterator>;
+    using node_type              = rb_node_handle<Value, Alloc>;
+    using insert_return_type     = rb_insert_return<iterator, node_type>;
+
+private:
+    using base_ptr  = __rb_tree_node_base*;
+    using link_type = __rb_tree_node<Value>*;
+    using node_pos  = MYSTL::pair<base_ptr, base_ptr>;
+    using node_allocator = __rebind_alloc<Alloc, __rb_tree_node<Value>>;
+
+    __rb_tree_node_base                   header_;
+    size_type                             node_count_;
+    key_compare                           comp_;
+    // holds the allocator: every node comes from and goes back through the cache
+    MYSTL::node_cache<__rb_tree_node<Value>, 64, node_allocator> cache_;
+
+public:
+    rb_tree() : node_count_(0), comp_() { reset_header(); }
+    explicit rb_tree(const allocator_type& a) : node_count_(0), comp_(), cache_(node_allocator(a)) {
+        reset_header();
+    }
+    explicit rb_tree(const key_compare& comp, const allocator_type& a = allocator_type())
+        : node_count_(0), comp_(comp), cache_(node_allocator(a)) { reset_header(); }
+
+    rb_tree(const rb_tree& rhs)
+        : node_count_(0), comp_(rhs.comp_), cache_(__select_on_copy(rhs.cache_.get_allocator())) {
+        reset_header();
+        copy_from(rhs);
+    }
+    rb_tree(rb_tree&& rhs) noexcept
+        : node_count_(0), comp_(rhs.comp_), cache_(rhs.cache_.get_allocator()) {
+        reset_header();
+        steal(rhs);
+    }
+
+    rb_tree& operator=(const rb_tree& rhs) {
+        if (this != &rhs) {
+            clear();
+            comp_ = rhs.comp_;
+            copy_from(rhs);
+        }
+        return *this;
+    }
+    rb_tree& operator=(rb_tree&& rhs) noexcept {
+        if (this != &rhs) {
+            clear();
+            comp_ = MYSTL::move(rhs.comp_);
+            // rhs's nodes are freed with rhs's allocator from now on
+            cache_.release();
+            cache_.swap(rhs.cache_);
+            steal(rhs);
+        }
+        return *this;
+    }
+
+    ~rb_tree() { clear(); }
+
+    allocator_type get_allocator() const { return allocator_type(cache_.get_allocator()); }
+
+public:
+    //iterators
+    iterator       begin()       { return iterator(header_.left); }
+    const_iterator begin() const { return const_iterator(header_.left); }
+    iterator       end()         { return iterator(&header_); }
+    const_iterator end()   const { return const_iterator(const_cast<base_ptr>(&header_)); }
+
+    reverse_iterator       rbegin()       { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()         { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()   const { return const_reverse_iterator(begin()); }
+
+    //capacity
+    bool      empty()    const { return node_count_ == 0; }
+    size_type size()     const { return node_count_; }
+    size_type max_size() const { return static_cast<size_type>(-1) / sizeof(__rb_tree_node<Value>); }
+
+    key_compare key_comp() const { return comp_; }
+
+    //insert
+    template <typename V>
+    MYSTL::pair<iterator, bool> insert_unique(V&& value) {
+        auto pos = get_insert_unique_pos(KeyOfValue()(value));
+        if (pos.second == nullptr)
+            return MYSTL::pair<iterator, bool>(iterator(pos.first), false);
+        return MYSTL::pair<iterator, bool>(
+            insert_node(pos.first, pos.second, create_node(MYSTL::forward<V>(value))), true);
+    }
+
+    template <typename V>
+    iterator insert_equal(V&& value) {
+        auto pos = get_insert_equal_pos(KeyOfValue()(value));
+        return insert_node(pos.first, pos.second, create_node(MYSTL::forward<V>(value)));
+    }
+
+    // a right hint (the element goes just before it) costs amortized O(1), so filling a
+    // tree from sorted input with end() as the hint is linear
+    template <typename V>
+    iterator insert_hint_unique(const_iterator hint, V&& value) {
+        auto pos = get_insert_hint_unique_pos(hint, KeyOfValue()(value));
+        if (pos.second == nullptr)
+            return iterator(pos.first);
+        return insert_node(pos.first, pos.second, create_node(MYSTL::forward<V>(value)));
+    }
+
+    template <typename V>
+    iterator insert_hint_equal(const_iterator hint, V&& value) {
+        auto pos = get_insert_hint_equal_pos(hint, KeyOfValue()(value));
+        return insert_node(pos.first, pos.second, create_node(MYSTL::forward<V>(value)));
+    }
+
+    template <typename InputIterator>
+    void insert_range_unique(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_hint_unique(end(), *first);
+    }
+
+    template <typename InputIterator>
+    void insert_range_equal(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert_hint_equal(end(), *first);
+    }
+
+    // the node is built first, its key decides whether it is kept
+    template <typename... Args>
+    MYSTL::pair<iterator, bool> emplace_unique(Args&&... args) {
+        auto z = create_node(MYSTL::forward<Args>(args)...);
+        auto pos = get_insert_unique_pos(KeyOfValue()(z->value));
+        if (pos.second == nullptr) {
+            destroy_node(z);
+            return MYSTL::pair<iterator, bool>(iterator(pos.first), false);
+        }
+        return MYSTL::pair<iterator, bool>(insert_node(pos.first, pos.second, z), true);
+    }
+
+    template <typename... Args>
+    iterator emplace_equal(Args&&... args) {
+        auto z = create_node(MYSTL::forward<Args>(args)...);
+        auto pos = get_insert_equal_pos(KeyOfValue()(z->value));
+        return insert_node(pos.first, pos.second, z);
+    }
+
+    template <typename... Args>
+    iterator emplace_hint_unique(const_iterator hint, Args&&... args) {
+        auto z = create_node(MYSTL::forward<Args>(args)...);
+        auto pos = get_insert_hint_unique_pos(hint, KeyOfValue()(z->value));
+        if (pos.second == nullptr) {
+            destroy_node(z);
+            return iterator(pos.first);
+        }
+        return insert_node(pos.first, pos.second, z);
+    }
+
+    template <typename... Args>
+    iterator emplace_hint_equal(const_iterator hint, Args&&... args) {
+        auto z = create_node(MYSTL::forward<Args>(args)...);
+        auto pos = get_insert_hint_equal_pos(hint, KeyOfValue()(z->value));
+        return insert_node(pos.first, pos.second, z);
+    }
+
+    //node handles
+    node_type extract(const_iterator position) {
+        auto z = __rb_tree_rebalance_for_erase(position.node_, header_);
+        --node_count_;
+        return node_type(static_cast<link_type>(z), cache_.get_allocator());
+    }
+    node_type extract(const key_type& key) {
+        auto it = find(key);
+        return it == end() ? node_type() : extract(const_iterator(it));
+    }
+
+    insert_return_type insert_unique_node(node_type&& nh) {
+        if (nh.empty())
+            return insert_return_type{end(), false, node_type()};
+        auto pos = get_insert_unique_pos(KeyOfValue()(nh.node_->value));
+        if (pos.second == nullptr)
+            return insert_return_type{iterator(pos.first), false, MYSTL::move(nh)};
+        return insert_return_type{insert_node(pos.first, pos.second, nh.release()), true, node_type()};
+    }
+    iterator insert_hint_unique_node(const_iterator hint, node_type&& nh) {
+        if (nh.empty())
+            return end();
+        auto pos = get_insert_hint_unique_pos(hint, KeyOfValue()(nh.node_->value));
+        if (pos.second == nullptr)
+            return iterator(pos.first);
+        return insert_node(pos.first, pos.second, nh.release());
+    }
+    iterator insert_equal_node(node_type&& nh) {
+        if (nh.empty())
+            return end();
+        auto pos = get_insert_equal_pos(KeyOfValue()(nh.node_->value));
+        return insert_node(pos.first, pos.second, nh.release());
+    }
+    iterator insert_hint_equal_node(const_iterator hint, node_type&& nh) {
+        if (nh.empty())
+            return end();
+        auto pos = get_insert_hint_equal_pos(hint, KeyOfValue()(nh.node_->value));
+        return insert_node(pos.first, pos.second, nh.release());
+    }
+
+    //erase
+    iterator erase(const_iterator position) {
+        auto next = position.__const_cast();
+        ++next;
+        destroy_node(static_cast<link_type>(__rb_tree_rebalance_for_erase(position.node_, header_)));
+        --node_count_;
+        return next;
+    }
+    iterator erase(const_iterator first, const_iterator last) {
+        if (first == begin() && last == end()) {
+            clear();
+            return end();
+        }
+        while (first != last)
+            first = erase(first);
+        return last.__const_cast();
+    }
+    size_type erase(const key_type& key) {
+        auto range = equal_range(key);
+        const size_type old_size = size();
+        erase(range.first, range.second);
+        return old_size - size();
+    }
+
+    void clear() {
+        if (node_count_ != 0) {
+            erase_subtree(root());
+            reset_header();
+            node_count_ = 0;
+        }
+    }
+
+    // returns the cached free nodes to the allocator
+    void shrink_to_fit() { cache_.release(); }
+
+    void swap(rb_tree& rhs) noexcept {
+        if (this == &rhs)
+            return;
+        rb_tree tmp(MYSTL::move(rhs));
+        rhs.steal(*this);
+        steal(tmp);
+        MYSTL::swap(comp_, rhs.comp_);
+        cache_.swap(rhs.cache_);
+    }
+
+    //lookup
+    iterator find(const key_type& key) {
+        auto it = lower_bound(key);
+        return it == end() || comp_(key, KeyOfValue()(*it)) ? end() : it;
+    }
+    const_iterator find(const key_type& key) const {
+        auto it = lower_bound(key);
+        return it == end() || comp_(key, KeyOfValue()(*it)) ? end() : it;
+    }
+
+    size_type count(const key_type& key) const {
+        auto range = equal_range(key);
+        size_type n = 0;
+        for (auto it = range.first; it != range.second; ++it)
+            ++n;
+        return n;
+    }
+
+    iterator       lower_bound(const key_type& key)       { return iterator(lower_bound_node(key)); }
+    const_iterator lower_bound(const key_type& key) const { return const_iterator(lower_bound_node(key)); }
+    iterator       upper_bound(const key_type& key)       { return iterator(upper_bound_node(key)); }
+    const_iterator upper_bound(const key_type& key) const { return const_iterator(upper_bound_node(key)); }
+
+    MYSTL::pair<iterator, iterator> equal_range(const key_type& key) {
+        return MYSTL::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+    MYSTL::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return MYSTL::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+private:
+    base_ptr  root()      const { return header_.parent; }
+    base_ptr  leftmost()  const { return header_.left; }
+    base_ptr  rightmost() const { return header_.right; }
+    base_ptr  header()    const { return const_cast<base_ptr>(&header_); }
+
+    static const key_type& key(base_ptr x) {
+        return KeyOfValue()(static_cast<link_type>(x)->value);
+    }
+
+    void reset_header() {
+        header_.color = __rb_tree_red;  // tells end() apart from the root in decrement
+        header_.parent = nullptr;
+        header_.left = &header_;
+        header_.right = &header_;
+    }
+
+    // takes over rhs's nodes, *this must be empty
+    void steal(rb_tree& rhs) noexcept {
+        if (rhs.root() != nullptr) {
+            header_.parent = rhs.header_.parent;
+            header_.left = rhs.header_.left;
+            header_.right = rhs.header_.right;
+            header_.parent->parent = &header_;
+            node_count_ = rhs.node_count_;
+            rhs.reset_header();
+            rhs.node_count_ = 0;
+        }
+    }
+
+    template <typename... Args>
+    link_type create_node(Args&&... args) {
+        link_type p = cache_.allocate();
+        try {
+            MYSTL::construct(MYSTL::addressof(p->value), MYSTL::forward<Args>(args)...);
+        }
+        catch(...) {
+            cache_.deallocate(p);
+            throw;
+        }
+        return p;
+    }
+
+    void destroy_node(link_type p) noexcept {
+        MYSTL::destroy(MYSTL::addressof(p->value));
+        cache_.deallocate(p);
+    }
+
+    link_type clone_node(base_ptr x) {
+        link_type p = create_node(static_cast<link_type>(x)->value);
+        p->color = x->color;
+        p->left = nullptr;
+        p->right = nullptr;
+        return p;
+    }
+
+    // copies the subtree at x under p: recursion on the right children, a loop down the left
+    link_type copy_subtree(base_ptr x, base_ptr p) {
+        link_type top = clone_node(x);
+        top->parent = p;
+        try {
+            if (x->right != nullptr)
+                top->right = copy_subtree(x->right, top);
+            p = top;
+            x = x->left;
+            while (x != nullptr) {
+                link_type y = clone_node(x);
+                p->left = y;
+                y->parent = p;
+                if (x->right != nullptr)
+                    y->right = copy_subtree(x->right, y);
+                p = y;
+                x = x->left;
+            }
+        }
+        catch(...) {
+            erase_subtree(top);
+            throw;
+        }
+        return top;
+    }
+
+    void copy_from(const rb_tree& rhs) {
+        if (rhs.root() != nullptr) {
+            header_.parent = copy_subtree(rhs.root(), &header_);
+            header_.left = __rb_tree_node_base::minimum(root());
+            header_.right = __rb_tree_node_base::maximum(root());
+            node_count_ = rhs.node_count_;
+        }
+    }
+
+    // no rebalancing, the whole subtree goes away
+    void erase_subtree(base_ptr x) noexcept {
+        while (x != nullptr) {
+            erase_subtree(x->right);
+            base_ptr left = x->left;
+            destroy_node(static_cast<link_type>(x));
+            x = left;
+        }
+    }
+
+    base_ptr lower_bound_node(const key_type& k) const {
+        base_ptr y = header();
+        base_ptr x = root();
+        while (x != nullptr) {
+            if (!comp_(key(x), k)) {
+                y = x;
+                x = x->left;
+            }
+            else {
+                x = x->right;
+            }
+        }
+        return y;
+    }
+
+    base_ptr upper_bound_node(const key_type& k) const {
+        base_ptr y = header();
+        base_ptr x = root();
+        while (x != nullptr) {
+            if (comp_(k, key(x))) {
+                y = x;
+                x = x->left;
+            }
+            else {
+                x = x->right;
+            }
+        }
+        return y;
+    }
+
+    // (x, p): link a new node under p, on the left if x != null or ordering says so.
+    // (node, null): an equal key exists at node
+    node_pos get_insert_unique_pos(const key_type& k) {
+        base_ptr x = root();
+        base_ptr y = header();
+        bool less = true;
+        while (x != nullptr) {
+            y = x;
+            less = comp_(k, key(x));
+            x = less ? x->left : x->right;
+        }
+        base_ptr j = y;
+        if (less) {
+            if (j == leftmost())
+                return node_pos(x, y);
+            j = __rb_tree_decrement(j);
+        }
+        if (comp_(key(j), k))
+            return node_pos(x, y);
+        return node_pos(j, nullptr);
+    }
+
+    node_pos get_insert_equal_pos(const key_type& k) {
+        base_ptr x = root();
+        base_ptr y = header();
+        while (x != nullptr) {
+            y = x;
+            x = comp_(k, key(x)) ? x->left : x->right;
+        }
+        return node_pos(x, y);
+    }
+
+    node_pos get_insert_hint_unique_pos(const_iterator hint, const key_type& k) {
+        base_ptr pos = hint.node_;
+        if (pos == header()) {
+            if (size() > 0 && comp_(key(rightmost()), k))
+                return node_pos(nullptr, rightmost());
+            return get_insert_unique_pos(k);
+        }
+        if (comp_(k, key(pos))) {
+            // k goes before the hint, check the element before it
+            if (pos == leftmost())
+                return node_pos(leftmost(), leftmost());
+            base_ptr before = __rb_tree_decrement(pos);
+            if (comp_(key(before), k))
+                return before->right == nullptr ? node_pos(nullptr, before) : node_pos(pos, pos);
+            return get_insert_unique_pos(k);
+        }
+        if (comp_(key(pos), k)) {
+            // k goes after the hint, check the element after it
+            if (pos == rightmost())
+                return node_pos(nullptr, rightmost());
+            base_ptr after = __rb_tree_increment(pos);
+            if (comp_(k, key(after)))
+                return pos->right == nullptr ? node_pos(nullptr, pos) : node_pos(after, after);
+            return get_insert_unique_pos(k);
+        }
+        return node_pos(pos, nullptr);
+    }
+
+    node_pos get_insert_hint_equal_pos(const_iterator hint, const key_type& k) {
+        base_ptr pos = hint.node_;
+        if (pos == header()) {
+            if (size() > 0 && !comp_(k, key(rightmost())))
+                return node_pos(nullptr, rightmost());
+            return get_insert_equal_pos(k);
+        }
+        if (!comp_(key(pos), k)) {
+            if (pos == leftmost())
+                return node_pos(leftmost(), leftmost());
+            base_ptr before = __rb_tree_decrement(pos);
+            if (!comp_(k, key(before)))
+                return before->right == nullptr ? node_pos(nullptr, before) : node_pos(pos, pos);
+            return get_insert_equal_pos(k);
+        }
+        if (pos == rightmost())
+            return node_pos(nullptr, rightmost());
+        base_ptr after = __rb_tree_increment(pos);
+        if (!comp_(key(after), k))
+            return pos->right == nullptr ? node_pos(nullptr, pos) : node_pos(after, after);
+        return get_insert_equal_pos(k);
+    }
+
+    iterator insert_node(base_ptr x, base_ptr p, link_type z) {
+        const bool insert_left = x != nullptr || p == header() || comp_(key(z), key(p));
+        __rb_tree_insert_and_rebalance(insert_left, z, p, header_);
+        ++node_count_;
+        return iterator(z);
+    }
+
+public:
+    // checks the red-black invariants, for tests
+    bool __verify() const {
+        if (node_count_ == 0)
+            return begin() == end() && leftmost() == header() && rightmost() == header();
+        if (root()->color != __rb_tree_black || root()->parent != header())
+            return false;
+        int black_height = -1;
+        size_type n = 0;
+        for (auto it = begin(); it != end(); ++it, ++n) {
+            base_ptr x = it.node_;
+            if (x->color == __rb_tree_red &&
+                ((x->left && x->left->color == __rb_tree_red) || (x->right && x->right->color == __rb_tree_red)))
+                return false;
+            if (x->left && comp_(key(x), key(x->left)))
+                return false;
+            if (x->right && comp_(key(x->right), key(x)))
+                return false;
+            if (x->left == nullptr && x->right == nullptr) {
+                int h = 0;
+                for (base_ptr y = x; y != root(); y = y->parent)
+                    h += y->color == __rb_tree_black;
+                if (black_height == -1)
+                    black_height = h;
+                else if (h != black_height)
+                    return false;
+            }
+        }
+        return n == node_count_ &&
+               leftmost() == __rb_tree_node_base::minimum(root()) &&
+               rightmost() == __rb_tree_node_base::maximum(root());
+    }
+};
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare, typename Alloc>
+bool operator==(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& lhs,
+                const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && MYSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare, typename Alloc>
+bool operator<(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& lhs,
+               const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& rhs) {
+    return MYSTL::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,382 @@
+#ifndef RING_BUFFER_H_
+#define RING_BUFFER_H_
+
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include "memory.h"
+#include "utility.h"
+#include "iterator.h"
+#include "allocator.h"
+#include "algobase.h"
+#include "uninitialized.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// ring_buffer
+// bounded circular buffer. the capacity is rounded up to a power of two so a slot is
+// found with `index & mask` instead of a division. head_ and tail_ count pushes and pops
+// without wrapping back, the slot of logical element i is (head_ + i) & mask_.
+// when it is full, push_back either drops the new element (reject) or replaces the
+// oldest one (overwrite_oldest).
+// two_spans() exposes the elements as at most two contiguous pieces for batched copies,
+// free_spans() + commit_back() let a producer construct straight into the free slots.
+// a moved-from ring_buffer is empty with capacity 0 and rejects every push.
+/*****************************************************************************************/
+
+enum class ring_full_policy { reject, overwrite_oldest };
+
+template <typename T, typename Ref, typename Ptr>
+struct ring_buffer_iterator
+    :public MYSTL::iterator<MYSTL::random_access_iterator_tag, T>
+{
+    using iterator          = ring_buffer_iterator<T, T&, T*>;
+    using const_iterator    = ring_buffer_iterator<T, const T&, const T*>;
+    using self              = ring_buffer_iterator;
+
+    using iterator_category = MYSTL::random_access_iterator_tag;
+    using value_type        = T;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+    T*        buffer;
+    size_type mask;
+    size_type index;  // unwrapped position, same counter as head_/tail_
+
+    ring_buffer_iterator() noexcept : buffer(nullptr), mask(0), index(0) {}
+    ring_buffer_iterator(T* b, size_type m, size_type i) noexcept : buffer(b), mask(m), index(i) {}
+    // iterator -> const_iterator; a template, so the implicit copy operations stay
+    template <typename R, typename P, typename = typename std::enable_if<
+              std::is_same<R, T&>::value && !std::is_same<R, Ref>::value>::type>
+    ring_buffer_iterator(const ring_buffer_iterator<T, R, P>& rhs) noexcept
+        : buffer(rhs.buffer), mask(rhs.mask), index(rhs.index) {}
+
+    reference operator*()  const { return buffer[index & mask]; }
+    pointer   operator->() const { return buffer + (index & mask); }
+    reference operator[](difference_type n) const { return buffer[(index + n) & mask]; }
+
+    self& operator++()    { ++index; return *this; }
+    self  operator++(int) { self tmp = *this; ++index; return tmp; }
+    self& operator--()    { --index; return *this; }
+    self  operator--(int) { self tmp = *this; --index; return tmp; }
+
+    self& operator+=(difference_type n) { index += n; return *this; }
+    self& operator-=(difference_type n) { index -= n; return *this; }
+    self  operator+(difference_type n) const { return self(buffer, mask, index + n); }
+    self  operator-(difference_type n) const { return self(buffer, mask, index - n); }
+    difference_type operator-(const self& rhs) const {
+        return static_cast<difference_type>(index - rhs.index);
+    }
+
+    bool operator==(const self& rhs) const { return index == rhs.index; }
+    bool operator!=(const self& rhs) const { return index != rhs.index; }
+    bool operator<(const self& rhs)  const { return (*this - rhs) < 0; }
+    bool operator>(const self& rhs)  const { return rhs < *this; }
+    bool operator<=(const self& rhs) const { return !(rhs < *this); }
+    bool operator>=(const self& rhs) const { return !(*this < rhs); }
+};
+
+
+template <typename T, ring_full_policy Policy = ring_full_policy::reject,
+          typename Alloc = MYSTL::allocator<T>>
+class ring_buffer : private __allocator_holder<Alloc> {
+    using alloc_base = __allocator_holder<Alloc>;
+
+public:
+    using allocator_type         = Alloc;
+
+    using value_type             = T;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+
+    using iterator               = ring_buffer_iterator<T, T&, T*>;
+    using const_iterator         = ring_buffer_iterator<T, const T&, const T*>;
+    using reverse_iterator       = MYSTL::reverse_iterator<iterator>;
+    using const_reverse_iterator = MYSTL::reverse_iterator<const_iterator>;
+
+    // a contiguous run of slots
+    template <typename P>
+    struct basic_span {
+        P         data;
+        size_type size;
+    };
+    using span       = basic_span<pointer>;
+    using const_span = basic_span<const_pointer>;
+
+    template <typename S>
+    struct basic_span_pair {
+        S first;
+        S second;
+    };
+    using span_pair       = basic_span_pair<span>;
+    using const_span_pair = basic_span_pair<const_span>;
+
+protected:
+    pointer   buffer_;
+    size_type mask_;   // capacity - 1, all ones when there is no storage
+    size_type head_;   // index of the front element
+    size_type tail_;   // one past the back element
+
+public:
+    explicit ring_buffer(size_type capacity, const allocator_type& a = allocator_type())
+        : alloc_base(a), buffer_(nullptr), mask_(round_up(capacity) - 1), head_(0), tail_(0) {
+        buffer_ = this->alloc().allocate(mask_ + 1);
+    }
+
+    ring_buffer(const ring_buffer& rhs)
+        : alloc_base(__select_on_copy(rhs.alloc())), buffer_(nullptr), mask_(rhs.mask_), head_(0), tail_(0) {
+        buffer_ = this->alloc().allocate(mask_ + 1);
+        try {
+            copy_in(rhs.two_spans());
+        }
+        catch(...) {
+            this->alloc().deallocate(buffer_, mask_ + 1);
+            throw;
+        }
+    }
+
+    ring_buffer(ring_buffer&& rhs) noexcept
+        : alloc_base(MYSTL::move(rhs.alloc())), buffer_(rhs.buffer_), mask_(rhs.mask_), head_(rhs.head_), tail_(rhs.tail_) {
+        rhs.buffer_ = nullptr;
+        rhs.mask_ = static_cast<size_type>(-1);
+        rhs.head_ = rhs.tail_ = 0;
+    }
+
+    ring_buffer& operator=(const ring_buffer& rhs) {
+        if (this != &rhs) {
+            ring_buffer tmp(rhs);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    ring_buffer& operator=(ring_buffer&& rhs) noexcept {
+        if (this != &rhs) {
+            destroy_and_free();
+            this->alloc() = MYSTL::move(rhs.alloc());
+            buffer_ = rhs.buffer_;
+            mask_ = rhs.mask_;
+            head_ = rhs.head_;
+            tail_ = rhs.tail_;
+            rhs.buffer_ = nullptr;
+            rhs.mask_ = static_cast<size_type>(-1);
+            rhs.head_ = rhs.tail_ = 0;
+        }
+        return *this;
+    }
+
+    ~ring_buffer() { destroy_and_free(); }
+
+    allocator_type get_allocator() const { return this->alloc(); }
+
+public:
+    //iterators
+    iterator        begin()       { return iterator(buffer_, mask_, head_); }
+    const_iterator  begin() const { return const_iterator(buffer_, mask_, head_); }
+    iterator        end()         { return iterator(buffer_, mask_, tail_); }
+    const_iterator  end()   const { return const_iterator(buffer_, mask_, tail_); }
+
+    reverse_iterator       rbegin()        { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin()  const { return const_reverse_iterator(end()); }
+    reverse_iterator       rend()          { return reverse_iterator(begin()); }
+    const_reverse_iterator rend()    const { return const_reverse_iterator(begin()); }
+
+    const_iterator         cbegin()  const { return begin(); }
+    const_iterator         cend()    const { return end(); }
+
+    //capacity
+    size_type size()     const { return tail_ - head_; }
+    size_type capacity() const { return mask_ + 1; }
+    bool      empty()    const { return head_ == tail_; }
+    bool      full()     const { return size() == capacity(); }
+
+    //element access
+    reference       operator[](size_type n)       { return buffer_[(head_ + n) & mask_]; }
+    const_reference operator[](size_type n) const { return buffer_[(head_ + n) & mask_]; }
+    reference at(size_type n) {
+        if (n >= size())
+            throw std::out_of_range("ring_buffer::at");
+        return (*this)[n];
+    }
+    const_reference at(size_type n) const {
+        if (n >= size())
+            throw std::out_of_range("ring_buffer::at");
+        return (*this)[n];
+    }
+    reference       front()       { return buffer_[head_ & mask_]; }
+    const_reference front() const { return buffer_[head_ & mask_]; }
+    reference       back()        { return buffer_[(tail_ - 1) & mask_]; }
+    const_reference back()  const { return buffer_[(tail_ - 1) & mask_]; }
+
+    // the elements in order: first runs from the front to the end of the storage
+    // (or to the back), second is the wrapped part and may be empty
+    span_pair       two_spans()       { return make_spans<span_pair>(buffer_, head_, size()); }
+    const_span_pair two_spans() const { return make_spans<const_span_pair>(buffer_, head_, size()); }
+
+    // the unconstructed slots after the back, in order. construct into them and then
+    // call commit_back with the number of slots used, starting from first.data
+    span_pair free_spans() { return make_spans<span_pair>(buffer_, tail_, capacity() - size()); }
+    void commit_back(size_type n) { tail_ += n; }
+
+    //modifiers
+    // returns false when the buffer is full and the policy is reject
+    template <typename... Args>
+    bool emplace_back(Args&&... args) {
+        if (full()) {
+            if (Policy == ring_full_policy::reject || capacity() == 0)
+                return false;
+            // the back slot is the front slot, replace the oldest element in place
+            buffer_[tail_ & mask_] = value_type(MYSTL::forward<Args>(args)...);
+            ++head_;
+            ++tail_;
+            return true;
+        }
+        MYSTL::construct(buffer_ + (tail_ & mask_), MYSTL::forward<Args>(args)...);
+        ++tail_;
+        return true;
+    }
+
+    bool push_back(const value_type& value) { return emplace_back(value); }
+    bool push_back(value_type&& value)      { return emplace_back(MYSTL::move(value)); }
+
+    // copies [first, first + n) in at most two chunks. with reject only what fits is
+    // copied, with overwrite_oldest the oldest elements make room (only the last
+    // capacity() elements are kept when n is larger than that).
+    // returns the number of elements copied
+    template <typename InputIterator>
+    size_type push_back_n(InputIterator first, size_type n);
+
+    void pop_front() {
+        MYSTL::destroy(buffer_ + (head_ & mask_));
+        ++head_;
+    }
+
+    void pop_back() {
+        --tail_;
+        MYSTL::destroy(buffer_ + (tail_ & mask_));
+    }
+
+    // drops the n oldest elements
+    void pop_front(size_type n) {
+        const span_pair s = make_spans<span_pair>(buffer_, head_, n);
+        MYSTL::destroy(s.first.data, s.first.data + s.first.size);
+        MYSTL::destroy(s.second.data, s.second.data + s.second.size);
+        head_ += n;
+    }
+
+    void clear() {
+        pop_front(size());
+        head_ = tail_ = 0;
+    }
+
+    void swap(ring_buffer& rhs) noexcept {
+        MYSTL::swap(buffer_, rhs.buffer_);
+        MYSTL::swap(mask_, rhs.mask_);
+        MYSTL::swap(head_, rhs.head_);
+        MYSTL::swap(tail_, rhs.tail_);
+        MYSTL::swap(this->alloc(), rhs.alloc());
+    }
+
+protected:
+    // past the largest power of two in size_type the doubling below would wrap to zero
+    static size_type round_up(size_type n) {
+        if (n > (static_cast<size_type>(-1) >> 1) + 1)
+            throw std::length_error("ring_buffer: capacity too large");
+        size_type cap = 1;
+        while (cap < n)
+            cap <<= 1;
+        return cap;
+    }
+
+    // splits the n slots starting at unwrapped index `from` at the end of the storage
+    template <typename Pair, typename P>
+    Pair make_spans(P base, size_type from, size_type n) const {
+        const size_type offset = from & mask_;
+        const size_type first_len = MYSTL::min(n, capacity() - offset);
+        Pair result;
+        result.first.data = base + offset;
+        result.first.size = first_len;
+        result.second.data = base;
+        result.second.size = n - first_len;
+        return result;
+    }
+
+    template <typename InputIterator>
+    void copy_back(InputIterator first, size_type n, MYSTL::input_iterator_tag);
+    template <typename ForwardIterator>
+    void copy_back(ForwardIterator first, size_type n, MYSTL::forward_iterator_tag);
+
+    void copy_in(const_span_pair s) {
+        pointer cur = buffer_;
+        cur = MYSTL::uninitialized_copy(s.first.data, s.first.data + s.first.size, cur);
+        cur = MYSTL::uninitialized_copy(s.second.data, s.second.data + s.second.size, cur);
+        tail_ = static_cast<size_type>(cur - buffer_);
+    }
+
+    void destroy_and_free() {
+        if (buffer_ == nullptr)
+            return;
+        clear();
+        this->alloc().deallocate(buffer_, capacity());
+        buffer_ = nullptr;
+    }
+};
+
+template <typename T, ring_full_policy Policy, typename Alloc>
+template <typename InputIterator>
+typename ring_buffer<T, Policy, Alloc>::size_type
+ring_buffer<T, Policy, Alloc>::push_back_n(InputIterator first, size_type n) {
+    if (Policy == ring_full_policy::reject) {
+        n = MYSTL::min(n, capacity() - size());
+    }
+    else {
+        if (n > capacity()) {
+            MYSTL::advance(first, n - capacity());
+            n = capacity();
+        }
+        const size_type room = capacity() - size();
+        if (n > room)
+            pop_front(n - room);
+    }
+    copy_back(first, n, iterator_category(first));
+    return n;
+}
+
+// a single pass iterator is read once, element by element
+template <typename T, ring_full_policy Policy, typename Alloc>
+template <typename InputIterator>
+void ring_buffer<T, Policy, Alloc>::copy_back(InputIterator first, size_type n, MYSTL::input_iterator_tag) {
+    for (; n != 0; --n, ++first) {
+        MYSTL::construct(buffer_ + (tail_ & mask_), *first);
+        ++tail_;
+    }
+}
+
+template <typename T, ring_full_policy Policy, typename Alloc>
+template <typename ForwardIterator>
+void ring_buffer<T, Policy, Alloc>::copy_back(ForwardIterator first, size_type n, MYSTL::forward_iterator_tag) {
+    const span_pair s = free_spans();
+    const size_type first_len = MYSTL::min(n, s.first.size);
+    MYSTL::uninitialized_copy_n(first, first_len, s.first.data);
+    tail_ += first_len;
+    MYSTL::advance(first, first_len);
+    MYSTL::uninitialized_copy_n(first, n - first_len, s.second.data);
+    tail_ += n - first_len;
+}
+
+template <typename T, ring_full_policy Policy, typename Alloc>
+void swap(ring_buffer<T, Policy, Alloc>& lhs, ring_buffer<T, Policy, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
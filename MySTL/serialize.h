@@ -0,0 +1,206 @@
+#ifndef SERIALIZE_H_
+#define SERIALIZE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include "utility.h"
+#include "algobase.h"
+#include "vector.h"
+#include "list.h"
+#include "basic_string.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// serialize / deserialize
+// binary snapshots on std::ostream / std::istream, in native byte order:
+//   trivially copyable T   its bytes
+//   pair                   first, then second
+//   vector, basic_string   a uint64 count, then the elements; trivially copyable elements
+//                          go out as one blob in a single write and come back with one
+//                          read per chunk into the resized storage
+//   list                   a uint64 count, then the elements one by one
+// nested containers recurse through serializer<T>, which a user type can specialize to
+// take part. a short read or a failed write throws std::runtime_error, and so does a
+// count above max_size() of the container. the count read is not trusted for memory:
+// storage grows in chunks of __read_chunk_bytes as the elements actually arrive, so a
+// corrupt count fails at the end of the input instead of reserving all of it up front.
+/*****************************************************************************************/
+
+inline void __write_bytes(std::ostream& os, const void* p, size_t n) {
+    if (n != 0 && !os.write(static_cast<const char*>(p), static_cast<std::streamsize>(n)))
+        throw std::runtime_error("serialize: write failed");
+}
+
+inline void __read_bytes(std::istream& is, void* p, size_t n) {
+    if (n != 0 && !is.read(static_cast<char*>(p), static_cast<std::streamsize>(n)))
+        throw std::runtime_error("deserialize: unexpected end of input");
+}
+
+inline void __write_count(std::ostream& os, size_t n) {
+    const uint64_t count = n;
+    __write_bytes(os, &count, sizeof(count));
+}
+
+inline size_t __read_count(std::istream& is) {
+    uint64_t count;
+    __read_bytes(is, &count, sizeof(count));
+    if (count > static_cast<uint64_t>(static_cast<size_t>(-1)))
+        throw std::runtime_error("deserialize: count out of range");
+    return static_cast<size_t>(count);
+}
+
+constexpr size_t __read_chunk_bytes = size_t(1) << 16;
+
+// elements of size elem_bytes per chunk, at least one
+inline size_t __read_chunk(size_t elem_bytes) noexcept {
+    return elem_bytes >= __read_chunk_bytes ? 1 : __read_chunk_bytes / elem_bytes;
+}
+
+inline void __check_count(size_t n, size_t max) {
+    if (n > max)
+        throw std::runtime_error("deserialize: count exceeds max_size");
+}
+
+template <typename T, typename = void>
+struct serializer {
+    static_assert(std::is_trivially_copyable<T>::value, "no serializer for this type");
+
+    static void write(std::ostream& os, const T& value) { __write_bytes(os, &value, sizeof(T)); }
+    static void read(std::istream& is, T& value) { __read_bytes(is, &value, sizeof(T)); }
+};
+
+template <typename T1, typename T2>
+struct serializer<pair<T1, T2>> {
+    static void write(std::ostream& os, const pair<T1, T2>& value) {
+        serializer<T1>::write(os, value.first);
+        serializer<T2>::write(os, value.second);
+    }
+    static void read(std::istream& is, pair<T1, T2>& value) {
+        serializer<T1>::read(is, value.first);
+        serializer<T2>::read(is, value.second);
+    }
+};
+
+// contiguous elements: one blob when their bytes are their value
+template <typename T>
+void __write_elements(std::ostream& os, const T* first, size_t n, std::true_type) {
+    __write_bytes(os, first, n * sizeof(T));
+}
+template <typename T>
+void __write_elements(std::ostream& os, const T* first, size_t n, std::false_type) {
+    for (size_t i = 0; i < n; ++i)
+        serializer<T>::write(os, first[i]);
+}
+
+template <typename T, typename Alloc>
+struct serializer<vector<T, Alloc>> {
+    static void write(std::ostream& os, const vector<T, Alloc>& v) {
+        __write_count(os, v.size());
+        __write_elements(os, v.data(), v.size(), std::is_trivially_copyable<T>());
+    }
+
+    static void read(std::istream& is, vector<T, Alloc>& v) {
+        const size_t n = __read_count(is);
+        __check_count(n, v.max_size());
+        v.clear();
+        read_elements(is, v, n, std::integral_constant<int, std::is_trivial<T>::value ? 2 :
+                                                           std::is_trivially_copyable<T>::value ? 1 : 0>());
+    }
+
+private:
+    // trivial: each chunk is read into uninitialized storage
+    static void read_elements(std::istream& is, vector<T, Alloc>& v, size_t n, std::integral_constant<int, 2>) {
+        const size_t chunk = __read_chunk(sizeof(T));
+        for (size_t done = 0; done < n;) {
+            const size_t len = MYSTL::min(chunk, n - done);
+            if (v.capacity() < done + len)
+                v.reserve(MYSTL::max(2 * v.capacity(), done + len));
+            v.resize_uninitialized(done + len);
+            __read_bytes(is, v.data() + done, len * sizeof(T));
+            done += len;
+        }
+    }
+    // trivially copyable but with a constructor to run first
+    static void read_elements(std::istream& is, vector<T, Alloc>& v, size_t n, std::integral_constant<int, 1>) {
+        const size_t chunk = __read_chunk(sizeof(T));
+        for (size_t done = 0; done < n;) {
+            const size_t len = MYSTL::min(chunk, n - done);
+            v.resize(done + len);
+            __read_bytes(is, v.data() + done, len * sizeof(T));
+            done += len;
+        }
+    }
+    // each element is read in place at the back
+    static void read_elements(std::istream& is, vector<T, Alloc>& v, size_t n, std::integral_constant<int, 0>) {
+        v.reserve(MYSTL::min(n, __read_chunk(sizeof(T))));
+        for (size_t i = 0; i < n; ++i) {
+            v.emplace_back();
+            serializer<T>::read(is, v.back());
+        }
+    }
+};
+
+template <typename CharT, typename Traits, typename Alloc>
+struct serializer<basic_string<CharT, Traits, Alloc>> {
+    static void write(std::ostream& os, const basic_string<CharT, Traits, Alloc>& s) {
+        __write_count(os, s.size());
+        __write_bytes(os, s.data(), s.size() * sizeof(CharT));
+    }
+    static void read(std::istream& is, basic_string<CharT, Traits, Alloc>& s) {
+        const size_t n = __read_count(is);
+        __check_count(n, s.max_size());
+        s.clear();
+        const size_t chunk = __read_chunk(sizeof(CharT));
+        for (size_t done = 0; done < n;) {
+            const size_t len = MYSTL::min(chunk, n - done);
+            s.resize(done + len);
+            __read_bytes(is, s.data() + done, len * sizeof(CharT));
+            done += len;
+        }
+    }
+};
+
+template <typename T, typename Alloc>
+struct serializer<list<T, Alloc>> {
+    static void write(std::ostream& os, const list<T, Alloc>& l) {
+        __write_count(os, l.size());
+        for (const auto& value : l)
+            serializer<T>::write(os, value);
+    }
+    static void read(std::istream& is, list<T, Alloc>& l) {
+        const size_t n = __read_count(is);
+        __check_count(n, l.max_size());
+        l.clear();
+        for (size_t i = 0; i < n; ++i) {
+            l.emplace_back();
+            serializer<T>::read(is, l.back());
+        }
+    }
+};
+
+template <typename T>
+void serialize(std::ostream& os, const T& value) {
+    serializer<T>::write(os, value);
+}
+
+template <typename T>
+void deserialize(std::istream& is, T& value) {
+    serializer<T>::read(is, value);
+}
+
+template <typename T>
+T deserialize(std::istream& is) {
+    T value;
+    serializer<T>::read(is, value);
+    return value;
+}
+
+} // end of namespace MYSTL
+
+#endif
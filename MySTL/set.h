@@ -0,0 +1,286 @@
+#ifndef SET_H_
+#define SET_H_
+
+#include <functional>
+#include <initializer_list>
+#include "rb_tree.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// set / multiset
+// ordered containers on rb_tree, iterators are constant. like map, a hinted insert at the
+// right spot is amortized O(1) and extract() / insert(node_type&&) relink nodes.
+/*****************************************************************************************/
+
+template <typename Key, typename Compare = std::less<Key>, typename Alloc = MYSTL::allocator<Key>>
+class set {
+public:
+    using key_type      = Key;
+    using value_type    = Key;
+    using key_compare   = Compare;
+    using allocator_type= Alloc;
+    using value_compare = Compare;
+
+private:
+    using tree_type = rb_tree<key_type, value_type, __identity<value_type>, key_compare, Alloc>;
+    tree_type tree_;
+
+public:
+    using size_type              = typename tree_type::size_type;
+    using difference_type        = typename tree_type::difference_type;
+    using reference              = typename tree_type::const_reference;
+    using const_reference        = typename tree_type::const_reference;
+    using iterator               = typename tree_type::const_iterator;
+    using const_iterator         = typename tree_type::const_iterator;
+    using reverse_iterator       = typename tree_type::const_reverse_iterator;
+    using const_reverse_iterator = typename tree_type::const_reverse_iterator;
+    using node_type              = typename tree_type::node_type;
+    using insert_return_type     = rb_insert_return<iterator, node_type>;
+
+public:
+    set() = default;
+    explicit set(const allocator_type& a) : tree_(a) {}
+    explicit set(const key_compare& comp, const allocator_type& a = allocator_type()) : tree_(comp, a) {}
+
+    template <typename InputIterator>
+    set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+        const allocator_type& a = allocator_type())
+        : tree_(comp, a) { tree_.insert_range_unique(first, last); }
+
+    set(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(),
+        const allocator_type& a = allocator_type())
+        : tree_(comp, a) { tree_.insert_range_unique(ilist.begin(), ilist.end()); }
+
+    set(const set&) = default;
+    set(set&&) = default;
+    set& operator=(const set&) = default;
+    set& operator=(set&&) = default;
+    set& operator=(std::initializer_list<value_type> ilist) {
+        tree_.clear();
+        tree_.insert_range_unique(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    //iterators
+    iterator         begin()   const { return tree_.begin(); }
+    iterator         end()     const { return tree_.end(); }
+    reverse_iterator rbegin()  const { return tree_.rbegin(); }
+    reverse_iterator rend()    const { return tree_.rend(); }
+    iterator         cbegin()  const { return begin(); }
+    iterator         cend()    const { return end(); }
+    reverse_iterator crbegin() const { return rbegin(); }
+    reverse_iterator crend()   const { return rend(); }
+
+    //capacity
+    bool      empty()    const { return tree_.empty(); }
+    size_type size()     const { return tree_.size(); }
+    size_type max_size() const { return tree_.max_size(); }
+
+    //modifiers
+    MYSTL::pair<iterator, bool> insert(const value_type& value) {
+        auto res = tree_.insert_unique(value);
+        return MYSTL::pair<iterator, bool>(res.first, res.second);
+    }
+    MYSTL::pair<iterator, bool> insert(value_type&& value) {
+        auto res = tree_.insert_unique(MYSTL::move(value));
+        return MYSTL::pair<iterator, bool>(res.first, res.second);
+    }
+    iterator insert(const_iterator hint, const value_type& value) {
+        return tree_.insert_hint_unique(hint, value);
+    }
+    iterator insert(const_iterator hint, value_type&& value) {
+        return tree_.insert_hint_unique(hint, MYSTL::move(value));
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) { tree_.insert_range_unique(first, last); }
+    void insert(std::initializer_list<value_type> ilist) {
+        tree_.insert_range_unique(ilist.begin(), ilist.end());
+    }
+
+    insert_return_type insert(node_type&& nh) {
+        auto res = tree_.insert_unique_node(MYSTL::move(nh));
+        return insert_return_type{res.position, res.inserted, MYSTL::move(res.node)};
+    }
+    iterator insert(const_iterator hint, node_type&& nh) {
+        return tree_.insert_hint_unique_node(hint, MYSTL::move(nh));
+    }
+
+    template <typename... Args>
+    MYSTL::pair<iterator, bool> emplace(Args&&... args) {
+        auto res = tree_.emplace_unique(MYSTL::forward<Args>(args)...);
+        return MYSTL::pair<iterator, bool>(res.first, res.second);
+    }
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return tree_.emplace_hint_unique(hint, MYSTL::forward<Args>(args)...);
+    }
+
+    iterator  erase(const_iterator position) { return tree_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+    size_type erase(const key_type& key) { return tree_.erase(key); }
+
+    node_type extract(const_iterator position) { return tree_.extract(position); }
+    node_type extract(const key_type& key) { return tree_.extract(key); }
+
+    void clear() { tree_.clear(); }
+    void shrink_to_fit() { tree_.shrink_to_fit(); }
+    void swap(set& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    //lookup
+    iterator  find(const key_type& key)     const { return tree_.find(key); }
+    size_type count(const key_type& key)    const { return find(key) == end() ? 0 : 1; }
+    bool      contains(const key_type& key) const { return find(key) != end(); }
+
+    iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+    iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+    MYSTL::pair<iterator, iterator> equal_range(const key_type& key) const { return tree_.equal_range(key); }
+
+    //observers
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+    key_compare   key_comp()   const { return tree_.key_comp(); }
+    value_compare value_comp() const { return tree_.key_comp(); }
+
+    bool __verify() const { return tree_.__verify(); }
+
+    friend bool operator==(const set& lhs, const set& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator<(const set& lhs, const set& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator!=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void swap(set<Key, Compare, Alloc>& lhs, set<Key, Compare, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+
+template <typename Key, typename Compare = std::less<Key>, typename Alloc = MYSTL::allocator<Key>>
+class multiset {
+public:
+    using key_type      = Key;
+    using value_type    = Key;
+    using key_compare   = Compare;
+    using allocator_type= Alloc;
+    using value_compare = Compare;
+
+private:
+    using tree_type = rb_tree<key_type, value_type, __identity<value_type>, key_compare, Alloc>;
+    tree_type tree_;
+
+public:
+    using size_type              = typename tree_type::size_type;
+    using difference_type        = typename tree_type::difference_type;
+    using reference              = typename tree_type::const_reference;
+    using const_reference        = typename tree_type::const_reference;
+    using iterator               = typename tree_type::const_iterator;
+    using const_iterator         = typename tree_type::const_iterator;
+    using reverse_iterator       = typename tree_type::const_reverse_iterator;
+    using const_reverse_iterator = typename tree_type::const_reverse_iterator;
+    using node_type              = typename tree_type::node_type;
+
+public:
+    multiset() = default;
+    explicit multiset(const allocator_type& a) : tree_(a) {}
+    explicit multiset(const key_compare& comp, const allocator_type& a = allocator_type()) : tree_(comp, a) {}
+
+    template <typename InputIterator>
+    multiset(InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
+        const allocator_type& a = allocator_type())
+        : tree_(comp, a) { tree_.insert_range_equal(first, last); }
+
+    multiset(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare(),
+        const allocator_type& a = allocator_type())
+        : tree_(comp, a) { tree_.insert_range_equal(ilist.begin(), ilist.end()); }
+
+    multiset(const multiset&) = default;
+    multiset(multiset&&) = default;
+    multiset& operator=(const multiset&) = default;
+    multiset& operator=(multiset&&) = default;
+
+    //iterators
+    iterator         begin()  const { return tree_.begin(); }
+    iterator         end()    const { return tree_.end(); }
+    reverse_iterator rbegin() const { return tree_.rbegin(); }
+    reverse_iterator rend()   const { return tree_.rend(); }
+    iterator         cbegin() const { return begin(); }
+    iterator         cend()   const { return end(); }
+
+    //capacity
+    bool      empty()    const { return tree_.empty(); }
+    size_type size()     const { return tree_.size(); }
+    size_type max_size() const { return tree_.max_size(); }
+
+    //modifiers
+    iterator insert(const value_type& value) { return tree_.insert_equal(value); }
+    iterator insert(value_type&& value) { return tree_.insert_equal(MYSTL::move(value)); }
+    iterator insert(const_iterator hint, const value_type& value) {
+        return tree_.insert_hint_equal(hint, value);
+    }
+    iterator insert(const_iterator hint, value_type&& value) {
+        return tree_.insert_hint_equal(hint, MYSTL::move(value));
+    }
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) { tree_.insert_range_equal(first, last); }
+    void insert(std::initializer_list<value_type> ilist) {
+        tree_.insert_range_equal(ilist.begin(), ilist.end());
+    }
+
+    iterator insert(node_type&& nh) { return tree_.insert_equal_node(MYSTL::move(nh)); }
+    iterator insert(const_iterator hint, node_type&& nh) {
+        return tree_.insert_hint_equal_node(hint, MYSTL::move(nh));
+    }
+
+    template <typename... Args>
+    iterator emplace(Args&&... args) { return tree_.emplace_equal(MYSTL::forward<Args>(args)...); }
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return tree_.emplace_hint_equal(hint, MYSTL::forward<Args>(args)...);
+    }
+
+    iterator  erase(const_iterator position) { return tree_.erase(position); }
+    iterator  erase(const_iterator first, const_iterator last) { return tree_.erase(first, last); }
+    size_type erase(const key_type& key) { return tree_.erase(key); }
+
+    node_type extract(const_iterator position) { return tree_.extract(position); }
+    node_type extract(const key_type& key) { return tree_.extract(key); }
+
+    void clear() { tree_.clear(); }
+    void shrink_to_fit() { tree_.shrink_to_fit(); }
+    void swap(multiset& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+    //lookup
+    iterator  find(const key_type& key)     const { return tree_.find(key); }
+    size_type count(const key_type& key)    const { return tree_.count(key); }
+    bool      contains(const key_type& key) const { return find(key) != end(); }
+
+    iterator lower_bound(const key_type& key) const { return tree_.lower_bound(key); }
+    iterator upper_bound(const key_type& key) const { return tree_.upper_bound(key); }
+    MYSTL::pair<iterator, iterator> equal_range(const key_type& key) const { return tree_.equal_range(key); }
+
+    allocator_type get_allocator() const { return tree_.get_allocator(); }
+    key_compare key_comp() const { return tree_.key_comp(); }
+
+    bool __verify() const { return tree_.__verify(); }
+
+    friend bool operator==(const multiset& lhs, const multiset& rhs) { return lhs.tree_ == rhs.tree_; }
+    friend bool operator<(const multiset& lhs, const multiset& rhs) { return lhs.tree_ < rhs.tree_; }
+};
+
+template <typename Key, typename Compare, typename Alloc>
+bool operator!=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare, typename Alloc>
+void swap(multiset<Key, Compare, Alloc>& lhs, multiset<Key, Compare, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
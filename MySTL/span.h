@@ -0,0 +1,187 @@
+#ifndef SPAN_H_
+#define SPAN_H_
+
+#include <cstddef>
+#include <type_traits>
+#include "iterator.h"
+#include "utility.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// span
+// a view of Extent contiguous T, or of a run-time count when Extent is dynamic_extent.
+// a static span stores only the pointer. it takes raw arrays, pointer + count, pointer
+// ranges and any contiguous container with data() and size() (MYSTL::vector, array,
+// basic_string), and slicing with first / last / subspan never copies elements.
+// iterators are plain pointers, so the MYSTL algorithms take their memmove / memchr
+// paths on them. indices are not checked; the elements must outlive the span.
+/*****************************************************************************************/
+
+constexpr size_t dynamic_extent = static_cast<size_t>(-1);
+
+template <typename T, size_t Extent = dynamic_extent>
+class span;
+
+template <typename T>
+struct __is_span : std::false_type {};
+template <typename T, size_t Extent>
+struct __is_span<span<T, Extent>> : std::true_type {};
+
+// a container whose data() points to elements a span<T> can view
+template <typename Container, typename T, typename = void>
+struct __is_span_compatible : std::false_type {};
+template <typename Container, typename T>
+struct __is_span_compatible<Container, T, typename std::enable_if<
+    !__is_span<typename std::remove_cv<Container>::type>::value &&
+    !std::is_array<Container>::value &&
+    std::is_convertible<typename std::remove_pointer<decltype(std::declval<Container&>().data())>::type(*)[], T(*)[]>::value &&
+    std::is_integral<decltype(std::declval<Container&>().size())>::value>::type>
+    : std::true_type {};
+
+// the size member only exists for dynamic spans
+template <size_t Extent>
+struct __span_extent {
+    constexpr __span_extent(size_t) noexcept {}
+    static constexpr size_t size() noexcept { return Extent; }
+};
+template <>
+struct __span_extent<dynamic_extent> {
+    size_t size_;
+    constexpr __span_extent(size_t n) noexcept : size_(n) {}
+    constexpr size_t size() const noexcept { return size_; }
+};
+
+template <typename T, size_t Extent>
+class span : private __span_extent<Extent> {
+    using extent_base = __span_extent<Extent>;
+
+public:
+    using element_type           = T;
+    using value_type             = typename std::remove_cv<T>::type;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using pointer                = T*;
+    using const_pointer          = const T*;
+    using reference              = T&;
+    using const_reference        = const T&;
+    using iterator               = T*;
+    using reverse_iterator       = MYSTL::reverse_iterator<iterator>;
+
+    static constexpr size_type extent = Extent;
+
+private:
+    T* data_;
+
+public:
+    template <size_t E = Extent, typename = typename std::enable_if<E == 0 || E == dynamic_extent>::type>
+    constexpr span() noexcept : extent_base(0), data_(nullptr) {}
+
+    // count must equal Extent for a static span
+    constexpr span(T* first, size_type count) : extent_base(count), data_(first) {}
+    constexpr span(T* first, T* last) : extent_base(static_cast<size_type>(last - first)), data_(first) {}
+
+    template <typename U, size_t N, typename = typename std::enable_if<
+        (Extent == dynamic_extent || Extent == N) && std::is_convertible<U(*)[], T(*)[]>::value>::type>
+    constexpr span(U (&arr)[N]) noexcept : extent_base(N), data_(arr) {}
+
+    template <typename Container, typename = typename std::enable_if<
+        __is_span_compatible<Container, T>::value>::type>
+    constexpr span(Container& c) : extent_base(static_cast<size_type>(c.size())), data_(c.data()) {}
+    template <typename Container, typename = typename std::enable_if<
+        __is_span_compatible<const Container, T>::value>::type>
+    constexpr span(const Container& c) : extent_base(static_cast<size_type>(c.size())), data_(c.data()) {}
+
+    // span<U> -> span<const U>, and static -> dynamic extent
+    template <typename U, size_t N, typename = typename std::enable_if<
+        (Extent == dynamic_extent || Extent == N) && std::is_convertible<U(*)[], T(*)[]>::value>::type>
+    constexpr span(const span<U, N>& rhs) noexcept : extent_base(rhs.size()), data_(rhs.data()) {}
+
+    constexpr span(const span&) noexcept = default;
+    span& operator=(const span&) noexcept = default;
+
+    //iterators
+    constexpr iterator begin()  const noexcept { return data_; }
+    constexpr iterator end()    const noexcept { return data_ + size(); }
+    reverse_iterator   rbegin() const noexcept { return reverse_iterator(end()); }
+    reverse_iterator   rend()   const noexcept { return reverse_iterator(begin()); }
+
+    //observers
+    using extent_base::size;
+    constexpr size_type size_bytes() const noexcept { return size() * sizeof(T); }
+    constexpr bool      empty()      const noexcept { return size() == 0; }
+
+    //element access
+    constexpr reference operator[](size_type n) const { return data_[n]; }
+    constexpr reference front() const { return data_[0]; }
+    constexpr reference back()  const { return data_[size() - 1]; }
+    constexpr pointer   data()  const noexcept { return data_; }
+
+    //subviews
+    template <size_t Count>
+    constexpr span<T, Count> first() const {
+        static_assert(Extent == dynamic_extent || Count <= Extent, "span::first out of range");
+        return span<T, Count>(data_, Count);
+    }
+    constexpr span<T, dynamic_extent> first(size_type count) const {
+        return span<T, dynamic_extent>(data_, count);
+    }
+
+    template <size_t Count>
+    constexpr span<T, Count> last() const {
+        static_assert(Extent == dynamic_extent || Count <= Extent, "span::last out of range");
+        return span<T, Count>(data_ + (size() - Count), Count);
+    }
+    constexpr span<T, dynamic_extent> last(size_type count) const {
+        return span<T, dynamic_extent>(data_ + (size() - count), count);
+    }
+
+    template <size_t Offset, size_t Count = dynamic_extent>
+    constexpr span<T, Count != dynamic_extent ? Count : Extent != dynamic_extent ? Extent - Offset : dynamic_extent>
+    subspan() const {
+        static_assert(Extent == dynamic_extent || Offset <= Extent, "span::subspan out of range");
+        static_assert(Extent == dynamic_extent || Count == dynamic_extent || Offset + Count <= Extent,
+                      "span::subspan out of range");
+        return span<T, Count != dynamic_extent ? Count : Extent != dynamic_extent ? Extent - Offset : dynamic_extent>(
+            data_ + Offset, Count != dynamic_extent ? Count : size() - Offset);
+    }
+    constexpr span<T, dynamic_extent> subspan(size_type offset, size_type count = dynamic_extent) const {
+        return span<T, dynamic_extent>(data_ + offset, count == dynamic_extent ? size() - offset : count);
+    }
+};
+
+template <typename T, size_t Extent>
+constexpr size_t span<T, Extent>::extent;
+
+// the object representation of a span of trivially copyable elements
+template <typename T, size_t Extent>
+span<const unsigned char, Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(T)>
+as_bytes(span<T, Extent> s) noexcept {
+    return span<const unsigned char, Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(T)>(
+        reinterpret_cast<const unsigned char*>(s.data()), s.size_bytes());
+}
+
+template <typename T, size_t Extent, typename = typename std::enable_if<!std::is_const<T>::value>::type>
+span<unsigned char, Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(T)>
+as_writable_bytes(span<T, Extent> s) noexcept {
+    return span<unsigned char, Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(T)>(
+        reinterpret_cast<unsigned char*>(s.data()), s.size_bytes());
+}
+
+// C++14 has no deduction guides: make_span(v) / make_span(p, n) spell the element type
+template <typename T>
+span<T> make_span(T* first, size_t count) { return span<T>(first, count); }
+
+template <typename T, size_t N>
+span<T, N> make_span(T (&arr)[N]) { return span<T, N>(arr); }
+
+template <typename Container>
+span<typename std::remove_pointer<decltype(std::declval<Container&>().data())>::type>
+make_span(Container& c) {
+    return span<typename std::remove_pointer<decltype(std::declval<Container&>().data())>::type>(c);
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef SPSC_QUEUE_H_
+#define SPSC_QUEUE_H_
+
+#include <atomic>
+#include <stdexcept>
+#include "utility.h"
+#include "iterator.h"
+#include "allocator.h"
+#include "algobase.h"
+#include "uninitialized.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// spsc_queue
+// bounded lock-free queue for exactly one producer thread and one consumer thread.
+// the producer only writes tail_, the consumer only writes head_, and each index sits on
+// its own cache line. each side also keeps a private copy of the other side's index and
+// only reloads it when the copy says the queue is full (producer) or empty (consumer),
+// so in steady state neither side touches the other's line.
+// try_push_n / try_pop_n move a whole run with at most two contiguous copies and publish
+// it with a single store.
+/*****************************************************************************************/
+
+template <typename T, typename Alloc = MYSTL::allocator<T>>
+class spsc_queue : private __allocator_holder<Alloc> {
+    using alloc_base = __allocator_holder<Alloc>;
+
+public:
+    using allocator_type = Alloc;
+
+    using value_type     = T;
+    using pointer        = T*;
+    using reference      = T&;
+    using size_type      = size_t;
+
+protected:
+    // read-only after construction, shared by both sides
+    alignas(cache_line_size) pointer buffer_;
+    size_type mask_;
+
+    // producer side
+    alignas(cache_line_size) std::atomic<size_type> tail_;
+    size_type head_cache_;
+
+    // consumer side
+    alignas(cache_line_size) std::atomic<size_type> head_;
+    size_type tail_cache_;
+
+    char pad_[cache_line_size - sizeof(std::atomic<size_type>) - sizeof(size_type)];
+
+public:
+    // the capacity is rounded up to a power of two
+    explicit spsc_queue(size_type capacity, const allocator_type& a = allocator_type())
+        : alloc_base(a), buffer_(nullptr), mask_(round_up(capacity) - 1),
+          tail_(0), head_cache_(0), head_(0), tail_cache_(0) {
+        buffer_ = this->alloc().allocate(mask_ + 1);
+    }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue() {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        for (size_type i = head; i != tail; ++i)
+            MYSTL::destroy(buffer_ + (i & mask_));
+        this->alloc().deallocate(buffer_, mask_ + 1);
+    }
+
+public:
+    allocator_type get_allocator() const { return this->alloc(); }
+
+    size_type capacity() const { return mask_ + 1; }
+
+    // only exact when called from one of the two threads with the other one idle
+    size_type size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+
+    //producer
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == capacity()) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == capacity())
+                return false;
+        }
+        MYSTL::construct(buffer_ + (tail & mask_), MYSTL::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const value_type& value) { return try_emplace(value); }
+    bool try_push(value_type&& value)      { return try_emplace(MYSTL::move(value)); }
+
+    // moves up to n elements from first, returns how many were taken
+    template <typename RandomAccessIterator>
+    size_type try_push_n(RandomAccessIterator first, size_type n);
+
+    //consumer
+    // the front element, or nullptr when the queue is empty
+    pointer front() {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_)
+                return nullptr;
+        }
+        return buffer_ + (head & mask_);
+    }
+
+    // drops the front element, front() must have returned non-null
+    void pop() {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        MYSTL::destroy(buffer_ + (head & mask_));
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    bool try_pop(value_type& out) {
+        pointer p = front();
+        if (p == nullptr)
+            return false;
+        out = MYSTL::move(*p);
+        pop();
+        return true;
+    }
+
+    // moves up to n elements into dest (assigned, not constructed), returns how many
+    template <typename OutputIterator>
+    size_type try_pop_n(OutputIterator dest, size_type n);
+
+protected:
+    // past the largest power of two in size_type the doubling below would wrap to zero
+    static size_type round_up(size_type n) {
+        if (n > (static_cast<size_type>(-1) >> 1) + 1)
+            throw std::length_error("spsc_queue: capacity too large");
+        size_type cap = 2;
+        while (cap < n)
+            cap <<= 1;
+        return cap;
+    }
+};
+
+template <typename T, typename Alloc>
+template <typename RandomAccessIterator>
+typename spsc_queue<T, Alloc>::size_type
+spsc_queue<T, Alloc>::try_push_n(RandomAccessIterator first, size_type n) {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    size_type room = capacity() - (tail - head_cache_);
+    if (room < n) {
+        head_cache_ = head_.load(std::memory_order_acquire);
+        room = capacity() - (tail - head_cache_);
+    }
+    n = MYSTL::min(n, room);
+    if (n == 0)
+        return 0;
+
+    const size_type offset = tail & mask_;
+    const size_type first_len = MYSTL::min(n, capacity() - offset);
+    MYSTL::uninitialized_move_n(first, first_len, buffer_ + offset);
+    MYSTL::uninitialized_move_n(first + first_len, n - first_len, buffer_);
+    tail_.store(tail + n, std::memory_order_release);
+    return n;
+}
+
+template <typename T, typename Alloc>
+template <typename OutputIterator>
+typename spsc_queue<T, Alloc>::size_type
+spsc_queue<T, Alloc>::try_pop_n(OutputIterator dest, size_type n) {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    size_type avail = tail_cache_ - head;
+    if (avail < n) {
+        tail_cache_ = tail_.load(std::memory_order_acquire);
+        avail = tail_cache_ - head;
+    }
+    n = MYSTL::min(n, avail);
+    if (n == 0)
+        return 0;
+
+    const size_type offset = head & mask_;
+    const size_type first_len = MYSTL::min(n, capacity() - offset);
+    dest = MYSTL::move(buffer_ + offset, buffer_ + offset + first_len, dest);
+    MYSTL::move(buffer_, buffer_ + (n - first_len), dest);
+    MYSTL::destroy(buffer_ + offset, buffer_ + offset + first_len);
+    MYSTL::destroy(buffer_, buffer_ + (n - first_len));
+    head_.store(head + n, std::memory_order_release);
+    return n;
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef STACK_H_
+#define STACK_H_
+
+#include <initializer_list>
+#include <utility>
+#include "utility.h"
+#include "deque.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// stack
+// LIFO adapter over any container with back/push_back/emplace_back/pop_back:
+// MYSTL::deque (default), MYSTL::vector or MYSTL::list.
+// reserve() is only available when the container has one (vector), so a parser stack
+// can be sized up front and never regrow.
+/*****************************************************************************************/
+
+template <typename T, typename Container = MYSTL::deque<T>>
+class stack {
+public:
+    using container_type  = Container;
+    using value_type      = typename Container::value_type;
+    using size_type       = typename Container::size_type;
+    using reference       = typename Container::reference;
+    using const_reference = typename Container::const_reference;
+
+protected:
+    Container c;
+
+public:
+    stack() = default;
+    explicit stack(const Container& cont) :c(cont) {}
+    explicit stack(Container&& cont) :c(MYSTL::move(cont)) {}
+
+    //capacity
+    bool      empty() const { return c.empty(); }
+    size_type size()  const { return c.size(); }
+
+    template <typename C = Container>
+    auto reserve(size_type n) -> decltype(std::declval<C&>().reserve(n), void()) {
+        c.reserve(n);
+    }
+
+    //element access
+    reference       top()       { return c.back(); }
+    const_reference top() const { return c.back(); }
+
+    //modifiers
+    void push(const value_type& value) { c.push_back(value); }
+    void push(value_type&& value)      { c.push_back(MYSTL::move(value)); }
+
+    template <typename... Args>
+    void emplace(Args&&... args) { c.emplace_back(MYSTL::forward<Args>(args)...); }
+
+    // pushes every element of the range in order, the last one ends up on top
+    template <typename Range>
+    void push_range(Range&& range) {
+        __reserve_more(c, __range_size_hint(range, 0), 0);
+        for (auto&& value : range)
+            c.push_back(MYSTL::forward<decltype(value)>(value));
+    }
+    void push_range(std::initializer_list<value_type> ilist) {
+        __reserve_more(c, ilist.size(), 0);
+        for (auto& value : ilist)
+            c.push_back(value);
+    }
+
+    void pop() { c.pop_back(); }
+
+    void swap(stack& rhs) { MYSTL::swap(c, rhs.c); }
+
+    // access to the underlying container for comparisons
+    const Container& container() const { return c; }
+};
+
+template <typename T, typename Container>
+bool operator==(const stack<T, Container>& lhs, const stack<T, Container>& rhs) {
+    return lhs.container() == rhs.container();
+}
+
+template <typename T, typename Container>
+bool operator!=(const stack<T, Container>& lhs, const stack<T, Container>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Container>
+bool operator<(const stack<T, Container>& lhs, const stack<T, Container>& rhs) {
+    return lhs.container() < rhs.container();
+}
+
+template <typename T, typename Container>
+void swap(stack<T, Container>& lhs, stack<T, Container>& rhs) {
+    lhs.swap(rhs);
+}
+
+} // end of namespace MYSTL
+
+#endif
@@ -0,0 +1,311 @@
+#ifndef STRING_VIEW_H_
+#define STRING_VIEW_H_
+
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include "iterator.h"
+#include "algobase.h"
+#include "algo.h"
+#include "hash.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// basic_string_view
+// a pointer and a length into characters owned by someone else: a string literal, a
+// basic_string, or a slice of a MYSTL::vector<char> buffer (string_view(v.data(), v.size())).
+// substr / remove_prefix / remove_suffix only move the pointer and the length. searches
+// share the memchr / memcmp paths of algo.h with basic_string.
+// the view does not own the characters, they must outlive it; it is not null terminated.
+/*****************************************************************************************/
+
+template <typename CharT, typename Traits = std::char_traits<CharT>>
+class basic_string_view {
+public:
+    using traits_type            = Traits;
+    using value_type             = CharT;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using pointer                = CharT*;
+    using const_pointer          = const CharT*;
+    using reference              = const CharT&;
+    using const_reference        = const CharT&;
+    using iterator               = const CharT*;
+    using const_iterator         = const CharT*;
+    using reverse_iterator       = MYSTL::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = MYSTL::reverse_iterator<const_iterator>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    const CharT* data_;
+    size_type    size_;
+
+    size_type clamp(size_type pos, size_type n) const { return MYSTL::min(n, size_ - pos); }
+
+public:
+    constexpr basic_string_view() noexcept : data_(nullptr), size_(0) {}
+    constexpr basic_string_view(const CharT* s, size_type n) noexcept : data_(s), size_(n) {}
+    basic_string_view(const CharT* s) : data_(s), size_(Traits::length(s)) {}
+    basic_string_view(const CharT* first, const CharT* last) noexcept
+        : data_(first), size_(static_cast<size_type>(last - first)) {}
+    basic_string_view(const std::basic_string<CharT, Traits>& s) noexcept : data_(s.data()), size_(s.size()) {}
+
+    constexpr basic_string_view(const basic_string_view&) noexcept = default;
+    basic_string_view& operator=(const basic_string_view&) noexcept = default;
+
+    //iterators
+    constexpr const_iterator begin()  const noexcept { return data_; }
+    constexpr const_iterator end()    const noexcept { return data_ + size_; }
+    constexpr const_iterator cbegin() const noexcept { return begin(); }
+    constexpr const_iterator cend()   const noexcept { return end(); }
+    const_reverse_iterator   rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator   rend()   const noexcept { return const_reverse_iterator(begin()); }
+
+    //capacity
+    constexpr size_type size()     const noexcept { return size_; }
+    constexpr size_type length()   const noexcept { return size_; }
+    constexpr bool      empty()    const noexcept { return size_ == 0; }
+    constexpr size_type max_size() const noexcept { return npos / sizeof(CharT); }
+
+    //element access
+    constexpr const_reference operator[](size_type n) const { return data_[n]; }
+    const_reference at(size_type n) const {
+        if (n >= size_)
+            throw std::out_of_range("basic_string_view::at");
+        return data_[n];
+    }
+    constexpr const_reference front() const { return data_[0]; }
+    constexpr const_reference back()  const { return data_[size_ - 1]; }
+    constexpr const_pointer   data()  const noexcept { return data_; }
+
+    //modifiers
+    void remove_prefix(size_type n) { data_ += n; size_ -= n; }
+    void remove_suffix(size_type n) { size_ -= n; }
+    void swap(basic_string_view& rhs) noexcept {
+        MYSTL::swap(data_, rhs.data_);
+        MYSTL::swap(size_, rhs.size_);
+    }
+
+    //operations
+    basic_string_view substr(size_type pos = 0, size_type n = npos) const {
+        if (pos > size_)
+            throw std::out_of_range("basic_string_view::substr");
+        return basic_string_view(data_ + pos, clamp(pos, n));
+    }
+
+    size_type copy(CharT* dest, size_type n, size_type pos = 0) const {
+        if (pos > size_)
+            throw std::out_of_range("basic_string_view::copy");
+        n = clamp(pos, n);
+        MYSTL::copy(data_ + pos, data_ + pos + n, dest);
+        return n;
+    }
+
+    int compare(basic_string_view v) const {
+        const int r = size_ == 0 || v.size_ == 0 ? 0 : Traits::compare(data_, v.data_, MYSTL::min(size_, v.size_));
+        return r != 0 ? r : size_ < v.size_ ? -1 : size_ > v.size_ ? 1 : 0;
+    }
+    int compare(size_type pos, size_type n, basic_string_view v) const { return substr(pos, n).compare(v); }
+    int compare(const CharT* s) const { return compare(basic_string_view(s)); }
+
+    bool starts_with(basic_string_view v) const { return size_ >= v.size_ && substr(0, v.size_).compare(v) == 0; }
+    bool starts_with(CharT ch) const { return !empty() && Traits::eq(front(), ch); }
+    bool starts_with(const CharT* s) const { return starts_with(basic_string_view(s)); }
+    bool ends_with(basic_string_view v) const {
+        return size_ >= v.size_ && substr(size_ - v.size_).compare(v) == 0;
+    }
+    bool ends_with(CharT ch) const { return !empty() && Traits::eq(back(), ch); }
+    bool ends_with(const CharT* s) const { return ends_with(basic_string_view(s)); }
+
+    //search
+    size_type find(basic_string_view v, size_type pos = 0) const {
+        if (pos > size_ || v.size_ > size_ - pos)
+            return npos;
+        if (v.size_ == 0)
+            return pos;
+        const CharT* it = MYSTL::search(data_ + pos, data_ + size_, v.data_, v.data_ + v.size_);
+        return it == data_ + size_ ? npos : static_cast<size_type>(it - data_);
+    }
+    size_type find(CharT ch, size_type pos = 0) const {
+        if (pos >= size_)
+            return npos;
+        const CharT* it = MYSTL::find(data_ + pos, data_ + size_, ch);
+        return it == data_ + size_ ? npos : static_cast<size_type>(it - data_);
+    }
+    size_type find(const CharT* s, size_type pos, size_type n) const { return find(basic_string_view(s, n), pos); }
+    size_type find(const CharT* s, size_type pos = 0) const { return find(basic_string_view(s), pos); }
+
+    size_type rfind(basic_string_view v, size_type pos = npos) const {
+        if (v.size_ > size_)
+            return npos;
+        pos = MYSTL::min(pos, size_ - v.size_);
+        if (v.size_ == 0)
+            return pos;
+        const CharT* last = data_ + pos + v.size_;
+        const CharT* it = MYSTL::find_end(data_, last, v.data_, v.data_ + v.size_);
+        return it == last ? npos : static_cast<size_type>(it - data_);
+    }
+    size_type rfind(CharT ch, size_type pos = npos) const {
+        if (size_ == 0)
+            return npos;
+        for (size_type i = MYSTL::min(pos, size_ - 1) + 1; i > 0; --i)
+            if (Traits::eq(data_[i - 1], ch))
+                return i - 1;
+        return npos;
+    }
+    size_type rfind(const CharT* s, size_type pos, size_type n) const { return rfind(basic_string_view(s, n), pos); }
+    size_type rfind(const CharT* s, size_type pos = npos) const { return rfind(basic_string_view(s), pos); }
+
+    size_type find_first_of(basic_string_view v, size_type pos = 0) const {
+        for (size_type i = pos; i < size_; ++i)
+            if (Traits::find(v.data_, v.size_, data_[i]) != nullptr)
+                return i;
+        return npos;
+    }
+    size_type find_first_of(CharT ch, size_type pos = 0) const { return find(ch, pos); }
+    size_type find_first_not_of(basic_string_view v, size_type pos = 0) const {
+        for (size_type i = pos; i < size_; ++i)
+            if (Traits::find(v.data_, v.size_, data_[i]) == nullptr)
+                return i;
+        return npos;
+    }
+    size_type find_last_of(basic_string_view v, size_type pos = npos) const {
+        if (size_ == 0)
+            return npos;
+        for (size_type i = MYSTL::min(pos, size_ - 1) + 1; i > 0; --i)
+            if (Traits::find(v.data_, v.size_, data_[i - 1]) != nullptr)
+                return i - 1;
+        return npos;
+    }
+    size_type find_last_not_of(basic_string_view v, size_type pos = npos) const {
+        if (size_ == 0)
+            return npos;
+        for (size_type i = MYSTL::min(pos, size_ - 1) + 1; i > 0; --i)
+            if (Traits::find(v.data_, v.size_, data_[i - 1]) == nullptr)
+                return i - 1;
+        return npos;
+    }
+};
+
+template <typename CharT, typename Traits>
+constexpr typename basic_string_view<CharT, Traits>::size_type basic_string_view<CharT, Traits>::npos;
+
+// the second overload of each pair takes anything convertible to a view (a literal, a
+// basic_string), it does not take part in deduction
+template <typename T>
+struct __identity_type { using type = T; };
+
+template <typename CharT, typename Traits>
+bool operator==(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+template <typename CharT, typename Traits>
+bool operator==(basic_string_view<CharT, Traits> lhs,
+                typename __identity_type<basic_string_view<CharT, Traits>>::type rhs) {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+template <typename CharT, typename Traits>
+bool operator==(typename __identity_type<basic_string_view<CharT, Traits>>::type lhs,
+                basic_string_view<CharT, Traits> rhs) {
+    return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+}
+
+template <typename CharT, typename Traits>
+bool operator!=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) {
+    return !(lhs == rhs);
+}
+template <typename CharT, typename Traits>
+bool operator!=(basic_string_view<CharT, Traits> lhs,
+                typename __identity_type<basic_string_view<CharT, Traits>>::type rhs) {
+    return !(lhs == rhs);
+}
+template <typename CharT, typename Traits>
+bool operator!=(typename __identity_type<basic_string_view<CharT, Traits>>::type lhs,
+                basic_string_view<CharT, Traits> rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename CharT, typename Traits>
+bool operator<(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) {
+    return lhs.compare(rhs) < 0;
+}
+template <typename CharT, typename Traits>
+bool operator<(basic_string_view<CharT, Traits> lhs,
+               typename __identity_type<basic_string_view<CharT, Traits>>::type rhs) {
+    return lhs.compare(rhs) < 0;
+}
+template <typename CharT, typename Traits>
+bool operator<(typename __identity_type<basic_string_view<CharT, Traits>>::type lhs,
+               basic_string_view<CharT, Traits> rhs) {
+    return lhs.compare(rhs) < 0;
+}
+template <typename CharT, typename Traits>
+bool operator<=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) {
+    return lhs.compare(rhs) <= 0;
+}
+template <typename CharT, typename Traits>
+bool operator<=(basic_string_view<CharT, Traits> lhs,
+                typename __identity_type<basic_string_view<CharT, Traits>>::type rhs) {
+    return lhs.compare(rhs) <= 0;
+}
+template <typename CharT, typename Traits>
+bool operator<=(typename __identity_type<basic_string_view<CharT, Traits>>::type lhs,
+                basic_string_view<CharT, Traits> rhs) {
+    return lhs.compare(rhs) <= 0;
+}
+template <typename CharT, typename Traits>
+bool operator>(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) {
+    return lhs.compare(rhs) > 0;
+}
+template <typename CharT, typename Traits>
+bool operator>(basic_string_view<CharT, Traits> lhs,
+               typename __identity_type<basic_string_view<CharT, Traits>>::type rhs) {
+    return lhs.compare(rhs) > 0;
+}
+template <typename CharT, typename Traits>
+bool operator>(typename __identity_type<basic_string_view<CharT, Traits>>::type lhs,
+               basic_string_view<CharT, Traits> rhs) {
+    return lhs.compare(rhs) > 0;
+}
+template <typename CharT, typename Traits>
+bool operator>=(basic_string_view<CharT, Traits> lhs, basic_string_view<CharT, Traits> rhs) {
+    return lhs.compare(rhs) >= 0;
+}
+template <typename CharT, typename Traits>
+bool operator>=(basic_string_view<CharT, Traits> lhs,
+                typename __identity_type<basic_string_view<CharT, Traits>>::type rhs) {
+    return lhs.compare(rhs) >= 0;
+}
+template <typename CharT, typename Traits>
+bool operator>=(typename __identity_type<basic_string_view<CharT, Traits>>::type lhs,
+                basic_string_view<CharT, Traits> rhs) {
+    return lhs.compare(rhs) >= 0;
+}
+
+template <typename CharT, typename Traits>
+std::basic_ostream<CharT, Traits>&
+operator<<(std::basic_ostream<CharT, Traits>& os, basic_string_view<CharT, Traits> v) {
+    return os.write(v.data(), static_cast<std::streamsize>(v.size()));
+}
+
+// same bytes, same hash as basic_string, so views can probe tables keyed by strings
+template <typename CharT, typename Traits>
+struct hash<basic_string_view<CharT, Traits>> {
+    using is_avalanching = void;
+    size_t operator()(basic_string_view<CharT, Traits> v) const noexcept {
+        return static_cast<size_t>(hash_bytes(v.data(), v.size() * sizeof(CharT)));
+    }
+};
+
+using string_view    = basic_string_view<char>;
+using wstring_view   = basic_string_view<wchar_t>;
+using u16string_view = basic_string_view<char16_t>;
+using u32string_view = basic_string_view<char32_t>;
+
+} // end of namespace MYSTL
+
+#endif
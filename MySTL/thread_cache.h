@@ -0,0 +1,306 @@
+#ifndef THREAD_CACHE_H_
+#define THREAD_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// thread cache
+// a size class allocator in the style of tcmalloc.
+//   small blocks (up to 32 KiB) are rounded to one of 40 size classes: 16 byte steps up
+//   to 128, then four classes per power of two. every thread keeps a free list per class
+//   and allocates / frees without locking.
+//   a thread whose list runs dry takes a whole batch of blocks from the central list of
+//   the class under one lock, and a list grown past two batches gives one batch back.
+//   the central lists are cut from 64 KiB spans of fresh mmap'ed pages, spans are never
+//   returned to the system.
+//   large blocks get their own mmap, freed with munmap.
+// deallocation needs the size that was allocated, as every MYSTL container passes it.
+// a block may be freed by any thread; it joins the cache of that thread. the cache of a
+// thread goes back to the central lists when the thread exits.
+// thread_cache_allocator<T> uses it directly. defining MYSTL_USE_THREAD_CACHE (in every
+// translation unit) switches MYSTL::allocator, and so every container, over to it.
+/*****************************************************************************************/
+
+struct __tc_size_class {
+    static constexpr size_t max_small = 32768;
+    static constexpr size_t count = 40;
+    static constexpr size_t span_bytes = 65536;
+
+    static size_t index(size_t bytes) noexcept {
+        if (bytes <= 128)
+            return bytes == 0 ? 0 : (bytes - 1) >> 4;
+        const unsigned p = 63 - static_cast<unsigned>(__builtin_clzll(bytes - 1));
+        return 8 + (p - 7) * 4 + ((bytes - 1 - (size_t(1) << p)) >> (p - 2));
+    }
+
+    static size_t size(size_t idx) noexcept {
+        if (idx < 8)
+            return (idx + 1) * 16;
+        const unsigned p = static_cast<unsigned>(7 + (idx - 8) / 4);
+        return (size_t(1) << p) + (((idx - 8) % 4 + 1) << (p - 2));
+    }
+
+    // blocks moved between a thread and the central list at once
+    static size_t batch(size_t idx) noexcept {
+        const size_t n = 32768 / size(idx);
+        return n < 2 ? 2 : n > 64 ? 64 : n;
+    }
+};
+
+// a free block links to the next one through its first word. the first block of a batch
+// on a central list links to the next batch through its second word
+inline void*& __tc_next(void* p) noexcept { return *static_cast<void**>(p); }
+inline void*& __tc_next_batch(void* p) noexcept { return static_cast<void**>(p)[1]; }
+
+inline void* __tc_map(size_t bytes) {
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        throw std::bad_alloc();
+    return p;
+}
+
+inline size_t __tc_page_round(size_t bytes) noexcept {
+    static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return (bytes + page - 1) / page * page;
+}
+
+// the central lists, shared by all threads
+class __tc_heap {
+    struct central_list {
+        std::mutex lock;
+        void*      batches = nullptr;  // full batches, linked by their first block
+        void*      loose = nullptr;    // leftovers of flushed caches
+        size_t     loose_count = 0;
+    };
+
+    central_list lists_[__tc_size_class::count];
+
+    // cuts a span into full batches and pushes them, called with the lock held
+    void grow(size_t idx) {
+        const size_t size = __tc_size_class::size(idx);
+        const size_t batch = __tc_size_class::batch(idx);
+        const size_t batch_bytes = size * batch;
+        const size_t batches = (__tc_size_class::span_bytes + batch_bytes - 1) / batch_bytes;
+        char* span = static_cast<char*>(__tc_map(__tc_page_round(batches * batch_bytes)));
+        central_list& c = lists_[idx];
+        for (size_t b = 0; b < batches; ++b) {
+            char* first = span + b * batch_bytes;
+            for (size_t i = 0; i + 1 < batch; ++i)
+                __tc_next(first + i * size) = first + (i + 1) * size;
+            __tc_next(first + (batch - 1) * size) = nullptr;
+            __tc_next_batch(first) = c.batches;
+            c.batches = first;
+        }
+    }
+
+public:
+    // never destroyed: blocks may still be freed by destructors of other statics
+    static __tc_heap& instance() {
+        alignas(__tc_heap) static unsigned char storage[sizeof(__tc_heap)];
+        static __tc_heap* heap = ::new (storage) __tc_heap();
+        return *heap;
+    }
+
+    // a chain of blocks of class idx, its length in n
+    void* fetch(size_t idx, size_t& n) {
+        central_list& c = lists_[idx];
+        std::lock_guard<std::mutex> guard(c.lock);
+        if (c.loose != nullptr) {
+            void* head = c.loose;
+            n = c.loose_count;
+            c.loose = nullptr;
+            c.loose_count = 0;
+            return head;
+        }
+        if (c.batches == nullptr)
+            grow(idx);
+        void* head = c.batches;
+        c.batches = __tc_next_batch(head);
+        n = __tc_size_class::batch(idx);
+        return head;
+    }
+
+    // takes back a chain of exactly batch(idx) blocks
+    void release_batch(size_t idx, void* head) noexcept {
+        central_list& c = lists_[idx];
+        std::lock_guard<std::mutex> guard(c.lock);
+        __tc_next_batch(head) = c.batches;
+        c.batches = head;
+    }
+
+    // takes back a chain of any length n ending at tail
+    void release_chain(size_t idx, void* head, void* tail, size_t n) noexcept {
+        central_list& c = lists_[idx];
+        std::lock_guard<std::mutex> guard(c.lock);
+        __tc_next(tail) = c.loose;
+        c.loose = head;
+        c.loose_count += n;
+    }
+};
+
+class __thread_cache {
+    struct free_list {
+        void*  head;
+        size_t count;
+    };
+
+    free_list lists_[__tc_size_class::count];
+
+    static bool& destroyed() noexcept {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    void refill(size_t idx) {
+        size_t n = 0;
+        lists_[idx].head = __tc_heap::instance().fetch(idx, n);
+        lists_[idx].count = n;
+    }
+
+    // the batch at the head goes back; those blocks were freed last and are still cached
+    void release_batch(size_t idx) noexcept {
+        free_list& l = lists_[idx];
+        const size_t batch = __tc_size_class::batch(idx);
+        void* head = l.head;
+        void* tail = head;
+        for (size_t i = 1; i < batch; ++i)
+            tail = __tc_next(tail);
+        l.head = __tc_next(tail);
+        l.count -= batch;
+        __tc_next(tail) = nullptr;
+        __tc_heap::instance().release_batch(idx, head);
+    }
+
+public:
+    __thread_cache() noexcept : lists_() {}
+    __thread_cache(const __thread_cache&) = delete;
+    __thread_cache& operator=(const __thread_cache&) = delete;
+    ~__thread_cache() {
+        flush();
+        destroyed() = true;
+    }
+
+    // the cache of the calling thread, nullptr once it has been destroyed at thread exit
+    static __thread_cache* local() noexcept {
+        if (destroyed())
+            return nullptr;
+        static thread_local __thread_cache cache;
+        return &cache;
+    }
+
+    void* allocate(size_t idx) {
+        free_list& l = lists_[idx];
+        if (l.head == nullptr)
+            refill(idx);
+        void* p = l.head;
+        l.head = __tc_next(p);
+        --l.count;
+        return p;
+    }
+
+    void deallocate(void* p, size_t idx) noexcept {
+        free_list& l = lists_[idx];
+        __tc_next(p) = l.head;
+        l.head = p;
+        if (++l.count >= 2 * __tc_size_class::batch(idx))
+            release_batch(idx);
+    }
+
+    // hands every cached block back to the central lists
+    void flush() noexcept {
+        for (size_t idx = 0; idx < __tc_size_class::count; ++idx) {
+            free_list& l = lists_[idx];
+            if (l.head == nullptr)
+                continue;
+            void* tail = l.head;
+            while (__tc_next(tail) != nullptr)
+                tail = __tc_next(tail);
+            __tc_heap::instance().release_chain(idx, l.head, tail, l.count);
+            l.head = nullptr;
+            l.count = 0;
+        }
+    }
+};
+
+inline void* __thread_cache_allocate(size_t bytes) {
+    if (bytes > __tc_size_class::max_small)
+        return __tc_map(__tc_page_round(bytes));
+    const size_t idx = __tc_size_class::index(bytes);
+    if (__thread_cache* cache = __thread_cache::local())
+        return cache->allocate(idx);
+    // after the cache of this thread is gone: one block straight from the central list
+    size_t n = 0;
+    void* head = __tc_heap::instance().fetch(idx, n);
+    if (n > 1) {
+        void* rest = __tc_next(head);
+        void* tail = rest;
+        while (__tc_next(tail) != nullptr)
+            tail = __tc_next(tail);
+        __tc_heap::instance().release_chain(idx, rest, tail, n - 1);
+    }
+    return head;
+}
+
+inline void __thread_cache_deallocate(void* p, size_t bytes) noexcept {
+    if (p == nullptr)
+        return;
+    if (bytes > __tc_size_class::max_small) {
+        ::munmap(p, __tc_page_round(bytes));
+        return;
+    }
+    const size_t idx = __tc_size_class::index(bytes);
+    if (__thread_cache* cache = __thread_cache::local()) {
+        cache->deallocate(p, idx);
+        return;
+    }
+    __tc_next(p) = nullptr;
+    __tc_heap::instance().release_chain(idx, p, p, 1);
+}
+
+// gives the blocks cached by the calling thread back to the central lists, for a thread
+// that goes idle after freeing a lot
+inline void thread_cache_release() noexcept {
+    if (__thread_cache* cache = __thread_cache::local())
+        cache->flush();
+}
+
+template <typename T>
+class thread_cache_allocator {
+    static_assert(alignof(T) <= 16, "thread_cache_allocator blocks are 16 byte aligned, use aligned_allocator");
+
+public:
+    using value_type      = T;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+    using reference       = T&;
+    using const_reference = const T&;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+
+    template <typename U>
+    struct rebind { using other = thread_cache_allocator<U>; };
+
+    thread_cache_allocator() = default;
+    template <typename U>
+    thread_cache_allocator(const thread_cache_allocator<U>&) noexcept {}
+
+    static T* allocate(size_type n) { return static_cast<T*>(__thread_cache_allocate(n * sizeof(T))); }
+    static void deallocate(T* p, size_type n) noexcept { __thread_cache_deallocate(p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const thread_cache_allocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const thread_cache_allocator<U>&) const noexcept { return false; }
+};
+
+} // end of namespace MYSTL
+
+#endif
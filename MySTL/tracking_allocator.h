@@ -0,0 +1,294 @@
+#ifndef TRACKING_ALLOCATOR_H_
+#define TRACKING_ALLOCATOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include "allocator.h"
+
+namespace MYSTL
+{
+
+/*****************************************************************************************/
+// tracking_allocator
+// an adaptor over any allocator that counts what goes through it, per tag: allocations,
+// deallocations, bytes allocated in total, bytes live, peak live bytes, and a histogram
+// of request sizes by power of two (vector growth shows up as one request per bucket,
+// list churn as a tall 16..32 byte bar).
+//   list<order, tracking_allocator<allocator<order>>> orders(tracking_allocator<...>("orders"));
+// the hot path only touches counters of the calling thread. a thread merges its counters
+// into the tag after 1024 events or 1 MiB of live change, when it exits, and when it
+// calls tracking_report / tracking_stats_of; so totals from other threads lag by at most
+// that much. peak is exact for a tag used by one thread at a time, and with several
+// threads it takes the peak of each thread since its last merge on top of the total.
+// up to 64 tags, registered by name on first use and never removed.
+/*****************************************************************************************/
+
+constexpr size_t tracking_max_tags = 64;
+constexpr size_t tracking_buckets = 40;  // bucket b: requests of [2^b, 2^(b+1)) bytes
+
+struct tracking_stats {
+    const char* tag;
+    uint64_t    allocations;
+    uint64_t    deallocations;
+    uint64_t    bytes_allocated;
+    int64_t     live_bytes;
+    int64_t     peak_bytes;
+    uint64_t    histogram[tracking_buckets];
+};
+
+// the shared counters of one tag
+struct tracking_tag {
+    char                  name[32];
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> deallocations;
+    std::atomic<uint64_t> bytes_allocated;
+    std::atomic<int64_t>  live_bytes;
+    std::atomic<int64_t>  peak_bytes;
+    std::atomic<uint64_t> histogram[tracking_buckets];
+
+    tracking_stats stats() const noexcept {
+        tracking_stats s;
+        s.tag = name;
+        s.allocations = allocations.load(std::memory_order_relaxed);
+        s.deallocations = deallocations.load(std::memory_order_relaxed);
+        s.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+        s.live_bytes = live_bytes.load(std::memory_order_relaxed);
+        s.peak_bytes = peak_bytes.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < tracking_buckets; ++b)
+            s.histogram[b] = histogram[b].load(std::memory_order_relaxed);
+        return s;
+    }
+};
+
+class __tracking_registry {
+    tracking_tag tags_[tracking_max_tags];
+    std::atomic<size_t> count_;
+    std::mutex lock_;
+
+    __tracking_registry() : tags_(), count_(0) {
+        std::strcpy(tags_[0].name, "untagged");
+        count_.store(1, std::memory_order_release);
+    }
+
+public:
+    // never destroyed: containers in statics free their memory after main
+    static __tracking_registry& instance() {
+        alignas(__tracking_registry) static unsigned char storage[sizeof(__tracking_registry)];
+        static __tracking_registry* registry = ::new (storage) __tracking_registry();
+        return *registry;
+    }
+
+    // the tag called name (at most 31 characters are kept), registered on first use
+    size_t find_or_add(const char* name) {
+        std::lock_guard<std::mutex> guard(lock_);
+        const size_t n = count_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < n; ++i)
+            if (std::strncmp(tags_[i].name, name, sizeof(tags_[i].name) - 1) == 0)
+                return i;
+        if (n == tracking_max_tags)
+            throw std::length_error("tracking_allocator: too many tags");
+        std::strncpy(tags_[n].name, name, sizeof(tags_[n].name) - 1);
+        count_.store(n + 1, std::memory_order_release);
+        return n;
+    }
+
+    size_t        size() const noexcept { return count_.load(std::memory_order_acquire); }
+    tracking_tag& operator[](size_t id) noexcept { return tags_[id]; }
+};
+
+inline size_t __tracking_bucket(size_t bytes) noexcept {
+    if (bytes == 0)
+        return 0;
+    const size_t b = static_cast<size_t>(63 - __builtin_clzll(bytes));
+    return b < tracking_buckets ? b : tracking_buckets - 1;
+}
+
+// counters of one thread not yet merged into the tags
+class __tracking_local {
+    struct delta {
+        uint32_t allocations;
+        uint32_t deallocations;
+        uint32_t events;
+        uint64_t bytes_allocated;
+        int64_t  live_bytes;
+        int64_t  peak_live;  // highest live_bytes since the last merge
+        uint32_t histogram[tracking_buckets];
+    };
+
+    static constexpr uint32_t max_events = 1024;
+    static constexpr int64_t  max_live_change = int64_t(1) << 20;
+
+    delta deltas_[tracking_max_tags];
+
+    static bool& destroyed() noexcept {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+public:
+    __tracking_local() noexcept : deltas_() {}
+    __tracking_local(const __tracking_local&) = delete;
+    __tracking_local& operator=(const __tracking_local&) = delete;
+    ~__tracking_local() {
+        flush();
+        destroyed() = true;
+    }
+
+    // nullptr once destroyed at thread exit; the caller then merges directly
+    static __tracking_local* local() noexcept {
+        if (destroyed())
+            return nullptr;
+        static thread_local __tracking_local counters;
+        return &counters;
+    }
+
+    void flush(size_t id) noexcept {
+        delta& d = deltas_[id];
+        if (d.events == 0)
+            return;
+        tracking_tag& t = __tracking_registry::instance()[id];
+        t.allocations.fetch_add(d.allocations, std::memory_order_relaxed);
+        t.deallocations.fetch_add(d.deallocations, std::memory_order_relaxed);
+        t.bytes_allocated.fetch_add(d.bytes_allocated, std::memory_order_relaxed);
+        for (size_t b = 0; b < tracking_buckets; ++b)
+            if (d.histogram[b] != 0)
+                t.histogram[b].fetch_add(d.histogram[b], std::memory_order_relaxed);
+        // the total before this merge plus the highest this thread took it since the last one
+        const int64_t live = t.live_bytes.fetch_add(d.live_bytes, std::memory_order_relaxed) + d.peak_live;
+        int64_t peak = t.peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !t.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+        d = delta();
+    }
+
+    void flush() noexcept {
+        for (size_t id = 0; id < tracking_max_tags; ++id)
+            flush(id);
+    }
+
+    void record(size_t id, size_t bytes, bool allocation) noexcept {
+        delta& d = deltas_[id];
+        if (allocation) {
+            ++d.allocations;
+            d.bytes_allocated += bytes;
+            d.live_bytes += static_cast<int64_t>(bytes);
+            ++d.histogram[__tracking_bucket(bytes)];
+            if (d.live_bytes > d.peak_live)
+                d.peak_live = d.live_bytes;
+        }
+        else {
+            ++d.deallocations;
+            d.live_bytes -= static_cast<int64_t>(bytes);
+        }
+        if (++d.events >= max_events || d.live_bytes >= max_live_change || d.live_bytes <= -max_live_change)
+            flush(id);
+    }
+};
+
+inline void __tracking_record(size_t id, size_t bytes, bool allocation) noexcept {
+    if (__tracking_local* local = __tracking_local::local()) {
+        local->record(id, bytes, allocation);
+        return;
+    }
+    __tracking_local late;  // merged by its destructor
+    late.record(id, bytes, allocation);
+}
+
+template <typename Alloc>
+class tracking_allocator : private __allocator_holder<Alloc> {
+    using alloc_base = __allocator_holder<Alloc>;
+
+    template <typename A> friend class tracking_allocator;
+
+    size_t tag_;
+
+public:
+    using value_type      = typename Alloc::value_type;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+
+    static constexpr size_t alignment = __allocator_alignment<Alloc>::value;
+
+    template <typename U>
+    struct rebind { using other = tracking_allocator<__rebind_alloc<Alloc, U>>; };
+
+    // counts under "untagged"
+    tracking_allocator() : tag_(0) {}
+    explicit tracking_allocator(const char* tag, const Alloc& a = Alloc())
+        : alloc_base(a), tag_(__tracking_registry::instance().find_or_add(tag)) {}
+
+    template <typename A>
+    tracking_allocator(const tracking_allocator<A>& rhs) : alloc_base(Alloc(rhs.alloc())), tag_(rhs.tag_) {}
+
+    const char*  tag()   const noexcept { return __tracking_registry::instance()[tag_].name; }
+    const Alloc& inner() const noexcept { return this->alloc(); }
+
+    value_type* allocate(size_type n) {
+        value_type* p = this->alloc().allocate(n);
+        __tracking_record(tag_, n * sizeof(value_type), true);
+        return p;
+    }
+
+    void deallocate(value_type* p, size_type n) {
+        if (p == nullptr)
+            return;
+        __tracking_record(tag_, n * sizeof(value_type), false);
+        this->alloc().deallocate(p, n);
+    }
+
+    template <typename A>
+    bool operator==(const tracking_allocator<A>& rhs) const noexcept {
+        return tag_ == rhs.tag_ && this->alloc() == rhs.alloc();
+    }
+    template <typename A>
+    bool operator!=(const tracking_allocator<A>& rhs) const noexcept { return !(*this == rhs); }
+};
+
+template <typename Alloc>
+constexpr size_t tracking_allocator<Alloc>::alignment;
+
+// the counters of a tag, after merging those of the calling thread
+inline tracking_stats tracking_stats_of(const char* tag) {
+    __tracking_registry& registry = __tracking_registry::instance();
+    const size_t id = registry.find_or_add(tag);
+    if (__tracking_local* local = __tracking_local::local())
+        local->flush(id);
+    return registry[id].stats();
+}
+
+// one line per tag with any allocation, then its size histogram
+inline void tracking_report(std::ostream& os) {
+    __tracking_registry& registry = __tracking_registry::instance();
+    if (__tracking_local* local = __tracking_local::local())
+        local->flush();
+    os << "tag                              allocs      frees        live bytes        peak bytes       total bytes\n";
+    const size_t n = registry.size();
+    for (size_t id = 0; id < n; ++id) {
+        const tracking_stats s = registry[id].stats();
+        if (s.allocations == 0)
+            continue;
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-32s %7llu %10llu %17lld %17lld %17llu\n", s.tag,
+                      static_cast<unsigned long long>(s.allocations), static_cast<unsigned long long>(s.deallocations),
+                      static_cast<long long>(s.live_bytes), static_cast<long long>(s.peak_bytes),
+                      static_cast<unsigned long long>(s.bytes_allocated));
+        os << line << "    sizes:";
+        for (size_t b = 0; b < tracking_buckets; ++b)
+            if (s.histogram[b] != 0)
+                os << ' ' << (uint64_t(1) << b) << "+:" << s.histogram[b];
+        os << '\n';
+    }
+}
+
+} // end of namespace MYSTL
+
+#endif
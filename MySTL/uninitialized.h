@@ -1,5 +1,5 @@
 #ifndef UNINTIALIZED_H
-#define UNINITALIZED_H
+#define UNINTIALIZED_H
 
 #include "algobase.h"
 #include "construct.h"
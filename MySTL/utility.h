@@ -250,6 +250,91 @@ pair<T1, T2> make_pair(T1&& first, T2&& second) {
 }
 
 
+/***************************__compressed_pair*************************/
+// a pair that stores an empty member as a base class, so it takes no space.
+// used for stateless deleters and allocators.
+template <typename T, int Index,
+          bool = std::is_empty<T>::value && !std::is_final<T>::value>
+struct __compressed_pair_elem
+{
+	T value_;
+
+	constexpr __compressed_pair_elem() : value_() {}
+	template <typename U>
+	constexpr explicit __compressed_pair_elem(U&& u) : value_(MYSTL::forward<U>(u)) {}
+
+	T&       get()       noexcept { return value_; }
+	const T& get() const noexcept { return value_; }
+};
+
+template <typename T, int Index>
+struct __compressed_pair_elem<T, Index, true> : private T
+{
+	constexpr __compressed_pair_elem() : T() {}
+	template <typename U>
+	constexpr explicit __compressed_pair_elem(U&& u) : T(MYSTL::forward<U>(u)) {}
+
+	T&       get()       noexcept { return *this; }
+	const T& get() const noexcept { return *this; }
+};
+
+template <typename T1, typename T2>
+class __compressed_pair : private __compressed_pair_elem<T1, 0>,
+                          private __compressed_pair_elem<T2, 1>
+{
+	using base1 = __compressed_pair_elem<T1, 0>;
+	using base2 = __compressed_pair_elem<T2, 1>;
+
+public:
+	constexpr __compressed_pair() : base1(), base2() {}
+
+	template <typename U1, typename U2>
+	constexpr __compressed_pair(U1&& a, U2&& b)
+		: base1(MYSTL::forward<U1>(a)), base2(MYSTL::forward<U2>(b)) {}
+
+	T1&       first()        noexcept { return base1::get(); }
+	const T1& first()  const noexcept { return base1::get(); }
+	T2&       second()       noexcept { return base2::get(); }
+	const T2& second() const noexcept { return base2::get(); }
+
+	void swap(__compressed_pair& other) {
+		MYSTL::swap(first(), other.first());
+		MYSTL::swap(second(), other.second());
+	}
+};
+
+/***************************cache line*************************/
+// size used to pad data written by different threads onto separate cache lines
+constexpr size_t cache_line_size = 64;
+
+/***************************adapter helpers*************************/
+// container adapters forward reserve() only when the underlying container has one,
+// and size a bulk push from the range's size() when it is cheap to ask for.
+// __reserve_more makes room for n more elements and grows at least geometrically, so a
+// run of small bulk pushes stays amortized O(1) instead of reallocating every time.
+
+template <typename Container>
+auto __reserve_more(Container& c, size_t n, int) -> decltype(c.reserve(n), c.capacity(), void()) {
+	const size_t needed = c.size() + n;
+	if (needed > c.capacity())
+		c.reserve(2 * c.capacity() > needed ? 2 * c.capacity() : needed);
+}
+
+template <typename Container>
+void __reserve_more(Container&, size_t, long) {}
+
+template <typename Range>
+auto __range_size_hint(const Range& r, int) -> decltype(static_cast<size_t>(r.size())) {
+	return static_cast<size_t>(r.size());
+}
+
+template <typename T, size_t N>
+size_t __range_size_hint(const T (&)[N], int) { return N; }
+
+template <typename Range>
+size_t __range_size_hint(const Range&, long) { return 0; }
+
+
 
 }
 
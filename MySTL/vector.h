@@ -13,9 +13,14 @@ namespace MYSTL
 
 
 template <typename T, typename Alloc = MYSTL::allocator<T>>
-class vector {
+class vector : private __allocator_holder<Alloc> {
+    using alloc_base = __allocator_holder<Alloc>;
+
+    // the allocator can resize a block in place and the elements may be moved bitwise
+    static constexpr bool use_reallocate = __has_reallocate<Alloc>::value && std::is_trivially_copyable<T>::value;
+
 public:
-    using data_allocator         = MYSTL::allocator<T>;
+    using allocator_type         = Alloc;
     using iterator_category      = MYSTL::random_access_iterator_tag;
 
     using value_type             = T;
@@ -31,6 +36,8 @@ public:
     using reverse_iterator       = MYSTL::reverse_iterator<iterator>;
     using const_reverse_iterator = MYSTL::reverse_iterator<const_iterator>;
 
+    // the alignment of data(): alignof(T), or Align for aligned_allocator<T, Align>
+    static constexpr size_t data_alignment = __allocator_alignment<Alloc>::value;
 
 protected:
     iterator start;
@@ -42,7 +49,7 @@ protected:
 
     void allocate(size_type init_size) {
         try {
-            start = data_allocator::allocate(init_size);
+            start = this->alloc().allocate(init_size);
             end_of_storage = finish = start + init_size;
         }
         catch(...) {
@@ -51,6 +58,18 @@ protected:
         }
     }
 
+    // an allocator with reallocate() resizes the block itself (file_allocator remaps
+    // it), the elements keep their values and the caller goes on as if there was room
+    bool resize_block(size_type n) { return resize_block(n, std::integral_constant<bool, use_reallocate>()); }
+    bool resize_block(size_type, std::false_type) { return false; }
+    bool resize_block(size_type n, std::true_type) {
+        const size_type old_size = size();
+        start = this->alloc().reallocate(start, capacity(), n);
+        finish = start + old_size;
+        end_of_storage = start + n;
+        return true;
+    }
+
     void fill_initialize(size_type n, const value_type& value);
 
     template <typename Iterator>
@@ -66,9 +85,12 @@ public:
 
     //ctors:
     vector() : start(0), finish(0), end_of_storage(0) {}
+    explicit vector(const allocator_type& a) : alloc_base(a), start(0), finish(0), end_of_storage(0) {}
     vector(size_type n, const value_type& value) { fill_initialize(n, value); }
     vector(size_type n) { fill_initialize(n, value_type()); }
-    vector(const vector& rhs) { range_initialize(rhs.begin(), rhs.end()); }
+    vector(const vector& rhs) : alloc_base(__select_on_copy(rhs.alloc())) {
+        range_initialize(rhs.begin(), rhs.end());
+    }
 
     // template <typename InputIterator, 
     // typename = typename std::enable_if<std::is_convertible<typename
@@ -85,10 +107,12 @@ public:
     vector(std::initializer_list<value_type> ilist) { range_initialize(ilist.begin(), ilist.end()); }
 
     ~vector() {
-        data_allocator::destroy(start, finish);
-        data_allocator::deallocate(start, end_of_storage - start);
+        MYSTL::destroy(start, finish);
+        this->alloc().deallocate(start, end_of_storage - start);
     }
 
+    allocator_type get_allocator() const { return this->alloc(); }
+
     //iterators
     iterator        begin()       { return start; }
     const_iterator  begin() const { return start; }
@@ -108,19 +132,22 @@ public:
     //capacity
     size_type   size()     const  { return static_cast<size_type>(end() - begin()); }
     size_type   capacity() const  { return static_cast<size_type>(end_of_storage - begin()); }
-    bool        empty()    const  { return begin() == end() && start != nullptr; }
+    size_type   max_size() const  { return static_cast<size_type>(-1) / sizeof(T); }
+    bool        empty()    const  { return begin() == end(); }
+    void        reserve(size_type n);
     void        shrink_to_fit() {
-        if(size() < capacity()) {
+        if(size() < capacity() && !resize_block(size())) {
             const auto new_size = size();
-            auto new_start = data_allocator::allocate(new_size);
+            auto new_start = this->alloc().allocate(new_size);
             try {
                 MYSTL::uninitialized_move(start, finish, new_start);
             }
             catch(...) {
-                data_allocator::deallocate(new_start, new_size);
+                this->alloc().deallocate(new_start, new_size);
                 throw;
             }
-            data_allocator::deallocate(start, end_of_storage - start);
+            MYSTL::destroy(start, finish);
+            this->alloc().deallocate(start, end_of_storage - start);
             start = new_start;
             finish = end_of_storage = start + new_size;
         }
@@ -135,8 +162,9 @@ public:
     const_reference back()                  const { return *(end() - 1); }
     reference       operator[](size_type n)       { return *(begin() + n); }
     const_reference operator[](size_type n) const { return *(begin() + n); }
-    pointer         data()                        { return start; }
-    const_pointer   data()                  const { return start; }
+    // aligned to data_alignment, so SIMD code may use aligned loads from data()
+    pointer         data()                        { return static_cast<pointer>(__builtin_assume_aligned(start, data_alignment)); }
+    const_pointer   data()                  const { return static_cast<const_pointer>(__builtin_assume_aligned(start, data_alignment)); }
 
     //modifiers:
     template <typename InputIterator, typename = typename
@@ -168,29 +196,33 @@ public:
     void     insert(const_pointer position, InputIterator first, InputIterator last);
 
     iterator erase(const_iterator position) {
-        if(position + 1 != end())
-            MYSTL::copy(position + 1, finish, position);
+        auto pos = const_cast<iterator>(position);
+        if(pos + 1 != end())
+            MYSTL::move(pos + 1, finish, pos);
         --finish;
-        destroy(finish);
-        return position;
+        MYSTL::destroy(finish);
+        return pos;
     }
     iterator erase(const_iterator first, const_iterator last);
-    iterator erase(iterator first, iterator last);
+    iterator erase(iterator first, iterator last) {
+        return erase(const_iterator(first), const_iterator(last));
+    }
     void     clear() { erase(begin(), end()); }
 
     //resize
     void resize(size_type new_size) { resize(new_size, value_type{}); }
     void resize(size_type new_size, const value_type& value) {
-        if(new_size > capacity()) {
-            vector tmp(new_size, value);
-            swap(tmp);
-        }
-        else if(new_size > size()) {
+        if(new_size > size())
             insert(end(), new_size - size(), value);
-        }
-        else {
+        else
             erase(begin() + new_size, end());
-        }
+    }
+    // trivial T only: the new elements are left uninitialized, for callers that fill
+    // them right away (a read from a file or a socket)
+    void resize_uninitialized(size_type new_size) {
+        static_assert(std::is_trivial<T>::value, "resize_uninitialized needs a trivial T");
+        reserve(new_size);
+        finish = start + new_size;
     }
 
 
@@ -199,6 +231,7 @@ public:
             MYSTL::swap(start, rhs.start);
             MYSTL::swap(finish, rhs.finish);
             MYSTL::swap(end_of_storage, rhs.end_of_storage);
+            MYSTL::swap(this->alloc(), rhs.alloc());
         }
     }
 };
@@ -222,32 +255,39 @@ void vector<T, Alloc>::range_initialize(Iterator first, Iterator last) {
 template <typename T, typename Alloc>
 void vector<T, Alloc>::insert_aux(iterator position, const value_type& value) {
     if (finish != end_of_storage) {
-        construct(finish, *(finish - 1));
+        MYSTL::construct(finish, *(finish - 1));
         ++finish;
         T value_copy = value;
-        copy_backward(position, finish - 2, finish - 1);
+        MYSTL::copy_backward(position, finish - 2, finish - 1);
         *position = value_copy;
     }
     else {
         const size_type old_size = size();
         const size_type new_size = old_size != 0 ? 2 * old_size : 1;
-        iterator new_start = data_allocator::allocate(new_size);
+        if (use_reallocate) {
+            const size_type offset = static_cast<size_type>(position - start);
+            T value_copy = value;  // value may live in the block that moves
+            resize_block(new_size);
+            insert(start + offset, value_copy);
+            return;
+        }
+        iterator new_start = this->alloc().allocate(new_size);
         iterator new_finish = new_start;
 
         try {
-            new_finish = uninitialized_copy(start, position, new_start);
-            construct(new_finish, value);
+            new_finish = MYSTL::uninitialized_copy(start, position, new_start);
+            MYSTL::construct(new_finish, value);
             ++new_finish;
-            new_finish = uninitialized_copy(position, finish, new_finish);
+            new_finish = MYSTL::uninitialized_copy(position, finish, new_finish);
         }
         catch(...) {
-            data_allocator::destroy(new_start, new_finish);
-            data_allocator::deallocate(new_start, new_size);
+            MYSTL::destroy(new_start, new_finish);
+            this->alloc().deallocate(new_start, new_size);
             throw;
         }
 
-        data_allocator::destroy(begin(), end());
-        data_allocator::deallocate(begin(), size());
+        MYSTL::destroy(begin(), end());
+        this->alloc().deallocate(start, end_of_storage - start);
         start = new_start;
         finish = new_finish;
         end_of_storage = new_start + new_size;
@@ -272,8 +312,9 @@ template <typename ForwardIterator>
 void vector<T, Alloc>::assign_aux(ForwardIterator first, ForwardIterator last, MYSTL::forward_iterator_tag) {
     const size_type len = MYSTL::distance(first, last);
     if(len > capacity()) {
-        vector tmp(first, last);
-        swap(tmp);
+        clear();
+        reserve(len);
+        finish = MYSTL::uninitialized_copy(first, last, start);
     }
     else if(len > size()) {
         auto mid = first;
@@ -284,13 +325,34 @@ void vector<T, Alloc>::assign_aux(ForwardIterator first, ForwardIterator last, M
     }
     else {
         auto new_finish = MYSTL::copy(first, last, start);
-        data_allocator::destroy(new_finish, finish);
+        MYSTL::destroy(new_finish, finish);
         finish = new_finish;
     }
 }
 
 /******************************************************************************/
 
+//capacity:
+template <typename T, typename Alloc>
+void vector<T, Alloc>::reserve(size_type n) {
+    if (n <= capacity() || resize_block(n))
+        return;
+    const size_type old_size = size();
+    auto new_start = this->alloc().allocate(n);
+    try {
+        MYSTL::uninitialized_move(start, finish, new_start);
+    }
+    catch(...) {
+        this->alloc().deallocate(new_start, n);
+        throw;
+    }
+    MYSTL::destroy(start, finish);
+    this->alloc().deallocate(start, end_of_storage - start);
+    start = new_start;
+    finish = new_start + old_size;
+    end_of_storage = new_start + n;
+}
+
 //modifiers:
 template <typename T, typename Alloc>
 template <typename InputIterator, typename>
@@ -303,8 +365,10 @@ template <typename T, typename Alloc>
 void vector<T, Alloc>::
 assign(size_type n, const value_type& value) {
     if(n > capacity()) {
-        vector tmp(n, value);
-        swap(tmp);
+        const value_type value_copy(value);
+        clear();
+        reserve(n);
+        finish = MYSTL::uninitialized_fill_n(start, n, value_copy);
     }
     else if(n > size()) {
         MYSTL::fill(begin(), end(), value);
@@ -326,35 +390,40 @@ vector<T, Alloc>::emplace(const_iterator position, Args&&... args) {
     const size_type n = position - cbegin();
     if(finish != end_of_storage) {
         if(const_cast_pos == cend()) {
-            data_allocator::construct(MYSTL::addressof(*finish), forward<Args>(args)...);
+            MYSTL::construct(MYSTL::addressof(*finish), MYSTL::forward<Args>(args)...);
             ++finish;
         }
         else {
-            auto new_finish = finish;
-            data_allocator::construct(MYSTL::addressof(*finish));
-            ++new_finish;
-            MYSTL::copy_backward(const_cast_pos, finish, new_finish);
-            *const_cast_pos = value_type(MYSTL::forward<Args>(args)...);
+            value_type tmp(MYSTL::forward<Args>(args)...);
+            MYSTL::construct(MYSTL::addressof(*finish), MYSTL::move(*(finish - 1)));
+            ++finish;
+            MYSTL::move_backward(const_cast_pos, finish - 2, finish - 1);
+            *const_cast_pos = MYSTL::move(tmp);
         }
     }
     else { //need to reallocate:
         const size_type old_size = size();
         const size_type new_size = old_size != 0 ? 2 * old_size : 1;
+        if (use_reallocate) {
+            value_type tmp(MYSTL::forward<Args>(args)...);
+            resize_block(new_size);
+            return emplace(start + n, MYSTL::move(tmp));
+        }
 
-        auto new_start = data_allocator::allocate(new_size);
+        auto new_start = this->alloc().allocate(new_size);
         auto new_finish = new_start;
         try {
             new_finish = MYSTL::uninitialized_move(start, const_cast_pos, new_start);
-            data_allocator::construct(MYSTL::addressof(*new_finish), MYSTL::forward<Args>(args)...);
+            MYSTL::construct(MYSTL::addressof(*new_finish), MYSTL::forward<Args>(args)...);
             ++new_finish;
             new_finish = MYSTL::uninitialized_move(const_cast_pos, finish, new_finish);
         }
         catch(...) {
-            data_allocator::deallocate(new_start, new_size);
+            this->alloc().deallocate(new_start, new_size);
             throw;
         }
-        data_allocator::destroy(start, finish);
-        data_allocator::deallocate(start, end_of_storage - start);
+        MYSTL::destroy(start, finish);
+        this->alloc().deallocate(start, end_of_storage - start);
         start = new_start;
         finish = new_finish;
         end_of_storage = new_start + new_size;
@@ -365,14 +434,14 @@ vector<T, Alloc>::emplace(const_iterator position, Args&&... args) {
 template <typename T, typename Alloc>
 template <typename... Args>
 void vector<T, Alloc>::emplace_back(Args&&... args) {
-    emplace(end(), (args)...);
+    emplace(end(), MYSTL::forward<Args>(args)...);
 }
 
 
 template <typename T, typename Alloc>
 void vector<T, Alloc>::push_back(const value_type& value) {
     if(finish != end_of_storage) {
-        construct(finish, value);
+        MYSTL::construct(finish, value);
         ++finish;
     }
     else
@@ -388,20 +457,32 @@ template <typename T, typename Alloc>
 void vector<T, Alloc>::pop_back() {
     if(!empty()) {
         --finish;
-        destroy(finish);
+        MYSTL::destroy(finish);
     }
 }
 
+template <typename T, typename Alloc>
+typename vector<T, Alloc>::iterator
+vector<T, Alloc>::erase(const_iterator first, const_iterator last) {
+    auto pos = const_cast<iterator>(first);
+    if (first != last) {
+        auto new_finish = MYSTL::move(const_cast<iterator>(last), finish, pos);
+        MYSTL::destroy(new_finish, finish);
+        finish = new_finish;
+    }
+    return pos;
+}
+
 template <typename T, typename Alloc>
 typename vector<T, Alloc>::iterator
 vector<T, Alloc>::insert(const_iterator position, const value_type& value) {
     const auto n = position - begin();
     if(finish != end_of_storage && position == end()) {
-        construct(finish, value);
+        MYSTL::construct(finish, value);
         ++finish;
     }
     else
-        insert_aux(position, value);
+        insert_aux(begin() + n, value);
     return begin() + n;
 }
 
@@ -409,60 +490,69 @@ vector<T, Alloc>::insert(const_iterator position, const value_type& value) {
 template <class T, class Alloc>
 typename vector<T, Alloc>::iterator 
 vector<T, Alloc>::insert(const_iterator position, size_type n, const value_type& value) {
+    auto pos = const_cast<iterator>(position);
+    const size_type offset = pos - start;
     if (n != 0) {
         if (static_cast<size_type>(end_of_storage - finish) >= n) {
             T value_copy(value);
-            const size_type elems_after = finish - position;
+            const size_type elems_after = finish - pos;
             iterator old_finish = finish;
             if (elems_after > n) {
-                finish = uninitialized_copy(finish - n, finish, finish);
-                move_backward(position, old_finish - n, old_finish);
-                uninitialized_fill_n(position, n, value_copy);
+                finish = MYSTL::uninitialized_move(finish - n, finish, finish);
+                MYSTL::move_backward(pos, old_finish - n, old_finish);
+                MYSTL::fill_n(pos, n, value_copy);
             }
             else {
-                finish = uninitialized_fill_n(finish, n - elems_after, value_copy);
-                finish = uninitialized_move(position, old_finish, finish);
-                uninitialized_fill_n(position, elems_after, value_copy);
+                finish = MYSTL::uninitialized_fill_n(finish, n - elems_after, value_copy);
+                finish = MYSTL::uninitialized_move(pos, old_finish, finish);
+                MYSTL::fill_n(pos, elems_after, value_copy);
             }
         }
         else { //need to reallocate
             const size_type old_size = size();        
-            const size_type len = old_size + max(old_size, n);
-            auto new_start = data_allocator::allocate(len);
+            const size_type len = old_size + MYSTL::max(old_size, n);
+            if (use_reallocate) {
+                T value_copy(value);
+                resize_block(len);
+                return insert(start + offset, n, value_copy);
+            }
+            auto new_start = this->alloc().allocate(len);
             auto new_finish = new_start;
             try {
-                new_finish = uninitialized_move(start, position, new_start);
-                new_finish = uninitialized_fill_n(new_finish, n, value);
-                new_finish = uninitialized_move(position, finish, new_finish);
+                new_finish = MYSTL::uninitialized_move(start, pos, new_start);
+                new_finish = MYSTL::uninitialized_fill_n(new_finish, n, value);
+                new_finish = MYSTL::uninitialized_move(pos, finish, new_finish);
             }
             catch(...) {
-                destroy(new_start, new_finish);
-                data_allocator::deallocate(new_start, len);
+                MYSTL::destroy(new_start, new_finish);
+                this->alloc().deallocate(new_start, len);
                 throw;
             }
-            data_allocator::destroy(start, finish);
-            data_allocator::deallocate(start, end_of_storage - start);
+            MYSTL::destroy(start, finish);
+            this->alloc().deallocate(start, end_of_storage - start);
             start = new_start;
             finish= new_finish;
             end_of_storage = new_start + len;
         }
     }
-
+    return start + offset;
 }
 
 template <typename T, typename Alloc>
 template <typename InputIterator, typename>
 void vector<T, Alloc>::insert(const_pointer position, InputIterator first, InputIterator last) {
     if (first == last)  return;
-    auto pos = static_cast<iterator>(position);
+    auto pos = const_cast<iterator>(position);
     const auto n = MYSTL::distance(first, last);
     if (end_of_storage - finish >= n) { 
         const auto after_elems = finish - position;
         auto old_finish = finish;
+        // [pos, old_finish) still holds live elements: those slots are assigned,
+        // only the raw storage past old_finish is constructed
         if (after_elems > n) {
-            finish = MYSTL::uninitialized_copy(finish - n, finish, finish);
+            finish = MYSTL::uninitialized_move(finish - n, finish, finish);
             MYSTL::move_backward(pos, old_finish - n, old_finish);
-            MYSTL::uninitialized_copy(first, last, pos);
+            MYSTL::copy(first, last, pos);
         }
         else
         {
@@ -470,13 +560,19 @@ void vector<T, Alloc>::insert(const_pointer position, InputIterator first, Input
             MYSTL::advance(mid, after_elems);
             finish = MYSTL::uninitialized_copy(mid, last, finish);
             finish = MYSTL::uninitialized_move(pos, old_finish, finish);
-            MYSTL::uninitialized_copy(first, mid, pos);
+            MYSTL::copy(first, mid, pos);
         }
     }
     else { // need to reallocate
         const size_type old_size = size();  
-        const size_type len = old_size + max(old_size, n);
-        auto new_start = data_allocator::allocate(len);
+        const size_type len = old_size + MYSTL::max(old_size, static_cast<size_type>(n));
+        if (use_reallocate) {
+            const auto offset = pos - start;
+            resize_block(len);
+            insert(start + offset, first, last);
+            return;
+        }
+        auto new_start = this->alloc().allocate(len);
         auto new_finish = new_start;
         try {
             new_finish = MYSTL::uninitialized_move(start, pos, new_start);
@@ -484,12 +580,12 @@ void vector<T, Alloc>::insert(const_pointer position, InputIterator first, Input
             new_finish = MYSTL::uninitialized_move(pos, finish, new_finish);
         }
         catch(...) {
-            destroy(new_start, new_finish);
-            data_allocator::deallocate(new_start, len);
+            MYSTL::destroy(new_start, new_finish);
+            this->alloc().deallocate(new_start, len);
             throw;
         }
-        data_allocator::destroy(start, finish);
-        data_allocator::deallocate(start, end_of_storage - start);
+        MYSTL::destroy(start, finish);
+        this->alloc().deallocate(start, end_of_storage - start);
         start = new_start;
         finish = new_finish;
         end_of_storage = start + len;
@@ -506,9 +602,13 @@ vector<T, Alloc>& vector<T, Alloc>::operator=(const vector& rhs) {
     return *this;
 }
 
+template <typename T, typename Alloc>
+constexpr size_t vector<T, Alloc>::data_alignment;
+
 template <typename T, typename Alloc>
 vector<T, Alloc>::vector(vector&& rhs) noexcept
-                    :start(rhs.start), 
+                    :alloc_base(MYSTL::move(rhs.alloc())),
+                    start(rhs.start), 
                     finish(rhs.finish), 
                     end_of_storage(rhs.end_of_storage)
 {
@@ -519,8 +619,11 @@ vector<T, Alloc>::vector(vector&& rhs) noexcept
 
 template <typename T, typename Alloc >
 vector<T, Alloc>& vector<T, Alloc>::operator=(vector&& rhs) noexcept {
-    data_allocator::destroy(start, finish);
-    data_allocator::deallocate(start, end_of_storage - start);
+    if (this == &rhs)
+        return *this;
+    MYSTL::destroy(start, finish);
+    this->alloc().deallocate(start, end_of_storage - start);
+    this->alloc() = MYSTL::move(rhs.alloc());
     start = rhs.start;
     finish = rhs.finish;
     end_of_storage = rhs.end_of_storage;
@@ -0,0 +1,108 @@
+#include "../MySTL/allocator.h"
+#include "../MySTL/vector.h"
+#include "../MySTL/list.h"
+#include "../MySTL/deque.h"
+#include "../MySTL/tracking_allocator.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+struct alignas(64) padded {
+    long value;
+};
+
+struct alignas(32) simd8 {
+    float lanes[8];
+};
+
+template <typename P>
+bool aligned(P p, size_t a) { return reinterpret_cast<uintptr_t>(p) % a == 0; }
+
+// sums with aligned loads; faults on a misaligned pointer
+float sum(const float* p, size_t n) {
+#ifdef __SSE__
+    __m128 acc = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm_add_ps(acc, _mm_load_ps(p + i));
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    float s = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; ++i)
+        s += p[i];
+    return s;
+#else
+    float s = 0;
+    for (size_t i = 0; i < n; ++i)
+        s += p[i];
+    return s;
+#endif
+}
+
+int main() {
+
+    // over-aligned element types through the default allocator
+    {
+        vector<padded> v;
+        for (long i = 0; i < 1000; ++i) {
+            v.push_back(padded{i});
+            assert(aligned(v.data(), 64));
+        }
+        static_assert(vector<padded>::data_alignment == 64, "alignof(T)");
+        vector<simd8> s(100);
+        assert(aligned(s.data(), 32));
+        s.shrink_to_fit();
+        assert(aligned(s.data(), 32));
+
+        list<padded> l;
+        for (long i = 0; i < 100; ++i)
+            l.push_back(padded{i});
+        for (auto& p : l)
+            assert(aligned(&p, 64));
+
+        deque<padded> d;
+        for (long i = 0; i < 200; ++i)
+            d.push_front(padded{i});
+        assert(aligned(&d[0], 64) && aligned(&d[199], 64));
+    }
+
+    // aligned_allocator over plain floats, for SIMD loads
+    {
+        using avx_floats = vector<float, aligned_allocator<float, 32>>;
+        static_assert(avx_floats::data_alignment == 32, "Align");
+        avx_floats v;
+        for (int i = 0; i < 1003; ++i) {
+            v.push_back(1.0f);
+            assert(aligned(v.data(), 32));
+        }
+        assert(sum(v.data(), v.size()) == 1003.0f);
+
+        vector<char, aligned_allocator<char>> line(10);
+        assert(aligned(line.data(), 64));
+
+        // rebinding keeps Align, raised to the alignment of the new type if above
+        static_assert(aligned_allocator<int, 128>::rebind<double>::other::alignment == 128, "rebind");
+        static_assert(aligned_allocator<char, 16>::rebind<padded>::other::alignment == 64, "rebind");
+        list<int, aligned_allocator<int, 128>> l{1, 2, 3};
+        assert(l.size() == 3 && l.back() == 3);
+
+        using tracked = tracking_allocator<aligned_allocator<float, 32>>;
+        static_assert(vector<float, tracked>::data_alignment == 32, "tracking keeps the alignment");
+        vector<float, tracked> t{tracked("aligned")};
+        t.assign(100, 2.0f);
+        assert(aligned(t.data(), 32) && sum(t.data(), t.size()) == 200.0f);
+
+        assert((aligned_allocator<int, 32>() == aligned_allocator<char, 64>()));
+    }
+
+    cout << "aligned_allocator test passed" << endl;
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "../MySTL/btree_map.h"
+#include "../MySTL/map.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+
+
+using std::cout;
+using std::endl;
+
+template <typename F>
+double time_ms(F f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// random inserts and lookups, then short range scans starting at random keys
+template <typename Map>
+void run(const char* name, const MYSTL::vector<int>& keys) {
+    Map m;
+    const double insert = time_ms([&] {
+        for (auto k : keys)
+            m.insert(typename Map::value_type(k, k));
+    });
+    long sink = 0;
+    const double find = time_ms([&] {
+        for (auto k : keys)
+            sink += (*m.find(k)).second;
+    });
+    const double scan = time_ms([&] {
+        for (size_t i = 0; i < keys.size(); i += 10) {
+            auto it = m.lower_bound(keys[i]);
+            for (int j = 0; j < 100 && it != m.end(); ++j, ++it)
+                sink += (*it).second;
+        }
+    });
+    cout << name << "  insert " << insert << " ms  find " << find << " ms  scan 100 x " << keys.size() / 10
+         << " " << scan << " ms" << (sink == 42 ? " " : "") << endl;
+}
+
+int main() {
+    const int n = 1000000;
+    MYSTL::vector<int> keys(n);
+    for (int i = 0; i < n; ++i)
+        keys[i] = rand();
+    run<MYSTL::btree_map<int, int>>("MYSTL::btree_map", keys);
+    run<MYSTL::map<int, int>>("MYSTL::map      ", keys);
+    run<std::map<int, int>>("std::map        ", keys);
+
+    // bulk load against one insert per element, both from sorted input
+    MYSTL::vector<MYSTL::pair<int, int>> sorted;
+    for (int i = 0; i < n; ++i)
+        sorted.push_back(MYSTL::make_pair(i, i));
+    MYSTL::btree_map<int, int> a, b;
+    const double bulk = time_ms([&] { a.assign_sorted(sorted.begin(), sorted.end()); });
+    const double one = time_ms([&] {
+        for (const auto& kv : sorted)
+            b.insert(kv);
+    });
+    cout << "sorted " << n << "  assign_sorted " << bulk << " ms  insert loop " << one << " ms" << endl;
+    return 0;
+}
@@ -0,0 +1,277 @@
+#include "../MySTL/btree_map.h"
+#include "../MySTL/btree_set.h"
+#include "../MySTL/tracking_allocator.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+template <typename M, typename R>
+bool same(const M& a, const R& b) {
+    if (a.size() != b.size())  return false;
+    auto it = b.begin();
+    for (auto kv : a) {
+        if (kv.first != it->first || kv.second != it->second)  return false;
+        ++it;
+    }
+    return true;
+}
+
+template <typename S, typename R>
+bool same_keys(const S& a, const R& b) {
+    if (a.size() != b.size())  return false;
+    auto it = b.begin();
+    for (const auto& k : a)
+        if (k != *it++)  return false;
+    return true;
+}
+
+// random operations checked against std::map, with the tree invariants after each round
+template <typename Map, typename Key>
+void random_ops(Key (*make_key)(int), int range) {
+    Map m;
+    std::map<Key, int, typename Map::key_compare> ref;
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 3000; ++i) {
+            const Key key = make_key(rand() % range);
+            switch (rand() % 5) {
+            case 0:
+                m[key] = i;
+                ref[key] = i;
+                break;
+            case 1:
+                assert(m.insert(MYSTL::make_pair(key, i)).second == ref.insert(std::make_pair(key, i)).second);
+                break;
+            case 2:
+                assert(m.erase(key) == ref.erase(key));
+                break;
+            case 3: {
+                auto it = m.lower_bound(key);
+                auto rit = ref.lower_bound(key);
+                assert((it == m.end()) == (rit == ref.end()));
+                if (it != m.end())
+                    assert(it->first == rit->first && it->second == rit->second);
+                auto ut = m.upper_bound(key);
+                auto rut = ref.upper_bound(key);
+                assert((ut == m.end()) == (rut == ref.end()));
+                if (ut != m.end())
+                    assert(ut->first == rut->first);
+                break;
+            }
+            default: {
+                auto it = m.find(key);
+                auto rit = ref.find(key);
+                assert((it == m.end()) == (rit == ref.end()));
+                if (it != m.end()) {
+                    auto next = m.erase(it);
+                    auto rnext = ref.erase(rit);
+                    assert((next == m.end()) == (rnext == ref.end()));
+                    if (next != m.end())
+                        assert(next->first == rnext->first);
+                }
+            }
+            }
+        }
+        assert(m.__verify() && same(m, ref));
+    }
+    // backwards iteration
+    auto rit = ref.rbegin();
+    for (auto it = m.end(); it != m.begin(); ++rit) {
+        --it;
+        assert(it->first == rit->first);
+    }
+    // erase everything one by one
+    while (!m.empty()) {
+        m.erase(m.begin());
+        assert(m.size() % 97 != 0 || m.__verify());
+    }
+    assert(m.__verify() && m.height() == 0);
+}
+
+// key whose copy throws once copies_left runs out; live counts the constructed keys
+struct fragile_key {
+    static int live;
+    static int copies_left;
+    int v;
+
+    explicit fragile_key(int x) : v(x) { ++live; }
+    fragile_key(const fragile_key& rhs) : v(rhs.v) {
+        if (copies_left-- == 0)
+            throw std::runtime_error("fragile_key copy");
+        ++live;
+    }
+    fragile_key(fragile_key&& rhs) noexcept : v(rhs.v) { ++live; }
+    ~fragile_key() { --live; }
+
+    bool operator<(const fragile_key& rhs) const { return v < rhs.v; }
+};
+int fragile_key::live = 0;
+int fragile_key::copies_left = -1;
+
+int int_key(int i) { return i; }
+unsigned unsigned_key(int i) { return static_cast<unsigned>(i) * 2654435761u; }
+double double_key(int i) { return i * 0.5 - 100; }
+std::string string_key(int i) { return std::to_string(i); }
+
+int main() {
+
+    btree_map<std::string, int> m{{"one", 1}, {"two", 2}, {"three", 3}};
+    m["four"] = 4;
+    for (auto kv : m)
+        cout << kv.first << ":" << kv.second << " ";
+    cout << endl;
+    assert(m.size() == 4 && m.at("two") == 2 && m.begin()->first == "four");
+    assert(!m.try_emplace("one", 100).second && m["one"] == 1);
+    assert(!m.insert_or_assign("one", 11).second && m["one"] == 11);
+    assert((--m.end())->first == "two");
+    try {
+        m.at("five");
+        assert(false);
+    }
+    catch (const std::out_of_range&) {}
+
+    // the 32-bit integer keys take the SSE2 node search, unsigned ones through the sign
+    // flip; doubles the counting loop; strings the binary search. the small node sizes
+    // make deep trees so that splits and merges run at every level
+    random_ops<btree_map<int, int>>(int_key, 2000);
+    random_ops<btree_map<int, int, std::less<int>, 64>>(int_key, 2000);
+    random_ops<btree_map<unsigned, int, std::less<unsigned>, 64>>(unsigned_key, 2000);
+    random_ops<btree_map<double, int>>(double_key, 2000);
+    random_ops<btree_map<std::string, int, std::less<std::string>, 128>>(string_key, 2000);
+    random_ops<btree_map<int, int, std::greater<int>, 64>>(int_key, 2000);
+
+    // ascending inserts pack the leaves
+    {
+        btree_set<int> s;
+        for (int i = 0; i < 100000; ++i)
+            assert(s.insert(i).second);
+        assert(s.__verify() && s.size() == 100000 && *s.begin() == 0 && *--s.end() == 99999);
+        btree_set<int> d;
+        for (int i = 100000; i > 0; --i)
+            d.insert(i);
+        assert(d.__verify() && d.size() == 100000);
+        assert(s.height() <= d.height());
+    }
+
+    // bulk load from a sorted vector, every size around the node boundaries
+    for (int n = 0; n < 3000; n += (n < 300 ? 1 : 37)) {
+        vector<int> keys;
+        for (int i = 0; i < n; ++i)
+            keys.push_back(i * 3);
+        btree_set<int, std::less<int>, 64> s(sorted_unique, keys.begin(), keys.end());
+        assert(s.__verify() && s.size() == static_cast<size_t>(n));
+        assert(MYSTL::equal(s.begin(), s.end(), keys.begin()));
+        if (n > 1) {
+            assert(*s.lower_bound(1) == 3 && s.contains(3 * (n - 1)) && !s.contains(1));
+            // the loaded tree takes further updates
+            s.insert(1);
+            s.erase(0);
+            assert(s.__verify() && *s.begin() == 1);
+        }
+    }
+    {
+        vector<pair<int, std::string>> kv;
+        for (int i = 0; i < 10000; ++i)
+            kv.push_back(MYSTL::make_pair(i, std::to_string(i)));
+        btree_map<int, std::string> bm(sorted_unique, kv.begin(), kv.end());
+        assert(bm.__verify() && bm.size() == 10000 && bm.at(4321) == "4321");
+
+        // range scan over the leaf chain
+        int expect = 2000;
+        for (auto it = bm.lower_bound(2000), last = bm.lower_bound(7000); it != last; ++it)
+            assert(it->first == expect && it->second == std::to_string(expect++));
+        assert(expect == 7000);
+
+        // copies are bulk loaded as well, moves steal the nodes
+        btree_map<int, std::string> copy(bm);
+        assert(copy == bm && copy.__verify());
+        copy.erase(copy.lower_bound(100), copy.lower_bound(9000));
+        assert(copy.size() == 1100 && copy.__verify() && copy != bm);
+        btree_map<int, std::string> moved(MYSTL::move(copy));
+        assert(copy.empty() && moved.size() == 1100 && moved.__verify());
+        moved.swap(bm);
+        assert(bm.size() == 1100 && moved.size() == 10000);
+        bm = moved;
+        assert(bm == moved && bm.__verify());
+        bm.erase(bm.begin(), bm.end());
+        assert(bm.empty() && bm.begin() == bm.end() && bm.__verify());
+    }
+
+    // set checked against std::set
+    {
+        btree_set<int, std::less<int>, 64> s;
+        std::set<int> ref;
+        for (int i = 0; i < 50000; ++i) {
+            const int key = rand() % 5000;
+            if (rand() % 3 == 0)
+                assert(s.erase(key) == ref.erase(key));
+            else
+                assert(s.insert(key).second == ref.insert(key).second);
+        }
+        assert(s.__verify() && same_keys(s, ref));
+        auto range = s.equal_range(*ref.begin());
+        assert(range.first == s.begin() && range.second == ++s.begin());
+    }
+
+    // a separator copy that throws while the inner levels are built frees every node
+    {
+        std::vector<fragile_key> keys;
+        keys.reserve(1000);
+        for (int i = 0; i < 1000; ++i)
+            keys.emplace_back(i);
+        const int before = fragile_key::live;
+        btree_set<fragile_key, std::less<fragile_key>, 64> s;
+        fragile_key::copies_left = 1000 + 3;  // every leaf copy and three separators
+        bool thrown = false;
+        try {
+            s.assign_sorted(keys.begin(), keys.end());
+        }
+        catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        fragile_key::copies_left = -1;
+        assert(thrown && s.empty() && s.begin() == s.end() && s.__verify());
+        assert(fragile_key::live == before);
+        s.assign_sorted(keys.begin(), keys.end());
+        assert(s.size() == 1000 && s.__verify());
+    }
+
+    // leaves and inner nodes go through the tree's allocator
+    {
+        using tracked = tracking_allocator<allocator<pair<int, int>>>;
+        {
+            btree_map<int, int, std::less<int>, 64, tracked> m{tracked("btree")};
+            for (int i = 0; i < 5000; ++i)
+                m[i] = i;
+            for (int i = 0; i < 2500; ++i)
+                m.erase(i * 2);
+            assert(tracking_stats_of("btree").live_bytes > 0);
+            auto copy = m;
+            btree_map<int, int, std::less<int>, 64, tracked> moved;
+            moved = MYSTL::move(m);
+            assert(moved == copy && moved.__verify() && copy.get_allocator() == tracked("btree"));
+
+            MYSTL::vector<int> keys;
+            for (int i = 0; i < 3000; ++i)
+                keys.push_back(i);
+            btree_set<int, std::less<int>, 64, tracking_allocator<allocator<int>>> s(
+                sorted_unique, keys.begin(), keys.end(), std::less<int>(), tracking_allocator<allocator<int>>("btree"));
+            assert(s.size() == 3000 && s.height() > 1 && s.__verify());
+        }
+        const tracking_stats st = tracking_stats_of("btree");
+        assert(st.allocations > 0 && st.allocations == st.deallocations && st.live_bytes == 0);
+    }
+
+    cout << "btree test passed" << endl;
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include "../MySTL/complex.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+template <typename T>
+bool close(T a, T b, T eps) { return std::fabs(a - b) <= eps * (1 + std::fabs(b)); }
+
+template <typename T>
+bool close(const complex<T>& a, const complex<T>& b, T eps) {
+    return close(a.real(), b.real(), eps) && close(a.imag(), b.imag(), eps);
+}
+
+static_assert(std::is_trivially_copyable<complex<float>>::value, "complex<float> is trivially copyable");
+static_assert(std::is_trivially_copyable<complex<double>>::value, "complex<double> is trivially copyable");
+
+int main() {
+
+    /*********************operators*****************************/
+    {
+        using cd = complex<double>;
+        const cd a(1, 2), b(3, -4);
+        assert(a + b == cd(4, -2) && a - b == cd(-2, 6));
+        assert(a * b == cd(11, 2));
+        assert(close(a / b, cd(-0.2, 0.4), 1e-15));
+        assert(a + 1.0 == cd(2, 2) && 1.0 + a == cd(2, 2));
+        assert(a - 1.0 == cd(0, 2) && 1.0 - a == cd(0, -2));
+        assert(a * 2.0 == cd(2, 4) && 2.0 * a == cd(2, 4));
+        assert(a / 2.0 == cd(0.5, 1) && close(1.0 / b, cd(0.12, 0.16), 1e-15));
+        assert(-a == cd(-1, -2) && +a == a);
+        assert(cd(3) == 3.0 && 3.0 == cd(3) && a != b && a != 1.0);
+
+        cd c = a;
+        c += b;
+        c -= 1.0;
+        c *= cd(0, 1);
+        assert(c == cd(2, 3));
+        c /= cd(0, 1);
+        assert(close(c, cd(3, -2), 1e-15));
+        c = 5.0;
+        assert(c == cd(5, 0));
+        c.real(7);
+        c.imag(-1);
+        assert(real(c) == 7 && imag(c) == -1);
+    }
+
+    /*********************values*****************************/
+    {
+        using cd = complex<double>;
+        const cd a(3, 4);
+        assert(norm(a) == 25 && abs(a) == 5);
+        assert(conj(a) == cd(3, -4));
+        assert(close(arg(cd(0, 1)), std::acos(-1.0) / 2, 1e-15));
+        assert(close(arg(cd(-1, 0)), std::acos(-1.0), 1e-15));
+        assert(close(polar(2.0, std::acos(-1.0) / 2), cd(0, 2), 1e-15));
+        assert(polar(2.0) == cd(2, 0));
+        const cd p = polar(abs(a), arg(a));
+        assert(close(p, a, 1e-15));
+        // no overflow in the intermediate squares
+        assert(close(abs(cd(3e200, 4e200)), 5e200, 1e-15));
+    }
+
+    /*********************batch kernels: SSE path against the plain loops*****************************/
+    for (size_t n = 0; n <= 13; ++n) {
+        vector<complex<float>> a, b;
+        for (size_t i = 0; i < n; ++i) {
+            a.push_back(complex<float>(0.5f * i - 1, 1.0f / (i + 1)));
+            b.push_back(complex<float>(2.0f - i, 0.25f * i));
+        }
+        vector<complex<float>> fast(n), slow(n);
+        complex_multiply(a.data(), b.data(), fast.data(), n);
+        complex_multiply<float>(a.data(), b.data(), slow.data(), n);
+        for (size_t i = 0; i < n; ++i)
+            assert(close(fast[i], slow[i], 1e-6f) && close(fast[i], a[i] * b[i], 1e-6f));
+
+        vector<float> fast_norm(n), slow_norm(n);
+        complex_norm(a.data(), fast_norm.data(), n);
+        complex_norm<float>(a.data(), slow_norm.data(), n);
+        for (size_t i = 0; i < n; ++i)
+            assert(close(fast_norm[i], slow_norm[i], 1e-6f));
+
+        vector<float> re(n), im(n);
+        complex_deinterleave(a.data(), re.data(), im.data(), n);
+        for (size_t i = 0; i < n; ++i)
+            assert(re[i] == a[i].real() && im[i] == a[i].imag());
+        vector<complex<float>> back(n);
+        complex_interleave(re.data(), im.data(), back.data(), n);
+        for (size_t i = 0; i < n; ++i)
+            assert(back[i] == a[i]);
+
+        // split layout
+        vector<float> b_re(n), b_im(n), out_re(n), out_im(n), split_norm(n);
+        complex_deinterleave(b.data(), b_re.data(), b_im.data(), n);
+        complex_multiply_split(re.data(), im.data(), b_re.data(), b_im.data(), out_re.data(), out_im.data(), n);
+        complex_norm_split(re.data(), im.data(), split_norm.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            assert(close(complex<float>(out_re[i], out_im[i]), slow[i], 1e-6f));
+            assert(close(split_norm[i], slow_norm[i], 1e-6f));
+        }
+
+        // vector front ends resize their output
+        vector<complex<float>> v_out;
+        vector<float> v_norm;
+        complex_multiply(a, b, v_out);
+        complex_norm(a, v_norm);
+        assert(v_out.size() == n && v_norm.size() == n);
+        for (size_t i = 0; i < n; ++i)
+            assert(v_out[i] == fast[i] && v_norm[i] == fast_norm[i]);
+    }
+
+    // double keeps to the plain loops
+    {
+        complex<double> a[5], b[5], out[5];
+        for (int i = 0; i < 5; ++i) {
+            a[i] = complex<double>(i, -i);
+            b[i] = complex<double>(1, i);
+        }
+        complex_multiply(a, b, out, 5);
+        for (int i = 0; i < 5; ++i)
+            assert(out[i] == a[i] * b[i]);
+    }
+
+    cout << "complex test passed" << endl;
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include "../MySTL/deque.h"
+#include "../MySTL/tracking_allocator.h"
+#include <iostream>
+#include <cassert>
+#include <deque>
+#include <cstdlib>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+template <typename T>
+bool same(const deque<T>& a, const std::deque<T>& b) {
+    if (a.size() != b.size())  return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (a[i] != b[i])  return false;
+    return true;
+}
+
+int main() {
+
+    deque<int> d1{1, 2, 3};
+    d1.push_front(0);
+    d1.push_back(4);
+    for (auto i : d1)
+        cout << i << " ";
+    cout << endl;
+
+    // random operations checked against std::deque
+    deque<int> d;
+    std::deque<int> ref;
+    std::srand(7);
+    for (int step = 0; step < 20000; ++step) {
+        const int op = std::rand() % 8;
+        const int v = std::rand();
+        if (op == 0)      { d.push_back(v);  ref.push_back(v); }
+        else if (op == 1) { d.push_front(v); ref.push_front(v); }
+        else if (op == 2 && !ref.empty()) { d.pop_back();  ref.pop_back(); }
+        else if (op == 3 && !ref.empty()) { d.pop_front(); ref.pop_front(); }
+        else if (op == 4) {
+            const size_t i = ref.empty() ? 0 : std::rand() % (ref.size() + 1);
+            d.insert(d.begin() + i, v);
+            ref.insert(ref.begin() + i, v);
+        }
+        else if (op == 5 && !ref.empty()) {
+            const size_t i = std::rand() % ref.size();
+            d.erase(d.begin() + i);
+            ref.erase(ref.begin() + i);
+        }
+        else if (op == 6) {
+            const size_t i = ref.empty() ? 0 : std::rand() % (ref.size() + 1);
+            const size_t n = std::rand() % 600;
+            d.insert(d.begin() + i, n, v);
+            ref.insert(ref.begin() + i, n, v);
+        }
+        else if (op == 7 && !ref.empty()) {
+            const size_t i = std::rand() % ref.size();
+            const size_t n = std::rand() % (ref.size() - i + 1);
+            d.erase(d.begin() + i, d.begin() + i + n);
+            ref.erase(ref.begin() + i, ref.begin() + i + n);
+        }
+    }
+    assert(same(d, ref));
+
+    // iterator arithmetic across blocks
+    deque<int> big;
+    for (int i = 0; i < 10000; ++i)
+        big.push_back(i);
+    auto it = big.begin() + 5000;
+    assert(*it == 5000 && *(it - 4321) == 679 && (big.end() - it) == 5000);
+    assert(big.at(9999) == 9999);
+
+    deque<int> copy(big);
+    deque<int> moved(MYSTL::move(copy));
+    assert(moved == big && copy.empty());
+    copy.push_back(1);
+    assert(copy.size() == 1);
+
+    int arr[] = {7, 8, 9};
+    moved.insert(moved.begin() + 3, arr, arr + 3);
+    assert(moved[3] == 7 && moved[5] == 9 && moved.size() == 10003);
+
+    deque<std::deque<int>> nested(3, std::deque<int>(2, 1));
+    nested.emplace(nested.begin() + 1, 5, 2);
+    assert(nested[1].size() == 5);
+
+    // steady-state FIFO, runs on the recycled blocks: no allocation after warm-up
+    {
+        using tracked = tracking_allocator<allocator<int>>;
+        deque<int, tracked> fifo{tracked("deque fifo")};
+        auto step = [&](int i) {
+            fifo.push_back(i);
+            if (fifo.size() > 3000)
+                fifo.pop_front();
+        };
+        int i = 0;
+        for (; i < 10000; ++i)
+            step(i);
+        const tracking_stats warm = tracking_stats_of("deque fifo");
+        for (; i < 1000000; ++i)
+            step(i);
+        const tracking_stats done = tracking_stats_of("deque fifo");
+        assert(done.allocations == warm.allocations && done.deallocations == warm.deallocations);
+        assert(fifo.front() == 1000000 - 3000 && fifo.back() == 999999);
+    }
+
+    // blocks and the map come from the deque's allocator
+    {
+        using tracked = tracking_allocator<allocator<int>>;
+        {
+            deque<int, tracked> td{tracked("deque")};
+            for (int i = 0; i < 5000; ++i)
+                td.push_front(i);
+            deque<int, tracked> tcopy(td);
+            deque<int, tracked> tmoved(MYSTL::move(td));
+            td = tcopy;
+            assert(td.size() == 5000 && tmoved.size() == 5000 && tcopy.get_allocator() == tracked("deque"));
+        }
+        const tracking_stats st = tracking_stats_of("deque");
+        assert(st.allocations > 0 && st.allocations == st.deallocations && st.live_bytes == 0);
+    }
+
+    cout << "deque test passed" << endl;
+    return 0;
+}
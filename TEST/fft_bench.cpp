@@ -0,0 +1,113 @@
+#include "../MySTL/fft.h"
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cassert>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+template <typename T>
+void naive_dft(const vector<complex<T>>& in, vector<complex<T>>& out) {
+    const size_t n = in.size();
+    const double pi = 3.14159265358979323846;
+    out.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        double re = 0, im = 0;
+        for (size_t j = 0; j < n; ++j) {
+            const double theta = -2.0 * pi * static_cast<double>((j * k) % n) / n;
+            re += in[j].real() * std::cos(theta) - in[j].imag() * std::sin(theta);
+            im += in[j].real() * std::sin(theta) + in[j].imag() * std::cos(theta);
+        }
+        out[k] = complex<T>(static_cast<T>(re), static_cast<T>(im));
+    }
+}
+
+template <typename T>
+double max_error(const vector<complex<T>>& a, const vector<complex<T>>& b, size_t n) {
+    double err = 0;
+    for (size_t i = 0; i < n; ++i)
+        err = MYSTL::max(err, static_cast<double>(abs(a[i] - b[i])));
+    return err;
+}
+
+template <typename F>
+double time_ms(F f, int reps) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < reps; ++i)
+        f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count() / reps;
+}
+
+template <typename T>
+void bench(size_t n, const char* name) {
+    vector<complex<T>> input(n), expect, got;
+    for (size_t i = 0; i < n; ++i)
+        input[i] = complex<T>(static_cast<T>(std::rand() % 1000) / 500 - 1,
+                              static_cast<T>(std::rand() % 1000) / 500 - 1);
+
+    fft_plan<T> plan(n);
+    const int reps = n <= 4096 ? 200 : 20;
+    const double fft_ms = time_ms([&] { got = input; plan.execute(got); }, reps);
+
+    // the naive dft is O(n^2), only time it on sizes where that finishes quickly
+    double dft_ms = -1;
+    double err = 0;
+    if (n <= 4096) {
+        dft_ms = time_ms([&] { naive_dft(input, expect); }, 1);
+        got = input;
+        plan.execute(got);
+        err = max_error(got, expect, n);
+    }
+
+    // round trip through the inverse plan
+    fft_plan<T> inverse(n, true);
+    vector<complex<T>> back = got;
+    inverse.execute(back);
+    for (size_t i = 0; i < n; ++i)
+        back[i] /= static_cast<T>(n);
+
+    const double round_trip_err = max_error(back, input, n);
+    cout << name << " n = " << n
+         << "  fft " << fft_ms << " ms"
+         << "  dft " << dft_ms << " ms"
+         << "  max err " << err
+         << "  round trip err " << round_trip_err << endl;
+    // inputs are in [-1, 1], so outputs grow like sqrt(n)
+    const double eps = sizeof(T) == sizeof(float) ? 1e-5 : 1e-13;
+    assert(err <= eps * n && round_trip_err <= eps * std::log2(static_cast<double>(n) + 1) * 10);
+}
+
+template <typename T>
+void bench_real(size_t n) {
+    vector<T> input(n);
+    vector<complex<T>> cinput(n), expect, got;
+    for (size_t i = 0; i < n; ++i) {
+        input[i] = static_cast<T>(std::rand() % 1000) / 500 - 1;
+        cinput[i] = complex<T>(input[i]);
+    }
+    rfft_plan<T> plan(n);
+    plan.execute(input, got);
+    naive_dft(cinput, expect);
+    const double err = max_error(got, expect, plan.output_size());
+    cout << "rfft n = " << n << "  max err " << err << endl;
+    assert(err <= (sizeof(T) == sizeof(float) ? 1e-5 : 1e-13) * n);
+}
+
+int main() {
+    const size_t sizes[] = {8, 64, 1000, 1024, 4096, 4095, 4099, 1 << 16, 65537, 1 << 20};
+    for (auto n : sizes)
+        bench<double>(n, "double");
+    for (auto n : sizes)
+        bench<float>(n, "float ");
+
+    bench_real<double>(1024);
+    bench_real<double>(1000);
+    bench_real<float>(999);
+
+    return 0;
+}
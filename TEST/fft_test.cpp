@@ -0,0 +1,175 @@
+#include "../MySTL/fft.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+template <typename T>
+vector<complex<T>> naive_dft(const vector<complex<T>>& in, bool inverse = false) {
+    const size_t n = in.size();
+    const double pi = 3.14159265358979323846;
+    vector<complex<T>> out(n);
+    for (size_t k = 0; k < n; ++k) {
+        double re = 0, im = 0;
+        for (size_t j = 0; j < n; ++j) {
+            const double theta = (inverse ? 2.0 : -2.0) * pi * static_cast<double>((j * k) % n) / n;
+            re += in[j].real() * std::cos(theta) - in[j].imag() * std::sin(theta);
+            im += in[j].real() * std::sin(theta) + in[j].imag() * std::cos(theta);
+        }
+        out[k] = complex<T>(static_cast<T>(re), static_cast<T>(im));
+    }
+    return out;
+}
+
+template <typename T>
+vector<complex<T>> random_input(size_t n) {
+    vector<complex<T>> v(n);
+    for (size_t i = 0; i < n; ++i)
+        v[i] = complex<T>(static_cast<T>(std::rand() % 2000) / 1000 - 1,
+                          static_cast<T>(std::rand() % 2000) / 1000 - 1);
+    return v;
+}
+
+// largest error relative to the largest magnitude of expect
+template <typename T>
+double rel_error(const vector<complex<T>>& got, const vector<complex<T>>& expect, size_t n) {
+    double err = 0, scale = 1e-300;
+    for (size_t i = 0; i < n; ++i) {
+        err = MYSTL::max(err, static_cast<double>(abs(got[i] - expect[i])));
+        scale = MYSTL::max(scale, static_cast<double>(abs(expect[i])));
+    }
+    return err / scale;
+}
+
+template <typename T>
+void check(size_t n, double eps) {
+    const vector<complex<T>> x = random_input<T>(n);
+
+    fft_plan<T> forward(n);
+    vector<complex<T>> got = x;
+    forward.execute(got);
+    assert(rel_error(got, naive_dft(x), n) < eps);
+
+    fft_plan<T> inverse(n, true);
+    vector<complex<T>> back = got;
+    inverse.execute(back);
+    assert(rel_error(back, naive_dft(got, true), n) < eps);
+    for (size_t i = 0; i < n; ++i)
+        back[i] /= static_cast<T>(n);
+    assert(rel_error(back, x, n) < eps);
+
+    // a plan runs again on new data, and a copy of it runs the same way
+    fft_plan<T> copy = forward;
+    vector<complex<T>> again = x;
+    copy.execute(again);
+    assert(rel_error(again, got, n) < eps);
+}
+
+// above the radix-2 cache block a full naive dft is too slow: check a sample of bins
+// against it, and the whole inverse round trip
+template <typename T>
+void check_sampled(size_t n, double eps) {
+    const vector<complex<T>> x = random_input<T>(n);
+    fft_plan<T> forward(n);
+    vector<complex<T>> got = x;
+    forward.execute(got);
+
+    const double pi = 3.14159265358979323846;
+    double err = 0, scale = 1e-300;
+    for (size_t s = 0; s < 32; ++s) {
+        const size_t k = s == 0 ? 0 : static_cast<size_t>(std::rand()) % n;
+        double re = 0, im = 0;
+        for (size_t j = 0; j < n; ++j) {
+            const double theta = -2.0 * pi * static_cast<double>((j * k) % n) / n;
+            re += x[j].real() * std::cos(theta) - x[j].imag() * std::sin(theta);
+            im += x[j].real() * std::sin(theta) + x[j].imag() * std::cos(theta);
+        }
+        err = MYSTL::max(err, std::hypot(got[k].real() - re, got[k].imag() - im));
+        scale = MYSTL::max(scale, std::hypot(re, im));
+    }
+    assert(err / scale < eps);
+
+    fft_plan<T> inverse(n, true);
+    inverse.execute(got);
+    for (size_t i = 0; i < n; ++i)
+        got[i] /= static_cast<T>(n);
+    assert(rel_error(got, x, n) < eps);
+}
+
+int main() {
+
+    /*********************against a naive dft*****************************/
+    {
+        // power of two, up to one cache block (2048 complex<double>, 4096 complex<float>)
+        for (size_t n : {1, 2, 4, 8, 16, 256, 2048})
+            check<double>(n, 1e-12);
+        // past the block: the blocked stages, then the stages across blocks
+        for (size_t n : {8192, 65536}) {
+            check_sampled<double>(n, 1e-12);
+            check_sampled<float>(n, 1e-4);
+        }
+        // mixed radix 4, 2, 3, 5 and small primes
+        for (size_t n : {3, 5, 6, 7, 12, 15, 30, 49, 100, 360, 1000, 2 * 3 * 5 * 7 * 11})
+            check<double>(n, 1e-12);
+        // primes from bluestein_min_prime on, alone and as a factor
+        for (size_t n : {61, 67, 97, 101, 2 * 101, 3 * 127, 1009, 2053})
+            check<double>(n, 1e-11);
+        for (size_t n : {64, 100, 97, 1009})
+            check<float>(n, 1e-4);
+    }
+
+    /*********************helpers and size checks*****************************/
+    {
+        vector<complex<double>> x = random_input<double>(97), y = x;
+        fft(y);
+        assert(rel_error(y, naive_dft(x), 97) < 1e-11);
+        ifft(y);
+        for (auto& v : y)
+            v /= 97.0;
+        assert(rel_error(y, x, 97) < 1e-11);
+
+        fft_plan<double> plan(16);
+        vector<complex<double>> wrong(15);
+        try {
+            plan.execute(wrong);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {}
+        assert(wrong.size() == 15);
+
+        rfft_plan<double> rplan(16);
+        vector<double> short_in(8);
+        vector<complex<double>> rout;
+        try {
+            rplan.execute(short_in, rout);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {}
+        assert(rout.empty());
+    }
+
+    /*********************real input*****************************/
+    for (size_t n : {8, 1000, 999, 202}) {
+        vector<double> in(n);
+        vector<complex<double>> cin(n);
+        for (size_t i = 0; i < n; ++i) {
+            in[i] = static_cast<double>(std::rand() % 2000) / 1000 - 1;
+            cin[i] = complex<double>(in[i]);
+        }
+        rfft_plan<double> plan(n);
+        vector<complex<double>> out;
+        plan.execute(in, out);
+        assert(out.size() == n / 2 + 1);
+        assert(rel_error(out, naive_dft(cin), out.size()) < 1e-11);
+    }
+
+    cout << "fft test passed" << endl;
+    return 0;
+}
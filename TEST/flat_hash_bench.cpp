@@ -0,0 +1,90 @@
+#include "../MySTL/flat_hash_map.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+template <typename F>
+double time_ms(F f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+static uint64_t next_random(uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// n inserts, then `ops` operations where find_pct percent are finds (half of them misses)
+// and the rest alternate erase / insert so the size stays around n
+template <typename Map>
+double mix(size_t n, size_t ops, unsigned find_pct, uint64_t& checksum) {
+    vector<uint64_t> keys(n);
+    uint64_t state = 88172645463325252ull;
+    for (size_t i = 0; i < n; ++i)
+        keys[i] = next_random(state);
+
+    Map m;
+    return time_ms([&] {
+        for (size_t i = 0; i < n; ++i)
+            m[keys[i]] = i;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < ops; ++i) {
+            const uint64_t r = next_random(state);
+            const size_t k = r % n;
+            if (r % 100 < find_pct) {
+                auto it = m.find((r & 1024) ? keys[k] : r);
+                if (it != m.end())
+                    sum += it->second;
+            }
+            else if (r & 1) {
+                m.erase(keys[k]);
+            }
+            else {
+                m[keys[k]] = i;
+            }
+        }
+        checksum += sum + m.size();
+    });
+}
+
+template <typename Map>
+double insert_only(size_t n, uint64_t& checksum) {
+    uint64_t state = 2463534242ull;
+    return time_ms([&] {
+        Map m;
+        for (size_t i = 0; i < n; ++i)
+            m[next_random(state)] = i;
+        checksum += m.size();
+    });
+}
+
+int main() {
+    using flat = flat_hash_map<uint64_t, uint64_t>;
+    using chained = std::unordered_map<uint64_t, uint64_t>;
+    uint64_t checksum = 0;
+
+    const size_t sizes[] = {1000, 100000, 1000000};
+    for (auto n : sizes) {
+        const size_t ops = 4000000;
+        cout << "n = " << n << endl;
+        cout << "  insert only      flat " << insert_only<flat>(n, checksum)
+             << " ms  chained " << insert_only<chained>(n, checksum) << " ms" << endl;
+        const unsigned find_pcts[] = {100, 90, 50};
+        for (auto pct : find_pcts)
+            cout << "  " << pct << "% find mix    flat " << mix<flat>(n, ops, pct, checksum)
+                 << " ms  chained " << mix<chained>(n, ops, pct, checksum) << " ms" << endl;
+    }
+    cout << "checksum " << checksum << endl;
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include "../MySTL/flat_hash_map.h"
+#include "../MySTL/flat_hash_set.h"
+#include "../MySTL/memory.h"
+#include "../MySTL/tracking_allocator.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+// looks strings up by const char* without building a std::string
+struct string_hash {
+    using is_transparent = void;
+    size_t operator()(const std::string& s) const { return std::hash<std::string>()(s); }
+    size_t operator()(const char* s) const { return std::hash<std::string>()(std::string(s)); }
+};
+struct string_eq {
+    using is_transparent = void;
+    bool operator()(const std::string& a, const std::string& b) const { return a == b; }
+    bool operator()(const std::string& a, const char* b) const { return a == b; }
+};
+
+// counts live objects; copying throws once copies_left runs out
+struct fragile {
+    static int live;
+    static int copies_left;
+    int value;
+
+    explicit fragile(int v) : value(v) { ++live; }
+    fragile(const fragile& rhs) : value(rhs.value) {
+        if (copies_left-- == 0)
+            throw std::runtime_error("fragile copy");
+        ++live;
+    }
+    fragile(fragile&& rhs) noexcept : value(rhs.value) { ++live; }
+    ~fragile() { --live; }
+
+    bool operator==(const fragile& rhs) const { return value == rhs.value; }
+};
+int fragile::live = 0;
+int fragile::copies_left = -1;
+
+struct fragile_hash {
+    size_t operator()(const fragile& f) const { return MYSTL::hash<int>()(f.value); }
+};
+
+int main() {
+
+    /*********************against std::unordered_map*****************************/
+    {
+        flat_hash_map<int, int> m;
+        std::unordered_map<int, int> ref;
+        std::srand(7);
+        for (int i = 0; i < 200000; ++i) {
+            const int key = std::rand() % 5000;
+            switch (std::rand() % 4) {
+            case 0:
+            case 1:
+                m[key] = i;
+                ref[key] = i;
+                break;
+            case 2:
+                assert(m.erase(key) == ref.erase(key));
+                break;
+            default: {
+                auto it = m.find(key);
+                auto rit = ref.find(key);
+                assert((it == m.end()) == (rit == ref.end()));
+                if (it != m.end())
+                    assert(it->second == rit->second);
+            }
+            }
+            assert(m.size() == ref.size());
+        }
+        size_t visited = 0;
+        for (auto& kv : m) {
+            assert(ref.at(kv.first) == kv.second);
+            ++visited;
+        }
+        assert(visited == ref.size());
+
+        flat_hash_map<int, int> copy(m);
+        assert(copy == m);
+        copy.erase(copy.begin());
+        assert(copy != m);
+        flat_hash_map<int, int> moved(MYSTL::move(copy));
+        assert(copy.empty() && moved.size() + 1 == m.size());
+
+        m.clear();
+        assert(m.empty() && m.begin() == m.end() && m.capacity() > 0);
+    }
+
+    /*********************reserve / erase*****************************/
+    {
+        flat_hash_set<int> s;
+        assert(s.begin() == s.end() && !s.contains(1));
+        s.reserve(1000);
+        const size_t cap = s.capacity();
+        for (int i = 0; i < 1000; ++i)
+            assert(s.insert(i).second);
+        assert(s.capacity() == cap && !s.insert(5).second);
+
+        // a sparse table erases without tombstones, the growth budget comes back
+        flat_hash_set<int> sparse(1024);
+        const size_t sparse_cap = sparse.capacity();
+        for (int round = 0; round < 100000; ++round) {
+            sparse.insert(round);
+            sparse.erase(round);
+        }
+        assert(sparse.capacity() == sparse_cap && sparse.empty());
+
+        // churn through a full table, tombstones get cleaned by same-size rehashes
+        flat_hash_set<int> churn;
+        for (int i = 0; i < 100; ++i)
+            churn.insert(i);
+        const size_t churn_cap = churn.capacity();
+        for (int i = 100; i < 100000; ++i) {
+            churn.erase(i - 100);
+            churn.insert(i);
+        }
+        assert(churn.size() == 100 && churn.capacity() == churn_cap);
+        for (int i = 99900; i < 100000; ++i)
+            assert(churn.contains(i));
+    }
+
+    /*********************strings and heterogeneous lookup*****************************/
+    {
+        flat_hash_map<std::string, int, string_hash, string_eq> m = {{"one", 1}, {"two", 2}};
+        m.emplace("three", 3);
+        m.try_emplace("four", 4);
+        assert(!m.try_emplace("one", 100).second && m.at("one") == 1);
+        m.insert_or_assign("one", 11);
+        assert(m["one"] == 11 && m.count("five") == 0);
+        assert(m.find("three")->second == 3 && m.erase("two") == 1);
+
+        char buf[8];
+        std::strcpy(buf, "four");
+        assert(m.contains(static_cast<const char*>(buf)));
+
+        bool thrown = false;
+        try {
+            m.at("missing");
+        }
+        catch(const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        for (int i = 0; i < 1000; ++i)
+            m[std::to_string(i) + "-long-enough-to-skip-sso"] = i;
+        assert(m.at("999-long-enough-to-skip-sso") == 999);
+
+        flat_hash_map<int, unique_ptr<int>> owners;
+        owners.try_emplace(1, new int(1));
+        owners[2] = make_unique<int>(2);
+        for (int i = 3; i < 100; ++i)
+            owners.emplace(i, make_unique<int>(i));
+        assert(*owners.at(50) == 50);
+    }
+
+    /*********************throwing copy*****************************/
+    {
+        {
+            flat_hash_set<fragile, fragile_hash> s;
+            for (int i = 0; i < 100; ++i)
+                s.emplace(i);
+            fragile::copies_left = 50;
+            try {
+                flat_hash_set<fragile, fragile_hash> copy(s);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {}
+            fragile::copies_left = -1;
+            assert(fragile::live == 100);
+        }
+        assert(fragile::live == 0);
+    }
+
+    /*********************allocator*****************************/
+    {
+        using tracked = tracking_allocator<allocator<pair<const int, int>>>;
+        {
+            flat_hash_map<int, int, hash<int>, std::equal_to<int>, tracked> m(tracked("flat_hash_map"));
+            for (int i = 0; i < 1000; ++i)
+                m[i] = i;
+            auto copy = m;
+            auto moved = MYSTL::move(m);
+            assert(copy.size() == 1000 && moved.size() == 1000);
+            assert(copy.get_allocator() == tracked("flat_hash_map"));
+            flat_hash_set<int, hash<int>, std::equal_to<int>, tracking_allocator<allocator<int>>>
+                s({1, 2, 3}, tracking_allocator<allocator<int>>("flat_hash_map"));
+            assert(s.size() == 3);
+        }
+        const tracking_stats st = tracking_stats_of("flat_hash_map");
+        assert(st.allocations > 0 && st.allocations == st.deallocations && st.live_bytes == 0);
+    }
+
+    cout << "flat_hash test passed" << endl;
+    return 0;
+}
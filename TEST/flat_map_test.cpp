@@ -0,0 +1,164 @@
+#include "../MySTL/flat_map.h"
+#include "../MySTL/flat_set.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+template <typename K, typename V>
+bool same(const flat_map<K, V>& a, const std::map<K, V>& b) {
+    if (a.size() != b.size())  return false;
+    auto it = b.begin();
+    for (auto kv : a) {
+        if (kv.first != it->first || kv.second != it->second)  return false;
+        ++it;
+    }
+    return true;
+}
+
+template <typename K>
+bool same(const flat_set<K>& a, const std::set<K>& b) {
+    return a.size() == b.size() && MYSTL::equal(a.begin(), a.end(), b.begin());
+}
+
+int main() {
+
+    /*********************algorithms*****************************/
+    {
+        MYSTL::vector<int> v(5000);
+        for (auto& x : v)
+            x = rand() % 1000;
+        MYSTL::sort(v.begin(), v.end());
+        assert(MYSTL::is_sorted(v.begin(), v.end()));
+        for (int key = -1; key <= 1000; ++key) {
+            auto lo = MYSTL::lower_bound(v.begin(), v.end(), key);
+            auto hi = MYSTL::upper_bound(v.begin(), v.end(), key);
+            assert(lo == std::lower_bound(v.begin(), v.end(), key));
+            assert(hi == std::upper_bound(v.begin(), v.end(), key));
+            assert(MYSTL::binary_search(v.begin(), v.end(), key) == (lo != hi));
+        }
+        // already sorted, reversed and all equal inputs
+        MYSTL::vector<int> r(3000);
+        for (int i = 0; i < 3000; ++i)
+            r[i] = 3000 - i;
+        MYSTL::sort(r.begin(), r.end());
+        assert(MYSTL::is_sorted(r.begin(), r.end()) && r.front() == 1);
+        MYSTL::vector<int> e(3000, 7);
+        MYSTL::sort(e.begin(), e.end(), [](int a, int b) { return a > b; });
+        v.erase(MYSTL::unique(v.begin(), v.end()), v.end());
+        assert(MYSTL::is_sorted(v.begin(), v.end(), [](int a, int b) { return a <= b; }));
+    }
+
+    /*********************flat_map*****************************/
+    flat_map<std::string, int> fm{{"b", 2}, {"a", 1}, {"c", 3}, {"a", 9}};
+    assert(fm.size() == 3 && fm.at("a") == 1);
+    for (auto kv : fm)
+        cout << kv.first << ":" << kv.second << " ";
+    cout << endl;
+    fm["d"] = 4;
+    fm.begin()->second = 10;
+    assert(fm["a"] == 10 && fm.keys().back() == "d");
+    assert(!fm.try_emplace("b", 100).second && fm["b"] == 2);
+    assert(!fm.insert_or_assign("b", 20).second && fm["b"] == 20);
+    assert(fm.erase("c") == 1 && fm.erase("c") == 0 && !fm.contains("c"));
+    try {
+        fm.at("zz");
+        assert(false);
+    }
+    catch (const std::out_of_range&) {}
+
+    // random operations checked against std::map
+    {
+        flat_map<int, int> m;
+        std::map<int, int> ref;
+        for (int i = 0; i < 20000; ++i) {
+            const int key = rand() % 2000;
+            switch (rand() % 5) {
+            case 0:
+                m[key] = i;
+                ref[key] = i;
+                break;
+            case 1:
+                assert(m.insert(make_pair(key, i)).second == ref.insert(std::make_pair(key, i)).second);
+                break;
+            case 2:
+                assert(m.erase(key) == ref.erase(key));
+                break;
+            case 3: {
+                auto it = m.lower_bound(key);
+                auto rit = ref.lower_bound(key);
+                assert((it == m.end()) == (rit == ref.end()));
+                if (it != m.end())
+                    assert(it->first == rit->first && (*it).second == rit->second);
+                break;
+            }
+            default: {
+                // bulk insert of a short unsorted run with duplicates
+                std::vector<std::pair<int, int>> batch;
+                for (int j = 0; j < 20; ++j)
+                    batch.push_back(std::make_pair(rand() % 2000, i + j));
+                m.insert(batch.begin(), batch.end());
+                ref.insert(batch.begin(), batch.end());
+                break;
+            }
+            }
+        }
+        assert(same(m, ref));
+        auto range = m.equal_range(ref.begin()->first);
+        assert(range.second - range.first == 1);
+    }
+
+    // bulk insert keeps existing values and the first of several duplicates
+    {
+        flat_map<int, int> m{{5, 50}, {1, 10}};
+        std::vector<pair<int, int>> batch;
+        for (int i = 100; i > 0; --i)
+            batch.push_back(make_pair(i % 10, i));
+        m.insert(batch.begin(), batch.end());
+        assert(m.size() == 10 && m[5] == 50 && m[1] == 10 && m[0] == 100 && m[9] == 99);
+        // sorted appends take the fast path
+        std::vector<pair<int, int>> tail{{20, 1}, {21, 2}, {22, 3}};
+        m.insert(tail.begin(), tail.end());
+        assert(m.size() == 13 && m.keys().back() == 22 && m.values().back() == 3);
+        assert(MYSTL::is_sorted(m.keys().begin(), m.keys().end()));
+    }
+
+    /*********************flat_set*****************************/
+    {
+        flat_set<int> s;
+        std::set<int> ref;
+        for (int i = 0; i < 10000; ++i) {
+            const int key = rand() % 1000;
+            if (rand() % 3 == 0) {
+                assert(s.erase(key) == ref.erase(key));
+            }
+            else if (rand() % 2) {
+                assert(s.insert(key).second == ref.insert(key).second);
+            }
+            else {
+                std::vector<int> batch;
+                for (int j = 0; j < 10; ++j)
+                    batch.push_back(rand() % 1000);
+                s.insert(batch.begin(), batch.end());
+                ref.insert(batch.begin(), batch.end());
+            }
+        }
+        assert(same(s, ref));
+        assert(s.count(*ref.begin()) == 1 && s.find(-1) == s.end());
+
+        flat_set<std::string> words{"pear", "apple", "fig", "apple"};
+        assert(words.size() == 3 && *words.begin() == "apple");
+    }
+
+    cout << "flat_map test passed" << endl;
+    return 0;
+}
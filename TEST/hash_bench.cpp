@@ -0,0 +1,61 @@
+#include "../MySTL/hash.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <chrono>
+#include <functional>
+#include <string>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+template <typename F>
+double time_s(F f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+// hashes keys of `len` bytes until about 256 MiB went through, the key start moves every
+// call so short keys are not served from one cache line
+void bytes(size_t len) {
+    vector<char> buf(len + 4096);
+    for (size_t i = 0; i < buf.size(); ++i)
+        buf[i] = static_cast<char>(i * 131);
+    const size_t calls = MYSTL::max<size_t>((256u << 20) / len, 1000);
+
+    uint64_t sink = 0;
+    const double mine = time_s([&] {
+        for (size_t i = 0; i < calls; ++i)
+            sink += hash_bytes(buf.data() + (i & 4095), len);
+    });
+    // libstdc++'s std::hash<string> runs murmur2 over the bytes
+    const double std_hash = time_s([&] {
+        for (size_t i = 0; i < calls; ++i)
+            sink += std::_Hash_bytes(buf.data() + (i & 4095), len, 0xc70f6907u);
+    });
+
+    const double total = static_cast<double>(calls) * len;
+    cout << "len " << len
+         << "  hash_bytes " << total / mine / 1e9 << " GB/s (" << mine / calls * 1e9 << " ns/key)"
+         << "  std::hash " << total / std_hash / 1e9 << " GB/s (" << std_hash / calls * 1e9 << " ns/key)"
+         << (sink == 42 ? " " : "") << endl;
+}
+
+int main() {
+    const size_t lens[] = {3, 8, 16, 24, 32, 64, 256, 4096, 1 << 20};
+    for (auto len : lens)
+        bytes(len);
+
+    const size_t n = 100000000;
+    uint64_t sink = 0;
+    const double t = time_s([&] {
+        hash<uint64_t> h;
+        for (size_t i = 0; i < n; ++i)
+            sink += h(i);
+    });
+    cout << "hash<uint64_t> " << t / n * 1e9 << " ns/key" << (sink == 42 ? " " : "") << endl;
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "../MySTL/hash.h"
+#include "../MySTL/flat_hash_map.h"
+#include "../MySTL/flat_hash_set.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+static int popcount(uint64_t x) { return __builtin_popcountll(x); }
+
+enum class color { red, green };
+
+int main() {
+
+    /*********************integers*****************************/
+    {
+        hash<uint64_t> h;
+        assert(h(42) == h(42) && h(0) != h(1));
+        // flipping one input bit flips about half of the output bits
+        long total = 0;
+        for (uint64_t i = 1; i <= 1000; ++i)
+            for (int bit = 0; bit < 64; ++bit)
+                total += popcount(h(i) ^ h(i ^ (1ull << bit)));
+        const double avg = static_cast<double>(total) / (1000 * 64);
+        assert(avg > 30 && avg < 34);
+
+        assert(hash<color>()(color::red) != hash<color>()(color::green));
+        assert(hash<double>()(0.0) == hash<double>()(-0.0) && hash<double>()(1.5) != hash<double>()(2.5));
+        int a = 0, b = 0;
+        assert(hash<int*>()(&a) != hash<int*>()(&b));
+    }
+
+    /*********************bytes*****************************/
+    {
+        // every length takes a different path through the short / medium / long cases
+        char buf[300];
+        for (int i = 0; i < 300; ++i)
+            buf[i] = static_cast<char>(i * 7);
+        flat_hash_set<uint64_t> seen;
+        for (size_t len = 0; len <= 300; ++len)
+            assert(seen.insert(hash_bytes(buf, len)).second);
+        // a change in any byte changes the hash
+        for (size_t pos = 0; pos < 300; ++pos) {
+            const uint64_t before = hash_bytes(buf, 300);
+            buf[pos] ^= 1;
+            assert(hash_bytes(buf, 300) != before);
+            buf[pos] ^= 1;
+        }
+        assert(hash_bytes(buf, 10, 1) != hash_bytes(buf, 10, 2));
+
+        std::string s = "hello world";
+        assert(hash<std::string>()(s) == hash_bytes(s.data(), s.size()));
+    }
+
+    /*********************pair and hash_combine*****************************/
+    {
+        hash<pair<int, int>> h;
+        assert(h(make_pair(1, 2)) != h(make_pair(2, 1)));
+        size_t seed1 = 0, seed2 = 0;
+        hash_combine(seed1, std::string("a"));
+        hash_combine(seed1, 1);
+        hash_combine(seed2, 1);
+        hash_combine(seed2, std::string("a"));
+        assert(seed1 != seed2);
+
+        flat_hash_map<pair<int, int>, int> grid;
+        for (int x = 0; x < 100; ++x)
+            for (int y = 0; y < 100; ++y)
+                grid[make_pair(x, y)] = x * 100 + y;
+        assert(grid.size() == 10000 && grid.at(make_pair(42, 17)) == 4217);
+    }
+
+    cout << "hash test passed" << endl;
+    return 0;
+}
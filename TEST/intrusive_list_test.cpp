@@ -0,0 +1,71 @@
+#include "../MySTL/intrusive_list.h"
+#include <iostream>
+#include <cassert>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+struct ready_tag {};
+struct all_tag {};
+
+// one object, linked into two lists at once
+struct Task : public list_hook<ready_tag>, public list_hook<all_tag> {
+    int id;
+    explicit Task(int i) : id(i) {}
+};
+
+int main() {
+
+    Task tasks[5] = {Task(0), Task(1), Task(2), Task(3), Task(4)};
+    intrusive_list<Task, list_hook<all_tag>> all;
+    intrusive_list<Task, list_hook<ready_tag>> ready;
+
+    for (auto& t : tasks)
+        all.push_back(t);
+    ready.push_back(tasks[3]);
+    ready.push_front(tasks[1]);
+    assert(all.size() == 5 && ready.size() == 2);
+    assert(ready.front().id == 1 && ready.back().id == 3);
+
+    all.remove(tasks[2]);
+    assert(all.size() == 4 && !static_cast<list_hook<all_tag>&>(tasks[2]).is_linked());
+    for (auto& t : all)
+        cout << t.id << " ";
+    cout << endl;
+
+    intrusive_list<Task, list_hook<all_tag>> moved(MYSTL::move(all));
+    assert(all.empty() && moved.size() == 4);
+
+    intrusive_list<Task, list_hook<all_tag>> other;
+    other.splice(other.end(), moved, moved.iterator_to(tasks[4]));
+    assert(other.size() == 1 && moved.size() == 3 && other.front().id == 4);
+
+    moved.remove_if([](const Task& t) { return t.id % 2 == 1; });
+    assert(moved.size() == 1 && moved.front().id == 0);
+
+    // a range moved within one list
+    moved.clear();
+    other.clear();
+    intrusive_list<Task, list_hook<all_tag>> order;
+    for (auto& t : tasks)
+        order.push_back(t);
+    auto first = order.iterator_to(tasks[1]);
+    auto last = order.iterator_to(tasks[3]);
+    order.splice(order.end(), order, first, last);
+    assert(order.size() == 5);
+    int expect[] = {0, 3, 4, 1, 2};
+    int i = 0;
+    for (auto& t : order)
+        assert(t.id == expect[i++]);
+    order.splice(order.begin(), order, order.iterator_to(tasks[1]), order.end());
+    assert(order.size() == 5 && order.front().id == 1 && order.back().id == 4);
+    order.clear();
+
+    ready.clear();
+    assert(ready.empty() && !static_cast<list_hook<ready_tag>&>(tasks[1]).is_linked());
+
+    cout << "intrusive_list test passed" << endl;
+    return 0;
+}
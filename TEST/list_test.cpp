@@ -2,6 +2,7 @@
 #include <iostream>
 #include <initializer_list>
 #include <utility>
+#include <cassert>
 
 
 using namespace MYSTL;
@@ -32,5 +33,27 @@ int main() {
     for(auto i:b)
         cout << i << endl;
 
+    /*********************splice*****************************/
+    {
+        list<int> l{0, 1, 2, 3, 4, 5};
+        auto first = l.begin();
+        ++first;
+        auto last = first;
+        ++last;
+        ++last;
+        // [1, 3) to the back of the same list
+        l.splice(l.end(), l, first, last);
+        assert(l.size() == 6);
+        int expect[] = {0, 3, 4, 5, 1, 2};
+        int i = 0;
+        for (auto v : l)
+            assert(v == expect[i++]);
+
+        list<int> other{7, 8};
+        l.splice(l.begin(), other, other.begin(), other.end());
+        assert(l.size() == 8 && other.empty() && l.front() == 7);
+    }
+
+    cout << "list test passed" << endl;
     return 0;
 }
@@ -0,0 +1,57 @@
+#include "../MySTL/map.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+
+
+using std::cout;
+using std::endl;
+
+template <typename F>
+double time_ms(F f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// random inserts and lookups, sorted inserts with an end() hint, and erase / insert churn
+// that the node cache serves without operator new
+template <typename Map>
+void run(const char* name, const MYSTL::vector<int>& keys) {
+    Map m;
+    const double insert = time_ms([&] {
+        for (auto k : keys)
+            m.insert(typename Map::value_type(k, k));
+    });
+    long sink = 0;
+    const double find = time_ms([&] {
+        for (auto k : keys)
+            sink += m.find(k)->second;
+    });
+    const double churn = time_ms([&] {
+        for (auto k : keys) {
+            m.erase(k);
+            m.insert(typename Map::value_type(k, k));
+        }
+    });
+    Map sorted;
+    const double hinted = time_ms([&] {
+        for (int i = 0; i < static_cast<int>(keys.size()); ++i)
+            sorted.insert(sorted.end(), typename Map::value_type(i, i));
+    });
+    cout << name << "  insert " << insert << " ms  find " << find << " ms  erase+insert " << churn
+         << " ms  sorted hinted insert " << hinted << " ms" << (sink == 42 ? " " : "") << endl;
+}
+
+int main() {
+    const int n = 1000000;
+    MYSTL::vector<int> keys(n);
+    for (int i = 0; i < n; ++i)
+        keys[i] = rand();
+    run<MYSTL::map<int, int>>("MYSTL::map", keys);
+    run<std::map<int, int>>("std::map  ", keys);
+    return 0;
+}
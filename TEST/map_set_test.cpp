@@ -0,0 +1,208 @@
+#include "../MySTL/map.h"
+#include "../MySTL/set.h"
+#include "../MySTL/tracking_allocator.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <map>
+#include <set>
+#include <string>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+template <typename M, typename R>
+bool same(const M& a, const R& b) {
+    if (a.size() != b.size())  return false;
+    auto it = b.begin();
+    for (const auto& kv : a) {
+        if (kv.first != it->first || kv.second != it->second)  return false;
+        ++it;
+    }
+    return true;
+}
+
+template <typename S, typename R>
+bool same_keys(const S& a, const R& b) {
+    return a.size() == b.size() && MYSTL::equal(a.begin(), a.end(), b.begin());
+}
+
+int main() {
+
+    map<std::string, int> m{{"one", 1}, {"two", 2}, {"three", 3}};
+    m["four"] = 4;
+    for (const auto& kv : m)
+        cout << kv.first << ":" << kv.second << " ";
+    cout << endl;
+    assert(m.size() == 4 && m.at("two") == 2 && m.begin()->first == "four");
+    assert(!m.try_emplace("one", 100).second && m["one"] == 1);
+    assert(!m.insert_or_assign("one", 11).second && m["one"] == 11);
+    assert((--m.end())->first == "two" && m.rbegin()->first == "two");
+    try {
+        m.at("five");
+        assert(false);
+    }
+    catch (const std::out_of_range&) {}
+
+    // random operations checked against std::map, with the tree invariants after each round
+    {
+        map<int, int> mm;
+        std::map<int, int> ref;
+        for (int round = 0; round < 20; ++round) {
+            for (int i = 0; i < 2000; ++i) {
+                const int key = rand() % 1000;
+                switch (rand() % 4) {
+                case 0:
+                    mm[key] = i;
+                    ref[key] = i;
+                    break;
+                case 1:
+                    assert(mm.insert(make_pair(key, i)).second == ref.insert(std::make_pair(key, i)).second);
+                    break;
+                case 2:
+                    assert(mm.erase(key) == ref.erase(key));
+                    break;
+                default: {
+                    auto it = mm.lower_bound(key);
+                    auto rit = ref.lower_bound(key);
+                    assert((it == mm.end()) == (rit == ref.end()));
+                    if (it != mm.end())
+                        assert(it->first == rit->first);
+                }
+                }
+            }
+            assert(mm.__verify() && same(mm, ref));
+        }
+
+        map<int, int> copy(mm);
+        assert(copy == mm && copy.__verify());
+        copy.erase(copy.begin(), copy.find(500));
+        assert(copy.begin()->first >= 500 && copy.__verify() && copy != mm);
+        map<int, int> moved(MYSTL::move(copy));
+        assert(copy.empty() && moved.__verify());
+        moved.swap(mm);
+        assert(same(moved, ref) && moved.__verify() && mm.__verify());
+        mm = moved;
+        assert(mm == moved);
+    }
+
+    // hinted inserts at the right spot, ascending and descending
+    {
+        set<int> s;
+        for (int i = 0; i < 10000; ++i)
+            s.insert(s.end(), i);
+        set<int> d;
+        for (int i = 10000; i > 0; --i)
+            d.insert(d.begin(), i);
+        assert(s.size() == 10000 && d.size() == 10000 && s.__verify() && d.__verify());
+        // a wrong hint still works
+        s.insert(s.begin(), 20000);
+        s.insert(s.find(5000), 5000);
+        assert(s.size() == 10001 && *s.rbegin() == 20000 && s.__verify());
+
+        multimap<int, int> mm;
+        for (int i = 0; i < 1000; ++i)
+            mm.insert(mm.end(), make_pair(i / 10, i));
+        assert(mm.count(42) == 10 && mm.__verify());
+        // equal keys keep their insertion order
+        auto range = mm.equal_range(42);
+        int expect = 420;
+        for (auto it = range.first; it != range.second; ++it)
+            assert(it->second == expect++);
+        assert(mm.erase(42) == 10 && mm.size() == 990 && mm.__verify());
+    }
+
+    // extract and insert(node_type) move nodes without new allocations
+    {
+        map<int, std::string> a{{1, "a"}, {2, "b"}, {3, "c"}};
+        map<int, std::string> b;
+        const std::string* addr = &a.find(2)->second;
+        auto nh = a.extract(2);
+        assert(!nh.empty() && nh.key() == 2 && nh.mapped() == "b" && a.size() == 2);
+        nh.key() = 20;
+        auto res = b.insert(MYSTL::move(nh));
+        assert(res.inserted && res.position->first == 20 && &res.position->second == addr);
+        assert(nh.empty() && a.__verify() && b.__verify());
+
+        // a duplicate key hands the node back
+        auto dup = a.extract(1);
+        b.insert(MYSTL::make_pair(1, std::string("x")));
+        auto res2 = b.insert(MYSTL::move(dup));
+        assert(!res2.inserted && !res2.node.empty() && res2.node.mapped() == "a" && res2.position->second == "x");
+        assert(a.extract(42).empty());
+
+        multiset<int> ms{1, 1, 2};
+        set<int> s;
+        auto n1 = ms.extract(1);
+        s.insert(MYSTL::move(n1));
+        assert(ms.size() == 2 && s.size() == 1 && *s.begin() == 1);
+        ms.insert(s.extract(s.begin()));
+        assert(ms.count(1) == 2 && s.empty() && ms.__verify());
+    }
+
+    // erased nodes are reused
+    {
+        set<int> s{1, 2, 3};
+        const int* addr = &*s.find(2);
+        s.erase(2);
+        auto it = s.insert(7).first;
+        assert(&*it == addr);
+        s.shrink_to_fit();
+        assert(s.__verify());
+    }
+
+    // multiset checked against std::multiset
+    {
+        multiset<int> ms;
+        std::multiset<int> ref;
+        for (int i = 0; i < 20000; ++i) {
+            const int key = rand() % 500;
+            if (rand() % 3 == 0) {
+                auto it = ms.find(key);
+                auto rit = ref.find(key);
+                assert((it == ms.end()) == (rit == ref.end()));
+                if (it != ms.end()) {
+                    ms.erase(it);
+                    ref.erase(rit);
+                }
+            }
+            else {
+                ms.insert(key);
+                ref.insert(key);
+            }
+        }
+        assert(ms.__verify() && same_keys(ms, ref));
+        assert(ms.count(7) == ref.count(7));
+    }
+
+    // nodes, cached nodes and extracted nodes go through the tree's allocator
+    {
+        using tracked = tracking_allocator<allocator<pair<const int, std::string>>>;
+        {
+            map<int, std::string, std::less<int>, tracked> m{tracked("map")};
+            for (int i = 0; i < 200; ++i)
+                m.emplace(i, "value");
+            for (int i = 0; i < 100; ++i)
+                m.erase(i);
+            auto nh = m.extract(150);
+            auto copy = m;
+            map<int, std::string, std::less<int>, tracked> moved;
+            moved = MYSTL::move(m);
+            assert(moved.insert(MYSTL::move(nh)).inserted && moved.size() == 100 && copy.size() == 99);
+            assert(copy.get_allocator() == tracked("map"));
+            nh = copy.extract(151);
+            assert(!nh.empty() && nh.get_allocator() == tracked("map"));
+
+            set<int, std::less<int>, tracking_allocator<allocator<int>>> s({3, 1, 2}, std::less<int>(),
+                                                                         tracking_allocator<allocator<int>>("map"));
+            assert(s.size() == 3 && *s.begin() == 1);
+        }
+        const tracking_stats st = tracking_stats_of("map");
+        assert(st.allocations > 0 && st.allocations == st.deallocations && st.live_bytes == 0);
+    }
+
+    cout << "map_set test passed" << endl;
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include "../MySTL/memory.h"
+#include <iostream>
+#include <cassert>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+struct Base {
+    static int alive;
+    int value;
+    explicit Base(int v = 0) : value(v) { ++alive; }
+    virtual ~Base() { --alive; }
+};
+int Base::alive = 0;
+
+struct Derived : Base {
+    explicit Derived(int v) : Base(v) {}
+};
+
+struct Counted : intrusive_ref_counter<Counted> {
+    static int alive;
+    Counted() { ++alive; }
+    ~Counted() { --alive; }
+};
+int Counted::alive = 0;
+
+// closes a fake descriptor, the handle type comes from Deleter::pointer
+struct fd_handle {
+    int fd;
+    fd_handle(std::nullptr_t = nullptr) : fd(-1) {}
+    explicit fd_handle(int f) : fd(f) {}
+    bool operator==(const fd_handle& rhs) const { return fd == rhs.fd; }
+    bool operator!=(const fd_handle& rhs) const { return fd != rhs.fd; }
+};
+static int closed_fds = 0;
+struct fd_closer {
+    using pointer = fd_handle;
+    void operator()(fd_handle h) const { if (h.fd >= 0) ++closed_fds; }
+};
+
+// empty deleters take no space
+static_assert(sizeof(unique_ptr<int>) == sizeof(int*), "default_delete must be free");
+static_assert(sizeof(unique_ptr<int[]>) == sizeof(int*), "default_delete[] must be free");
+static_assert(sizeof(unique_ptr<int, void(*)(int*)>) == 2 * sizeof(int*), "stateful deleter is stored");
+
+int main() {
+
+    /*********************unique_ptr*****************************/
+    {
+        unique_ptr<Base> u1(new Base(1));
+        unique_ptr<Base> u2(MYSTL::move(u1));
+        assert(!u1 && u2->value == 1);
+        u2.reset(new Base(2));
+        assert(Base::alive == 1);
+    }
+    assert(Base::alive == 0);
+
+    {
+        unique_ptr<Base> u3 = make_unique<Derived>(3);
+        assert(u3->value == 3);
+
+        unique_ptr<int[]> arr = make_unique<int[]>(16);
+        assert(arr[15] == 0);
+        unique_ptr<int[]> raw = make_unique_for_overwrite<int[]>(1 << 20);
+        raw[0] = 1;
+        assert(raw[0] == 1);
+
+        {
+            unique_ptr<fd_handle, fd_closer> fd(fd_handle(3));
+            assert(fd.get().fd == 3);
+        }
+        assert(closed_fds == 1);
+
+        static int freed = 0;
+        {
+            unique_ptr<int, void(*)(int*)> custom(new int(1), [](int* p) { ++freed; delete p; });
+            shared_ptr<int> shared(MYSTL::move(custom));
+            assert(!custom && *shared == 1);
+        }
+        assert(freed == 1);
+    }
+    assert(Base::alive == 0);
+
+    /*********************shared_ptr*****************************/
+    {
+        shared_ptr<Base> s1 = make_shared<Base>(3);
+        shared_ptr<Base> s2 = s1;
+        assert(s1.use_count() == 2 && s2->value == 3);
+
+        weak_ptr<Base> w = s1;
+        s1.reset();
+        assert(!w.expired() && w.use_count() == 1);
+        s2.reset();
+        assert(w.expired() && !w.lock());
+        assert(Base::alive == 0);
+
+        shared_ptr<Base> s3(new Derived(4));
+        shared_ptr<Derived> s4 = static_pointer_cast<Derived>(s3);
+        assert(s4->value == 4 && s3.use_count() == 2);
+        assert(dynamic_pointer_cast<Derived>(s3) == s4);
+
+        bool thrown = false;
+        try {
+            shared_ptr<Base> bad{weak_ptr<Base>()};
+        }
+        catch(const bad_weak_ptr&) {
+            thrown = true;
+        }
+        assert(thrown);
+
+        int deleted = 0;
+        {
+            shared_ptr<int> sd(new int(5), [&](int* p) { ++deleted; delete p; });
+        }
+        assert(deleted == 1);
+
+        shared_ptr<Base> s5 = allocate_shared<Base>(MYSTL::allocator<Base>(), 6);
+        assert(s5->value == 6);
+    }
+    assert(Base::alive == 0);
+
+    /*********************local_shared_ptr*****************************/
+    {
+        local_shared_ptr<Base> l1 = make_local_shared<Base>(7);
+        local_shared_ptr<Base> l2 = l1;
+        local_weak_ptr<Base> lw = l2;
+        assert(l1.use_count() == 2 && lw.lock()->value == 7);
+        l1.reset();
+        l2.reset();
+        assert(lw.expired());
+        local_shared_ptr<Base> l3 = allocate_local_shared<Derived>(MYSTL::allocator<Derived>(), 8);
+        assert(l3->value == 8);
+    }
+    assert(Base::alive == 0);
+
+    /*********************intrusive_ptr*****************************/
+    {
+        intrusive_ptr<Counted> i1(new Counted);
+        intrusive_ptr<Counted> i2 = i1;
+        assert(i1->use_count() == 2 && i1 == i2);
+        i1.reset();
+        assert(i2->use_count() == 1 && Counted::alive == 1);
+    }
+    assert(Counted::alive == 0);
+
+    cout << "memory test passed" << endl;
+    return 0;
+}
@@ -0,0 +1,113 @@
+#include "../MySTL/mmap_vector.h"
+#include "../MySTL/vector.h"
+#include "../MySTL/algo.h"
+#include "../MySTL/span.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+#include <unistd.h>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+struct record {
+    long key;
+    double value;
+};
+
+template <typename T>
+void write_file(const char* path, const T* data, size_t n) {
+    std::FILE* f = std::fopen(path, "wb");
+    assert(f != nullptr);
+    assert(std::fwrite(data, sizeof(T), n, f) == n);
+    std::fclose(f);
+}
+
+int main() {
+    char path[] = "/tmp/mmap_vector_testXXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    const size_t n = 100000;
+    vector<record> src;
+    for (size_t i = 0; i < n; ++i)
+        src.push_back(record{static_cast<long>(i * 7), i * 0.5});
+    write_file(path, src.data(), n);
+
+    // read-only: the algorithms run on the mapping itself
+    {
+        mmap_vector<record> mv(path, map_advice::random);
+        // a read-only mapping gives out no writable access
+        static_assert(std::is_same<decltype(mv[0]), const record&>::value, "const element");
+        static_assert(std::is_same<decltype(mv.begin()), const record*>::value, "const iterator");
+        static_assert(std::is_same<decltype(mv.data()), const record*>::value, "const data");
+        static_assert(std::is_same<decltype(mv.front()), const record&>::value, "const front");
+        assert(mv.mode() == map_mode::read_only);
+        assert(mv.is_open() && mv.size() == n && mv.capacity() == n && !mv.empty());
+        assert(mv.front().key == 0 && mv.back().key == static_cast<long>((n - 1) * 7) && mv.at(10).value == 5.0);
+        auto it = MYSTL::lower_bound(mv.begin(), mv.end(), 700,
+                                     [](const record& r, long k) { return r.key < k; });
+        assert(it - mv.begin() == 100);
+        mv.advise(map_advice::sequential);
+        mv.advise(map_advice::willneed, 5000, 100);
+        double total = 0;
+        for (const auto& r : mv)
+            total += r.value;
+        assert(total == 0.5 * n * (n - 1) / 2);
+        span<const record> s(mv);
+        assert(s.size() == n && s.data() == mv.data());
+        try {
+            mv.at(n);
+            assert(false);
+        }
+        catch (const std::out_of_range&) {}
+
+        mmap_vector<record> moved(MYSTL::move(mv));
+        assert(!mv.is_open() && mv.empty() && moved.size() == n);
+    }
+
+    // copy-on-write: edits stay private, the file keeps its contents
+    {
+        vector<int> ints;
+        for (int i = 0; i < 50000; ++i)
+            ints.push_back(rand());
+        write_file(path, ints.data(), ints.size());
+        mmap_vector<int, map_mode::copy_on_write> cow(path, map_advice::normal, true);
+        static_assert(std::is_same<decltype(cow[0]), int&>::value, "writable element");
+        assert(cow.mode() == map_mode::copy_on_write);
+        MYSTL::sort(cow.begin(), cow.end());
+        assert(MYSTL::is_sorted(cow.begin(), cow.end()));
+        mmap_vector<int> ro(path);
+        assert(MYSTL::equal(ro.begin(), ro.end(), ints.begin()));
+        assert(!MYSTL::equal(ro.begin(), ro.end(), cow.begin()));
+    }
+
+    // empty file, a size that is no whole number of records, a missing file
+    {
+        write_file<char>(path, "", 0);
+        mmap_vector<int> empty(path);
+        assert(empty.empty() && empty.begin() == empty.end());
+        write_file(path, "abcde", 5);
+        try {
+            mmap_vector<int> bad(path);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {}
+        unlink(path);
+        try {
+            mmap_vector<int> missing(path);
+            assert(false);
+        }
+        catch (const std::system_error& e) {
+            assert(e.code().value() == ENOENT);
+        }
+    }
+
+    cout << "mmap_vector test passed" << endl;
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "../MySTL/mpmc_queue.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <chrono>
+#include <thread>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+// moves `total` ints through the queue with p producers and c consumers,
+// returns millions of messages per second
+template <typename Queue, typename Push, typename Pop>
+double run(int p, int c, long total, Push push, Pop pop) {
+    Queue q(1024);
+    std::atomic<long> claimed(0);
+    std::atomic<long> sum(0);
+    const long per_producer = total / p;
+    total = per_producer * p;
+
+    auto t0 = std::chrono::steady_clock::now();
+    vector<std::thread> threads;
+    for (int i = 0; i < p; ++i)
+        threads.emplace_back([&] {
+            for (long v = 0; v < per_producer; ++v)
+                push(q, v);
+        });
+    for (int i = 0; i < c; ++i)
+        threads.emplace_back([&] {
+            long local = 0, v;
+            while (claimed.fetch_add(1, std::memory_order_relaxed) < total) {
+                pop(q, v);
+                local += v;
+            }
+            sum += local;
+        });
+    for (auto& t : threads)
+        t.join();
+    auto t1 = std::chrono::steady_clock::now();
+
+    if (sum != p * (per_producer * (per_producer - 1) / 2))
+        cout << "checksum mismatch" << endl;
+    return total / std::chrono::duration<double>(t1 - t0).count() / 1e6;
+}
+
+int main() {
+    const long total = 2000000;
+    const int counts[] = {1, 2, 4, 8};
+    cout << "cores: " << std::thread::hardware_concurrency() << endl;
+
+    for (int p : counts) {
+        for (int c : counts) {
+            // the raw queue retries with yield so it also makes progress on few cores
+            const double lock_free = run<mpmc_queue<long>>(p, c, total,
+                [](mpmc_queue<long>& q, long v) { while (!q.try_push(v)) std::this_thread::yield(); },
+                [](mpmc_queue<long>& q, long& v) { while (!q.try_pop(v)) std::this_thread::yield(); });
+            const double blocking = run<blocking_mpmc_queue<long>>(p, c, total,
+                [](blocking_mpmc_queue<long>& q, long v) { q.push(v); },
+                [](blocking_mpmc_queue<long>& q, long& v) { q.pop(v); });
+            cout << p << "P/" << c << "C  try " << lock_free << " M msgs/s"
+                 << "  blocking " << blocking << " M msgs/s" << endl;
+        }
+    }
+    return 0;
+}
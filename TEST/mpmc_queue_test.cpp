@@ -0,0 +1,166 @@
+#include "../MySTL/mpmc_queue.h"
+#include "../MySTL/memory.h"
+#include "../MySTL/vector.h"
+#include "../MySTL/tracking_allocator.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <stdexcept>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+// throws when built from a negative value, or on copy / assignment while the flag is set
+struct fragile {
+    static int live;
+    static bool fail_copy;
+    static bool fail_assign;
+    int value;
+
+    fragile() : value(0) { ++live; }
+    fragile(int v) : value(v) {
+        if (v < 0)
+            throw std::runtime_error("fragile");
+        ++live;
+    }
+    fragile(const fragile& rhs) : value(rhs.value) {
+        if (fail_copy)
+            throw std::runtime_error("fragile");
+        ++live;
+    }
+    fragile& operator=(const fragile& rhs) {
+        if (fail_assign)
+            throw std::runtime_error("fragile");
+        value = rhs.value;
+        return *this;
+    }
+    ~fragile() { --live; }
+};
+int fragile::live = 0;
+bool fragile::fail_copy = false;
+bool fragile::fail_assign = false;
+
+int main() {
+
+    /*********************single thread*****************************/
+    {
+        mpmc_queue<std::string> q(4);
+        for (int i = 0; i < 4; ++i)
+            assert(q.try_push(std::to_string(i)));
+        assert(!q.try_push("full") && q.size_approx() == 4);
+        std::string out;
+        assert(q.try_pop(out) && out == "0");
+        assert(q.try_push("4"));
+
+        // left over elements are destroyed with the queue
+        mpmc_queue<unique_ptr<int>> owners(8);
+        owners.try_emplace(new int(1));
+    }
+
+    /*********************throwing element*****************************/
+    {
+        {
+            mpmc_queue<fragile> q(4);
+            fragile out;
+            // laps over slots whose producer threw keep the queue usable
+            for (int lap = 0; lap < 5; ++lap) {
+                assert(q.try_emplace(1));
+                bool threw = false;
+                try { q.try_emplace(-1); } catch (const std::runtime_error&) { threw = true; }
+                assert(threw);
+                assert(q.try_emplace(2));
+                assert(q.try_pop(out) && out.value == 1);
+                assert(q.try_pop(out) && out.value == 2);
+                assert(!q.try_pop(out));
+            }
+
+            // a failed move assignment loses that element only
+            assert(q.try_emplace(3) && q.try_emplace(4));
+            fragile::fail_assign = true;
+            bool threw = false;
+            try { q.try_pop(out); } catch (const std::runtime_error&) { threw = true; }
+            fragile::fail_assign = false;
+            assert(threw);
+            assert(q.try_pop(out) && out.value == 4);
+
+            // the destructor only destroys what was constructed
+            assert(q.try_emplace(5));
+            try { q.try_emplace(-1); } catch (const std::runtime_error&) {}
+            assert(q.try_emplace(6));
+        }
+        assert(fragile::live == 0);
+
+        // a full queue of skipped slots does not leave a blocked producer parked
+        blocking_mpmc_queue<fragile> bq(2, 4);
+        fragile::fail_copy = true;
+        for (int i = 0; i < 2; ++i) {
+            bool threw = false;
+            try { bq.push(fragile(8)); } catch (const std::runtime_error&) { threw = true; }
+            assert(threw);
+        }
+        fragile::fail_copy = false;
+        std::thread producer([&] { bq.push(fragile(7)); });
+        fragile out;
+        bq.pop(out);
+        producer.join();
+        assert(out.value == 7);
+    }
+
+    /*********************many producers / consumers*****************************/
+    {
+        const int producers = 4, consumers = 3, per_producer = 50000;
+        blocking_mpmc_queue<long> q(64, 64);
+        std::atomic<long> sum(0);
+        std::atomic<int> popped(0);
+
+        vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+            threads.emplace_back([&, p] {
+                for (int i = 0; i < per_producer; ++i)
+                    q.push(static_cast<long>(p) * per_producer + i);
+            });
+        for (int c = 0; c < consumers; ++c)
+            threads.emplace_back([&] {
+                long v;
+                while (popped.fetch_add(1) < producers * per_producer) {
+                    q.pop(v);
+                    sum += v;
+                }
+            });
+        for (auto& t : threads)
+            t.join();
+
+        const long n = static_cast<long>(producers) * per_producer;
+        assert(sum == n * (n - 1) / 2);
+        long v;
+        assert(!q.try_pop(v));
+    }
+
+    /*********************allocator*****************************/
+    {
+        using tracked = tracking_allocator<allocator<std::string>>;
+        {
+            mpmc_queue<std::string, tracked> q(16, tracked("mpmc_queue"));
+            blocking_mpmc_queue<std::string, tracked> bq(16, 64, tracked("mpmc_queue"));
+            assert(q.try_push("x") && bq.try_push("y"));
+            assert(q.get_allocator() == tracked("mpmc_queue") && bq.get_allocator() == tracked("mpmc_queue"));
+        }
+        const tracking_stats st = tracking_stats_of("mpmc_queue");
+        assert(st.allocations == 2 && st.deallocations == 2 && st.live_bytes == 0);
+    }
+
+    // a capacity above the largest power of two is rejected instead of looping forever
+    for (size_t bad : {(static_cast<size_t>(-1) >> 1) + 2, static_cast<size_t>(-1)}) {
+        try {
+            mpmc_queue<int> q(bad);
+            assert(false);
+        }
+        catch (const std::length_error&) {}
+    }
+
+    cout << "mpmc_queue test passed" << endl;
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "../MySTL/numa_allocator.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <cassert>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+template <typename Alloc>
+void fill_and_check(const Alloc& a, size_t n) {
+    vector<double, Alloc> v(a);
+    for (size_t i = 0; i < n; ++i)
+        v.push_back(static_cast<double>(i));
+    for (size_t i = 0; i < n; i += 997)
+        assert(v[i] == static_cast<double>(i));
+    vector<double, Alloc> copy(v);
+    assert(copy == v);
+}
+
+int main() {
+    const int nodes = numa_node_count();
+    assert(nodes >= 1 && (numa_online_nodes() & 1UL) != 0);
+    cout << "numa nodes online: " << nodes << endl;
+
+    // small blocks come from operator new, large ones are mapped
+    const size_t n = 1 << 20;
+    fill_and_check(numa_allocator<double>(), n);
+    fill_and_check(numa_allocator<double>(page_policy::normal, numa_policy::local), 1000);
+    fill_and_check(numa_allocator<double>::interleaved(), n);
+    fill_and_check(numa_allocator<double>::preferring(0), n);
+
+    // bound to node 0: the pages report node 0 where the kernel tells
+    {
+        vector<double, numa_allocator<double>> v(numa_allocator<double>::on_node(0));
+        v.resize(n, 1.0);
+        const int node = numa_node_of(v.data() + n / 2);
+        assert(node == 0 || node == -1);
+    }
+
+    // binding to a node that is not online fails at allocation
+    try {
+        numa_allocator<double>::on_node(63).allocate(n);
+        assert(false);
+    }
+    catch (const std::system_error&) {}
+
+    // hugetlb falls back to normal pages when no pool is reserved
+    {
+        numa_allocator<int> a(page_policy::hugetlb, numa_policy::local, 0, 4096);
+        int* p = a.allocate(3000);  // 12000 bytes, one huge page mapped
+        p[0] = 1;
+        p[2999] = 2;
+        assert(p[0] + p[2999] == 3);
+        a.deallocate(p, 3000);
+        fill_and_check(numa_allocator<double>(page_policy::hugetlb, numa_policy::local), n);
+    }
+
+    // rebinding keeps the policy
+    {
+        numa_allocator<char> c = numa_allocator<int>::on_node(0, page_policy::normal);
+        assert(c.policy() == numa_policy::bind && c.nodes() == 1UL && c.pages() == page_policy::normal);
+        assert(c == numa_allocator<char>(page_policy::normal, numa_policy::local));
+    }
+
+    // parallel first touch
+    {
+        auto v = first_touch_vector<long>(1000003, 7L, MYSTL::allocator<long>(), 4);
+        assert(v.size() == 1000003 && v.front() == 7 && v[500000] == 7 && v.back() == 7);
+        auto w = first_touch_vector<float>(n, 0.5f, numa_allocator<float>());
+        assert(w.size() == n && w[n - 1] == 0.5f);
+        auto e = first_touch_vector<int>(0, 1, MYSTL::allocator<int>(), 8);
+        assert(e.empty());
+        auto few = first_touch_vector<int>(3, 9, MYSTL::allocator<int>(), 8);
+        assert(few.size() == 3 && few[2] == 9);
+    }
+
+    cout << "numa_allocator test passed" << endl;
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "../MySTL/persistent_vector.h"
+#include "../MySTL/file_allocator.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+
+using std::cout;
+using std::endl;
+
+template <typename F>
+double time_ms(F f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+struct tick {
+    long   time;
+    double price;
+};
+
+void report(const char* name, size_t n, double ms) {
+    cout << name << "  " << ms << " ms  " << n / ms / 1000.0 << " M appends/s" << endl;
+}
+
+// appends n ticks to a fresh file, waiting for msync every `every` elements and at the end
+void run_file(const char* name, const char* path, size_t n, size_t every) {
+    std::remove(path);
+    MYSTL::persistent_vector<tick> log(path);
+    const double ms = time_ms([&] {
+        for (size_t i = 0; i < n; ++i) {
+            log.push_back(tick{static_cast<long>(i), i * 0.25});
+            if (every != 0 && (i + 1) % every == 0)
+                log.sync(true);
+        }
+        log.sync(true);
+    });
+    report(name, n, ms);
+}
+
+int main() {
+    const size_t n = 10000000;
+    char path[] = "/tmp/persistent_vector_benchXXXXXX";
+    const int fd = ::mkstemp(path);
+    if (fd < 0)
+        return 1;
+    ::close(fd);
+
+    // in-memory baseline
+    {
+        MYSTL::vector<tick> v;
+        const double ms = time_ms([&] {
+            for (size_t i = 0; i < n; ++i)
+                v.push_back(tick{static_cast<long>(i), i * 0.25});
+        });
+        report("MYSTL::vector (memory)           ", n, ms);
+    }
+    // vector growing by mremap on anonymous memory, then inside a file
+    {
+        MYSTL::vector<tick, MYSTL::file_allocator<tick>> v;
+        const double ms = time_ms([&] {
+            for (size_t i = 0; i < n; ++i)
+                v.push_back(tick{static_cast<long>(i), i * 0.25});
+        });
+        report("vector<file_allocator> anonymous ", n, ms);
+    }
+    {
+        std::remove(path);
+        MYSTL::vector<tick, MYSTL::file_allocator<tick>> v{MYSTL::file_allocator<tick>(path)};
+        const double ms = time_ms([&] {
+            for (size_t i = 0; i < n; ++i)
+                v.push_back(tick{static_cast<long>(i), i * 0.25});
+        });
+        report("vector<file_allocator> file      ", n, ms);
+    }
+
+    run_file("persistent_vector, one final sync ", path, n, 0);
+    {
+        std::remove(path);
+        MYSTL::persistent_vector<tick> log(path);
+        log.set_sync_every(1 << 16);
+        const double ms = time_ms([&] {
+            for (size_t i = 0; i < n; ++i)
+                log.push_back(tick{static_cast<long>(i), i * 0.25});
+            log.sync(true);
+        });
+        report("persistent_vector, async / 64Ki  ", n, ms);
+    }
+    run_file("persistent_vector, sync / 1Mi    ", path, n, 1 << 20);
+    run_file("persistent_vector, sync / 64Ki   ", path, n / 10, 1 << 16);
+
+    std::remove(path);
+    return 0;
+}
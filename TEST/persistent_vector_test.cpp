@@ -0,0 +1,157 @@
+#include "../MySTL/persistent_vector.h"
+#include "../MySTL/file_allocator.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/mman.h>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+struct event {
+    long   id;
+    double value;
+};
+
+int main() {
+    char path[] = "/tmp/persistent_vector_testXXXXXX";
+    const int fd = ::mkstemp(path);
+    assert(fd >= 0);
+    ::close(fd);
+
+    // append across many growths, then reopen
+    {
+        persistent_vector<event> log(path);
+        assert(log.is_open() && log.empty() && log.capacity() > 0);
+        for (long i = 0; i < 10000; ++i)
+            log.push_back(event{i, i * 0.5});
+        log.emplace_back(event{-1, -1.0});
+        event batch[100];
+        for (long i = 0; i < 100; ++i)
+            batch[i] = event{20000 + i, 0.0};
+        log.append(batch, batch + 100);
+        log.sync();
+        assert(log.size() == 10101 && log[5000].id == 5000 && log.back().id == 20099);
+    }
+    {
+        persistent_vector<event> log(path);
+        assert(log.size() == 10101 && log.capacity() >= log.size());
+        for (long i = 0; i < 10000; ++i)
+            assert(log[i].id == i && log[i].value == i * 0.5);
+        assert(log[10000].id == -1 && log.at(10100).id == 20099);
+        try {
+            log.at(log.size());
+            assert(false);
+        }
+        catch (const std::out_of_range&) {}
+
+        // batched writeback keeps working after a reopen
+        log.set_sync_every(64);
+        for (long i = 0; i < 1000; ++i)
+            log.push_back(event{30000 + i, 1.0});
+        persistent_vector<event> moved(MYSTL::move(log));
+        assert(!log.is_open() && moved.size() == 11101);
+    }
+    {
+        persistent_vector<event> log(path);
+        assert(log.size() == 11101 && log.back().id == 30999);
+
+        // wrong element type
+        try {
+            persistent_vector<int> wrong(path);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {}
+    }
+    std::remove(path);
+
+    // arguments pointing into the vector survive a growth that moves the mapping
+    {
+        persistent_vector<event> log(path);
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t header = persistent_vector<event>::header_bytes;
+        // pages right behind the mapping are taken, so mremap has to move it
+        auto block_next_page = [&] {
+            const char* base = reinterpret_cast<const char*>(log.data()) - header;
+            const size_t mapped = (header + log.capacity() * sizeof(event) + page - 1) / page * page;
+            void* next = const_cast<char*>(base + mapped);
+            void* p = ::mmap(next, page, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            assert(p != MAP_FAILED);
+            return p;
+        };
+
+        log.reserve((page - header) / sizeof(event));
+        for (long i = 0; static_cast<size_t>(i) < log.capacity(); ++i)
+            log.push_back(event{i, 0.0});
+        void* blocker = block_next_page();
+        const event* before = log.data();
+        log.push_back(log[3]);
+        assert(log.data() != before);
+        assert(log.back().id == 3 && log[3].id == 3);
+        ::munmap(blocker, page);
+
+        while (log.size() < log.capacity())
+            log.push_back(event{static_cast<long>(log.size()), 0.0});
+        const size_t n = log.size();
+        blocker = block_next_page();
+        before = log.data();
+        log.append(log.data(), n);
+        assert(log.data() != before && log.size() == 2 * n);
+        for (size_t i = 0; i < n; ++i)
+            assert(log[n + i].id == log[i].id);
+        ::munmap(blocker, page);
+    }
+    std::remove(path);
+
+    // vector growing in place inside a file
+    {
+        file_allocator<int> file(path);
+        vector<int, file_allocator<int>> v(file);
+        for (int i = 0; i < 100000; ++i)
+            v.push_back(i);
+        v.insert(v.begin(), 5, v[10]);
+        v.insert(v.begin() + 1, v[3]);
+        assert(v.size() == 100006 && v[0] == 10 && v[1] == 10 && v[6] == 0 && v.back() == 99999);
+        assert(v.get_allocator().file_size() == v.capacity() * sizeof(int));
+
+        // a copy lives in anonymous memory, the file still backs v
+        vector<int, file_allocator<int>> copy(v);
+        assert(!copy.get_allocator().is_file() && copy == v);
+        v.resize(10);
+        v.shrink_to_fit();
+        assert(v.capacity() == 10 && v.get_allocator().file_size() == 10 * sizeof(int));
+        assert(v[9] == 3 && copy.size() == 100006);
+
+        // the file holds only one block
+        try {
+            file.allocate(1);
+            assert(false);
+        }
+        catch (const std::logic_error&) {}
+    }
+    std::remove(path);
+
+    // anonymous mappings grow with mremap
+    {
+        vector<long, file_allocator<long>> v;
+        for (long i = 0; i < 50000; ++i)
+            v.emplace_back(i * 3);
+        v.reserve(200000);
+        assert(v.size() == 50000 && v[49999] == 149997);
+        v.assign(300000, 7);
+        assert(v.size() == 300000 && v.front() == 7 && v.back() == 7);
+        v.insert(v.begin() + 1, 400000, v[0] + 1);
+        vector<long> more(500000, 9);
+        v.insert(v.end(), more.begin(), more.end());
+        assert(v.size() == 1200000 && v[0] == 7 && v[1] == 8 && v[400001] == 7 && v.back() == 9);
+    }
+
+    cout << "persistent_vector test passed" << endl;
+    return 0;
+}
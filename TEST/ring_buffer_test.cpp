@@ -0,0 +1,183 @@
+#include "../MySTL/ring_buffer.h"
+#include "../MySTL/vector.h"
+#include "../MySTL/tracking_allocator.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <stdexcept>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+// single pass: every copy shares one cursor, like a stream iterator
+struct counting_input {
+    using iterator_category = MYSTL::input_iterator_tag;
+    using value_type        = int;
+    using difference_type   = ptrdiff_t;
+    using pointer           = const int*;
+    using reference         = const int&;
+
+    int* cursor;
+
+    const int& operator*() const { return *cursor; }
+    counting_input& operator++() { ++*cursor; return *this; }
+};
+
+int main() {
+
+    /*********************reject*****************************/
+    {
+        ring_buffer<int> rb(5);
+        assert(rb.capacity() == 8 && rb.empty());
+        for (int i = 0; i < 8; ++i)
+            assert(rb.push_back(i));
+        assert(rb.full() && !rb.push_back(8));
+        assert(rb.front() == 0 && rb.back() == 7);
+
+        // wrap around a few times
+        for (int i = 8; i < 100; ++i) {
+            rb.pop_front();
+            assert(rb.push_back(i));
+        }
+        assert(rb.front() == 92 && rb.back() == 99 && rb[3] == 95);
+
+        int expect = 92;
+        for (auto it = rb.begin(); it != rb.end(); ++it)
+            assert(*it == expect++);
+        assert(rb.end() - rb.begin() == 8);
+        assert(*(rb.begin() + 5) == 97 && rb.begin()[7] == 99);
+        assert(*rb.rbegin() == 99);
+
+        // head_ is at slot 92 & 7 = 4, so the elements are split in two
+        auto s = rb.two_spans();
+        assert(s.first.size == 4 && s.second.size == 4);
+        assert(s.first.data[0] == 92 && s.second.data[0] == 96);
+
+        bool thrown = false;
+        try {
+            rb.at(8);
+        }
+        catch(const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+
+    /*********************overwrite_oldest*****************************/
+    {
+        ring_buffer<std::string, ring_full_policy::overwrite_oldest> rb(4);
+        for (int i = 0; i < 10; ++i)
+            rb.emplace_back(std::to_string(i));
+        assert(rb.size() == 4 && rb.front() == "6" && rb.back() == "9");
+
+        ring_buffer<std::string, ring_full_policy::overwrite_oldest> copy(rb);
+        assert(copy.size() == 4 && copy.front() == "6");
+        copy.pop_back();
+        assert(copy.back() == "8" && rb.back() == "9");
+
+        ring_buffer<std::string, ring_full_policy::overwrite_oldest> moved(MYSTL::move(copy));
+        assert(moved.size() == 3 && copy.empty());
+        rb = moved;
+        assert(rb.size() == 3);
+    }
+
+    /*********************batched writes*****************************/
+    {
+        vector<int> src(20);
+        for (int i = 0; i < 20; ++i)
+            src[i] = i;
+
+        ring_buffer<int> rb(16);
+        rb.push_back(-1);
+        rb.pop_front();
+        assert(rb.push_back_n(src.begin(), 20) == 16);
+        assert(rb.front() == 0 && rb.back() == 15);
+        rb.pop_front(10);
+        assert(rb.size() == 6 && rb.front() == 10);
+
+        ring_buffer<int, ring_full_policy::overwrite_oldest> ow(16);
+        ow.push_back_n(src.begin(), 10);
+        ow.push_back_n(src.begin() + 10, 10);
+        assert(ow.size() == 16 && ow.front() == 4 && ow.back() == 19);
+
+        // producer constructs into the free slots directly
+        ring_buffer<int> direct(8);
+        direct.push_back_n(src.begin(), 6);
+        direct.pop_front(5);
+        auto free = direct.free_spans();
+        assert(free.first.size + free.second.size == 7);
+        int written = 0;
+        for (size_t i = 0; i < free.first.size; ++i)
+            free.first.data[i] = 100 + written++;
+        for (size_t i = 0; i < free.second.size; ++i)
+            free.second.data[i] = 100 + written++;
+        direct.commit_back(written);
+        assert(direct.full() && direct[0] == 5 && direct[1] == 100 && direct.back() == 106);
+    }
+
+    /*********************single pass input*****************************/
+    {
+        ring_buffer<int> rb(8);
+        for (int i = 0; i < 6; ++i)
+            rb.push_back(i);
+        rb.pop_front(6);  // the free slots now wrap around the end of the storage
+        int next = 100;
+        assert(rb.push_back_n(counting_input{&next}, 8) == 8);
+        assert(next == 108);
+        for (int i = 0; i < 8; ++i)
+            assert(rb[i] == 100 + i);
+
+        ring_buffer<int, ring_full_policy::overwrite_oldest> ow(4);
+        next = 0;
+        assert(ow.push_back_n(counting_input{&next}, 6) == 4);
+        assert(next == 6 && ow.front() == 2 && ow.back() == 5);
+    }
+
+    /*********************moved from*****************************/
+    {
+        ring_buffer<std::string> a(4);
+        a.push_back("x");
+        ring_buffer<std::string> b(MYSTL::move(a));
+        assert(a.empty() && a.capacity() == 0 && a.full());
+        assert(!a.push_back("y") && a.push_back_n(b.begin(), 1) == 0);
+        assert(b.size() == 1 && b.front() == "x");
+
+        ring_buffer<std::string, ring_full_policy::overwrite_oldest> c(4), d(2);
+        c.push_back("z");
+        d = MYSTL::move(c);
+        assert(c.capacity() == 0 && !c.push_back("w") && c.empty());
+        assert(c.push_back_n(d.begin(), 1) == 0 && c.empty());
+        ring_buffer<std::string, ring_full_policy::overwrite_oldest> e(c);
+        assert(e.capacity() == 0 && !e.push_back("w"));
+        c = d;
+        assert(c.capacity() == 4 && c.front() == "z");
+    }
+
+    /*********************allocator*****************************/
+    {
+        using tracked = tracking_allocator<allocator<std::string>>;
+        {
+            ring_buffer<std::string, ring_full_policy::reject, tracked> a(8, tracked("ring_buffer"));
+            a.push_back("x");
+            ring_buffer<std::string, ring_full_policy::reject, tracked> b(a), c(MYSTL::move(a));
+            assert(b.front() == "x" && c.front() == "x" && b.get_allocator() == tracked("ring_buffer"));
+            assert(tracking_stats_of("ring_buffer").live_bytes == 2 * 8 * sizeof(std::string));
+        }
+        const tracking_stats st = tracking_stats_of("ring_buffer");
+        assert(st.allocations == 2 && st.deallocations == 2 && st.live_bytes == 0);
+    }
+
+    // a capacity above the largest power of two is rejected instead of looping forever
+    for (size_t bad : {(static_cast<size_t>(-1) >> 1) + 2, static_cast<size_t>(-1)}) {
+        try {
+            ring_buffer<int> q(bad);
+            assert(false);
+        }
+        catch (const std::length_error&) {}
+    }
+
+    cout << "ring_buffer test passed" << endl;
+    return 0;
+}
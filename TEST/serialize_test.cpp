@@ -0,0 +1,150 @@
+#include "../MySTL/serialize.h"
+#include "../MySTL/vector.h"
+#include "../MySTL/list.h"
+#include "../MySTL/basic_string.h"
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <cassert>
+#include <stdexcept>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+struct point {
+    float x, y, z;
+};
+
+bool operator==(const point& a, const point& b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+bool operator!=(const point& a, const point& b) { return !(a == b); }
+
+// counts the write calls reaching the stream buffer
+class counting_buf : public std::stringbuf {
+public:
+    int writes = 0;
+
+protected:
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        ++writes;
+        return std::stringbuf::xsputn(s, n);
+    }
+};
+
+template <typename T>
+T round_trip(const T& value) {
+    std::stringstream ss;
+    serialize(ss, value);
+    return deserialize<T>(ss);
+}
+
+int main() {
+
+    // a vector of trivially copyable T is one blob
+    {
+        vector<point> v;
+        for (int i = 0; i < 100000; ++i)
+            v.push_back(point{i * 1.0f, i * 2.0f, i * 3.0f});
+        counting_buf buf;
+        std::ostream os(&buf);
+        serialize(os, v);
+        assert(buf.writes == 2);  // the count and the blob
+        assert(buf.str().size() == 8 + v.size() * sizeof(point));
+
+        std::istream is(&buf);
+        vector<point> back;
+        back.push_back(point{-1, -1, -1});
+        deserialize(is, back);
+        assert(back == v && back.capacity() >= v.size());
+    }
+
+    // pair, strings and nested containers
+    {
+        vector<vector<int>> nested{{1, 2, 3}, {}, {4}};
+        assert(round_trip(nested) == nested);
+
+        vector<pair<int, string>> named;
+        named.push_back(MYSTL::make_pair(1, string("one")));
+        named.push_back(MYSTL::make_pair(2, string("a string long enough to leave the inline buffer")));
+        named.push_back(MYSTL::make_pair(3, string()));
+        auto named_back = round_trip(named);
+        assert(named_back == named);
+
+        list<pair<long, vector<double>>> l;
+        l.push_back(make_pair(7L, vector<double>{0.5, 1.5}));
+        l.push_back(make_pair(8L, vector<double>()));
+        auto l_back = round_trip(l);
+        assert(l_back.size() == 2 && l_back.front().first == 7 && l_back.front().second[1] == 1.5);
+        assert(l_back.back().first == 8 && l_back.back().second.empty());
+
+        pair<int, pair<char, double>> p(1, make_pair('x', 2.5));
+        auto p_back = round_trip(p);
+        assert(p_back.first == 1 && p_back.second.first == 'x' && p_back.second.second == 2.5);
+
+        list<vector<string>> deep;
+        deep.push_back(vector<string>{string("a"), string("bc")});
+        auto deep_back = round_trip(deep);
+        assert(deep_back.front().size() == 2 && deep_back.front()[1] == "bc");
+    }
+
+    // several values back to back, then truncated input
+    {
+        std::stringstream ss;
+        serialize(ss, vector<int>{1, 2, 3});
+        serialize(ss, string("tail"));
+        serialize(ss, 42);
+        assert(deserialize<vector<int>>(ss).size() == 3);
+        assert(deserialize<string>(ss) == "tail");
+        assert(deserialize<int>(ss) == 42);
+
+        std::string bytes;
+        {
+            std::stringstream full;
+            serialize(full, vector<long>(1000, 5));
+            bytes = full.str();
+        }
+        std::stringstream cut(bytes.substr(0, bytes.size() - 3));
+        try {
+            deserialize<vector<long>>(cut);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {}
+    }
+
+    // corrupt counts fail with runtime_error without reserving what they claim
+    {
+        auto with_count = [](uint64_t count) {
+            std::string bytes(reinterpret_cast<const char*>(&count), sizeof(count));
+            return bytes + std::string(16, 'x');
+        };
+        auto rejects = [](const std::string& bytes, auto* target) {
+            std::stringstream ss(bytes);
+            try {
+                deserialize(ss, *target);
+                return false;
+            }
+            catch (const std::runtime_error&) {
+                return true;
+            }
+        };
+        vector<int> vi;
+        vector<double> vd;
+        vector<string> vs;
+        string s;
+        list<int> li;
+        // n * sizeof(T) would wrap to 0
+        assert(rejects(with_count(uint64_t(1) << 62), &vi));
+        assert(rejects(with_count(~uint64_t(0)), &vd));
+        // below max_size but far beyond the input
+        assert(rejects(with_count(uint64_t(1) << 40), &vi));
+        assert(rejects(with_count(uint64_t(1) << 40), &vd));
+        assert(rejects(with_count(uint64_t(1) << 40), &vs));
+        assert(rejects(with_count(uint64_t(1) << 40), &s));
+        assert(rejects(with_count(uint64_t(1) << 40), &li));
+        assert(vi.capacity() < (size_t(1) << 20) && s.capacity() < (size_t(1) << 20));
+    }
+
+    cout << "serialize test passed" << endl;
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include "../MySTL/memory.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <chrono>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+struct Payload {
+    long value;
+    explicit Payload(long v) : value(v) {}
+};
+
+// pass by value so every call pays one increment and one decrement
+template <typename Ptr>
+__attribute__((noinline)) long consume(Ptr p) {
+    return p->value;
+}
+
+template <typename Ptr, typename Make>
+double copy_bench(Make make, size_t objects, int rounds) {
+    vector<Ptr> src;
+    for (size_t i = 0; i < objects; ++i)
+        src.push_back(make(static_cast<long>(i)));
+
+    auto t0 = std::chrono::steady_clock::now();
+    long sum = 0;
+    for (int r = 0; r < rounds; ++r) {
+        vector<Ptr> copy(src);
+        for (size_t i = 0; i < copy.size(); ++i)
+            sum += consume(copy[i]);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    if (sum == 42)  cout << "";
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    // one copy into the vector + one copy per consume call
+    return ns / (2.0 * objects * rounds);
+}
+
+int main() {
+    const size_t objects = 1 << 12;
+    const int rounds = 2000;
+
+    const double atomic_ns = copy_bench<shared_ptr<Payload>>(
+        [](long v) { return make_shared<Payload>(v); }, objects, rounds);
+    const double local_ns = copy_bench<local_shared_ptr<Payload>>(
+        [](long v) { return make_local_shared<Payload>(v); }, objects, rounds);
+
+    cout << "shared_ptr       " << atomic_ns << " ns / copy" << endl;
+    cout << "local_shared_ptr " << local_ns << " ns / copy" << endl;
+    cout << "speedup          " << atomic_ns / local_ns << "x" << endl;
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "../MySTL/spsc_queue.h"
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+// pins the calling thread, wraps around when the machine has fewer cores
+static void pin_to_cpu(unsigned cpu) {
+    const unsigned cores = std::thread::hardware_concurrency();
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cores ? cpu % cores : 0, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+struct record {
+    size_t seq;
+    char payload[56];
+};
+
+// moves `count` records from a producer on cpu 0 to a consumer on cpu 1,
+// `batch` elements per try_push_n / try_pop_n (1 uses try_push / try_pop)
+double run(size_t count, size_t batch) {
+    spsc_queue<record> q(4096);
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread producer([&] {
+        pin_to_cpu(0);
+        record buf[256];
+        size_t sent = 0;
+        while (sent < count) {
+            if (batch == 1) {
+                buf[0].seq = sent;
+                if (q.try_push(buf[0]))
+                    ++sent;
+                else
+                    std::this_thread::yield();
+            }
+            else {
+                const size_t n = MYSTL::min(batch, count - sent);
+                for (size_t i = 0; i < n; ++i)
+                    buf[i].seq = sent + i;
+                const size_t pushed = q.try_push_n(buf, n);
+                sent += pushed;
+                if (pushed == 0)
+                    std::this_thread::yield();
+            }
+        }
+    });
+
+    pin_to_cpu(1);
+    record buf[256];
+    size_t received = 0, checksum = 0;
+    while (received < count) {
+        const size_t n = batch == 1 ? (q.try_pop(buf[0]) ? 1 : 0) : q.try_pop_n(buf, batch);
+        for (size_t i = 0; i < n; ++i)
+            checksum += buf[i].seq;
+        received += n;
+        if (n == 0)
+            std::this_thread::yield();
+    }
+    producer.join();
+    auto t1 = std::chrono::steady_clock::now();
+
+    if (checksum != count * (count - 1) / 2)
+        cout << "checksum mismatch" << endl;
+    return count / std::chrono::duration<double>(t1 - t0).count();
+}
+
+int main() {
+    const size_t count = 10000000;
+    cout << "cores: " << std::thread::hardware_concurrency() << endl;
+    const size_t batches[] = {1, 8, 64, 256};
+    for (auto b : batches)
+        cout << "batch " << b << ": " << run(count, b) / 1e6 << " M msgs/s" << endl;
+    return 0;
+}
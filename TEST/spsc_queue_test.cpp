@@ -0,0 +1,101 @@
+#include "../MySTL/spsc_queue.h"
+#include "../MySTL/memory.h"
+#include "../MySTL/tracking_allocator.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <stdexcept>
+#include <thread>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+int main() {
+
+    /*********************single thread*****************************/
+    {
+        spsc_queue<std::string> q(3);
+        assert(q.capacity() == 4 && q.empty());
+        for (int i = 0; i < 4; ++i)
+            assert(q.try_push(std::to_string(i)));
+        assert(!q.try_push("full"));
+
+        std::string out;
+        assert(q.try_pop(out) && out == "0");
+        assert(*q.front() == "1");
+        q.pop();
+
+        std::string batch[] = {"4", "5", "6"};
+        assert(q.try_push_n(batch, 3) == 2);
+        std::string got[4];
+        assert(q.try_pop_n(got, 4) == 4);
+        assert(got[0] == "2" && got[3] == "5" && q.front() == nullptr);
+
+        // left over elements are destroyed with the queue
+        spsc_queue<unique_ptr<int>> owners(8);
+        owners.try_emplace(new int(1));
+        owners.try_push(make_unique<int>(2));
+    }
+
+    /*********************producer / consumer*****************************/
+    {
+        const size_t count = 1000000;
+        spsc_queue<size_t> q(1024);
+
+        std::thread producer([&] {
+            size_t next = 0;
+            size_t batch[32];
+            while (next < count) {
+                if (next % 3 == 0) {
+                    if (q.try_push(next))
+                        ++next;
+                }
+                else {
+                    const size_t n = MYSTL::min<size_t>(32, count - next);
+                    for (size_t i = 0; i < n; ++i)
+                        batch[i] = next + i;
+                    next += q.try_push_n(batch, n);
+                }
+            }
+        });
+
+        size_t expect = 0;
+        size_t batch[17];
+        while (expect < count) {
+            const size_t n = q.try_pop_n(batch, 17);
+            for (size_t i = 0; i < n; ++i)
+                assert(batch[i] == expect++);
+            size_t one;
+            if (q.try_pop(one))
+                assert(one == expect++);
+        }
+        producer.join();
+        assert(q.empty());
+    }
+
+    /*********************allocator*****************************/
+    {
+        using tracked = tracking_allocator<allocator<std::string>>;
+        {
+            spsc_queue<std::string, tracked> q(16, tracked("spsc_queue"));
+            assert(q.try_push("left in the queue") && q.get_allocator() == tracked("spsc_queue"));
+            assert(tracking_stats_of("spsc_queue").live_bytes == 16 * sizeof(std::string));
+        }
+        const tracking_stats st = tracking_stats_of("spsc_queue");
+        assert(st.allocations == 1 && st.deallocations == 1 && st.live_bytes == 0);
+    }
+
+    // a capacity above the largest power of two is rejected instead of looping forever
+    for (size_t bad : {(static_cast<size_t>(-1) >> 1) + 2, static_cast<size_t>(-1)}) {
+        try {
+            spsc_queue<int> q(bad);
+            assert(false);
+        }
+        catch (const std::length_error&) {}
+    }
+
+    cout << "spsc_queue test passed" << endl;
+    return 0;
+}
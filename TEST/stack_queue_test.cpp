@@ -0,0 +1,120 @@
+#include "../MySTL/stack.h"
+#include "../MySTL/queue.h"
+#include "../MySTL/vector.h"
+#include "../MySTL/list.h"
+#include "../MySTL/memory.h"
+#include <iostream>
+#include <cassert>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+struct Point {
+    int x, y;
+    Point(int a, int b) : x(a), y(b) {}
+};
+
+// reserve() is only there when the container has one
+template <typename A, typename = void>
+struct has_reserve : std::false_type {};
+template <typename A>
+struct has_reserve<A, decltype(std::declval<A&>().reserve(0), void())> : std::true_type {};
+
+static_assert(has_reserve<stack<int, vector<int>>>::value, "vector backed stack reserves");
+static_assert(!has_reserve<stack<int>>::value, "deque backed stack has no reserve");
+static_assert(!has_reserve<queue<int, list<int>>>::value, "list backed queue has no reserve");
+
+int main() {
+
+    /*********************stack*****************************/
+    {
+        stack<int> s;
+        for (int i = 0; i < 10000; ++i)
+            s.push(i);
+        assert(s.size() == 10000 && s.top() == 9999);
+        while (s.size() > 1)
+            s.pop();
+        assert(s.top() == 0);
+    }
+
+    {
+        stack<int, vector<int>> s;
+        s.reserve(64);
+        s.push_range({1, 2, 3});
+        int more[] = {4, 5};
+        s.push_range(more);
+        assert(s.size() == 5 && s.top() == 5);
+        s.pop();
+        s.pop();
+        assert(s.top() == 3);
+
+        stack<int, vector<int>> t;
+        t.push_range(vector<int>{1, 2, 3});
+        assert(s == t);
+        t.push(4);
+        assert(s != t && s < t);
+        swap(s, t);
+        assert(s.size() == 4);
+
+        // many small bulk pushes grow the vector geometrically, not once per call
+        stack<int, vector<int>> many;
+        size_t grows = 0;
+        for (int i = 0; i < 50000; ++i) {
+            const size_t cap = many.container().capacity();
+            many.push_range({i, i});
+            grows += many.container().capacity() != cap;
+        }
+        assert(many.size() == 100000 && many.top() == 49999 && grows < 40);
+    }
+
+    {
+        stack<Point, list<Point>> s;
+        s.emplace(1, 2);
+        s.emplace(3, 4);
+        assert(s.top().x == 3);
+        s.pop();
+        assert(s.top().y == 2);
+
+        stack<unique_ptr<int>, vector<unique_ptr<int>>> owners;
+        owners.emplace(new int(7));
+        owners.push(make_unique<int>(8));
+        assert(*owners.top() == 8);
+    }
+
+    /*********************queue*****************************/
+    {
+        // bfs over an implicit binary tree, the frontier stays bounded
+        queue<int> q;
+        q.push(1);
+        int visited = 0;
+        while (!q.empty()) {
+            int v = q.front();
+            q.pop();
+            ++visited;
+            if (2 * v + 1 <= 100000) {
+                q.push(2 * v);
+                q.push(2 * v + 1);
+            }
+        }
+        assert(visited == 99999);
+    }
+
+    {
+        queue<Point, list<Point>> q;
+        q.emplace(1, 2);
+        q.push_range({Point(3, 4), Point(5, 6)});
+        assert(q.size() == 3 && q.front().x == 1 && q.back().x == 5);
+        q.pop();
+        assert(q.front().y == 4);
+
+        queue<int> a, b;
+        a.push_range({1, 2, 3});
+        b.push_range(a.container());
+        assert(a == b);
+    }
+
+    cout << "stack/queue test passed" << endl;
+    return 0;
+}
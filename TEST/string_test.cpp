@@ -0,0 +1,178 @@
+#include "../MySTL/basic_string.h"
+#include "../MySTL/flat_hash_map.h"
+#include "../MySTL/tracking_allocator.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <string>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+template <typename S, typename R>
+bool same(const S& a, const R& b) {
+    return a.size() == b.size() && std::char_traits<typename R::value_type>::compare(a.c_str(), b.c_str(), a.size() + 1) == 0;
+}
+
+int main() {
+
+    // the object is three words and short strings stay inside it
+    static_assert(sizeof(string) == 3 * sizeof(void*), "three words");
+    string s;
+    assert(s.empty() && s.c_str()[0] == '\0' && s.capacity() == 3 * sizeof(void*) - 1);
+    const char* inside = s.data();
+    s = "exactly twenty three ch";
+    assert(s.size() == 23 && s.data() == inside && s.c_str()[23] == '\0');
+    s += '!';
+    assert(s.size() == 24 && s.data() != inside && s == "exactly twenty three ch!");
+    s.pop_back();
+    s.shrink_to_fit();
+    assert(s.data() == inside && s == "exactly twenty three ch");
+
+    u32string w(5, U'x');
+    assert(w.capacity() == 5 && w.size() == 5 && w.c_str()[5] == 0);
+    w.push_back(U'y');
+    assert(w.size() == 6 && w.back() == U'y' && w[0] == U'x');
+
+    // append, insert, erase and replace, aliasing included
+    string a("hello");
+    a.append(" world").append(3, '!');
+    assert(a == "hello world!!!" && a.length() == 14);
+    a.append(a);
+    assert(a == "hello world!!!hello world!!!");
+    a.append(a.data() + 6, 5);
+    assert(a.ends_with("world") && a.starts_with("hello"));
+    a.insert(0, a.data() + 6, 5);
+    assert(a.substr(0, 10) == "worldhello");
+    a.erase(5, 100);
+    assert(a == "world");
+    a.replace(1, 3, "ORL");
+    assert(a == "wORLd");
+    a.replace(0, 1, a);
+    assert(a == "wORLdORLd");
+    a.replace(a.begin(), a.begin() + 5, string("x"));
+    assert(a == "xORLd");
+    a.insert(a.begin() + 1, '-');
+    a.erase(a.end() - 1);
+    assert(a == "x-ORL" && a.compare("x-ORL") == 0 && a < string("y") && a > string("x"));
+    try {
+        a.at(5);
+        assert(false);
+    }
+    catch (const std::out_of_range&) {}
+
+    // find / rfind against std::string on random text over a small alphabet
+    {
+        std::string ref;
+        for (int i = 0; i < 2000; ++i)
+            ref.push_back(static_cast<char>('a' + rand() % 4));
+        string str(ref);
+        for (int i = 0; i < 2000; ++i) {
+            const std::string pat = ref.substr(rand() % ref.size(), rand() % 6);
+            const size_t pos = rand() % (ref.size() + 10);
+            assert(str.find(pat.c_str(), pos) == ref.find(pat, pos));
+            assert(str.rfind(pat.c_str(), pos) == ref.rfind(pat, pos));
+            assert(str.find(pat.c_str()) == ref.find(pat));
+            assert(str.rfind(pat.c_str()) == ref.rfind(pat));
+            const char ch = static_cast<char>('a' + rand() % 5);
+            assert(str.find(ch, pos) == ref.find(ch, pos));
+            assert(str.rfind(ch, pos) == ref.rfind(ch, pos));
+        }
+        assert(str.find("zz") == string::npos && str.find("") == 0 && str.rfind("") == str.size());
+        assert(str.find_first_of("dc") == ref.find_first_of("dc"));
+        assert(str.find_last_of("ab") == ref.find_last_of("ab"));
+        assert(str.find_first_not_of("ab") == ref.find_first_not_of("ab"));
+        assert(str.std_string() == ref);
+    }
+
+    // random edits checked against std::string, across the short / long boundary
+    {
+        string str;
+        std::string ref;
+        for (int i = 0; i < 20000; ++i) {
+            switch (rand() % 7) {
+            case 0:
+                str.push_back('a' + i % 26);
+                ref.push_back('a' + i % 26);
+                break;
+            case 1: {
+                const size_t n = rand() % 8;
+                str.append(n, 'z');
+                ref.append(n, 'z');
+                break;
+            }
+            case 2:
+                if (!ref.empty()) {
+                    const size_t pos = rand() % ref.size(), n = rand() % 10;
+                    str.erase(pos, n);
+                    ref.erase(pos, n);
+                }
+                break;
+            case 3: {
+                const size_t pos = ref.empty() ? 0 : rand() % ref.size();
+                str.insert(pos, "0123456789", rand() % 10);
+                ref.insert(pos, "0123456789", str.size() - ref.size());
+                break;
+            }
+            case 4:
+                if (ref.size() > 40) {
+                    str.resize(rand() % 30);
+                    ref.resize(str.size());
+                }
+                break;
+            case 5: {
+                const size_t pos = ref.empty() ? 0 : rand() % ref.size();
+                str.replace(pos, 3, "ABCDE", 5);
+                ref.replace(pos, 3, "ABCDE", 5);
+                break;
+            }
+            default: {
+                string copy(str);
+                string moved(MYSTL::move(copy));
+                assert(copy.empty() && moved == str);
+                str.swap(moved);
+                str.shrink_to_fit();
+            }
+            }
+            assert(same(str, ref));
+        }
+    }
+
+    // operator+, streams and the hash
+    {
+        string x = string("ab") + "cd" + 'e' + string("fg");
+        assert(x == "abcdefg" && "abcdefg" == x);
+        cout << x << endl;
+        assert(MYSTL::hash<string>()(x) == MYSTL::hash<std::string>()(std::string("abcdefg")));
+        flat_hash_map<string, int> counts;
+        for (int i = 0; i < 1000; ++i)
+            ++counts[string(1, static_cast<char>('a' + i % 10)) + "key"];
+        assert(counts.size() == 10 && counts[string("bkey")] == 100);
+    }
+
+    // long buffers come from the string's allocator, which travels with copies and moves
+    {
+        using tracked = tracking_allocator<allocator<char>>;
+        using tstring = basic_string<char, std::char_traits<char>, tracked>;
+        {
+            tstring a("a string too long for the inline buffer", tracked("string"));
+            tstring b(a), c(MYSTL::move(a));
+            tstring d;
+            d = MYSTL::move(b);
+            d.append(100, 'x');
+            d.assign(200, 'y');
+            d.shrink_to_fit();
+            c += c;
+            const tstring e = c.substr(3, 40) + "tail";
+            assert(e.get_allocator() == tracked("string") && d.get_allocator() == tracked("string"));
+            assert(d.size() == 200 && e.size() == 44);
+        }
+        const tracking_stats st = tracking_stats_of("string");
+        assert(st.allocations > 0 && st.allocations == st.deallocations && st.live_bytes == 0);
+    }
+
+    cout << "string test passed" << endl;
+    return 0;
+}
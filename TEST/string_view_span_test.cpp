@@ -0,0 +1,138 @@
+#include "../MySTL/string_view.h"
+#include "../MySTL/span.h"
+#include "../MySTL/basic_string.h"
+#include "../MySTL/vector.h"
+#include "../MySTL/algo.h"
+#include "../MySTL/flat_hash_map.h"
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <string>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+// splits "key=value;key=value" without copying a byte of the input
+size_t parse(string_view input, vector<pair<string_view, string_view>>& out) {
+    while (!input.empty()) {
+        const size_t end = MYSTL::min(input.find(';'), input.size());
+        string_view field = input.substr(0, end);
+        const size_t eq = field.find('=');
+        if (eq != string_view::npos)
+            out.push_back(MYSTL::make_pair(field.substr(0, eq), field.substr(eq + 1)));
+        input.remove_prefix(MYSTL::min(end + 1, input.size()));
+    }
+    return out.size();
+}
+
+int sum(span<const int> s) {
+    int total = 0;
+    for (int x : s)
+        total += x;
+    return total;
+}
+
+int main() {
+
+    // string_view over a vector<char> buffer
+    const char* text = "host=example.org;port=8080;;path=/index;junk";
+    vector<char> buf(text, text + std::strlen(text));
+    vector<pair<string_view, string_view>> fields;
+    assert(parse(string_view(buf.data(), buf.size()), fields) == 3);
+    assert(fields[0].first == "host" && fields[0].second == "example.org");
+    assert(fields[1].second == "8080" && fields[2].second == "/index");
+    assert(fields[0].first.data() == buf.data());
+    cout << fields[2].first << " = " << fields[2].second << endl;
+
+    // the searches agree with std::string
+    {
+        std::string ref = "abracadabra, abracadabra";
+        string_view v(ref);
+        const char* pats[] = {"", "a", "abra", "cad", "ra,", "zz", "abracadabra, abracadabra!"};
+        for (const char* p : pats) {
+            for (size_t pos = 0; pos <= ref.size() + 1; ++pos) {
+                assert(v.find(p, pos) == ref.find(p, pos));
+                assert(v.rfind(p, pos) == ref.rfind(p, pos));
+            }
+        }
+        assert(v.find_first_of("dc") == ref.find_first_of("dc"));
+        assert(v.find_last_of("dc") == ref.find_last_of("dc"));
+        assert(v.find_first_not_of("abr") == ref.find_first_not_of("abr"));
+        assert(v.find_last_not_of("abr") == ref.find_last_not_of("abr"));
+        assert(v.starts_with("abra") && v.ends_with("dabra") && !v.ends_with('x'));
+        assert(v.substr(4, 3) == "cad" && v.substr(5) < v.substr(4, 3) && v.compare(v) == 0);
+        // ordering against anything convertible to a view, on either side
+        assert(v < "abs" && v <= "abs" && v > "abracadabra" && v >= "abr");
+        assert("abs" > v && "abs" >= v && "abracadabra" < v && "abr" <= v && !(v < "abr"));
+        try {
+            v.substr(ref.size() + 1);
+            assert(false);
+        }
+        catch (const std::out_of_range&) {}
+    }
+
+    // with basic_string: conversions both ways, mixed comparison, same hash
+    {
+        string s("hello world");
+        string_view v = s;
+        assert(v == s && s == v && v.data() == s.data());
+        string copy(v.substr(6));
+        assert(copy == "world");
+        copy += string_view(" and more", 4);
+        assert(copy == "world and");
+        assert(MYSTL::hash<string_view>()(v) == MYSTL::hash<string>()(s));
+
+        flat_hash_map<string_view, int> words;
+        const char* sentence = "the cat and the dog and the bird";
+        string_view rest(sentence);
+        while (!rest.empty()) {
+            const size_t sp = MYSTL::min(rest.find(' '), rest.size());
+            ++words[rest.substr(0, sp)];
+            rest.remove_prefix(MYSTL::min(sp + 1, rest.size()));
+        }
+        assert(words.size() == 5 && words["the"] == 3 && words["and"] == 2);
+    }
+
+    // span: dynamic and static extent over vectors and arrays
+    {
+        vector<int> v{5, 1, 4, 2, 3};
+        span<int> all(v);
+        assert(all.size() == 5 && all.data() == v.data() && sum(all) == 15);
+        MYSTL::sort(all.begin(), all.end());
+        assert(v[0] == 1 && v[4] == 5);
+        assert(sum(all.first(2)) == 3 && sum(all.last(2)) == 9 && sum(all.subspan(1, 3)) == 9);
+        assert(MYSTL::lower_bound(all.begin(), all.end(), 4) == v.data() + 3);
+
+        int arr[6] = {1, 2, 3, 4, 5, 6};
+        span<int, 6> fixed(arr);
+        static_assert(sizeof(fixed) == sizeof(int*), "a static span is one pointer");
+        static_assert(sizeof(span<int>) == 2 * sizeof(void*), "a dynamic span is two words");
+        span<int, 2> head = fixed.first<2>();
+        span<int, 3> mid = fixed.subspan<1, 3>();
+        span<int, 4> tail = fixed.subspan<2>();
+        assert(head[1] == 2 && mid.front() == 2 && mid.back() == 4 && tail.size() == 4 && tail[3] == 6);
+        span<const int> dyn = fixed;
+        assert(dyn.size() == 6 && sum(dyn) == 21 && sum(fixed.last<3>()) == 15);
+        auto rit = fixed.rbegin();
+        assert(*rit == 6 && *++rit == 5);
+
+        // byte views
+        auto bytes = as_writable_bytes(fixed);
+        static_assert(decltype(bytes)::extent == 6 * sizeof(int), "static byte extent");
+        MYSTL::fill_n(bytes.data(), sizeof(int), 0);
+        assert(arr[0] == 0 && as_bytes(dyn).size() == 6 * sizeof(int));
+
+        const vector<int>& cv = v;
+        span<const int> cs(cv);
+        auto made = make_span(v);
+        assert(cs.size() == 5 && made.data() == v.data() && make_span(arr).size() == 6);
+
+        span<int> empty_span;
+        assert(empty_span.empty() && empty_span.begin() == empty_span.end());
+    }
+
+    cout << "string_view/span test passed" << endl;
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "../MySTL/thread_cache.h"
+#include "../MySTL/vector.h"
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <new>
+#include <thread>
+
+
+using std::cout;
+using std::endl;
+
+template <typename F>
+double time_ms(F f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+struct use_new {
+    static void* allocate(size_t n) { return ::operator new(n); }
+    static void deallocate(void* p, size_t) { ::operator delete(p); }
+};
+struct use_thread_cache {
+    static void* allocate(size_t n) { return MYSTL::__thread_cache_allocate(n); }
+    static void deallocate(void* p, size_t n) { MYSTL::__thread_cache_deallocate(p, n); }
+};
+
+// every thread allocates 256 blocks of 16..512 bytes, touches them and frees them, again
+// and again. returns million allocate + deallocate pairs per second over all threads
+template <typename Alloc>
+double run(unsigned threads, size_t rounds) {
+    const double ms = time_ms([&] {
+        MYSTL::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t)
+            workers.emplace_back([rounds, t] {
+                void* blocks[256];
+                size_t sizes[256];
+                uint64_t x = t * 0x9e3779b97f4a7c15ULL + 1;
+                for (int i = 0; i < 256; ++i) {
+                    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                    sizes[i] = 16 + x % 497;
+                }
+                for (size_t r = 0; r < rounds; ++r) {
+                    for (int i = 0; i < 256; ++i) {
+                        blocks[i] = Alloc::allocate(sizes[i]);
+                        *static_cast<char*>(blocks[i]) = static_cast<char>(i);
+                    }
+                    for (int i = 0; i < 256; ++i)
+                        Alloc::deallocate(blocks[i], sizes[i]);
+                }
+            });
+        for (auto& w : workers)
+            w.join();
+    });
+    return threads * rounds * 256 / ms / 1000.0;
+}
+
+// measures the single-thread fast path, and scaling only up to the hardware threads of the
+// machine it runs on: with more threads than cores the numbers show time slicing, not
+// contention, so those counts are not run. on one core there is nothing to scale.
+int main() {
+    const unsigned cores = MYSTL::max(1u, std::thread::hardware_concurrency());
+    const size_t rounds = 20000;
+    cout << "hardware threads: " << cores << endl;
+    if (cores == 1)
+        cout << "one hardware thread: multi-core scaling is not measured" << endl;
+    for (unsigned threads = 1; threads <= cores; threads *= 2) {
+        const double a = run<use_new>(threads, rounds);
+        const double b = run<use_thread_cache>(threads, rounds);
+        cout << threads << " threads  operator new " << a << " M/s  thread cache " << b << " M/s  x" << b / a
+             << endl;
+    }
+    return 0;
+}
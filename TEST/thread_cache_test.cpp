@@ -0,0 +1,144 @@
+#define MYSTL_USE_THREAD_CACHE
+#include "../MySTL/thread_cache.h"
+#include "../MySTL/vector.h"
+#include "../MySTL/list.h"
+#include "../MySTL/map.h"
+#include "../MySTL/basic_string.h"
+#include "../MySTL/memory.h"
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+// a block filled with a byte derived from its address and size
+void stamp(void* p, size_t bytes) {
+    std::memset(p, static_cast<int>((reinterpret_cast<uintptr_t>(p) >> 4) ^ bytes) & 0xff, bytes);
+}
+bool stamped(const void* p, size_t bytes) {
+    const unsigned char expect = static_cast<unsigned char>((reinterpret_cast<uintptr_t>(p) >> 4) ^ bytes);
+    const unsigned char* b = static_cast<const unsigned char*>(p);
+    for (size_t i = 0; i < bytes; ++i)
+        if (b[i] != expect)
+            return false;
+    return true;
+}
+
+struct block {
+    void*  p;
+    size_t bytes;
+};
+
+// allocates with a mix of sizes, frees half, hands the rest to the caller
+void churn(unsigned seed, vector<block>& keep) {
+    uint64_t x = seed * 0x9e3779b97f4a7c15ULL + 1;
+    vector<block> live;
+    for (int i = 0; i < 20000; ++i) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        const size_t bytes = (x % 16 == 0) ? x % 70000 : x % 600;
+        void* p = __thread_cache_allocate(bytes);
+        assert(reinterpret_cast<uintptr_t>(p) % 16 == 0);
+        stamp(p, bytes);
+        live.push_back(block{p, bytes});
+        if (live.size() > 64) {
+            const size_t k = x % live.size();
+            assert(stamped(live[k].p, live[k].bytes));
+            __thread_cache_deallocate(live[k].p, live[k].bytes);
+            live[k] = live.back();
+            live.pop_back();
+        }
+    }
+    for (size_t i = 0; i < live.size(); ++i) {
+        if (i % 2)
+            keep.push_back(live[i]);
+        else
+            __thread_cache_deallocate(live[i].p, live[i].bytes);
+    }
+}
+
+// allocated before the cache of its thread, destroyed after it
+struct late {
+    vector<int> v;
+    ~late() {
+        v.push_back(1);
+        vector<int> other(100, 2);
+        assert(other[99] == 2);
+    }
+};
+thread_local late late_object;
+
+int main() {
+
+    // size classes cover every small size tightly
+    for (size_t i = 0; i < __tc_size_class::count; ++i) {
+        assert(__tc_size_class::index(__tc_size_class::size(i)) == i);
+        assert(__tc_size_class::size(i) % 16 == 0);
+    }
+    for (size_t b = 1; b <= __tc_size_class::max_small; ++b) {
+        const size_t idx = __tc_size_class::index(b);
+        assert(__tc_size_class::size(idx) >= b && (idx == 0 || __tc_size_class::size(idx - 1) < b));
+        assert(__tc_size_class::size(idx) - b <= b / 4 + 16);
+    }
+
+    // threads allocating, and blocks freed by a thread other than their owner
+    {
+        const unsigned threads = 8;
+        vector<vector<block>> kept(threads);
+        vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t)
+            workers.emplace_back([&kept, t] {
+                churn(t + 1, kept[t]);
+                late_object.v.push_back(static_cast<int>(t));
+            });
+        for (auto& w : workers)
+            w.join();
+        std::thread freer([&kept] {
+            for (auto& k : kept)
+                for (auto& b : k) {
+                    assert(stamped(b.p, b.bytes));
+                    __thread_cache_deallocate(b.p, b.bytes);
+                }
+            thread_cache_release();
+        });
+        freer.join();
+    }
+
+    // containers on top of the switched MYSTL::allocator
+    {
+        vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t)
+            workers.emplace_back([t] {
+                map<int, string> m;
+                list<vector<int>> l;
+                for (int i = 0; i < 5000; ++i) {
+                    m[i] = string(static_cast<size_t>(i % 50), static_cast<char>('a' + t));
+                    l.push_back(vector<int>(static_cast<size_t>(i % 20), i));
+                    if (i % 3 == 0)
+                        m.erase(i / 2);
+                }
+                assert(m.find(4999) != m.end() && (*m.find(4999)).second.size() == 4999 % 50);
+                assert(l.back().size() == 4999 % 20 && l.back().front() == 4999);
+                auto sp = make_shared<vector<int>>(1000, t);
+                assert((*sp)[999] == t);
+            });
+        for (auto& w : workers)
+            w.join();
+    }
+
+    // the allocator type on its own, large blocks included
+    {
+        vector<double, thread_cache_allocator<double>> v;
+        for (int i = 0; i < 100000; ++i)
+            v.push_back(i * 0.5);
+        assert(v[99999] == 99999 * 0.5);
+        assert(thread_cache_allocator<int>() == thread_cache_allocator<double>());
+    }
+
+    cout << "thread_cache test passed" << endl;
+    return 0;
+}
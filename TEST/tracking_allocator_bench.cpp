@@ -0,0 +1,52 @@
+#include "../MySTL/tracking_allocator.h"
+#include "../MySTL/vector.h"
+#include "../MySTL/list.h"
+#include <iostream>
+#include <chrono>
+#include <thread>
+
+
+using std::cout;
+using std::endl;
+
+template <typename F>
+double time_ms(F f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// list churn and vector growth on `threads` threads, with the allocator a
+template <typename Alloc>
+double run(const Alloc& a, unsigned threads) {
+    return time_ms([&] {
+        MYSTL::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t)
+            workers.emplace_back([&a] {
+                using list_alloc = typename Alloc::template rebind<long>::other;
+                MYSTL::list<long, list_alloc> l{list_alloc(a)};
+                for (int round = 0; round < 2000; ++round) {
+                    for (long i = 0; i < 100; ++i)
+                        l.push_back(i);
+                    while (!l.empty())
+                        l.pop_front();
+                    MYSTL::vector<int, Alloc> v{a};
+                    for (int i = 0; i < 1000; ++i)
+                        v.push_back(i);
+                }
+            });
+        for (auto& w : workers)
+            w.join();
+    });
+}
+
+int main() {
+    const unsigned threads = std::thread::hardware_concurrency() < 4 ? 4 : std::thread::hardware_concurrency();
+    const double plain = run(MYSTL::allocator<int>(), threads);
+    const double tracked = run(MYSTL::tracking_allocator<MYSTL::allocator<int>>("bench"), threads);
+    cout << threads << " threads  plain " << plain << " ms  tracked " << tracked << " ms  overhead "
+         << (tracked / plain - 1) * 100 << " %" << endl;
+    MYSTL::tracking_report(cout);
+    return 0;
+}
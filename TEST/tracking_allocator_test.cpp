@@ -0,0 +1,94 @@
+#include "../MySTL/tracking_allocator.h"
+#include "../MySTL/vector.h"
+#include "../MySTL/list.h"
+#include <iostream>
+#include <sstream>
+#include <cassert>
+#include <string>
+#include <thread>
+
+
+using namespace MYSTL;
+using std::cout;
+using std::endl;
+
+using tracked_ints = tracking_allocator<allocator<int>>;
+
+int main() {
+
+    // vector growth: one request per doubling, all freed again
+    {
+        vector<int, tracked_ints> v{tracked_ints("vector growth")};
+        for (int i = 0; i < 1000; ++i)
+            v.push_back(i);
+        const tracking_stats s = tracking_stats_of("vector growth");
+        assert(s.allocations == 11 && s.deallocations == 10);  // 1, 2, 4 ... 1024 ints
+        assert(s.live_bytes == static_cast<int64_t>(v.capacity() * sizeof(int)));
+        assert(s.peak_bytes == static_cast<int64_t>((512 + 1024) * sizeof(int)));
+        assert(s.bytes_allocated == 2047 * sizeof(int));
+        for (size_t b = 2; b <= 12; ++b)
+            assert(s.histogram[b] == 1);
+        assert(v.get_allocator().tag() == std::string("vector growth"));
+    }
+    assert(tracking_stats_of("vector growth").live_bytes == 0);
+
+    // list churn: every node counted, the rebound allocator keeps the tag
+    {
+        list<long, tracking_allocator<allocator<long>>> l{tracking_allocator<allocator<long>>("list churn")};
+        for (int round = 0; round < 100; ++round) {
+            for (int i = 0; i < 50; ++i)
+                l.push_back(i);
+            while (l.size() > 10)
+                l.pop_front();
+        }
+        list<long, tracking_allocator<allocator<long>>> copy(l);
+        list<long, tracking_allocator<allocator<long>>> moved;
+        moved = MYSTL::move(copy);
+        assert(moved.size() == 10 && copy.empty());
+        const tracking_stats s = tracking_stats_of("list churn");
+        assert(s.allocations >= 5000 && s.allocations - s.deallocations == 1 + 10 + 1 + 10 + 1);
+        assert(s.histogram[4] + s.histogram[5] == s.allocations);  // nodes are 24 bytes
+    }
+    {
+        const tracking_stats s = tracking_stats_of("list churn");
+        assert(s.live_bytes == 0 && s.allocations == s.deallocations);
+    }
+
+    // threads merge lazily, and completely when they exit
+    {
+        int* kept[4];
+        vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t)
+            workers.emplace_back([&kept, t] {
+                tracked_ints a("threads");
+                for (int i = 0; i < 3000; ++i) {
+                    int* p = a.allocate(4);
+                    a.deallocate(p, 4);
+                }
+                kept[t] = a.allocate(100);  // still live when the thread exits
+            });
+        for (auto& w : workers)
+            w.join();
+        const tracking_stats s = tracking_stats_of("threads");
+        assert(s.allocations == 4 * 3001 && s.deallocations == 4 * 3000);
+        assert(s.live_bytes == 4 * 400 && s.histogram[4] == 4 * 3000 && s.histogram[8] == 4);
+        tracked_ints a("threads");
+        for (int* p : kept)
+            a.deallocate(p, 100);
+        assert(tracking_stats_of("threads").live_bytes == 0);
+    }
+
+    // the report lists every tag in use
+    {
+        std::ostringstream os;
+        tracking_report(os);
+        const std::string r = os.str();
+        assert(r.find("vector growth") != std::string::npos && r.find("list churn") != std::string::npos);
+        assert(r.find("threads") != std::string::npos);
+        cout << r;
+    }
+
+    assert(tracked_ints("a") == tracking_allocator<allocator<char>>("a") && tracked_ints("a") != tracked_ints("b"));
+    cout << "tracking_allocator test passed" << endl;
+    return 0;
+}
@@ -1,68 +1,106 @@
 #include "../MySTL/vector.h"
 #include <iostream>
+#include <cassert>
 #include <initializer_list>
+#include <string>
 #include <utility>
 
 
 using namespace MYSTL;
 using std::cout;
 using std::endl;
-using std::ostream;
 
-template <typename T>
-void printVec(vector<T> vec) {
-    for(auto i: vec) {
-        cout << i << endl;
-    }
-}
-
-int main() {
-
-    vector<int> vec2{2, 4, 5};
-
-    vector<int> vec3(10, 3);
-    vector<int> vec4(std::move(vec2));
-    //printVec(vec3);
-    //const vector<int> con_vec1 = vec3;
-    //const vector<int> con_vec2(10, 3);    
-
-    // cout << "vec2:" << endl;
-    // printVec(vec2);
+// counts live objects, so a leaked or doubly destroyed element shows up
+struct counted {
+    static int live;
+    std::string value;
 
-    // cout << "vec1: " << endl;
-    // printVec(vec1);
-    cout << "vec4:" << endl;
-    printVec(vec4);
+    counted() { ++live; }
+    counted(const char* s) : value(s) { ++live; }
+    counted(const counted& rhs) : value(rhs.value) { ++live; }
+    counted(counted&& rhs) noexcept : value(std::move(rhs.value)) { ++live; }
+    counted& operator=(const counted&) = default;
+    counted& operator=(counted&&) = default;
+    ~counted() { --live; }
 
-    vec4.emplace_back(4);
+    bool operator==(const char* s) const { return value == s; }
+};
+int counted::live = 0;
 
-    vector<int> vec1;
-    vec1.push_back(3);
-    for(int i = 0; i < 10; i ++)
-        vec1.push_back(i * 3);
-    cout << "vec1" << endl;
-    printVec(vec1);
-
-    cout << "vec4" << endl;
-    printVec(vec4);
-
-    cout << "vec1.size() = " << vec1.size() << endl;
-    cout << "vec1.capacaty() = " << vec1.capacity() << endl;
-    vec1.shrink_to_fit();
-    cout << "vec1.size() = " << vec1.size() << endl;
-    cout << "vec1.capacaty() = " << vec1.capacity() << endl;
-    vec4.assign(vec1.begin(), vec1.end());
-    cout << "vec4" << endl;
-    printVec(vec4);
-    cout << "vec4.size() = " << vec4.size() << endl;
-    cout << "vec4.capacaty() = " << vec4.capacity() << endl;
-    vec4.push_back(3);
-    cout << vec4.capacity() << endl;
+template <typename T>
+bool equal_to(const vector<T>& v, std::initializer_list<const char*> expected) {
+    if (v.size() != expected.size())
+        return false;
+    size_t i = 0;
+    for (const char* s : expected)
+        if (!(v[i++] == s))
+            return false;
+    return true;
+}
 
+int main() {
 
-    /*********************const vector test*****************************/
-    const vector<int> cvec1 = {3, 4, 5, 6};
+    /*********************basic operations*****************************/
+    {
+        vector<int> vec2{2, 4, 5};
+        vector<int> vec3(10, 3);
+        assert(vec3.size() == 10 && vec3[9] == 3);
+        vector<int> vec4(std::move(vec2));
+        assert(vec2.empty() && vec4.size() == 3 && vec4[2] == 5);
+        vec4.emplace_back(4);
+        assert(vec4.back() == 4);
+
+        vector<int> vec1;
+        vec1.push_back(3);
+        for (int i = 0; i < 10; i++)
+            vec1.push_back(i * 3);
+        assert(vec1.size() == 11 && vec1.capacity() >= 11 && vec1[10] == 27);
+        vec1.shrink_to_fit();
+        assert(vec1.size() == 11 && vec1.capacity() == 11 && vec1[0] == 3);
+
+        vec4.assign(vec1.begin(), vec1.end());
+        assert(vec4.size() == 11 && vec4[5] == 12);
+        vec4.push_back(3);
+        assert(vec4.size() == 12 && vec4.capacity() >= 12);
+
+        const vector<int> cvec1 = {3, 4, 5, 6};
+        assert(cvec1.front() == 3 && cvec1.back() == 6);
+    }
 
+    /*********************range insert within capacity*****************************/
+    {
+        const counted src[] = {"x", "y", "z"};
+
+        // more elements after the position than inserted
+        vector<counted> v{"a", "b", "c", "d", "e"};
+        v.reserve(16);
+        v.insert(v.begin() + 1, src, src + 2);
+        assert(equal_to(v, {"a", "x", "y", "b", "c", "d", "e"}));
+
+        // fewer elements after the position than inserted
+        v.insert(v.end() - 1, src, src + 3);
+        assert(equal_to(v, {"a", "x", "y", "b", "c", "d", "x", "y", "z", "e"}));
+
+        // with reallocation
+        v.shrink_to_fit();
+        v.insert(v.begin(), src, src + 3);
+        assert(equal_to(v, {"x", "y", "z", "a", "x", "y", "b", "c", "d", "x", "y", "z", "e"}));
+        assert(counted::live == 3 + 13);
+    }
+    assert(counted::live == 0);
+
+    /*********************shrink_to_fit*****************************/
+    {
+        vector<counted> v;
+        for (int i = 0; i < 5; ++i)
+            v.emplace_back("s");
+        v.reserve(64);
+        v.shrink_to_fit();
+        assert(v.capacity() == 5 && equal_to(v, {"s", "s", "s", "s", "s"}));
+        assert(counted::live == 5);
+    }
+    assert(counted::live == 0);
 
+    cout << "vector test passed" << endl;
     return 0;
 }